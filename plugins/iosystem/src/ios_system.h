@@ -881,6 +881,7 @@ TEMP EventSet THIS::OutputEvents(void) const {
 TEMP void THIS::OutputEvents(const EventSet& rEventSet) {
   //FD_DIO("IoSystem(" << this << ")::OutputEvents(" << rEventSet.Name() << ")");
   EventSet::Iterator eit;
+  BASE::pAlphabet->Detach();
   for(eit=BASE::AlphabetBegin(); eit!=BASE::AlphabetEnd(); eit++) 
     if(rEventSet.Exists(*eit)) SetOutputEvent(*eit);
     else ClrOutputEvent(*eit);
@@ -957,6 +958,7 @@ TEMP EventSet THIS::InputEvents(void) const {
 TEMP void THIS::InputEvents(const EventSet& rEventSet) {
   //FD_DIO("IoSystem(" << this << ")::InputEvents(" << rEventSet.Name() << ")");
   EventSet::Iterator eit;
+  BASE::pAlphabet->Detach();
   for(eit=BASE::AlphabetBegin(); eit!=BASE::AlphabetEnd(); eit++) 
     if(rEventSet.Exists(*eit)) SetInputEvent(*eit);
     else ClrInputEvent(*eit);
@@ -1034,6 +1036,7 @@ TEMP StateSet THIS::OutputStates(void) const {
 TEMP void THIS::OutputStates(const StateSet& rStateSet) {
   FD_DIO("IoSystem(" << this << ")::OutputStates(" << rStateSet.Name() << ")");
   StateSet::Iterator sit;
+  BASE::pStates->Detach();
   for(sit=BASE::StatesBegin(); sit!=BASE::StatesEnd(); sit++) 
     if(rStateSet.Exists(*sit)) SetOutputState(*sit);
     else ClrOutputState(*sit);
@@ -1111,6 +1114,7 @@ TEMP StateSet THIS::InputStates(void) const {
 TEMP void THIS::InputStates(const StateSet& rStateSet) {
   //FD_DIO("IoSystem(" << this << ")::InputStates(" << rStateSet.Name() << ")");
   StateSet::Iterator sit;
+  BASE::pStates->Detach();
   for(sit=BASE::StatesBegin(); sit!=BASE::StatesEnd(); sit++) 
     if(rStateSet.Exists(*sit)) SetInputState(*sit);
     else ClrInputState(*sit);
@@ -1190,6 +1194,7 @@ TEMP StateSet THIS::ErrorStates(void) const {
 TEMP void THIS::ErrorStates(const StateSet& rStateSet) {
   //FD_DIO("IoSystem(" << this << ")::ErrorStates(" << rStateSet.Name() << ")");
   StateSet::Iterator sit;
+  BASE::pStates->Detach();
   for(sit=BASE::StatesBegin(); sit!=BASE::StatesEnd(); sit++) 
     if(rStateSet.Exists(*sit)) SetErrorState(*sit);
     else ClrErrorState(*sit);
@@ -1133,6 +1133,7 @@ TEMP void THIS::DelColor(const std::string& rColorName) {
 
   Idx index = ColorIndex(rColorName);
 
+  BASE::pStates->Detach();
   for (lit = BASE::pStates->Begin(); lit != BASE::pStates->End(); lit++) {
     attr = BASE::StateAttributep(*lit);
     attr->Colors().Erase(index);
@@ -1144,6 +1145,7 @@ TEMP void THIS::DelColor(const std::string& rColorName) {
 TEMP void THIS::DelColor(Idx colorIndex) {
   StateSet::Iterator lit;
   StateAttr *attr;
+  BASE::pStates->Detach();
   for (lit = BASE::pStates->Begin(); lit != BASE::pStates->End(); lit++) {
     attr = BASE::StateAttributep(*lit);
     attr->Colors().Erase(colorIndex);
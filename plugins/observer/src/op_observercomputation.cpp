@@ -36,122 +36,281 @@ is implemented.
 
 #include "op_observercomputation.h"
 #include "cfl_localgen.h"
+#include <algorithm>
 
 using namespace std;
   
 namespace faudes{
 
 
+/*
+Local reachability by SCC condensation
+
+The dynamic systems used by the observer algorithms are based on local reachability, i.e.,
+reachability via low-level events only. Rather than to run one search per state, the helper
+class op_LocalReach condenses the local subgraph to its strongly connected components and
+computes the local reach and the locally reachable high-level exits once per component. The
+components are numbered in reverse topological order (as emitted by Tarjan's algorithm) and
+the states are positioned accordingly. Thus, the local reach of a component is represented
+by a typically short list of intervals of consecutive positions. Results are computed on
+demand and then shared by all states that locally reach the respective component.
+*/
+class op_LocalReach {
+public:
+	// intervals [first,last) of positions
+	typedef std::vector< std::pair<Idx,Idx> > Intervals;
+	// construct for the specified compiled generator
+	op_LocalReach(const CompiledGenerator& rCGen);
+	// condense the local subgraph, i.e., transitions with events neither in rHighAlph nor in pExclude;
+	// states in pStop have neither local transitions nor exits; optionally follow transitions backward
+	void Condense(const EventSet& rHighAlph, const EventSet* pExclude=0, const StateSet* pStop=0, bool backward=false);
+	// number of components
+	Idx Size(void) const { return (Idx) mSucc.size(); }
+	// component of a state (internal index)
+	Idx Component(Idx q) const { return mComp[q]; }
+	// positions of the states of a component
+	Idx Begin(Idx c) const { return mBegin[c]; }
+	Idx End(Idx c) const { return mBegin[c+1]; }
+	// state (internal index) at position
+	Idx At(Idx pos) const { return mOrder[pos]; }
+	// local reach of a component, intervals of positions
+	const Intervals& Reach(Idx c);
+	// pairs of high-level event and entry component, locally reachable from a component
+	const std::vector< std::pair<Idx,Idx> >& Exits(Idx c);
+	// flags for components from which a high-level exit is locally reachable
+	void ExitReach(std::vector<bool>& rFlags) const;
+	// insert the transitions of the dynamic system for the specified state (internal index)
+	void Transitions(Idx q, TransSet& rTrans);
+protected:
+	// edges in the direction of search
+	CompiledGenerator::Iterator EdgesBegin(Idx q) const { return mBackward ? mrCGen.PredBegin(q) : mrCGen.SuccBegin(q); }
+	CompiledGenerator::Iterator EdgesEnd(Idx q) const { return mBackward ? mrCGen.PredEnd(q) : mrCGen.SuccEnd(q); }
+	// classify edges
+	bool Local(Idx q, const CompiledGenerator::Edge& rEdge) const { return (!mStop[q]) && mEvMode[rEdge.Ev]==0; }
+	bool High(Idx q, const CompiledGenerator::Edge& rEdge) const { return (!mStop[q]) && mEvMode[rEdge.Ev]==1; }
+	// callbacks for IterativeScc(): follow local edges, record components
+	static bool LocalEdge(void* pData, Idx q, const CompiledGenerator::Edge& rEdge);
+	static bool Record(void* pData, Idx root, const std::vector<Idx>& rScc);
+	// unresolved components reachable from c, successors first
+	void Schedule(Idx c, std::vector<char>& rState);
+	// compiled generator
+	const CompiledGenerator& mrCGen;
+	bool mBackward;
+	// event classification: 0 local, 1 high-level, 2 excluded
+	std::vector<char> mEvMode;
+	std::vector<bool> mStop;
+	// components: per state, positions and condensed successors
+	std::vector<Idx> mComp;
+	std::vector<Idx> mOrder;
+	std::vector<Idx> mBegin;
+	std::vector< std::vector<Idx> > mSucc;
+	// results per component, computed on demand
+	std::vector<Intervals> mReach;
+	std::vector<char> mReachState;
+	std::vector< std::vector< std::pair<Idx,Idx> > > mExits;
+	std::vector<char> mExitsState;
+	std::vector<Idx> mSchedule;
+};
+
+// construct
+op_LocalReach::op_LocalReach(const CompiledGenerator& rCGen) :
+	mrCGen(rCGen),
+	mBackward(false)
+{}
+
+// follow local edges only
+bool op_LocalReach::LocalEdge(void* pData, Idx q, const CompiledGenerator::Edge& rEdge) {
+	return ((op_LocalReach*) pData)->Local(q, rEdge);
+}
+
+// record component
+bool op_LocalReach::Record(void* pData, Idx root, const std::vector<Idx>& rScc) {
+	(void) root;
+	op_LocalReach* pReach = (op_LocalReach*) pData;
+	Idx c = (Idx) pReach->mBegin.size();
+	pReach->mBegin.push_back((Idx) pReach->mOrder.size());
+	for(std::size_t i = 0; i < rScc.size(); ++i) {
+		pReach->mComp[rScc[i]] = c;
+		pReach->mOrder.push_back(rScc[i]);
+	}
+	return true;
+}
+
+// condense local subgraph
+void op_LocalReach::Condense(const EventSet& rHighAlph, const EventSet* pExclude, const StateSet* pStop, bool backward) {
+	mBackward = backward;
+	Idx n = mrCGen.Size();
+	// classify events and states
+	mEvMode.assign(mrCGen.AlphabetSize()+1, 0);
+	for(Idx e = 1; e <= mrCGen.AlphabetSize(); ++e) {
+		if(rHighAlph.Exists(mrCGen.Event(e))) mEvMode[e] = 1;
+		else if(pExclude) if(pExclude->Exists(mrCGen.Event(e))) mEvMode[e] = 2;
+	}
+	mStop.assign(n+1, false);
+	if(pStop) {
+		StateSet::Iterator sit = pStop->Begin();
+		StateSet::Iterator sit_end = pStop->End();
+		for(; sit != sit_end; ++sit) mStop[mrCGen.StateIndex(*sit)] = true;
+		mStop[0] = false;
+	}
+	// strongly connected components, successors first
+	mComp.assign(n+1, 0);
+	mOrder.clear();
+	mOrder.reserve(n);
+	mBegin.clear();
+	std::vector<bool> todo(n+1, true);
+	IterativeScc(mrCGen, todo, &LocalEdge, &Record, this, backward);
+	Idx m = (Idx) mBegin.size();
+	mBegin.push_back((Idx) mOrder.size());
+	// condensed successors, all with a smaller index
+	mSucc.assign(m, std::vector<Idx>());
+	for(Idx c = 0; c < m; ++c) {
+		std::vector<Idx>& succ = mSucc[c];
+		for(Idx pos = mBegin[c]; pos < mBegin[c+1]; ++pos) {
+			Idx q = mOrder[pos];
+			CompiledGenerator::Iterator eit = EdgesBegin(q);
+			CompiledGenerator::Iterator eit_end = EdgesEnd(q);
+			for(; eit != eit_end; ++eit)
+				if(Local(q, *eit) && mComp[eit->X] != c) succ.push_back(mComp[eit->X]);
+		}
+		std::sort(succ.begin(), succ.end());
+		succ.erase(std::unique(succ.begin(), succ.end()), succ.end());
+	}
+	// invalidate results
+	mReach.assign(m, Intervals());
+	mReachState.assign(m, 0);
+	mExits.assign(m, std::vector< std::pair<Idx,Idx> >());
+	mExitsState.assign(m, 0);
+}
+
+// unresolved components reachable from c, successors first (depth-first on the condensed graph)
+void op_LocalReach::Schedule(Idx c, std::vector<char>& rState) {
+	mSchedule.clear();
+	if(rState[c] != 0) return;
+	std::vector< std::pair<Idx,Idx> > stack;
+	rState[c] = 1;
+	stack.push_back(std::make_pair(c, (Idx) 0));
+	while(!stack.empty()) {
+		Idx d = stack.back().first;
+		Idx i = stack.back().second;
+		if(i < mSucc[d].size()) {
+			stack.back().second = i+1;
+			Idx s = mSucc[d][i];
+			if(rState[s] != 0) continue;
+			rState[s] = 1;
+			stack.push_back(std::make_pair(s, (Idx) 0));
+			continue;
+		}
+		mSchedule.push_back(d);
+		stack.pop_back();
+	}
+}
+
+// local reach of a component
+const op_LocalReach::Intervals& op_LocalReach::Reach(Idx c) {
+	Schedule(c, mReachState);
+	Intervals all;
+	for(std::size_t k = 0; k < mSchedule.size(); ++k) {
+		Idx d = mSchedule[k];
+		// own states and the reach of successors
+		all.clear();
+		all.push_back(std::make_pair(mBegin[d], mBegin[d+1]));
+		for(std::size_t i = 0; i < mSucc[d].size(); ++i) {
+			const Intervals& sreach = mReach[mSucc[d][i]];
+			all.insert(all.end(), sreach.begin(), sreach.end());
+		}
+		// merge intervals
+		std::sort(all.begin(), all.end());
+		Intervals& reach = mReach[d];
+		for(std::size_t i = 0; i < all.size(); ++i) {
+			if(!reach.empty() && all[i].first <= reach.back().second) {
+				if(all[i].second > reach.back().second) reach.back().second = all[i].second;
+				continue;
+			}
+			reach.push_back(all[i]);
+		}
+		mReachState[d] = 2;
+	}
+	return mReach[c];
+}
+
+// locally reachable high-level exits of a component
+const std::vector< std::pair<Idx,Idx> >& op_LocalReach::Exits(Idx c) {
+	Schedule(c, mExitsState);
+	for(std::size_t k = 0; k < mSchedule.size(); ++k) {
+		Idx d = mSchedule[k];
+		std::vector< std::pair<Idx,Idx> >& exits = mExits[d];
+		// own exits and the exits of successors
+		for(Idx pos = mBegin[d]; pos < mBegin[d+1]; ++pos) {
+			Idx q = mOrder[pos];
+			CompiledGenerator::Iterator eit = EdgesBegin(q);
+			CompiledGenerator::Iterator eit_end = EdgesEnd(q);
+			for(; eit != eit_end; ++eit)
+				if(High(q, *eit)) exits.push_back(std::make_pair(mrCGen.Event(eit->Ev), mComp[eit->X]));
+		}
+		for(std::size_t i = 0; i < mSucc[d].size(); ++i) {
+			const std::vector< std::pair<Idx,Idx> >& sexits = mExits[mSucc[d][i]];
+			exits.insert(exits.end(), sexits.begin(), sexits.end());
+		}
+		std::sort(exits.begin(), exits.end());
+		exits.erase(std::unique(exits.begin(), exits.end()), exits.end());
+		mExitsState[d] = 2;
+	}
+	return mExits[c];
+}
+
+// flag components that locally reach a high-level exit (single pass, successors come first)
+void op_LocalReach::ExitReach(std::vector<bool>& rFlags) const {
+	Idx m = Size();
+	rFlags.assign(m, false);
+	for(Idx c = 0; c < m; ++c) {
+		bool exit = false;
+		for(std::size_t i = 0; (!exit) && i < mSucc[c].size(); ++i)
+			exit = rFlags[mSucc[c][i]];
+		for(Idx pos = mBegin[c]; (!exit) && pos < mBegin[c+1]; ++pos) {
+			Idx q = mOrder[pos];
+			CompiledGenerator::Iterator eit = EdgesBegin(q);
+			CompiledGenerator::Iterator eit_end = EdgesEnd(q);
+			for(; (!exit) && eit != eit_end; ++eit)
+				exit = High(q, *eit);
+		}
+		rFlags[c] = exit;
+	}
+}
+
+// transitions of the dynamic system: the state is connected to the local reach of all entry 
+// states that can be reached via a high-level event from its local reach
+void op_LocalReach::Transitions(Idx q, TransSet& rTrans) {
+	Idx x1 = mrCGen.State(q);
+	const std::vector< std::pair<Idx,Idx> >& exits = Exits(mComp[q]);
+	for(std::size_t i = 0; i < exits.size(); ++i) {
+		const Intervals& reach = Reach(exits[i].second);
+		for(std::size_t j = 0; j < reach.size(); ++j)
+			for(Idx pos = reach[j].first; pos < reach[j].second; ++pos)
+				rTrans.Insert(x1, exits[i].first, mrCGen.State(mOrder[pos]));
+	}
+}
+
 // calculateDynamicSystemClosedObs(rGen, rHighAlph, rGenDyn)
 void calculateDynamicSystemClosedObs(const Generator& rGen, EventSet& rHighAlph, Generator& rGenDyn)
 {
 	OP_DF("calculateDynamicSystemClosedObs(" << rGen.Name() << "," << rHighAlph.Name() << "," << rGenDyn.Name() << ")");
-	// transition relation sorted in reverse order for backwards reachability
-	TransSetX2EvX1 tset_X2EvX1;
-	rGen.TransRel(tset_X2EvX1);
-	
 	// prepare generator rGenDyn
 	rGenDyn.ClearTransRel();
 	rGenDyn.InjectAlphabet(rHighAlph); // all high-level events are contained in the alphabet of rGenDyn
 	rGenDyn.InjectStates(rGen.States() ); // the dynamic system has all states of rGen
 	
-	// helpers
-	EventSet::Iterator eIt = rGenDyn.AlphabetBegin();
-	EventSet::Iterator eItEnd = rGenDyn.AlphabetEnd();
-	
-	TransSetX2EvX1::Iterator tItByX2Ev;
-	TransSetX2EvX1::Iterator tItByX2EvEnd;
-	StateSet reach;
-	// map from exit states (Idx) to high-level event (Idx) and reachable entry state (Idx)
-	map<Idx,vector<pair<Idx,Idx> > > exitStateToEventState;
-	StateSet::Iterator sIt;
-	StateSet::Iterator sItEnd;
-	TransSet::Iterator tIt;
-	TransSet::Iterator tItEnd;
-	map<Idx,StateSet> entryStateToLocalReach;
-	map<Idx,vector<pair<Idx,Idx> > >::iterator esIt;
-	map<Idx,vector<pair<Idx,Idx> > >::iterator esItEnd;	
-	// algorithm for computing the dynamic system
-	// loop over all states of original generator
-	StateSet::Iterator stateSetIt = rGen.StatesBegin();
-	StateSet::Iterator stateSetItEnd = rGen.StatesEnd();
-	// flag that indicates if the current state is an entry state
-	bool isEntryState = false;
-	for( ; stateSetIt != stateSetItEnd; ++stateSetIt) {
-		OP_DF("calculateDynamicSystemClosedObs: loop over all states; current state: " << rGen.StateName(*stateSetIt) 
-		<< " [" << *stateSetIt << "]");
-		// check if current state (*stateSetIt) is an entry-state (a backward transition with
-		// a high-level event exists. If yes, the locally reachable states (reach) are stored in
-		// the entryStateToLocalReach map
-		isEntryState = false;
-		tItByX2Ev=tset_X2EvX1.BeginByX2(*stateSetIt); 
-		tItByX2EvEnd=tset_X2EvX1.EndByX2(*stateSetIt); 
-		for(; tItByX2Ev != tItByX2EvEnd; ++tItByX2Ev)
-		{
-			OP_DF("calculateDynamicSystemClosedObs: checking transition : " << rGen.TStr(*tItByX2Ev));
-			if(rHighAlph.Exists(tItByX2Ev->Ev)){
-                isEntryState = true;
-			    OP_DF("calculateDynamicSystemClosedObs: current state is an entry-state");
-			    // insert the exit state and the high-level event with the reachable entry state into the exitStates set
-			    esIt = exitStateToEventState.find(tItByX2Ev->X1);
-			    if(esIt == exitStateToEventState.end() ){
-			        exitStateToEventState[tItByX2Ev->X1] = vector<pair<Idx,Idx> >();
-			    }
-			    exitStateToEventState[tItByX2Ev->X1].push_back(make_pair(tItByX2Ev->Ev,tItByX2Ev->X2) );
-			}
-		}
-		if(isEntryState == true){
-            // compute locally reachable states for current entry state and insert it into entryStateToLocalReach
-            reach.Clear();
-            LocalAccessibleReach(rGen, rHighAlph, *stateSetIt, reach);
-            OP_DF("calculateDynamicSystemClosedObs: states in local reach: \n " << reach.ToString() );
-            entryStateToLocalReach[*stateSetIt]=reach;
-		}
-	}
-	// after this loop we have the set of exit states in exitStates and a map from entry states to their 
-	// locally reachable state set entryStateToLocalReach
-	
-	// create the transition structure of the dynamic system
-	esIt    = exitStateToEventState.begin();
-	esItEnd = exitStateToEventState.end();
-	vector<pair <Idx,Idx> >::iterator vIt;
-	vector<pair <Idx,Idx> >::iterator vItEnd;
-	// To construct the dynamic system, each local state has to be connected to all states in
-	// the local accessible reach of entry states that can be reached via a high-level event.
-	// We compute the local backward reach of each exit state and find the corresponding entry states in 
-	// the map exitStateToEventState
-	StateSet exitStateBackwardReach;
-	StateSet::Iterator brIt, brItEnd;
-	map<Idx,StateSet>::const_iterator enIt;
-	for(; esIt != esItEnd; ++esIt)
-	{
-	    // compute the locally backwards reachable states
-	    exitStateBackwardReach.Clear();
-	    LocalCoaccessibleReach(tset_X2EvX1, rHighAlph, esIt->first, exitStateBackwardReach);
-
-    	vIt    = esIt->second.begin();
-    	vItEnd = esIt->second.end();
-    	brItEnd = exitStateBackwardReach.End();
-    	// loop over all pairs (Ev,X2) of current exit state and insert transitions from all states in the
-    	// backwards reach
-    	for( ; vIt != vItEnd; ++vIt)
-    	{
-    	     brIt = exitStateBackwardReach.Begin();
-    	     // go over all backwards reachable states
-    	     for( ; brIt != brItEnd; brIt++){
-                  // find the set of reachable states from exit state
-                  enIt = entryStateToLocalReach.find(vIt->second);
-                  sIt = enIt->second.Begin();
-                  sItEnd = enIt->second.End();
-                  // go over all reachable states from the entry states
-                  for( ; sIt != sItEnd; sIt++){
-                      rGenDyn.SetTransition(*brIt,vIt->first,*sIt);
-                      OP_DF("calculateDynamicSystemClosedObs: Transition added to resulting generator: " << 
-        				rGenDyn.TStr(Transition(*brIt,vIt->first,*sIt))); 
-                  }
-    	     }
-        }
-	}
+	// condense the local subgraph of rGen
+	CompiledGenerator cgen(rGen,false);
+	op_LocalReach local(cgen);
+	local.Condense(rHighAlph);
+	// To construct the dynamic system, each state has to be connected to all states in the local
+	// accessible reach of entry states that can be reached via a high-level event from the local
+	// accessible reach of the state itself. Both are evaluated once per strongly connected component.
+	TransSet dyntrans;
+	for(Idx q = 1; q <= cgen.Size(); ++q)
+		local.Transitions(q, dyntrans);
+	rGenDyn.InjectTransRel(dyntrans);
 	OP_DF("calculateDynamicSystemClosedObs: leaving function");
 }
 
@@ -160,32 +319,30 @@ void calculateDynamicSystemObs(const Generator& rGen, EventSet& rHighAlph, Gener
 {
 	OP_DF("calculateDynamicSystemObs(" << rGen.Name() << "," << rHighAlph.Name() << "," << rGenDyn.Name() << ")");	
 	// prepare generator rGenDyn
-	// locally reachable states
-	StateSet reach;
-	StateSet::Iterator stIt, stEndIt;
 	// label for transitions to marked states in the dynamic system
 	std::string eventname = ( rGenDyn.EventSymbolTablep())->UniqueSymbol("obsLabel");
 	Idx obsLabel = (rGenDyn.EventSymbolTablep())->InsEntry(eventname);	
 	rGenDyn.InsEvent(obsLabel);
-	// algorithm for computing the dynamic system
-	// loop over all states of original generator
-	StateSet::Iterator stateSetIt = rGen.StatesBegin();
-	StateSet::Iterator stateSetItEnd = rGen.StatesEnd();
-	for( ; stateSetIt != stateSetItEnd; ++stateSetIt) {
-		OP_DF("calculateDynamicSystemObs: loop over all states; current state: " << rGen.StateName(*stateSetIt) 
-		<< " [" << *stateSetIt << "]");
-		// compute locally reachable states for current state
-		reach.Clear();
-		LocalAccessibleReach(rGen, rHighAlph, *stateSetIt, reach);
-		OP_DF("calculateDynamicSystemObs: states in local reach: \n " << reach.ToString() );
-		stIt = reach.Begin();
-		stEndIt = reach.End();
-		for( ; stIt != stEndIt; stIt++){
-		    if(rGen.ExistsMarkedState(*stIt) ){
-		          rGenDyn.SetTransition(*stateSetIt,obsLabel,*stIt);
-		          OP_DF("calculateDynamicSystemObs: Transition added to resulting generator: " << 
-        				rGenDyn.TStr(Transition(*stateSetIt,obsLabel,*stIt))); 
-		    }
+	// condense the local subgraph of rGen
+	CompiledGenerator cgen(rGen,false);
+	op_LocalReach local(cgen);
+	local.Condense(rHighAlph);
+	// algorithm for computing the dynamic system: each state is connected to the marked states in its
+	// local accessible reach; the latter is evaluated once per strongly connected component
+	std::vector<Idx> marked;
+	for(Idx c = 0; c < local.Size(); ++c) {
+		marked.clear();
+		const op_LocalReach::Intervals& reach = local.Reach(c);
+		for(std::size_t i = 0; i < reach.size(); ++i)
+			for(Idx pos = reach[i].first; pos < reach[i].second; ++pos)
+				if(cgen.MarkedState(local.At(pos))) marked.push_back(cgen.State(local.At(pos)));
+		for(Idx pos = local.Begin(c); pos < local.End(c); ++pos) {
+			Idx x1 = cgen.State(local.At(pos));
+			for(std::size_t i = 0; i < marked.size(); ++i) {
+				rGenDyn.SetTransition(x1,obsLabel,marked[i]);
+				OP_DF("calculateDynamicSystemObs: Transition added to resulting generator: " << 
+					rGenDyn.TStr(Transition(x1,obsLabel,marked[i]))); 
+			}
 		}
 	}
 	OP_DF("calculateDynamicSystemObs: leaving function");
@@ -195,55 +352,42 @@ void calculateDynamicSystemObs(const Generator& rGen, EventSet& rHighAlph, Gener
 void calculateDynamicSystemMSA(const Generator& rGen, EventSet& rHighAlph, Generator& rGenDyn)
 {
 	OP_DF("calculateDynamicSystemMSA(" << rGen.Name() << "," << rHighAlph.Name() << "," << rGenDyn.Name() << ")");
-	// transition relation sorted in reverse order for backwards reachability
-	TransSetX2EvX1 tset_X2EvX1;
-	rGen.TransRel(tset_X2EvX1);
-	
 	// prepare generator rGenDyn
-	// set of states already investigated
-	StateSet doneStates, goodStates;
 	TransSet::Iterator tIt;
 	TransSet::Iterator tEndIt;
 	// label for transitions for msa-accepting states in the dynamic system
 	std::string eventname = ( rGenDyn.EventSymbolTablep())->UniqueSymbol("msaLabel");
 	Idx msaLabel = (rGenDyn.EventSymbolTablep())->InsEntry(eventname);	
 	rGenDyn.InsEvent(msaLabel);
+	// condense the local subgraph of rGen forward and backward, with local paths ending in marked states
+	CompiledGenerator cgen(rGen);
+	op_LocalReach fwd(cgen), bwd(cgen);
+	fwd.Condense(rHighAlph, 0, &rGen.MarkedStates());
+	bwd.Condense(rHighAlph, 0, &rGen.MarkedStates(), true);
+	// msa holds for a state, if it is marked or if all local paths via non-marked states lead to 
+	// marked states in forward or in backward direction; we flag the components that locally
+	// reach a high-level transition instead
+	std::vector<bool> fwdexit, bwdexit;
+	fwd.ExitReach(fwdexit);
+	bwd.ExitReach(bwdexit);
+	// we insert transitions while iterating: own the data beforehand
+	rGenDyn.TransRel().Detach();
 	// algorithm for computing the dynamic system
 	// loop over all states of original generator
-	StateSet::Iterator stateSetIt = rGen.StatesBegin();
-	StateSet::Iterator stateSetItEnd = rGen.StatesEnd();
-	// flag that indicates if the current state is an entry state
-	for( ; stateSetIt != stateSetItEnd; ++stateSetIt) {
-	    // if the state is known to be good (msa holds), it does not have to be considered again
-	    if(goodStates.Exists(*stateSetIt) )
-	         continue;
-	         
-		OP_DF("calculateDynamicSystemMSA: loop over all states; current state: " << rGen.StateName(*stateSetIt) 
-		<< " [" << *stateSetIt << "]");
-		doneStates.Clear();
-		bool msaHolds = recursiveCheckMSAForward(rGen, rHighAlph, *stateSetIt, doneStates);
-		// if all forward transitions lead to marked states, all states that have been reached are states where msa holds
-		if(msaHolds == true){
-		    goodStates.InsertSet(doneStates);
-		    continue;
-		}
-		doneStates.Clear();
-		msaHolds = recursiveCheckMSABackward(rGen, tset_X2EvX1, rHighAlph, *stateSetIt, doneStates);
-		// if all backward transitions lead to marked states, all states that have been reached are states where msa holds
-		if(msaHolds == true){
-		    goodStates.InsertSet(doneStates);
-		    continue;
-		}
-		// otherwise, msa is violated for the current state. Then, msa-transitions are introduced to all states 
+	for(Idx q = 1; q <= cgen.Size(); ++q) {
+		if(cgen.MarkedState(q)) continue;
+		if(!fwdexit[fwd.Component(q)]) continue;
+		if(!bwdexit[bwd.Component(q)]) continue;
+		// msa is violated for the current state. Then, msa-transitions are introduced to all states 
 		// reachable via a high-level event
-		else{
-		    tIt = rGenDyn.TransRelBegin(*stateSetIt);
-		    tEndIt = rGenDyn.TransRelEnd(*stateSetIt);
-		    for( ; tIt != tEndIt; tIt++){
-                rGenDyn.SetTransition(*stateSetIt,msaLabel,tIt->X2);
-                OP_DF("calculateDynamicSystemObs: Transition added to resulting generator: " << 
-        				rGenDyn.TStr(Transition(*stateSetIt,msaLabel,tIt->X2))); 		        
-		    }
+		Idx x1 = cgen.State(q);
+		OP_DF("calculateDynamicSystemMSA: msa violated for state: " << rGen.StateName(x1) << " [" << x1 << "]");
+		tIt = rGenDyn.TransRelBegin(x1);
+		tEndIt = rGenDyn.TransRelEnd(x1);
+		for( ; tIt != tEndIt; tIt++){
+			rGenDyn.SetTransition(x1,msaLabel,tIt->X2);
+			OP_DF("calculateDynamicSystemMSA: Transition added to resulting generator: " << 
+				rGenDyn.TStr(Transition(x1,msaLabel,tIt->X2))); 
 		}
 	}
 	OP_DF("calculateDynamicSystemMSA: leaving function");
@@ -302,13 +446,7 @@ bool recursiveCheckMSABackward(const Generator& rGen, const TransSetX2EvX1& rRev
 //calculateDynamicSystemLCC(rGen, rControllableEvents, rHighAlph, rGenDyn)
 void calculateDynamicSystemLCC(const Generator& rGen, const EventSet& rControllableEvents, const EventSet& rHighAlph, Generator& rGenDyn){
 	OP_DF("calculateDynamicSystemLCC(" << rGen.Name() << "," << rControllableEvents.Name() << "," << rHighAlph.Name() << "," << rGenDyn.Name() << ")");
-	// transition relation sorted in reverse order for backwards reachability
-	TransSetX2EvX1 tset_X2EvX1;
-	rGen.TransRel(tset_X2EvX1);
-	
 	// prepare generator rGenDyn
-	TransSet::Iterator tIt;
-	TransSet::Iterator tEndIt;
 	// labels for transitions for states with uncontrollable successor strings in the dynamic system
 	// eventLCCLabel maps the original event to the LCCLabel in the dynamic system
 	EventSet::Iterator eIt, eEndIt;
@@ -322,66 +460,34 @@ void calculateDynamicSystemLCC(const Generator& rGen, const EventSet& rControlla
           rGenDyn.InsEvent(eventLCCLabel[*eIt] );	    
 	    }
 	}
-	// map from exit states (Idx) to uncontrollable high-level events (Idx)
-	map<Idx,vector<Idx> > exitStateToEvents;	
-	map<Idx,vector<Idx> >::const_iterator esIt, esEndIt;
-	// algorithm for computing the dynamic system
-	// loop over all states of original generator
-	StateSet::Iterator sIt = rGen.StatesBegin();
-	StateSet::Iterator sEndIt = rGen.StatesEnd();
-	for( ; sIt != sEndIt; ++sIt) {
-		OP_DF("calculateDynamicSystemLCC: loop over all states; current state: " << rGen.StateName(*sIt) 
-		<< " [" << *sIt << "]");
-		// check if current state (*stateSetIt) is an exit-state (a forward transition with
-		// a high-level event exists. If yes, the outgoing high-level events are stored
-		tIt = rGen.TransRelBegin(*sIt);
-		tEndIt = rGen.TransRelEnd(*sIt);
-		for(; tIt != tEndIt; ++tIt)
-		{
-			OP_DF("calculateDynamicSystemLCC: checking transition : " << rGen.TStr(*tIt));
-			// if the event is an uncontrollable high-level event, it is inserted for the current exit state
-			if(rHighAlph.Exists(tIt->Ev) && !rControllableEvents.Exists(tIt->Ev) ){
-			    OP_DF("calculateDynamicSystemLCC: current state is an exit-state");
-			    // insert the exit state and the high-level event into the exitStates set
-			    esIt = exitStateToEvents.find(*sIt);
-			    if(esIt == exitStateToEvents.end() ){
-			        exitStateToEvents[*sIt] = vector<Idx>();
-			    }
-			    exitStateToEvents[*sIt].push_back(tIt->Ev);
-			}
+	// condense the local subgraph of uncontrollable low-level events
+	CompiledGenerator cgen(rGen,false);
+	op_LocalReach local(cgen);
+	local.Condense(rHighAlph, &rControllableEvents);
+	// lcc-labels are introduced for each uncontrollable high-level event that is locally reachable via
+	// an uncontrollable string; the exits are evaluated once per strongly connected component
+	std::vector<Idx> x2s;
+	for(Idx q = 1; q <= cgen.Size(); ++q) {
+		const std::vector< std::pair<Idx,Idx> >& exits = local.Exits(local.Component(q));
+		if(exits.empty()) continue;
+		Idx x1 = cgen.State(q);
+		OP_DF("calculateDynamicSystemLCC: current state: " << rGen.StateName(x1) << " [" << x1 << "]");
+		// states reachable via strings with one high-level event (these states are already encoded
+		// in rGenDyn if calculateDynamicSystemClosedObs is called before calculateDynamicSystemLCC)
+		x2s.clear();
+		TransSet::Iterator dsIt = rGenDyn.TransRelBegin(x1);
+		TransSet::Iterator dsEndIt = rGenDyn.TransRelEnd(x1);
+		for( ; dsIt != dsEndIt; dsIt++)
+			x2s.push_back(dsIt->X2);
+		// loop over all locally reachable uncontrollable high-level events
+		for(std::size_t i = 0; i < exits.size(); ++i) {
+			if(i > 0 && exits[i-1].first == exits[i].first) continue;
+			if(rControllableEvents.Exists(exits[i].first)) continue;
+			Idx lcclabel = eventLCCLabel[exits[i].first];
+			for(std::size_t j = 0; j < x2s.size(); ++j)
+				rGenDyn.SetTransition(x1, lcclabel, x2s[j]);
 		}
 	}
-	// after this loop, we have the set of exit states with their outgoing uncontrollable high-level events. 
-	// Now we compute the backwards reachable state via uncontrollable strings to determine all states where lcc holds
-	esIt = exitStateToEvents.begin();
-	esEndIt = exitStateToEvents.end();
-	vector<Idx>::const_iterator vIt, vEndIt;
-	// set of states already investigated
-	StateSet doneStates;
- 	for( ; esIt != esEndIt; esIt++){
-        doneStates.Clear();
-        recursiveCheckLCC(tset_X2EvX1, rControllableEvents, rHighAlph, esIt->first, doneStates);
-        // add the uncontrollable transition labels to all states found in the backward reachability
-        // transitions are introduced to all states that are reachable via strings including one high-level event
-        vIt = esIt->second.begin();
-        vEndIt = esIt->second.end();
-        // loop over all uncontrollable high-level events in the current exit state
-        for( ; vIt != vEndIt; vIt++){
-            sIt = doneStates.Begin();
-            sEndIt = doneStates.End();
-            // loop over all backward reachable states
-            for( ; sIt != sEndIt; sIt++){
-                TransSet::Iterator dsIt, dsEndIt;
-                dsIt = rGenDyn.TransRelBegin(*sIt);
-                dsEndIt = rGenDyn.TransRelEnd(*sIt);
-                // loop over all states reachable via strings with one high-level event (these states are already encoded
-                // in rGenDyn if calculateDynamicSystemClosedObs is called before calculateDynamicSystemLCC)
-                for( ; dsIt != dsEndIt; dsIt++){
-                    rGenDyn.SetTransition(*sIt, eventLCCLabel[*vIt], dsIt->X2);
-                }
-            }
-        }
- 	}
 }
 
 void recursiveCheckLCC(const TransSetX2EvX1& rRevTransSet, const EventSet& rControllableEvents, const EventSet& rHighAlph, Idx currentState, StateSet& rDoneStates){
@@ -409,110 +515,206 @@ void recursiveCheckLCC(const TransSetX2EvX1& rRevTransSet, const EventSet& rCont
 }
 
 
-// calcClosedObserver(rGen,rHighAlph)
-Idx calcClosedObserver(const Generator& rGen, EventSet& rHighAlph){
+/*
+Incremental observer computation
+
+The observer algorithms alternate the computation of the dynamic system and its quasi-congruence
+with the extension of the high-level alphabet. Since the high-level alphabet only grows, the
+transitions of the dynamic system are maintained per state and are only recomputed for states
+that are affected by the newly added high-level events, i.e., states whose local reach contains
+a transition with a new high-level event, and states whose local reach exits to such a state via
+a high-level transition. For the closed and the natural observer, the quasi-congruence w.r.t. an
+extended alphabet refines the quasi-congruence w.r.t. the original alphabet. Thus, partition
+refinement can be restarted from the previous result. The msa and lcc labels are not monotone
+w.r.t. the high-level alphabet; they are recomputed per iteration and partition refinement
+starts from the trivial partition.
+*/
+
+// extend a set of states by all states that locally reach the set
+static void op_LocalBackwardClosure(const TransSetX2EvX1& rRevTransRel, const EventSet& rHighAlph, StateSet& rStates) {
+	stack<Idx> todo;
+	StateSet::Iterator sIt = rStates.Begin();
+	StateSet::Iterator sItEnd = rStates.End();
+	for( ; sIt != sItEnd; ++sIt) todo.push(*sIt);
+	while(!todo.empty()) {
+		Idx x2 = todo.top();
+		todo.pop();
+		TransSetX2EvX1::Iterator tIt = rRevTransRel.BeginByX2(x2);
+		TransSetX2EvX1::Iterator tItEnd = rRevTransRel.EndByX2(x2);
+		for( ; tIt != tItEnd; ++tIt) {
+			if(rHighAlph.Exists(tIt->Ev)) continue;
+			if(rStates.Insert(tIt->X1)) todo.push(tIt->X1);
+		}
+	}
+}
+
+// transitions of the dynamic system for one state: closed observer part
+static void op_ClosedObsRow(const CompiledGenerator& rCGen, op_LocalReach& rLocal, Idx x, TransSet& rTrans) {
+	rTrans.EraseByX1(x);
+	rLocal.Transitions(rCGen.StateIndex(x), rTrans);
+}
+
+// transitions of the dynamic system for one state: marked states in the local reach
+static void op_ObsRow(const CompiledGenerator& rCGen, op_LocalReach& rLocal, Idx x, Idx obsLabel, TransSet& rTrans) {
+	rTrans.EraseByX1(x);
+	const op_LocalReach::Intervals& reach = rLocal.Reach(rLocal.Component(rCGen.StateIndex(x)));
+	for(std::size_t i = 0; i < reach.size(); ++i) {
+		for(Idx pos = reach[i].first; pos < reach[i].second; ++pos) {
+			Idx q = rLocal.At(pos);
+			if(rCGen.MarkedState(q)) rTrans.Insert(x, obsLabel, rCGen.State(q));
+		}
+	}
+}
+
+// observer computation by extension of the high-level alphabet (pControllableEvents for lcc, 0 otherwise)
+static Idx op_CalcObserver(const Generator& rGen, const EventSet* pControllableEvents, bool obs, bool msa, EventSet& rHighAlph) {
+	// trivial case: nothing to do (as the non-incremental loop, report zero classes)
+	EventSet origAlph;
+	if(origAlph == rHighAlph) return 0;
+	// transition relation sorted in reverse order for backwards reachability
+	TransSetX2EvX1 tset_X2EvX1;
+	rGen.TransRel(tset_X2EvX1);
+	// persistent dynamic system: closed observer part and marking part
+	TransSet closedTrans;
+	TransSet obsTrans;
+	Idx obsLabel = 0;
+	if(obs) {
+		std::string eventname = SymbolTable::GlobalEventSymbolTablep()->UniqueSymbol("obsLabel");
+		obsLabel = SymbolTable::GlobalEventSymbolTablep()->InsEntry(eventname);
+	}
+	// persistent partition
+	map<Idx,Idx> mapStateToPartition;
+	vector<StateSet> prePartition;
+	bool reuse = (pControllableEvents == 0) && (!msa);
+	Idx classes = 0;
     // helpers
     Generator dynGen;
-    map<Idx,Idx> mapStateToPartition;
-    EventSet origAlph;
-    Generator genPart;
+	CompiledGenerator cgen(rGen,false);
+	op_LocalReach local(cgen);
+	StateSet affected, affectedObs;
+	bool initial = true;
     while(origAlph != rHighAlph){
+		// figure states whose transitions in the dynamic system need to be recomputed
+		affected.Clear();
+		affectedObs.Clear();
+		if((!initial) && (origAlph <= rHighAlph)) {
+			EventSet newAlph = rHighAlph - origAlph;
+			// states with a transition labeled by a new high-level event and states that locally reach them
+			TransSet::Iterator tIt = rGen.TransRelBegin();
+			TransSet::Iterator tItEnd = rGen.TransRelEnd();
+			for( ; tIt != tItEnd; ++tIt)
+				if(newAlph.Exists(tIt->Ev)) affected.Insert(tIt->X1);
+			op_LocalBackwardClosure(tset_X2EvX1, origAlph, affected);
+			affectedObs = affected;
+			// states that locally reach a high-level transition to the above states
+			StateSet exits;
+			StateSet::Iterator sIt = affectedObs.Begin();
+			StateSet::Iterator sItEnd = affectedObs.End();
+			for( ; sIt != sItEnd; ++sIt) {
+				TransSetX2EvX1::Iterator rIt = tset_X2EvX1.BeginByX2(*sIt);
+				TransSetX2EvX1::Iterator rItEnd = tset_X2EvX1.EndByX2(*sIt);
+				for( ; rIt != rItEnd; ++rIt)
+					if(rHighAlph.Exists(rIt->Ev)) exits.Insert(rIt->X1);
+			}
+			op_LocalBackwardClosure(tset_X2EvX1, origAlph, exits);
+			affected.InsertSet(exits);
+		} else {
+			affected = rGen.States();
+			affectedObs = rGen.States();
+			prePartition.clear();
+		}
         origAlph  = rHighAlph;
+		OP_DF("op_CalcObserver: recompute dynamic system for #" << affected.Size() << " states");
+		// update the dynamic system for the given generator and high-level alphabet
+		local.Condense(rHighAlph);
+		{
+			StateSet::Iterator sIt = affected.Begin();
+			StateSet::Iterator sItEnd = affected.End();
+			for( ; sIt != sItEnd; ++sIt) {
+				LoopCallback();
+				op_ClosedObsRow(cgen, local, *sIt, closedTrans);
+			}
+		}
+		if(obs) {
+			StateSet::Iterator sIt = affectedObs.Begin();
+			StateSet::Iterator sItEnd = affectedObs.End();
+			for( ; sIt != sItEnd; ++sIt) {
+				LoopCallback();
+				op_ObsRow(cgen, local, *sIt, obsLabel, obsTrans);
+			}
+		}
+		initial = false;
+		// assemble the dynamic system (the lcc and msa labels refer to the closed observer part)
         dynGen.Clear();
-        // compute the dynamic system for the given generator and high-level alphabet
-        calculateDynamicSystemClosedObs(rGen, rHighAlph, dynGen);
-        // compute the quasi conqruence 
-        ComputeBisimulation(dynGen, mapStateToPartition, genPart);
+		dynGen.InjectAlphabet(rHighAlph);
+		dynGen.InjectStates(rGen.States());
+		dynGen.InjectTransRel(closedTrans);
+		if(pControllableEvents != 0) 
+			calculateDynamicSystemLCC(rGen, *pControllableEvents, rHighAlph, dynGen);
+		if(msa)
+			calculateDynamicSystemMSA(rGen, rHighAlph, dynGen);
+		if(obs) {
+			dynGen.InsEvent(obsLabel);
+			TransSet::Iterator tIt = obsTrans.Begin();
+			TransSet::Iterator tItEnd = obsTrans.End();
+			for( ; tIt != tItEnd; ++tIt)
+				dynGen.SetTransition(*tIt);
+		}
+		// compute the quasi conqruence, starting from the previous one if applicable
+		list<StateSet> nontrivial;
+		if(reuse) ComputeBisimulationCTA(dynGen, nontrivial, prePartition);
+		else ComputeBisimulationCTA(dynGen, nontrivial);
+		mapStateToPartition.clear();
+		prePartition.clear();
+		classes = 0;
+		list<StateSet>::const_iterator cIt = nontrivial.begin();
+		list<StateSet>::const_iterator cItEnd = nontrivial.end();
+		for( ; cIt != cItEnd; ++cIt) {
+			++classes;
+			StateSet::Iterator sIt = cIt->Begin();
+			StateSet::Iterator sItEnd = cIt->End();
+			for( ; sIt != sItEnd; ++sIt) mapStateToPartition[*sIt] = classes;
+			if(reuse) prePartition.push_back(*cIt);
+		}
+		StateSet::Iterator sIt = rGen.StatesBegin();
+		StateSet::Iterator sItEnd = rGen.StatesEnd();
+		for( ; sIt != sItEnd; ++sIt) {
+			if(mapStateToPartition.find(*sIt) != mapStateToPartition.end()) continue;
+			mapStateToPartition[*sIt] = ++classes;
+			if(reuse) {
+				prePartition.push_back(StateSet());
+				prePartition.back().Insert(*sIt);
+			}
+		}
         // Extend the high-level alphabet according to the algorithm of Lei
         ExtendHighAlphabet(rGen, rHighAlph, mapStateToPartition);
     }
-    return genPart.Size();
+	return classes;
+}
+
+// calcClosedObserver(rGen,rHighAlph)
+Idx calcClosedObserver(const Generator& rGen, EventSet& rHighAlph){
+	return op_CalcObserver(rGen, 0, false, false, rHighAlph);
 }
 
 // calcNaturalObserver(rGen,rHighAlph)
 Int calcNaturalObserver(const Generator& rGen, EventSet& rHighAlph){
-    // helpers
-    Generator dynGen;
-    map<Idx,Idx> mapStateToPartition;
-    EventSet origAlph;
-    Generator genPart;
-    while(origAlph != rHighAlph){
-        origAlph  = rHighAlph;
-        dynGen.Clear();
-        // compute the dynamic system for the given generator and high-level alphabet
-        calculateDynamicSystemClosedObs(rGen, rHighAlph, dynGen);	
-        calculateDynamicSystemObs(rGen, rHighAlph, dynGen);
-        // compute the quasi conqruence 
-        ComputeBisimulation(dynGen, mapStateToPartition, genPart);
-        // Extend the high-level alphabet according to the algorithm of Lei
-        ExtendHighAlphabet(rGen, rHighAlph, mapStateToPartition);
-    }
-    return genPart.Size();
+	return op_CalcObserver(rGen, 0, true, false, rHighAlph);
 }
 
 // calcNaturalObserverLCC(rGen,rHighAlph)
 Int calcNaturalObserverLCC(const Generator& rGen, const EventSet& rControllableEvents, EventSet& rHighAlph){
-    // helpers
-    Generator dynGen;
-    map<Idx,Idx> mapStateToPartition;
-    EventSet origAlph;
-    Generator genPart;
-    while(origAlph != rHighAlph){
-        origAlph  = rHighAlph;
-        dynGen.Clear();
-        // compute the dynamic system for the given generator and high-level alphabet
-        calculateDynamicSystemClosedObs(rGen, rHighAlph, dynGen);
-        calculateDynamicSystemLCC(rGen, rControllableEvents, rHighAlph, dynGen);
-        calculateDynamicSystemObs(rGen, rHighAlph, dynGen);
-        // compute the quasi conqruence 
-        ComputeBisimulation(dynGen, mapStateToPartition, genPart);
-        // Extend the high-level alphabet according to the algorithm of Lei
-        ExtendHighAlphabet(rGen, rHighAlph, mapStateToPartition);
-    }
-    return genPart.Size();
+	return op_CalcObserver(rGen, &rControllableEvents, true, false, rHighAlph);
 }
 
 // calcMSAObserver(rGen,rHighAlph)
 Int calcMSAObserver(const Generator& rGen, EventSet& rHighAlph){
-    // helpers
-    Generator dynGen;
-    map<Idx,Idx> mapStateToPartition;
-    EventSet origAlph;
-    Generator genPart;
-    while(origAlph != rHighAlph){
-        origAlph  = rHighAlph;
-        dynGen.Clear();
-        // compute the dynamic system for the given generator and high-level alphabet
-        calculateDynamicSystemClosedObs(rGen, rHighAlph, dynGen);
-        calculateDynamicSystemMSA(rGen, rHighAlph, dynGen);
-        // compute the quasi conqruence 
-        ComputeBisimulation(dynGen, mapStateToPartition, genPart);
-        // Extend the high-level alphabet according to the algorithm of Lei
-        ExtendHighAlphabet(rGen, rHighAlph, mapStateToPartition);
-    }
-    return genPart.Size();
+	return op_CalcObserver(rGen, 0, false, true, rHighAlph);
 }   
 
 // calcMSAObserverLCC(rGen,rHighAlph)
 Int calcMSAObserverLCC(const Generator& rGen, const EventSet& rControllableEvents, EventSet& rHighAlph){
-    // helpers
-    Generator dynGen;
-    map<Idx,Idx> mapStateToPartition;
-    EventSet origAlph;
-    Generator genPart;
-    while(origAlph != rHighAlph){
-        origAlph  = rHighAlph;
-        dynGen.Clear();
-        // compute the dynamic system for the given generator and high-level alphabet
-        calculateDynamicSystemClosedObs(rGen, rHighAlph, dynGen);
-        calculateDynamicSystemLCC(rGen, rControllableEvents, rHighAlph, dynGen);
-        calculateDynamicSystemMSA(rGen, rHighAlph, dynGen);
-        // compute the quasi conqruence 
-        ComputeBisimulation(dynGen, mapStateToPartition, genPart);
-        // Extend the high-level alphabet according to the algorithm of Lei
-        ExtendHighAlphabet(rGen, rHighAlph, mapStateToPartition);
-    }
-    return genPart.Size();
+	return op_CalcObserver(rGen, &rControllableEvents, false, true, rHighAlph);
 }
 
 
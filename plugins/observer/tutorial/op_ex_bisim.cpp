@@ -50,7 +50,7 @@ int main(int argc, char* argv[]) {
   std::cout << "#########################################\n";
   genPart.DWrite();
   // Write the resulting generator to file output 
-  genPart.Write("./results/ex_bisim/genPart.gen");
+  genPart.Write("tmp_op_bisim_part.gen");
   // output the map from states in the original generator to equivalence classes (states in genPart)
   std::map<Idx,Idx>::const_iterator mIt, mEndIt;
   mIt = mapStateToPartition.begin();
@@ -62,5 +62,86 @@ int main(int argc, char* argv[]) {
   }
   std::cout << "##################################################\n";
 
+  // record test case
+  FAUDES_TEST_DUMP("quotient",genPart);
+  FAUDES_TEST_DUMP("class of state 1",(long int) mapStateToPartition[1]);
+  FAUDES_TEST_DUMP("class of state 2",(long int) mapStateToPartition[2]);
+  FAUDES_TEST_DUMP("class of state 3",(long int) mapStateToPartition[3]);
+  FAUDES_TEST_DUMP("class of state 4",(long int) mapStateToPartition[4]);
+  FAUDES_TEST_DUMP("class of state 5",(long int) mapStateToPartition[5]);
+  FAUDES_TEST_DUMP("class of state 6",(long int) mapStateToPartition[6]);
+
+  // weak and delayed bisimulation with "alpha" considered silent
+  EventSet silent;
+  silent.Insert("alpha");
+  std::list<StateSet> partWeak, partDelayed;
+  ComputeWeakBisimulationCTA(genOrig, silent, partWeak);
+  ComputeDelayedBisimulationCTA(genOrig, silent, partDelayed);
+  std::cout << "##################################################\n";
+  std::cout << "# weak bisimulation, non-trivial classes\n";
+  std::list<StateSet>::const_iterator pIt=partWeak.begin();
+  for(; pIt!=partWeak.end(); ++pIt) std::cout << pIt->ToString() << "\n";
+  std::cout << "# delayed bisimulation, non-trivial classes\n";
+  for(pIt=partDelayed.begin(); pIt!=partDelayed.end(); ++pIt) std::cout << pIt->ToString() << "\n";
+  std::cout << "##################################################\n";
+
+  // record test case
+  std::string strWeak, strDelayed;
+  for(pIt=partWeak.begin(); pIt!=partWeak.end(); ++pIt) strWeak += pIt->ToString();
+  for(pIt=partDelayed.begin(); pIt!=partDelayed.end(); ++pIt) strDelayed += pIt->ToString();
+  FAUDES_TEST_DUMP("weak bisimulation",strWeak);
+  FAUDES_TEST_DUMP("delayed bisimulation",strDelayed);
+
+  // set up a larger generator with 30000 states: 100 copies of each state of a pseudo 
+  // random automaton with 300 states, where transitions lead to any copy of the target state
+  Generator genLarge;
+  genLarge.InsEvent("alpha");
+  genLarge.InsEvent("beta");
+  genLarge.InsEvent("gamma");
+  Idx m=300, k=100;
+  for(Idx q=1; q<=m*k; ++q) genLarge.InsState(q);
+  genLarge.SetInitState(1);
+  unsigned long int rnd=1;
+  std::vector<Idx> target(3*m);
+  for(Idx i=0; i<3*m; ++i) {
+    rnd=(rnd*1103515245+12345)%2147483648UL;
+    target[i]= (rnd%4==0 ? m : (rnd/4)%m);
+  }
+  for(Idx q=1; q<=m*k; ++q) {
+    Idx a=(q-1)%m;
+    if(a%7==0) genLarge.SetMarkedState(q);
+    Idx e=0;
+    EventSet::Iterator eit=genLarge.AlphabetBegin();
+    for(;eit!=genLarge.AlphabetEnd();++eit,++e) {
+      rnd=(rnd*1103515245+12345)%2147483648UL;
+      if(target[3*a+e]==m) continue;
+      genLarge.SetTransition(q,*eit,target[3*a+e]+m*((rnd/4)%k)+1);
+    }
+  }
+
+  // compute the bisimulation sequentially and with four threads
+  std::list<StateSet> partSeq, partPar;
+  ComputeBisimulation(genLarge, partSeq);
+  Context ctxPar;
+  ctxPar.Threads(4);
+  {
+    ContextScope scopePar(&ctxPar);
+    ComputeBisimulation(genLarge, partPar);
+  }
+  bool parEqual = (partSeq==partPar);
+
+  // report
+  std::cout << "##################################################\n";
+  std::cout << "# larger example: #" << genLarge.Size() << " states, #" << partSeq.size() << " classes\n";
+  std::cout << "# sequential and multi-threaded computation: " << (parEqual ? "match" : "FAIL") << "\n";
+  std::cout << "##################################################\n";
+
+  // record test case
+  FAUDES_TEST_DUMP("larger example classes",(long int) partSeq.size());
+  FAUDES_TEST_DUMP("larger example threads",parEqual);
+
+  // validate
+  FAUDES_TEST_DIFF();
+
   return 0;
 }
@@ -15,6 +15,7 @@
 #include <iostream>
 #include "libfaudes.h"
 #include "op_include.h"
+#include "cfl_localgen.h"
 
 // make libFAUDES namespace available
 using namespace faudes;
@@ -90,5 +91,124 @@ int main(int argc, char* argv[]) {
   std::cout << "lcc verification result: " << lcc << std::endl;
   std::cout << "###########################\n";
 
+  //////////////////////////////////////////////////////////////
+  //Synthesis of natural projections and verification of the result
+  //////////////////////////////////////////////////////////////
+
+  // read the example of the synthesis tutorial
+  genOrig.Read("data/ex_synthesis/ex_natural_all.gen");
+  EventSet initAlph("data/ex_synthesis/ex_natural_all.alph", "Alphabet");
+  EventSet controllableEvents;
+  controllableEvents.Insert("a");
+  controllableEvents.Insert("f");
+  controllableEvents.Insert("g");
+  controllableEvents.Insert("h");
+  // extend the high-level alphabet such that the natural projection is an Lm-observer, 
+  // an msa-observer, and that it in addition satisfies LCC, respectively
+  EventSet closedAlph(initAlph), obsAlph(initAlph), msaAlph(initAlph), obsLccAlph(initAlph), msaLccAlph(initAlph);
+  calcClosedObserver(genOrig,closedAlph);
+  calcNaturalObserver(genOrig,obsAlph);
+  calcMSAObserver(genOrig,msaAlph);
+  calcNaturalObserverLCC(genOrig,controllableEvents,obsLccAlph);
+  calcMSAObserverLCC(genOrig,controllableEvents,msaLccAlph);
+  // verify the results
+  bool obsok = IsObs(genOrig,obsAlph) && IsObs(genOrig,obsLccAlph) && IsLCC(genOrig,obsLccAlph);
+  std::cout << "###########################\n";
+  std::cout << "observer synthesis: ";
+  obsAlph.Write();
+  std::cout << "observer synthesis, with LCC: ";
+  obsLccAlph.Write();
+  std::cout << "verification result: " << obsok << std::endl;
+  std::cout << "###########################\n";
+
+  // record test case
+  FAUDES_TEST_DUMP("closed observer",closedAlph.ToString());
+  FAUDES_TEST_DUMP("natural observer",obsAlph.ToString());
+  FAUDES_TEST_DUMP("msa observer",msaAlph.ToString());
+  FAUDES_TEST_DUMP("natural observer lcc",obsLccAlph.ToString());
+  FAUDES_TEST_DUMP("msa observer lcc",msaLccAlph.ToString());
+  FAUDES_TEST_DUMP("observer verification",obsok);
+
+  // set up a larger generator with 2000 states by a simple pseudo random number generator
+  Generator genLarge;
+  for(int e=0; e<8; ++e) genLarge.InsEvent("e"+ToStringInteger(e));
+  Idx n=2000;
+  for(Idx q=1; q<=n; ++q) genLarge.InsState(q);
+  genLarge.SetInitState(1);
+  unsigned long int rnd=1;
+  for(Idx q=1; q<=n; ++q) {
+    if(q%50==0) genLarge.SetMarkedState(q);
+    EventSet::Iterator eit=genLarge.AlphabetBegin();
+    for(;eit!=genLarge.AlphabetEnd();++eit) {
+      rnd=(rnd*1103515245+12345)%2147483648UL;
+      if(rnd%8>=1) continue;
+      genLarge.SetTransition(q,*eit,(rnd/8)%n+1);
+    }
+  }
+  EventSet largeAlph;
+  largeAlph.Insert("e0");
+  calcNaturalObserver(genLarge,largeAlph);
+  bool largeok = IsObs(genLarge,largeAlph);
+  std::cout << "###########################\n";
+  std::cout << "observer synthesis, larger example: ";
+  largeAlph.Write();
+  std::cout << "verification result: " << largeok << std::endl;
+  std::cout << "###########################\n";
+
+  // record test case
+  FAUDES_TEST_DUMP("natural observer, larger example",largeAlph.ToString());
+  FAUDES_TEST_DUMP("observer verification, larger example",largeok);
+
+  // the dynamic system of the observer algorithms evaluates the local reach once per strongly
+  // connected component; compare with the plain per-state search by LocalAccessibleReach on a
+  // generator with plenty of local cycles
+  Generator genCyc;
+  for(int e=0; e<6; ++e) genCyc.InsEvent("e"+ToStringInteger(e));
+  Idx m=200;
+  for(Idx q=1; q<=m; ++q) genCyc.InsState(q);
+  genCyc.SetInitState(1);
+  for(Idx q=1; q<=m; ++q) {
+    if(q%20==0) genCyc.SetMarkedState(q);
+    EventSet::Iterator eit=genCyc.AlphabetBegin();
+    for(;eit!=genCyc.AlphabetEnd();++eit) {
+      rnd=(rnd*1103515245+12345)%2147483648UL;
+      if((rnd>>16)%3>=1) continue;
+      rnd=(rnd*1103515245+12345)%2147483648UL;
+      genCyc.SetTransition(q,*eit,(rnd>>8)%m+1);
+    }
+  }
+  EventSet dynAlph;
+  dynAlph.Insert("e0");
+  dynAlph.Insert("e1");
+  std::vector<StateSet> localReach(m+1);
+  for(Idx q=1; q<=m; ++q) LocalAccessibleReach(genCyc,dynAlph,q,localReach[q]);
+  TransSet closedRef;
+  for(Idx q=1; q<=m; ++q) {
+    StateSet::Iterator sit=localReach[q].Begin();
+    for(;sit!=localReach[q].End();++sit) {
+      TransSet::Iterator tit=genCyc.TransRelBegin(*sit);
+      for(;tit!=genCyc.TransRelEnd(*sit);++tit) {
+        if(!dynAlph.Exists(tit->Ev)) continue;
+        StateSet::Iterator zit=localReach[tit->X2].Begin();
+        for(;zit!=localReach[tit->X2].End();++zit)
+          closedRef.Insert(q,tit->Ev,*zit);
+      }
+    }
+  }
+  Generator dynClosed;
+  calculateDynamicSystemClosedObs(genCyc,dynAlph,dynClosed);
+  bool dynok = (dynClosed.TransRel()==closedRef);
+  std::cout << "###########################\n";
+  std::cout << "dynamic system, #" << closedRef.Size() << " transitions, ";
+  std::cout << "match with local reach: " << dynok << std::endl;
+  std::cout << "###########################\n";
+
+  // record test case
+  FAUDES_TEST_DUMP("dynamic system size",(long int) closedRef.Size());
+  FAUDES_TEST_DUMP("dynamic system match",dynok);
+
+  // validate
+  FAUDES_TEST_DIFF();
+
   return 0;
 }
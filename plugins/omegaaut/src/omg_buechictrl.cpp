@@ -302,15 +302,25 @@ bool ControlledBuechiLiveness(
 	
   FD_DF("ControlledBuechiLiveness()");
 
+  // compile generator to operate on dense state sets
+  CompiledGenerator cgen(rSupCandGen,false);
+  Idx fsz=cgen.Size();
+  std::vector<bool> cflags(cgen.AlphabetSize()+1,false);
+  for(Idx e=1; e<=cgen.AlphabetSize(); ++e)
+    cflags[e]=rCAlph.Exists(cgen.Event(e));
+  DenseStateSet markedK, markedL;
+  markedK.FromStateSet(rSupCandGen.MarkedStates(),cgen);
+  markedL.FromStateSet(rPlantMarking,cgen);
+
   // declare iterate sets
-  StateSet resolved, initialK, targetLstar;
-  StateSet initialL, targetL;
-  StateSet domainL, target1;
-  StateSet target, domain, theta;
+  DenseStateSet resolved(fsz), initialK(fsz), targetLstar(fsz);
+  DenseStateSet initialL(fsz), targetL(fsz);
+  DenseStateSet domainL(fsz), target1(fsz);
+  DenseStateSet target(fsz), domain(fsz), theta(fsz);
  
   // convenience
-  const StateSet& full = rSupCandGen.States();
-  Idx fsz=full.Size();
+  DenseStateSet full(fsz);
+  full.Fill();
 
   // evaluate mu(resolved).nu(initialK)[ p(initialK * markedK + resolved )) ];
   // here, p(T) denotes the set of states that can be driven to enter T under liveness assumption inf-markL;
@@ -323,7 +333,9 @@ bool ControlledBuechiLiveness(
       Idx iKsz = initialK.Size();
 
       // prepare target for P(): targetLstar = initialK * markedK + resolved 
-      targetLstar = (initialK * rSupCandGen.MarkedStates()) + resolved;
+      targetLstar = initialK;
+      targetLstar.RestrictSet(markedK);
+      targetLstar.InsertSet(resolved);
       FD_DF("ControlledBuechiLiveness(): [STD] iterate resolved/targetLstar #" << rsz << "/" << targetLstar.Size());
 
       // evaluate p(targetLstar) = mu(initialL).[ thetaTilde(targetLstar+initialL) ] 
@@ -335,14 +347,14 @@ bool ControlledBuechiLiveness(
         Idx iLsz = initialL.Size();
 
         // prepare targetL=targetLstar+initialL
-        targetL=targetLstar+initialL; 
+        targetL=targetLstar;
+        targetL.InsertSet(initialL);
         FD_DF("ControlledBuechiLiveness(): [STD] ---- iterate targetL #" << targetL.Size());
 
         // evaluate thetaTilde(targetL)=nu(domainL).mu(target1)[ theta(targetL+(target1-markL), domainL-markL) ];
         // here, theta(T,D) is the set of states that, by one transition, can enter T and can be controlled not to exit D+T;
         // start with domainL:=full and iterate domainL -= mu(target1)[theta(targetL+(target1-markL), domainL-markL)];
         domainL=full;
-        targetL = targetLstar + initialL;
         while(true) {
           Idx dLsz = domainL.Size();
           FD_DF("ControlledBuechiLiveness(): [STD] --- iterate domainL #" << domainL.Size());
@@ -351,7 +363,8 @@ bool ControlledBuechiLiveness(
           FD_WPC(1,2,"ControlledBuechiLiveness(): [STD] iterating reverse dynamics"); 
    
           // prepare domain = domainL - marL
-	  domain=domainL-rPlantMarking;
+	  domain=domainL;
+          domain.EraseSet(markedL);
 
           // evaluate mu(target1)[ theta(targetL+(target1-markL), domain) ];
           // start with target1:=0 and iterate target+=theta(targetL+(target1-markL), domainL-markL) ]; 
@@ -360,27 +373,27 @@ bool ControlledBuechiLiveness(
             Idx t1sz = target1.Size();
        
             // prepare target= targetL+(target1-markL)
-            target = targetL + (target1-rPlantMarking);
+            target = target1;
+            target.EraseSet(markedL);
+            target.InsertSet(targetL);
 
             // evaluate theta(target,domain) 
             FD_DF("ControlledBuechiLiveness(): [STD] -- evaluate theta for target/domain # " 
                << target.Size() << "/" << domain.Size());
             theta.Clear();
-            StateSet::Iterator sit = full.Begin(); 
-            StateSet::Iterator sit_end = full.End(); 
-            for(;sit!=sit_end;++sit) {
+            for(Idx q=1; q<=fsz; ++q) {
               bool pass = false;
               bool fail = false;      
-              TransSet::Iterator tit = rSupCandGen.TransRelBegin(*sit);
-              TransSet::Iterator tit_end = rSupCandGen.TransRelEnd(*sit);
-              for(;tit!=tit_end; ++tit) {
-                if(target.Exists(tit->X2)) {pass = true; continue;}
-                if(domain.Exists(tit->X2)) {continue;}
-    	        if(!rCAlph.Exists(tit->Ev)){ fail = true; break;}
+              CompiledGenerator::Iterator eit = cgen.SuccBegin(q);
+              CompiledGenerator::Iterator eit_end = cgen.SuccEnd(q);
+              for(;eit!=eit_end; ++eit) {
+                if(target.Exists(eit->X)) {pass = true; continue;}
+                if(domain.Exists(eit->X)) {continue;}
+    	        if(!cflags[eit->Ev]){ fail = true; break;}
               }
               if(pass && !fail) {
-                theta.Insert(*sit);
-                FD_DF("ControlledBuechiLiveness(): [STD] theta found state " << rSupCandGen.SStr(*sit));
+                theta.Insert(q);
+                FD_DF("ControlledBuechiLiveness(): [STD] theta found state " << rSupCandGen.SStr(cgen.State(q)));
 	      }
             } // end: theta   
   
@@ -419,7 +432,10 @@ bool ControlledBuechiLiveness(
   } // end: mu
  
   // restrict candidate to resolved states
-  rSupCandGen.DelStates(full - resolved);
+  full.EraseSet(resolved);
+  StateSet unresolved;
+  full.ToStateSet(unresolved,cgen);
+  rSupCandGen.DelStates(unresolved);
 
   // done
   return true;
@@ -1393,6 +1409,7 @@ void BuechiCon(
   // compute restrictive feedback
   std::map< Idx , EventSet> feedback;
   ControlledBuechiLiveness(rResGen, rCAlph, plantmarking, feedback);
+  rResGen.TransRel().Detach();
   // apply restrictive feedback
   StateSet::Iterator sit = rResGen.StatesBegin();
   StateSet::Iterator sit_end = rResGen.StatesEnd();
@@ -1506,6 +1523,7 @@ void BuechiConNorm(
   SupBuechiConNormUnchecked(rPlantGen, rCAlph, rOAlph, rSpecGen, plantmarking, cxmap, feedback, rResGen);
   // compute restrictive feedback
   ControlledBuechiLiveness(rResGen, rCAlph, plantmarking, cxmap, feedback);
+  rResGen.TransRel().Detach();
   // apply restrictive feedback
   StateSet::Iterator sit = rResGen.StatesBegin();
   StateSet::Iterator sit_end = rResGen.StatesEnd();
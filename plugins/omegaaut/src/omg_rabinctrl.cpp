@@ -63,15 +63,15 @@ Rabin pair, as this is our current use case.
   
 /*
 Base class for my operators to hold context
+
+All operators share one compiled generator and evaluate on dense state sets;
+conversion from/to StateSet only takes place at the API boundary.
 */
 class  RabinInvDynOperator : public StateSetOperator {
 protected:
   /** record context references */
   const vGenerator& rGen;
-  const StateSet& rDomain;
-  const StateSet& rMarkedStates;
-  const TransSet& rTransRel;
-  const TransSetX2EvX1& rRevTransRel;
+  const CompiledGenerator& rCGen;
   EventSet mSigmaCtrl;
   /** record control patterns */
   bool mRecCtrl=false;
@@ -79,14 +79,11 @@ protected:
 public:
   /** construct to record context */
   RabinInvDynOperator(
-    const vGenerator& gen, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const vGenerator& gen, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
     StateSetOperator(),
     rGen(gen),
-    rDomain(gen.States()),
-    rMarkedStates(gen.MarkedStates()),
-    rTransRel(gen.TransRel()),
-    rRevTransRel(revtrans),    
+    rCGen(cgen),
     mSigmaCtrl(sigctrl),
     mRecCtrl(false)
   {
@@ -95,7 +92,11 @@ public:
   };
   /** overaall stateset */
   virtual const StateSet& Domain(void) const {
-    return rDomain;
+    return rGen.States();
+  }
+  /** we evaluate on dense sets */
+  virtual const CompiledGenerator* DenseDomain(void) const {
+    return &rCGen;
   }
   /** access control flag  */
   void RecCtrl(bool on) { mRecCtrl=on; }
@@ -113,6 +114,21 @@ public:
       if(!mController.Exists(*sit))
 	mController.Insert(*sit,otherctrl.Attribute(*sit));
   }
+protected:
+  /** evaluate on state sets by conversion */
+  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+    std::vector<DenseStateSet> dargs(rArgs.Size());
+    DenseStateSetVector dargrefs;
+    for(StateSetVector::Position pos=0; pos<rArgs.Size(); ++pos) {
+      dargs[pos].FromStateSet(rArgs.At(pos),rCGen);
+      dargrefs.push_back(&dargs[pos]);
+    }
+    DenseStateSet dres;
+    DoEvaluateDense(dargrefs,dres);
+    dres.ToStateSet(rRes,rCGen);
+  }
+  /** actual operator implementation */
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) =0;
 };      
 
 
@@ -134,50 +150,63 @@ class  RabinInvDynTheta : public RabinInvDynOperator {
 public:
   /** construct to record context */
   RabinInvDynTheta(
-    const vGenerator& gen, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const vGenerator& gen, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(gen,revtrans,sigctrl)
+    RabinInvDynOperator(gen,cgen,sigctrl)
   {
     FD_DF("RabinInvDynTheta(): instantiated for " << rGen.Name());
     Name("theta([Z1,Z2])");
     mArgNames= std::vector<std::string>{"Z1","Z2"};
     mArgCount=2;
+    // prepare dense evaluation
+    mCtrlFlags.assign(rCGen.AlphabetSize()+1,false);
+    for(Idx e=1; e<=rCGen.AlphabetSize(); ++e)
+      mCtrlFlags[e]=mSigmaCtrl.Exists(rCGen.Event(e));
+    mDMarked.FromStateSet(rGen.MarkedStates(),rCGen);
   };
 protected:
+  /** controllable events by internal index */
+  std::vector<bool> mCtrlFlags;
+  /** marked states, dense */
+  DenseStateSet mDMarked;
   /** loop local vars */
   EventSet mDisable;    
-  /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
-    // convenience accesors
-    const StateSet& Z1=rArgs.At(0);
-    const StateSet& Z2=rArgs.At(1);
-    // do operate
-    rRes=rRevTransRel.PredecessorStates(Z1);
-    StateSet::Iterator sit=rRes.Begin();
-    StateSet::Iterator sit_end=rRes.End();
-    while(sit!=sit_end){
+  /** dense implementation of theta */
+  void DenseTheta(const DenseStateSet& Z1, const DenseStateSet& Z2, DenseStateSet& rRes) {
+    // candidates: predecessors of Z1
+    rRes.Resize(rCGen.Size());
+    Idx q;
+    for(q=Z1.Next(0); q!=0; q=Z1.Next(q)) {
+      CompiledGenerator::Iterator eit=rCGen.PredBegin(q);
+      CompiledGenerator::Iterator eit_end=rCGen.PredEnd(q);
+      for(;eit!=eit_end;++eit) rRes.Insert(eit->X);
+    }
+    // test candidates
+    for(q=rRes.Next(0); q!=0; q=rRes.Next(q)) {
       if(mRecCtrl) mDisable.Clear();
-      TransSet::Iterator tit=rTransRel.Begin(*sit);
-      TransSet::Iterator tit_end=rTransRel.End(*sit);
+      CompiledGenerator::Iterator eit=rCGen.SuccBegin(q);
+      CompiledGenerator::Iterator eit_end=rCGen.SuccEnd(q);
       bool enterZ1 = false;
       bool exitZ12 = false;      
-      for(;tit!=tit_end;++tit){
+      for(;eit!=eit_end;++eit){
 	// successor is in Z1: will not disable, found evidence to enter Z1
-        if(Z1.Exists(tit->X2)) {enterZ1=true; continue;}
+        if(Z1.Exists(eit->X)) {enterZ1=true; continue;}
         // successor is in Z2: will not disable     	
-        if(Z2.Exists(tit->X2)) {continue;}
+        if(Z2.Exists(eit->X)) {continue;}
 	// sucessor is neither in Z1 nor Z2: need to disable
-    	if(!mSigmaCtrl.Exists(tit->Ev)){exitZ12 = true; break;}
+    	if(!mCtrlFlags[eit->Ev]){exitZ12 = true; break;}
 	// record controls
-	if(mRecCtrl) mDisable.Insert(tit->Ev);
+	if(mRecCtrl) mDisable.Insert(rCGen.Event(eit->Ev));
       }
       // failed
-      if(!enterZ1 || exitZ12) {rRes.Erase(sit++); continue;}
+      if(!enterZ1 || exitZ12) {rRes.Erase(q); continue;}
       // success
-      if(mRecCtrl) mController.Insert(*sit,rGen.Alphabet()-mDisable);
-      ++sit;
+      if(mRecCtrl) mController.Insert(rCGen.State(q),rGen.Alphabet()-mDisable);
     }
-    
+  }
+  /** actual operator implementation */
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
+    DenseTheta(*rArgs[0],*rArgs[1],rRes);
   }; 
 };      
     
@@ -197,9 +226,9 @@ class  RabinInvDynThetaTildeCore : public RabinInvDynTheta {
 public:
   /** construct to record context */
   RabinInvDynThetaTildeCore(
-    const vGenerator& gen, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const vGenerator& gen, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynTheta(gen,revtrans,sigctrl)
+    RabinInvDynTheta(gen,cgen,sigctrl)
   {
     FD_DF("RabinInvDynThetaTildeCore(): instantiated for " << rGen.Name());
     Name("theta_tilde_core([Y1,Y2,Y3,Y4])");
@@ -207,21 +236,20 @@ public:
     mArgCount=4;
   };
 protected:  
+  /** loop local vars */
+  DenseStateSet mDZ1, mDZ2;
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
-    // convenience acsesors
-    const StateSet& Y1=rArgs.At(0);
-    const StateSet& Y2=rArgs.At(1);
-    const StateSet& Y3=rArgs.At(2);
-    const StateSet& Y4=rArgs.At(3);
-    StateSetVector args;
-    args.Size(2);
-    StateSet& Z1=args.At(0);
-    StateSet& Z2=args.At(1);
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
+    // Z1= Y1 + (Y4 - rMarkedStates);
+    mDZ1=*rArgs[3];
+    mDZ1.EraseSet(mDMarked);
+    mDZ1.InsertSet(*rArgs[0]);
+    // Z2= Y2 * (Y3 - rMarkedStates);
+    mDZ2=*rArgs[2];
+    mDZ2.EraseSet(mDMarked);
+    mDZ2.RestrictSet(*rArgs[1]);
     // do operate
-    Z1= Y1 + (Y4 - rMarkedStates);
-    Z2= Y2 * (Y3 - rMarkedStates);
-    RabinInvDynTheta::DoEvaluate(args,rRes);
+    DenseTheta(mDZ1,mDZ2,rRes);
   };
 };      
     
@@ -237,10 +265,10 @@ protected:
 public:
   /** construct to record context */
   RabinInvDynThetaTildeInner(
-    const vGenerator& gen, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const vGenerator& gen, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(gen,revtrans,sigctrl),
-    mThetaCore(gen,revtrans,sigctrl),
+    RabinInvDynOperator(gen,cgen,sigctrl),
+    mThetaCore(gen,cgen,sigctrl),
     mMuThetaCore(mThetaCore)
   {
     FD_DF("RabinInvDynThetaTildeInner(): instantiated for " << rGen.Name());
@@ -250,7 +278,7 @@ public:
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
     // pass on ctrl record flag
     mThetaCore.RecCtrl(mRecCtrl);
     mThetaCore.ClrCtrl();
@@ -273,10 +301,10 @@ protected:
 public:
   /** construct to record context */
   RabinInvDynThetaTilde(
-    const vGenerator& gen, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const vGenerator& gen, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(gen,revtrans,sigctrl),
-    mMuThetaCore(gen,revtrans,sigctrl),
+    RabinInvDynOperator(gen,cgen,sigctrl),
+    mMuThetaCore(gen,cgen,sigctrl),
     mNuMuThetaCore(mMuThetaCore)
   {
     FD_DF("RabinInvDynThetaTilde(): instantiated for " << rGen.Name());
@@ -286,17 +314,16 @@ public:
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
     // plain fixpoint, dont record in inner mu
     mMuThetaCore.RecCtrl(false);
     mNuMuThetaCore.Evaluate(rArgs, rRes);
     // if we have been asked to record, run mu again with nu-var set to fixpoint
     if(mRecCtrl) {
-      StateSetVector args;
-      args.CopyByReference(rArgs);
-      args.PushBack(&rRes);
+      DenseStateSetVector args(rArgs);
+      args.push_back(&rRes);
       mMuThetaCore.RecCtrl(true);
-      StateSet dummy;
+      DenseStateSet dummy;
       mMuThetaCore.Evaluate(args,dummy);
       InsCtrl(mMuThetaCore);
 #ifdef FAUDES_DEBUG 
@@ -326,46 +353,49 @@ class  RabinInvDynPReachCore : public RabinInvDynOperator {
   /** additional context */
   RabinInvDynThetaTilde mThetaTilde;
   RabinAcceptance::CIterator mRPit;
+  /** dense domain and I-set */
+  DenseStateSet mDDomain, mDISet;
+  /** loop local vars */
+  DenseStateSet mDY1, mDRhs;
 public:
   /** construct to record context */
   RabinInvDynPReachCore(
-    const RabinAutomaton& raut, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const RabinAutomaton& raut, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(raut,revtrans,sigctrl),
-    mThetaTilde(raut,revtrans,sigctrl),
+    RabinInvDynOperator(raut,cgen,sigctrl),
+    mThetaTilde(raut,cgen,sigctrl),
     mRPit(raut.RabinAcceptance().Begin())
   {
     FD_DF("RabinInvDynPReachCore(): instantiated for " << rGen.Name());
     Name("p_reach_core([U1,U2,U3)");
     mArgNames= std::vector<std::string>{"U1","U2","U3"};
     mArgCount=3;
+    mDDomain.Resize(rCGen.Size());
+    mDDomain.Fill();
+    mDISet.FromStateSet(mRPit->ISet(),rCGen);
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
     // pass on rec flag
     mThetaTilde.RecCtrl(mRecCtrl);
     mThetaTilde.ClrCtrl();
     // convenience accessors
-    const StateSet& U1=rArgs.At(0);
-    const StateSet& U2=rArgs.At(1);
-    const StateSet& U3=rArgs.At(2);
-    StateSetVector args;
-    args.Size(2);
-    StateSet& Y1=args.At(0);
-    StateSet& Y2=args.At(1);
+    const DenseStateSet& U1=*rArgs[0];
+    const DenseStateSet& U2=*rArgs[1];
+    const DenseStateSet& U3=*rArgs[2];
+    DenseStateSetVector args{&mDY1,&mDDomain};
     // do operate a
-    Y1=U1;
-    Y2=Domain();
+    mDY1=U1;
     mThetaTilde.Evaluate(args,rRes);
     InsCtrl(mThetaTilde);
     // do operate b
-    Y1=U1+U2+U3;
-    Y2=mRPit->ISet();
-    StateSet rhs;
-    mThetaTilde.Evaluate(args,rhs);
+    mDY1.InsertSet(U2);
+    mDY1.InsertSet(U3);
+    args[1]=&mDISet;
+    mThetaTilde.Evaluate(args,mDRhs);
     InsCtrl(mThetaTilde);
-    rRes.InsertSet(rhs);
+    rRes.InsertSet(mDRhs);
     //std::cout << "p_reach_core: ctrl #" << mController.Size() << std::endl;
   };
 };      
@@ -379,10 +409,10 @@ protected:
 public:
   /** construct to record context */
   RabinInvDynPReach(
-    const RabinAutomaton& raut, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const RabinAutomaton& raut, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(raut,revtrans,sigctrl),
-    mPReachCore(raut,revtrans,sigctrl),
+    RabinInvDynOperator(raut,cgen,sigctrl),
+    mPReachCore(raut,cgen,sigctrl),
     mMuPReachCore(mPReachCore)
   {
     FD_DF("RabinInvDynPReach(): instantiated for " << rGen.Name());
@@ -392,7 +422,7 @@ public:
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
     // pass on ctrl record flag
     mPReachCore.RecCtrl(mRecCtrl);
     mPReachCore.ClrCtrl();
@@ -418,33 +448,33 @@ We first implement the core formula without the mu/nu iteration, and then do the
 class  RabinInvDynCtrlCore : public RabinInvDynPReach {
   /** additional context */
   RabinAcceptance::CIterator mRPit;
+  /** dense R-set */
+  DenseStateSet mDRSet;
+  /** loop local vars */
+  DenseStateSet mDO2;
 public:
   /** construct to record context */
   RabinInvDynCtrlCore(
-    const RabinAutomaton& raut, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const RabinAutomaton& raut, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynPReach(raut,revtrans,sigctrl),
+    RabinInvDynPReach(raut,cgen,sigctrl),
     mRPit(raut.RabinAcceptance().Begin())
   {
     FD_DF("RabinInvDynCtrlCore(): instantiated for " << rGen.Name());
     Name("ctrl_core([X1,X2])");
     mArgNames= std::vector<std::string>{"X1","X2"};
     mArgCount=2;
+    mDRSet.FromStateSet(mRPit->RSet(),rCGen);
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
-    // convenience accessors
-    const StateSet& X1=rArgs.At(0);
-    const StateSet& X2=rArgs.At(1);
-    StateSetVector args;
-    args.Size(2);
-    StateSet& O1=args.At(0);
-    StateSet& O2=args.At(1);
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
+    // O1=X1, O2=X2 * RSet
+    mDO2=*rArgs[1];
+    mDO2.RestrictSet(mDRSet);
+    DenseStateSetVector args{rArgs[0],&mDO2};
     // do operate
-    O1=X1;
-    O2=X2 * mRPit->RSet();
-    RabinInvDynPReach::DoEvaluate(args,rRes);
+    RabinInvDynPReach::DoEvaluateDense(args,rRes);
   };
 };      
     
@@ -457,10 +487,10 @@ protected:
 public:
   /** construct to record context */
   RabinInvDynCtrlInner(
-    const RabinAutomaton& raut, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const RabinAutomaton& raut, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(raut,revtrans,sigctrl),
-    mCtrlCore(raut,revtrans,sigctrl),
+    RabinInvDynOperator(raut,cgen,sigctrl),
+    mCtrlCore(raut,cgen,sigctrl),
     mNuCtrlCore(mCtrlCore)
   {
     FD_DF("RabinInvDynCtrlInner(): instantiated for " << rGen.Name());
@@ -470,17 +500,16 @@ public:
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
     // plain fixpoint, dont record 
     mCtrlCore.RecCtrl(false);
     mNuCtrlCore.Evaluate(rArgs, rRes);
     // if we have been asked to record, nu-var set to fixpoint
     if(mRecCtrl) {
-      StateSetVector args;
-      args.CopyByReference(rArgs);
-      args.PushBack(&rRes);
+      DenseStateSetVector args(rArgs);
+      args.push_back(&rRes);
       mCtrlCore.RecCtrl(true);
-      StateSet dummy;
+      DenseStateSet dummy;
       mCtrlCore.Evaluate(args,dummy);
       InsCtrl(mCtrlCore);
 #ifdef FAUDES_DEBUG 
@@ -502,10 +531,10 @@ protected:
 public:
   /** construct to record context */
   RabinInvDynCtrl(
-    const RabinAutomaton& raut, const TransSetX2EvX1& revtrans, const EventSet& sigctrl)
+    const RabinAutomaton& raut, const CompiledGenerator& cgen, const EventSet& sigctrl)
   :
-    RabinInvDynOperator(raut,revtrans,sigctrl),
-    mNuCtrlCore(raut,revtrans,sigctrl),
+    RabinInvDynOperator(raut,cgen,sigctrl),
+    mNuCtrlCore(raut,cgen,sigctrl),
     mMuNuCtrlCore(mNuCtrlCore)
   {
     FD_DF("RabinInvDynCtrl(): instantiated for " << rGen.Name());
@@ -514,7 +543,7 @@ public:
   };
 protected:  
   /** actual operator implementation */
-  virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
     // pass on ctrl record flag
     mNuCtrlCore.RecCtrl(mRecCtrl);
     mNuCtrlCore.ClrCtrl();
@@ -563,10 +592,10 @@ void RabinCtrlPfx(
     throw Exception("RabinCtrlPfx", errstr.str(), 80);
   }
   // set up various helper
-  TransSetX2EvX1 revtrans(rRAut.TransRel());
+  CompiledGenerator cgen(rRAut);
   EventSet sigctrl(rSigmaCtrl);
   // have operator
-  RabinInvDynCtrl ctrl(rRAut,revtrans,sigctrl);
+  RabinInvDynCtrl ctrl(rRAut,cgen,sigctrl);
   // run
   ctrl.Evaluate(rCtrlPfx);
 };
@@ -584,10 +613,10 @@ void RabinCtrlPfx(
     throw Exception("RabinCtrlPfx", errstr.str(), 80);
   }
   // set up various helper
-  TransSetX2EvX1 revtrans(rRAut.TransRel());
+  CompiledGenerator cgen(rRAut);
   EventSet sigctrl(rSigmaCtrl);
   // have operator
-  RabinInvDynCtrl ctrl(rRAut,revtrans,sigctrl);
+  RabinInvDynCtrl ctrl(rRAut,cgen,sigctrl);
   ctrl.RecCtrl(true);
   // run
   StateSet ctrlpfx;
@@ -780,6 +809,7 @@ void RabinCtrl(
   gcand.InsMarkedStates(pbuechi);
   
   // execute: apply control patterns
+  gcand.TransRel().Detach();
   TransSet::Iterator tit=gcand.TransRelBegin();
   Idx cx=0;
   const EventSet* pctrlpat=nullptr;
@@ -862,6 +892,7 @@ void RabinCtrl(
 #endif  
 
   // execute: apply control patterns on exit of lspec;
+  rRes.TransRel().Detach();
   TransSet::Iterator tit=rRes.TransRelBegin();
   Idx cx=0;
   Idx csx=0;
@@ -165,6 +165,7 @@ protected:
     const StateSet& Z2=rArgs.At(1);
     // do operate
     rRes=rRevTransRel.PredecessorStates(Z1);
+    rRes.Detach();
     StateSet::Iterator sit=rRes.Begin();
     StateSet::Iterator sit_end=rRes.End();
     while(sit!=sit_end){
@@ -574,6 +575,7 @@ private:
                               int muLevel, int nuLevel, int branchType) const {
     // This implements the basic inverse dynamics operator θ(Z1, Z2)
     rRes = rRevTransRel.PredecessorStates(Z1);
+    rRes.Detach();
     StateSet::Iterator sit = rRes.Begin();
     StateSet::Iterator sit_end = rRes.End();
     
@@ -185,27 +185,18 @@ void Candidate::ExtendedTransRel(const Generator& rGen, const EventSet& rSilentA
 void Candidate::ObservationEquivalentQuotient(Generator& g, const EventSet& silent){
   FD_DF("ObservationEquivalentQuotient(): prepare for t#"<<g.TransRelSize());
 
-  // have extendend/reverse-ordered transition relations
+  // have reverse-ordered transition relation
   TransSetX2EvX1 rtrans;
   g.TransRel().ReSort(rtrans);
 
-  Generator xg(g);  // a copy of input g, which will be augmented with some fancy transitions
-  TransSet xtrans;
-  ExtendedTransRel(xg,silent,xtrans);
-  FD_DF("ObservationEquivalentQuotient(): ext. trans t#"<<xtrans.Size());
-
-  // figure observation equivalent states
+  // figure observation equivalent states: the partition refinement kernel
+  // saturates the transition relation and installs silent selfloops, see also ExtendedTransRel
   std::list< StateSet > eqclasses;
-  xg.InjectTransRel(xtrans);
-  // install silent selfloops
-  if (!silent.Empty()){
-    StateSet::Iterator sit = xg.StatesBegin();
-    for(;sit!=xg.StatesEnd();sit++){
-      EventSet::Iterator eit = silent.Begin();
-      xg.SetTransition(*sit,*eit,*sit);
-    }
-  }
-  ComputeBisimulationCTA(xg,eqclasses);
+  SignatureRefinement obseq;
+  obseq.Compile(g);
+  obseq.Saturate(silent,2);
+  obseq.Refine();
+  obseq.Classes(eqclasses);
 
 
   // merge  classes
@@ -244,18 +235,12 @@ void Candidate::ReverseObservationEquivalentQuotient(Generator &g, const EventSe
   }
 
   // figure out eqclasses, see e.g. ObservationEquivalentQuotient
-  TransSet xtrans;
-  ExtendedTransRel(rev_g,silent,xtrans);
-  rev_g.InjectTransRel(xtrans);
-  if (!silent.Empty()){
-    StateSet::Iterator sit2 = rev_g.StatesBegin();
-    StateSet::Iterator sit2_end = rev_g.StatesEnd();
-    for(;sit2!=sit2_end;sit2++){
-      rev_g.SetTransition(*sit2,*silent.Begin(),*sit2);
-    }
-  }
   std::list<StateSet> eqclasses;
-  ComputeBisimulationCTA(rev_g,eqclasses);
+  SignatureRefinement obseq;
+  obseq.Compile(rev_g);
+  obseq.Saturate(silent,2);
+  obseq.Refine();
+  obseq.Classes(eqclasses);
 
   // refine eqclasses in that all states in a class has outgoing tau
   std::list<StateSet> eqclasses_fine; // store result in new list, as some classes may be directly abandoned
@@ -485,6 +470,7 @@ void Candidate::ActiveEventsANDEnabledContinuationRule(
 
 // simple function removing tau self loops
 void Candidate::RemoveTauSelfloops(Generator &g, const EventSet &silent){
+  g.TransRel().Detach();
   TransSet::Iterator tit = g.TransRelBegin();
   TransSet::Iterator tit_end = g.TransRelEnd();
   while(tit!=tit_end){
@@ -504,6 +490,7 @@ void Candidate::MergeSilentLoops(Generator &g, const EventSet &silent){
 
   // have a generator copy where only silent transitions are preserved
   Generator copyg(g);
+  copyg.TransRel().Detach(); // the copy shares its transitions with the original
   TransSet::Iterator tit = copyg.TransRel().Begin();
   while (tit!=copyg.TransRelEnd()){
     if (!silent.Exists(tit->Ev)) // if not a silent trans, delete
@@ -530,6 +517,7 @@ void Candidate::MergeSilentLoops(Generator &g, const EventSet &silent){
 // -- remove outgoing transitions from not coaccessible states
 void Candidate::RemoveNonCoaccessibleOut(Generator& g){
   StateSet notcoaccSet=g.States()-g.CoaccessibleSet();
+  g.TransRel().Detach();
   StateSet::Iterator sit=notcoaccSet.Begin();
   StateSet::Iterator sit_end=notcoaccSet.End();
   for(;sit!=sit_end;++sit){
@@ -559,6 +547,7 @@ void Candidate::BlockingSilentEvent(Generator& g,const EventSet& silent){
         sblock.Insert(tit->X1);
   }
   // unmark blocking states and eliminate possible future
+  g.TransRel().Detach();
   sit=sblock.Begin();
   sit_end=sblock.End();
   for(;sit!=sit_end;++sit) {
@@ -743,6 +732,7 @@ void Candidate::HidePrivateEvs(EventSet& silent){
     mGenMerged = mGenHidden;
     return;
   }
+  mGenHidden.TransRel().Detach();
   TransSet::Iterator tit=mGenHidden.TransRelBegin();
   TransSet::Iterator tit_end=mGenHidden.TransRelEnd();
   for(;tit!=tit_end;) {
@@ -854,6 +844,7 @@ void WritePrio (const pGenerator& rPGen){
 // shaping priosities for specified preempting events (retains unreachable states)
 void ShapeUpsilon(vGenerator& rGen, const EventPriorities& rPrios, const EventSet& rUpsilon){
   Idx lowest  = rPrios.LowestPriority();
+  rGen.TransRel().Detach();
   StateSet::Iterator sit = rGen.StatesBegin();
   for(;sit!=rGen.StatesEnd();sit++){
     // figure highest enabled priority
@@ -907,6 +898,7 @@ void ShapePriorities(pGenerator& rPGen){
 
 // shape by set of preempting events only (TM2025: need this old version to compile/link example)
 void ShapePreemption(Generator& rGen, const EventSet &pevs){
+  rGen.TransRel().Detach();
   StateSet::Iterator sit = rGen.StatesBegin();
   StateSet::Iterator sit_end = rGen.StatesEnd();
   for(;sit!=sit_end; sit++){
@@ -926,6 +918,7 @@ void ShapePreemption(Generator& rGen, const EventSet &pevs){
 
 // require WF!
 void RemoveRedSilentSelfloops (pGenerator& rPGen, const EventSet& rSilent){
+  rPGen.TransRel().Detach();
   TransSet::Iterator tit=rPGen.TransRelBegin();
   while(tit!=rPGen.TransRelEnd()){
     if (tit->X1!=tit->X2) {tit++; continue;}
@@ -958,7 +951,7 @@ EventSet NonsilHigherThen (const pGenerator& rPGen,
       eit++;
       continue;
     }
-    result.Erase(eit++);
+    eit=result.Erase(eit);
   }
   return result;
 }
@@ -1044,6 +1037,7 @@ void MergeEquivalenceClasses(
 void SaturateLowestPrio(const pGenerator& rPGen, const EventSet& rSilent, pGenerator& rResult){
   FD_DF("SaturateLowestPrio()");
   rResult=rPGen;
+  rResult.TransRel().Detach();
   // only preserve silent transitions
   TransSet::Iterator tit = rResult.TransRelBegin();
   while (tit!=rResult.TransRelEnd()){
@@ -1194,6 +1188,7 @@ void DetectLiveLocks(const pGenerator &rPGen, const EventSet &rSilent, std::map<
 
   // have a generator copy where only silent transitions are preserved
   pGenerator copyg(rPGen);
+  copyg.TransRel().Detach(); // the copy shares its transitions with the original
   TransSet::Iterator tit = copyg.TransRel().Begin();
   while (tit!=copyg.TransRelEnd()){
     if (!rSilent.Exists(tit->Ev)) // if not a silent trans, delete
@@ -1279,6 +1274,7 @@ bool IncomingTransSet(
 		      IncTransSet& rResult){
   FD_DF("IncommingTransSet()");
   TransSetX2EvX1 trans_lowest = rtrans_lowest;
+  trans_lowest.Detach(); // the copy shares its data with rtrans_lowest
   rResult.clear();
   // 1. test if there are silent pred with higher prio non-sil ev
   // if a silent pred can execute tau, then (due to wf) this tau must reach
@@ -1678,6 +1674,7 @@ StateSet StronglyCoaccessibleSet(const pGenerator& rPGen){
 void RemoveNonCoaccessibleOut(pGenerator& rPGen){
   FD_DF("RemoveNonCoaccessible()");
   StateSet notcoacc=rPGen.States()-StronglyCoaccessibleSet(rPGen);
+  rPGen.TransRel().Detach();
   StateSet::Iterator sit=notcoacc.Begin();
   StateSet::Iterator sit_end=notcoacc.End();
   for(;sit!=sit_end;++sit){
@@ -1718,6 +1715,7 @@ void BlockingSilentEvent(pGenerator& rPGen,const EventSet& rSilent){
       }
   }
   // unmark blocking states and eliminate possible future
+  rPGen.TransRel().Detach();
   sit=sblock.Begin();
   sit_end=sblock.End();
   for(;sit!=sit_end;++sit) {
@@ -1957,6 +1955,7 @@ EventSet HidePrivateEvs(pGenerator& rPGen,
     rPrios.InsPriority(tauev,k);
   }
   rTau++; // updates tau index
+  rPGen.TransRel().Detach();
   TransSet::Iterator tit = rPGen.TransRelBegin();
   EventSet unhideable;
   if (pUnHideable != nullptr) unhideable = *pUnHideable;
@@ -2429,6 +2428,7 @@ void PCandidate::HidePrivateEvs(EventSet& silent){
     mGenMerged.Name(mGenRaw.Name()+"_M");
     return;
   }
+  mGenHidden.TransRel().Detach();
   TransSet::Iterator tit=mGenHidden.TransRelBegin();
   TransSet::Iterator tit_end=mGenHidden.TransRelEnd();
   for(;tit!=tit_end;) {
@@ -566,6 +566,7 @@ TEMP void THIS::Priority(const std::string& rName, Idx prio) {
 // Priorities(otherset)
 TEMP void THIS::Priorities(const TpEventSet<EventAttr>& rOtherSet) {
   FD_DG("TpGenerator(" << this << ")::Priorities(src)");
+  this->pAlphabet->Detach();
   NameSet::Iterator eit=this->AlphabetBegin();  
   NameSet::Iterator eit_end=this->AlphabetEnd();
   for(;eit!=eit_end;++eit) {
@@ -125,6 +125,7 @@ bool ProposingExecutor::ExecuteTime(Time::Type duration){
   if(!LoggingExecutor::ExecuteTime(duration)) return false;
   // update stochastic event state
   EventSet::Iterator eit;
+  mSimEvents.Detach();
   for(eit=mSimEvents.Begin(); eit!=mSimEvents.End(); ++eit) {
     SimEventAttribute* pattr= mSimEvents.Attributep(*eit);
     // stochastic only
@@ -179,6 +180,7 @@ bool ProposingExecutor::ExecuteEvent(Idx event){
 
   // invalidate/re-schedule event states
   EventSet::Iterator eit;
+  mSimEvents.Detach();
   for(eit=mSimEvents.Begin(); eit!=mSimEvents.End(); ++eit) {
     SimEventAttribute* pattr= mSimEvents.Attributep(*eit);
     // stochastic only
@@ -318,6 +318,7 @@ SimConditionSet SimConditionSet::EnabledConditions(void) {
 // condition state: reset alls
 void SimConditionSet::Reset(void) {
   FD_DX("SimConditionSet::Reset()");
+  Detach();
   for(Iterator cit=Begin(); cit != End(); ++cit) {
     AttributeSimCondition* pattr=Attributep(*cit);
     pattr->Reset();
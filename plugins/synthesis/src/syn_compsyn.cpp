@@ -314,6 +314,45 @@ PART C: implementation of all of the above
 */
 
 
+// figure number of threads for the specified number of tasks
+static Idx comsyn_threads(std::size_t count) {
+  return TaskThreads(Context::Current()->Threads(),count);
+}
+
+// run independent tasks, see RunTasks()
+static void comsyn_schedule(std::size_t count, TaskFnct fnct, void* pData) {
+  FD_DF("ComSyn: schedule #" << count << " tasks");
+  RunTasks(comsyn_threads(count),count,fnct,pData);
+}
+
+// test whether a generator matches a copy taken earlier
+static bool comsyn_unchanged(const Generator& rGen, const Generator& rCopy) {
+  if(rGen.Alphabet()!=rCopy.Alphabet()) return false;
+  if(rGen.States()!=rCopy.States()) return false;
+  if(rGen.InitStates()!=rCopy.InitStates()) return false;
+  if(rGen.MarkedStates()!=rCopy.MarkedStates()) return false;
+  if(rGen.TransRel()!=rCopy.TransRel()) return false;
+  return true;
+}
+
+// preprocessing task: abstraction of one component, speculative w.r.t. the initial buffer
+typedef struct {
+  Generator mOrigGen;                      // component, own storage
+  EventSet mLocAlph;                       // local events, own storage
+  EventSet mConAlph;                       // controllable events, own storage
+  Generator mAbstGen;                      // result: abstraction
+  std::map<Idx,Idx> mMapStateToPartition;  // result: state map from mOrigGen to mAbstGen
+} comsyn_abstraction;
+
+// run preprocessing task
+static void comsyn_abstraction_task(void* pData, std::size_t worker, std::size_t task) {
+  (void) worker;
+  comsyn_abstraction& abst=(*((std::vector<comsyn_abstraction>*) pData))[task];
+  ComputeSynthObsEquiv(abst.mOrigGen, abst.mConAlph, abst.mLocAlph, abst.mMapStateToPartition, abst.mAbstGen);
+  LocalSelfloop(abst.mAbstGen, abst.mLocAlph);
+}
+
+
 // Constructor 
 ComSyn::ComSyn(const GeneratorVector& rPlantGenVec,
 	       const EventSet& rConAlph,
@@ -398,9 +437,27 @@ void ComSyn::Preprocess()
   // is replaced by two events[alias] (the second idx)
   std::map<Idx,std::vector<Idx> >  MapOldToNew;
 
-  // loop for GenVec 
+  // abstract all components w.r.t. the initial buffer as independent tasks; 
+  // the results are used below if they match the sequential procedure
+  std::vector<comsyn_abstraction> Abstractions;
+  if(comsyn_threads(GenVec.Size())>1) {
+    Abstractions.resize(GenVec.Size());
+    for(GeneratorVector::Position k = 0; k < GenVec.Size(); ++k) {
+      comsyn_abstraction& abst=Abstractions[k];
+      SetPartUnion(GenVec, k, RestAlph); 
+      SetDifference(GenVec.At(k).Alphabet(), RestAlph, LocAlph);
+      SetIntersection(GenVec.At(k).Alphabet(), GConAlph, ConAlph);
+      TaskCopy(LocAlph, abst.mLocAlph);
+      TaskCopy(ConAlph, abst.mConAlph);
+      TaskCopy(GenVec.At(k), abst.mOrigGen);
+    }
+    comsyn_schedule(Abstractions.size(), &comsyn_abstraction_task, &Abstractions);
+  }
+
+  // loop for GenVec, k refers to the initial position
   GeneratorVector::Position i = 0;
-  for(; i < GenVec.Size(); ++i) {
+  GeneratorVector::Position k = 0;
+  for(; i < GenVec.Size(); ++i, ++k) {
 
     // build related eventset
     // ****from class private ****
@@ -410,14 +467,26 @@ void ComSyn::Preprocess()
     // construct controllable alphabet of OrigGen
     SetIntersection(GenVec.At(i).Alphabet(), GConAlph, ConAlph);
 
-    //GenVec.At(i).Write();
-    // abstraction rule -> SOE 
+    // use speculative abstraction if the input still matches
+    if(k < Abstractions.size() && 
+       LocAlph == Abstractions[k].mLocAlph && ConAlph == Abstractions[k].mConAlph &&
+       comsyn_unchanged(GenVec.At(i), Abstractions[k].mOrigGen)) {
+      AbstGen = Abstractions[k].mAbstGen;
+      MapStateToPartition.swap(Abstractions[k].mMapStateToPartition);
+    }
+
+    else {
+
+      //GenVec.At(i).Write();
+      // abstraction rule -> SOE 
     
-    ComputeSynthObsEquiv(GenVec.At(i), ConAlph, LocAlph, MapStateToPartition, AbstGen);
-    //AbstGen.Write();
+      ComputeSynthObsEquiv(GenVec.At(i), ConAlph, LocAlph, MapStateToPartition, AbstGen);
+      //AbstGen.Write();
 
-    // abstraction rule -> remove local events if it hat only selfloop-transitions
-    LocalSelfloop(AbstGen, LocAlph);
+      // abstraction rule -> remove local events if it hat only selfloop-transitions
+      LocalSelfloop(AbstGen, LocAlph);
+
+    }
     
     // abstraction rule -> give up the AbstGen if it hat only one state
     if(AbstGen.Size() == 1) {
@@ -483,6 +552,8 @@ void ComSyn::Synthesis()
     // Step 1: Select subsystem and compose them, then remove subsystem from buffer    
     
     SelectSubsystem_V1(GenVec, OrigGen);
+    // allow for user interrupt, incl cancellation and limits
+    LoopCheck(OrigGen.Size());
     // set default state name of OrigGen
     OrigGen.SetDefaultStateNames();
     // test
@@ -707,7 +778,7 @@ void GlobalSelfloop(GeneratorVector& rGenVec){
       for(std::vector<GeneratorVector::Position>::iterator vit = PsubGens.begin(); vit != PsubGens.end(); ++vit){
 	for(TransSet::Iterator tit = rGenVec.At(*vit).TransRelBegin(); tit != rGenVec.At(*vit).TransRelEnd(); ){
 	  if((*eit == tit->Ev) && (tit->X1 == tit->X2))
-	    rGenVec.At(*vit).ClrTransition(tit++); // tmoor 201602
+	    tit=rGenVec.At(*vit).ClrTransition(tit); // tmoor 201602
           else
             ++tit;
 	}//end inner for
@@ -973,37 +1044,6 @@ void Splitter(const std::map<Idx, std::vector<Idx> >& rMapOldToNew,
 ////////////////////////////////////////////////////////////////
 
 
-// make class as predicate for passing more parameters in STL algorithm
-class SmallSize {
-
-private:
-  const GeneratorVector& rGenVec;
-
-public:
-  SmallSize(const GeneratorVector& rGenVec):
-    rGenVec(rGenVec) {}
-
-  bool operator()(const std::vector<GeneratorVector::Position> rPosVec1,
-		  const std::vector<GeneratorVector::Position> rPosVec2) {
-
-    Generator Gen1;
-    GeneratorVector GenVec1;
-    std::vector<GeneratorVector::Position>::const_iterator vit1;
-    vit1 = rPosVec1.begin();
-    for(; vit1 != rPosVec1.end(); ++vit1) GenVec1.PushBack(rGenVec.At(*vit1));
-    aParallel(GenVec1, Gen1);
-
-    Generator Gen2;
-    GeneratorVector GenVec2;
-    std::vector<GeneratorVector::Position>::const_iterator vit2;
-    vit2 = rPosVec2.begin();
-    for(; vit2 != rPosVec2.end(); ++vit2) GenVec2.PushBack(rGenVec.At(*vit2));
-    aParallel(GenVec2, Gen2);
-
-    return Gen1.Size() < Gen2.Size();
-  }
-};
-
 ////////////////
 // select_V1
 // MustL + MinS
@@ -1029,6 +1069,45 @@ bool BiggerMax(std::vector<GeneratorVector::Position>& rCandidate,
   
 }
 
+// scoring task: size of the composition of a candidate subsystem
+typedef struct {
+  GeneratorVector mGenVec;  // components, own storage
+  bool mLimit;              // give up when the composition exceeds the limit, see BiggerMax
+  bool mBigger;             // result: composition exceeds the limit
+  Idx mSize;                // result: number of states of the composition
+} comsyn_score;
+
+// set up scoring task
+static void comsyn_score_prepare(comsyn_score& rScore, 
+			  const GeneratorVector& rGenVec,
+			  const std::vector<GeneratorVector::Position>& rCandidate,
+			  bool limit) {
+  rScore.mGenVec.Clear();
+  std::vector<GeneratorVector::Position>::const_iterator vit=rCandidate.begin();
+  for(; vit != rCandidate.end(); ++vit) {
+    rScore.mGenVec.PushBack(Generator());
+    TaskCopy(rGenVec.At(*vit), rScore.mGenVec.At(rScore.mGenVec.Size()-1));
+  }
+  rScore.mLimit=limit;
+  rScore.mBigger=false;
+  rScore.mSize=0;
+}
+
+// run scoring task
+static void comsyn_score_task(void* pData, std::size_t worker, std::size_t task) {
+  (void) worker;
+  comsyn_score& score=(*((std::vector<comsyn_score>*) pData))[task];
+  if(score.mLimit) {
+    std::vector<GeneratorVector::Position> all;
+    for(GeneratorVector::Position i = 0; i < score.mGenVec.Size(); ++i) all.push_back(i);
+    score.mBigger=BiggerMax(all, score.mGenVec);
+    if(score.mBigger) return;
+  }
+  Generator gen;
+  aParallel(score.mGenVec, gen);
+  score.mSize=gen.Size();
+}
+
 void SelectSubsystem_V1(GeneratorVector& rGenVec,
 			Generator& rResGen) {
   
@@ -1056,20 +1135,46 @@ void SelectSubsystem_V1(GeneratorVector& rGenVec,
     for(; i < rGenVec.Size(); ++i)
       if(rGenVec.At(i).ExistsEvent(*eit)) Candidate.push_back(i);
     if(Candidate.size() == 1) continue;
-    // give up the candidate which is bigger than MAX
-    if(BiggerMax(Candidate, rGenVec)) continue;
     Candidates.push_back(Candidate);
   }
 
   // step 2 is expensive, because of composing for large automaton
   // before the step2 firstly test the size of every candidate !! 
-  // give up which is bigger than a given size 
-  // 
+  // give up which is bigger than a given size;
+  // candidates are scored as independent tasks 
+  std::vector<comsyn_score> Scores(Candidates.size());
+  for(std::size_t c = 0; c < Candidates.size(); ++c)
+    comsyn_score_prepare(Scores[c], rGenVec, Candidates[c], true);
+  comsyn_schedule(Scores.size(), &comsyn_score_task, &Scores);
+
+  // Step 2: find the target, i.e., the first smallest candidate within the limit 
+  std::size_t Target = Candidates.size();
+  for(std::size_t c = 0; c < Candidates.size(); ++c) {
+    if(Scores[c].mBigger) continue;
+    if(Target == Candidates.size() || Scores[c].mSize < Scores[Target].mSize) Target = c;
+  }
 
-  // Step 2: find the target
-  std::vector<std::vector<GeneratorVector::Position> >::iterator PosTarget;
-  PosTarget = std::min_element(Candidates.begin(), Candidates.end(),
-			    SmallSize(rGenVec));
+  // fallback: no shared events at all, so compose the first two components
+  if(Candidates.empty()) {
+    Candidate.clear();
+    Candidate.push_back(0);
+    Candidate.push_back(1);
+    Candidates.push_back(Candidate);
+    Scores.resize(1);
+    Scores[0].mBigger=false;
+    Target = 0;
+  }
+
+  // fallback: all candidates exceed the limit, so consider them all
+  if(Target == Candidates.size()) {
+    for(std::size_t c = 0; c < Candidates.size(); ++c)
+      comsyn_score_prepare(Scores[c], rGenVec, Candidates[c], false);
+    comsyn_schedule(Scores.size(), &comsyn_score_task, &Scores);
+    Target = 0;
+    for(std::size_t c = 1; c < Candidates.size(); ++c) 
+      if(Scores[c].mSize < Scores[Target].mSize) Target = c;
+  }
+  std::vector<std::vector<GeneratorVector::Position> >::iterator PosTarget = Candidates.begin() + Target;
 
   // *parallel composition 
 
@@ -1097,6 +1202,22 @@ void SelectSubsystem_V1(GeneratorVector& rGenVec,
 // MaxC + MinS
 ////////////////
 
+// score pairs of components as independent tasks, record number of states of the composition
+static void comsyn_score_pairs(const GeneratorVector& rGenVec,
+			const std::vector< std::pair<GeneratorVector::Position,GeneratorVector::Position> >& rPairs,
+			std::map< std::pair<GeneratorVector::Position,GeneratorVector::Position>, Idx>& rSizes) {
+  std::vector<comsyn_score> scores(rPairs.size());
+  std::vector<GeneratorVector::Position> candidate(2);
+  for(std::size_t c = 0; c < rPairs.size(); ++c) {
+    candidate[0] = rPairs[c].first;
+    candidate[1] = rPairs[c].second;
+    comsyn_score_prepare(scores[c], rGenVec, candidate, false);
+  }
+  comsyn_schedule(scores.size(), &comsyn_score_task, &scores);
+  for(std::size_t c = 0; c < rPairs.size(); ++c) 
+    rSizes[rPairs[c]] = scores[c].mSize;
+}
+
 void SelectSubsystem_V2(GeneratorVector& rGenVec,
 			Generator& rResGen) {
 
@@ -1113,6 +1234,7 @@ void SelectSubsystem_V2(GeneratorVector& rGenVec,
   // helpers 
   std::vector<GeneratorVector::Position> candidate;
   std::vector<std::vector<GeneratorVector::Position> > candidates;
+  std::vector<std::vector<GeneratorVector::Position> > ties;
 
   Idx maxsize;
   GeneratorVector::Position pos;
@@ -1124,28 +1246,32 @@ void SelectSubsystem_V2(GeneratorVector& rGenVec,
     // component 1
     const EventSet& alph1 = rGenVec.At(i).Alphabet();
 
-    // determine component 2
-    SetIntersection(alph1, rGenVec.At(i+1).Alphabet(), alph);
-    pos = i+1;
-    maxsize = alph.Size();
-    // loop from i+2 
-    GeneratorVector::Position j = i+2;
+    // determine components 2 with "MaxC": maximal common event
+    ties.push_back(std::vector<GeneratorVector::Position>());
+    maxsize = 0;
+    GeneratorVector::Position j = i+1;
     for(; j < rGenVec.Size(); ++j) {
       // setintersection
       SetIntersection(alph1, rGenVec.At(j).Alphabet(), alph);
-      // "MaxC": maximal common event
-      if(alph.Size() > maxsize) {pos = j; maxsize = alph.Size();}
-      else if(alph.Size() == maxsize) {
-	Generator g_pos;
-	Generator g_j;
-	Parallel(rGenVec.At(i), rGenVec.At(pos), g_pos);
-	Parallel(rGenVec.At(i), rGenVec.At(j), g_j);
-	// choose "MinS" if the number of common events is same
-	// or choose others: "MaxL"
-	if(g_j.Size() < g_pos.Size()) {pos = j; maxsize = alph.Size();}
-      }
+      if(j == i+1 || alph.Size() > maxsize) {ties.back().clear(); maxsize = alph.Size();}
+      if(alph.Size() == maxsize) ties.back().push_back(j);
     }
+  }
 
+  // choose "MinS" if the number of common events is same
+  // or choose others: "MaxL"
+  std::map< std::pair<GeneratorVector::Position,GeneratorVector::Position>, Idx> sizes;
+  std::vector< std::pair<GeneratorVector::Position,GeneratorVector::Position> > pairs;
+  for(i = 0; i < ties.size(); ++i) {
+    if(ties[i].size() < 2) continue;
+    for(std::size_t t = 0; t < ties[i].size(); ++t) 
+      pairs.push_back(std::make_pair(i,ties[i][t]));
+  }
+  comsyn_score_pairs(rGenVec, pairs, sizes);
+  for(i = 0; i < ties.size(); ++i) {
+    pos = ties[i].front();
+    for(std::size_t t = 1; t < ties[i].size(); ++t) 
+      if(sizes[std::make_pair(i,ties[i][t])] < sizes[std::make_pair(i,pos)]) pos = ties[i][t];
     // save as a candidate in candidates
     candidate.clear();
     candidate.push_back(i);
@@ -1153,10 +1279,18 @@ void SelectSubsystem_V2(GeneratorVector& rGenVec,
     candidates.push_back(candidate);
   }
 
-  // step 2: pick out the best candidate
-  std::vector<std::vector<GeneratorVector::Position> >::iterator PosTarget;
-  PosTarget = std::min_element(candidates.begin(), candidates.end(),
-			    SmallSize(rGenVec));
+  // score remaining candidates
+  pairs.clear();
+  for(i = 0; i < ties.size(); ++i) 
+    if(ties[i].size() < 2) pairs.push_back(std::make_pair(i,ties[i].front()));
+  comsyn_score_pairs(rGenVec, pairs, sizes);
+
+  // step 2: pick out the best candidate, i.e., the first smallest
+  std::vector<std::vector<GeneratorVector::Position> >::iterator PosTarget = candidates.begin();
+  std::vector<std::vector<GeneratorVector::Position> >::iterator cit = candidates.begin();
+  for(; cit != candidates.end(); ++cit)
+    if(sizes[std::make_pair(cit->at(0),cit->at(1))] < sizes[std::make_pair(PosTarget->at(0),PosTarget->at(1))]) 
+      PosTarget = cit;
 
   // *parallel composition 
   Parallel(rGenVec.At(PosTarget->at(0)), rGenVec.At(PosTarget->at(1)), rResGen);
@@ -1201,7 +1335,9 @@ void H_tocollect(StateSet& rBlockingstates,
   TransSetX2EvX1::Iterator tit;
   TransSetX2EvX1::Iterator tit_end;
   //loop
+  Idx lcnt=0;
   while(!todo.empty()){
+    FD_LOOP(lcnt,0);
     //pop
     x2 = todo.top();
     todo.pop();
@@ -1263,6 +1399,7 @@ void ComputeHSupCon(const Generator& rOrigGen,
 
   //loop until no more blockingstates 
   while(!blockingstates.Empty()){
+    LoopCallback();
     //collect more blockingstates and transition relation which need to be redirected
     H_tocollect(blockingstates, itrel, louc, shuc, toredirect);    //to implement
     //delete blockingstates
@@ -41,6 +41,13 @@ namespace faudes {
  * throughs an exception on invalid input data; see also 
  * CompositionalSynthesisUnchecked(const GeneratorVector&,const EventSet&,const GeneratorVector&,std::map<Idx,Idx>&,GeneratorVector&,GeneratorVector&);
  * 
+ * When libFAUDES is configured with the option core_threads, independent tasks are
+ * run concurrently by the number of threads specified by the current Context, see Context::Threads(),
+ * i.e., the abstraction of the individual components in the preprocessing stage and the scoring of
+ * candidate subsystems when selecting the next subsystem to compose. Abstractions are computed
+ * speculatively w.r.t. the initial components and are only used if the sequential procedure would
+ * have computed the very same abstraction. Results are merged in the order of the sequential
+ * procedure and, thus, do not depend on the number of threads.
  *
  * @param rPlantGenVec
  *   Plant components (must be deterministic)
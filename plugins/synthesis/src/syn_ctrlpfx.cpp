@@ -25,6 +25,148 @@
 
 namespace faudes {
 
+/*  
+*********************************************************************
+
+Implementation of dense state sets
+
+*********************************************************************    
+*/
+
+// bit count, portable fallback
+static inline Idx dss_popcount(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (Idx) __builtin_popcountll(w);
+#else
+  Idx cnt=0;
+  while(w) { w &= w-1; ++cnt; }
+  return cnt;
+#endif
+}
+
+// index of lowest set bit (w must not be zero), portable fallback
+static inline Idx dss_lowbit(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (Idx) __builtin_ctzll(w);
+#else
+  Idx pos=0;
+  while(!(w & 1)) { w >>= 1; ++pos; }
+  return pos;
+#endif
+}
+
+// full range
+void DenseStateSet::Fill(void) {
+  std::size_t n=mWords.size();
+  for(std::size_t i=0; i<n; ++i) mWords[i]=~uint64_t(0);
+  // mask out index 0 and indices beyond range
+  mWords[0] &= ~uint64_t(1);
+  Idx tail= (mMaxIndex & 63) + 1;
+  if(tail<64) mWords[n-1] &= (uint64_t(1) << tail) - 1;
+}
+
+// count elements
+Idx DenseStateSet::Size(void) const {
+  Idx cnt=0;
+  std::size_t n=mWords.size();
+  for(std::size_t i=0; i<n; ++i) cnt+=dss_popcount(mWords[i]);
+  return cnt;
+}
+
+// test empty
+bool DenseStateSet::Empty(void) const {
+  std::size_t n=mWords.size();
+  for(std::size_t i=0; i<n; ++i) 
+    if(mWords[i]) return false;
+  return true;
+}
+
+// iterate
+Idx DenseStateSet::Next(Idx x) const {
+  ++x;
+  if(x>mMaxIndex) return 0;
+  std::size_t i=x>>6;
+  uint64_t w=mWords[i] & (~uint64_t(0) << (x&63));
+  while(!w) {
+    if(++i>=mWords.size()) return 0;
+    w=mWords[i];
+  }
+  return (Idx) (i<<6) + dss_lowbit(w);
+}
+
+// union
+void DenseStateSet::InsertSet(const DenseStateSet& rOther) {
+  uint64_t* dst=&mWords[0];
+  const uint64_t* src=&rOther.mWords[0];
+  std::size_t n=mWords.size();
+  for(std::size_t i=0; i<n; ++i) dst[i] |= src[i];
+}
+
+// intersection
+void DenseStateSet::RestrictSet(const DenseStateSet& rOther) {
+  uint64_t* dst=&mWords[0];
+  const uint64_t* src=&rOther.mWords[0];
+  std::size_t n=mWords.size();
+  for(std::size_t i=0; i<n; ++i) dst[i] &= src[i];
+}
+
+// difference
+void DenseStateSet::EraseSet(const DenseStateSet& rOther) {
+  uint64_t* dst=&mWords[0];
+  const uint64_t* src=&rOther.mWords[0];
+  std::size_t n=mWords.size();
+  for(std::size_t i=0; i<n; ++i) dst[i] &= ~src[i];
+}
+
+// test for 1,2,...n
+bool DenseStateSet::Consecutive(const StateSet& rStates) {
+  if(rStates.Empty()) return true;
+  return rStates.MaxIndex()==rStates.Size();
+}
+
+// convert by identity
+void DenseStateSet::FromStateSet(const StateSet& rStates) {
+  Clear();
+  StateSet::Iterator sit=rStates.Begin();
+  StateSet::Iterator sit_end=rStates.End();
+  for(;sit!=sit_end;++sit) {
+#ifdef FAUDES_CHECKED
+    if(*sit>mMaxIndex) {
+      std::stringstream errstr;
+      errstr << "state index " << *sit << " out of range #" << mMaxIndex;
+      throw Exception("DenseStateSet::FromStateSet", errstr.str(), 80);
+    }
+#endif
+    Insert(*sit);
+  }
+}
+
+// convert by identity
+void DenseStateSet::ToStateSet(StateSet& rStates) const {
+  rStates.Clear();
+  for(Idx x=Next(0); x!=0; x=Next(x))
+    rStates.Insert(x);
+}
+
+// convert via compiled generator
+void DenseStateSet::FromStateSet(const StateSet& rStates, const CompiledGenerator& rCGen) {
+  Resize(rCGen.Size());
+  StateSet::Iterator sit=rStates.Begin();
+  StateSet::Iterator sit_end=rStates.End();
+  for(;sit!=sit_end;++sit) {
+    Idx q=rCGen.StateIndex(*sit);
+    if(q!=0) Insert(q);
+  }
+}
+
+// convert via compiled generator
+void DenseStateSet::ToStateSet(StateSet& rStates, const CompiledGenerator& rCGen) const {
+  rStates.Clear();
+  for(Idx q=Next(0); q!=0; q=Next(q))
+    rStates.Insert(rCGen.State(q));
+}
+
+
 /*  
 *********************************************************************
 
@@ -39,6 +181,11 @@ const StateSet&  StateSetOperator::Domain(void) const {
   return empty;
 }
 
+// no dense domain
+const CompiledGenerator* StateSetOperator::DenseDomain(void) const {
+  return NULL;
+}
+
 // API wrapper, multiple arguments  
 void StateSetOperator::Evaluate(StateSetVector& rArgs, StateSet& rRes) const {
   if(rArgs.Size()!=mArgCount) {
@@ -75,6 +222,36 @@ void StateSetOperator::Evaluate(StateSet& rRes) const {
   const_cast<StateSetOperator*>(this)->DoEvaluate(args,rRes); 
 }
 
+// API wrapper, dense arguments
+void StateSetOperator::Evaluate(DenseStateSetVector& rArgs, DenseStateSet& rRes) const {
+  if(rArgs.size()!=mArgCount) {
+    std::stringstream errstr;
+    errstr << "signature mismatch: expected arguments #" << mArgCount <<
+      " provided argumenst #" << rArgs.size();
+    throw Exception("StateSetOperator::Evaluate", errstr.str(), 80);
+  }
+  const_cast<StateSetOperator*>(this)->DoEvaluateDense(rArgs,rRes); 
+}
+
+// dense evaluation by conversion (fallback)
+void StateSetOperator::DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
+  const CompiledGenerator* cgen=DenseDomain();
+  if(!cgen) {
+    std::stringstream errstr;
+    errstr << "operator \"" << Name() << "\" does not support dense evaluation";
+    throw Exception("StateSetOperator::Evaluate", errstr.str(), 80);
+  }
+  std::vector<StateSet> args(rArgs.size());
+  StateSetVector argrefs;
+  for(std::size_t pos=0; pos<rArgs.size(); ++pos) {
+    rArgs[pos]->ToStateSet(args[pos],*cgen);
+    argrefs.PushBack(&args[pos]);
+  }
+  StateSet res;
+  DoEvaluate(argrefs,res);
+  rRes.FromStateSet(res,*cgen);
+}
+
 // signature, i.e., the number of arguments */
 StateSetVector::Position StateSetOperator::ArgCount(void) const {
   return mArgCount;
@@ -96,6 +273,15 @@ std::string StateSetOperator::ArgStatistics(const StateSetVector& rArgs) const {
   return res.str();
 }
 
+// stats  
+std::string StateSetOperator::ArgStatistics(const DenseStateSetVector& rArgs) const {
+  std::stringstream res;
+  for(std::size_t pos=0; pos< rArgs.size(); ++pos) {
+    res << " " << ArgName(pos) << " #" << rArgs[pos]->Size();
+  }
+  return res.str();
+}
+
 // indentation for nested iterations
 const std::string& StateSetOperator::Indent(void) const {
   return mIndent;
@@ -122,13 +308,18 @@ CtrlPfxOperator::CtrlPfxOperator(const vGenerator& rGenerator, const EventSet& r
   rGen(rGenerator),
   mSigmaCtrl(rSigmaCtrl),
   rTransRel(rGen.TransRel()),
-  mRevTransRel(rGen.TransRel())
+  mCGen(rGenerator)
 {
   FD_DF("CtrlPfxOperator(): instantiated from " << mrGen.Name());
   rGen.SWrite();
   Name("cpx_op([Y,X])");
   mArgNames= std::vector<std::string>{"Y","X"};
   mArgCount=2;
+  // prepare dense evaluation
+  mCtrlFlags.assign(mCGen.AlphabetSize()+1,false);
+  for(Idx e=1; e<=mCGen.AlphabetSize(); ++e)
+    mCtrlFlags[e]=mSigmaCtrl.Exists(mCGen.Event(e));
+  mMarked.FromStateSet(rGen.MarkedStates(),mCGen);
 };
 
 // domain
@@ -136,51 +327,49 @@ const StateSet& CtrlPfxOperator::Domain(void) const {
   return rGen.States();
 }  
 
-// evaluation
+// dense domain
+const CompiledGenerator* CtrlPfxOperator::DenseDomain(void) const {
+  return &mCGen;
+}  
+
+// evaluation (convert at API boundary)
 void CtrlPfxOperator::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
   FD_DF("CtrlPfxOperator::DoEvaluate(): " << Name());
-  // prepare result
-  rRes.Clear();
+  mY.FromStateSet(rArgs.At(0),mCGen);
+  mX.FromStateSet(rArgs.At(1),mCGen);
+  DenseStateSetVector args{&mY,&mX};
+  DoEvaluateDense(args,mR);
+  mR.ToStateSet(rRes,mCGen);
+}
+
+// evaluation
+void CtrlPfxOperator::DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
   // have neat accessors
-  StateSet& Y=rArgs.At(0);
-  StateSet& X=rArgs.At(1);
-  //FD_DF("CtrlPfxOperator::DoEvaluate(): Y " << rGen.StateSetToString(Y));
-  //FD_DF("CtrlPfxOperator::DoEvaluate(): X " << rGen.StateSetToString(X));
+  const DenseStateSet& Y=*rArgs[0];
+  const DenseStateSet& X=*rArgs[1];
+  // prepare result
+  rRes.Resize(mCGen.Size());
 
   // actual implementation comes here, aka
   // eval([Y,X]) =
   //   (pre_exisntial(X) union marked_states) intersectted with  pre_universal(Y)
-
-  /*
-  // variant 1: by the book  
-  StateSet lhs;
-  lhs.Copy(mRevTransRel.PredecessorStates(X));
-  lhs.InsertSet(rGen.MarkedStates());
-  StateSet rhs;
-  StateSet Ycmp= rGen.States() - Y;
-  rhs.Copy(rGen.States());
-  rhs.EraseSet(mRevTransRel.PredecessorStates(Ycmp,mSigmaUc) );
-  rRes=lhs * rhs;
-  */
-  
-  // variant 2: perhaps gain some performance
-  rRes.Copy(mRevTransRel.PredecessorStates(X));
-  rRes.InsertSet(rGen.MarkedStates());
-  StateSet::Iterator sit=rRes.Begin();
-  StateSet::Iterator sit_end=rRes.End();
-  while(sit!=sit_end){
-    TransSet::Iterator tit=rTransRel.Begin(*sit);
-    TransSet::Iterator tit_end=rTransRel.End(*sit);
-    for(;tit!=tit_end;++tit){
-      if(mSigmaCtrl.Exists(tit->Ev)) continue;
-      if(Y.Exists(tit->X2)) continue;
+  Idx q;
+  for(q=X.Next(0); q!=0; q=X.Next(q)) {
+    CompiledGenerator::Iterator eit=mCGen.PredBegin(q);
+    CompiledGenerator::Iterator eit_end=mCGen.PredEnd(q);
+    for(;eit!=eit_end;++eit) rRes.Insert(eit->X);
+  }
+  rRes.InsertSet(mMarked);
+  for(q=rRes.Next(0); q!=0; q=rRes.Next(q)) {
+    CompiledGenerator::Iterator eit=mCGen.SuccBegin(q);
+    CompiledGenerator::Iterator eit_end=mCGen.SuccEnd(q);
+    for(;eit!=eit_end;++eit){
+      if(mCtrlFlags[eit->Ev]) continue;
+      if(Y.Exists(eit->X)) continue;
       break;
     }  
-    if(tit!=tit_end) rRes.Erase(sit++);
-    else++sit;
+    if(eit!=eit_end) rRes.Erase(q);
   }
-  
-  //FD_DF("CtrlPfxOperator::DoEvaluate(): R " << rGen.StateSetToString(rRes));
 };
   
 
@@ -223,8 +412,27 @@ const StateSet& MuIteration::Domain(void) const {
   return mrOp.Domain();
 }  
 
+// inherit dense domain
+const CompiledGenerator* MuIteration::DenseDomain(void) const {
+  return mrOp.DenseDomain();
+}  
+
 // evaluation
 void MuIteration::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  // dense operator: convert once at the API boundary
+  const CompiledGenerator* cgen=DenseDomain();
+  if(cgen) {
+    std::vector<DenseStateSet> dargs(rArgs.Size());
+    DenseStateSetVector dargrefs;
+    for(StateSetVector::Position pos=0; pos<rArgs.Size(); ++pos) {
+      dargs[pos].FromStateSet(rArgs.At(pos),*cgen);
+      dargrefs.push_back(&dargs[pos]);
+    }
+    DenseStateSet dres;
+    DoEvaluateDense(dargrefs,dres);
+    dres.ToStateSet(rRes,*cgen);
+    return;
+  }
   // prepare progress message
   std::string prog;
   if(Verbosity()>=10) {
@@ -239,6 +447,7 @@ void MuIteration::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
   xargs.PushBack(&rRes);
   StateSet R;
   while(true) {
+    LoopCallback();
     Idx xsz=rRes.Size();
     mrOp.Evaluate(xargs,R);
     FD_DF("MuIteration::DoEvaluate(): " << Indent() << xsz << "# -> #" << R.Size());
@@ -253,6 +462,41 @@ void MuIteration::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
   }
 };
 
+// evaluation on dense state sets
+void MuIteration::DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
+  const CompiledGenerator* cgen=DenseDomain();
+  if(!cgen) {
+    StateSetOperator::DoEvaluateDense(rArgs,rRes);
+    return;
+  }
+  // prepare progress message
+  std::string prog;
+  if(Verbosity()>=10) {
+    prog="MuIteration::DoEvaluate(): " + Indent() + Name() + ": " + ArgStatistics(rArgs);
+    FAUDES_WRITE_CONSOLE("FAUDES_MUNU:  " << prog);
+  }
+  // prepare result
+  rRes.Resize(cgen->Size());
+  // actual implementation comes here
+  DenseStateSetVector xargs(rArgs);
+  xargs.push_back(&rRes);
+  DenseStateSet R;
+  while(true) {
+    LoopCallback();
+    Idx xsz=rRes.Size();
+    mrOp.Evaluate(xargs,R);
+    FD_DF("MuIteration::DoEvaluate(): " << Indent() << xsz << "# -> #" << R.Size());
+    rRes=R;
+    if(rRes.Size()==xsz) break;  
+    FD_WPC(1,2,prog);
+  }
+  // say goodby
+  if(Verbosity()>=10) {
+    prog=prog + " -> " + mrOp.ArgName(mrOp.ArgCount()-1) + " #" + faudes::ToStringInteger(rRes.Size());
+    FAUDES_WRITE_CONSOLE("FAUDES_MUNU:  " << prog);
+  }
+};
+
 
 // evaluation incl rank (there are more clever wayz to implement this ...)
 void MuIteration::Rank(StateSetVector& rArgs, std::map<Idx,int>& rRMap) const {
@@ -271,6 +515,39 @@ void MuIteration::Rank(StateSetVector& rArgs, std::map<Idx,int>& rRMap) const {
   }
   // prepare result
   rRMap.clear();
+  // dense operator: convert once and iterate on dense state sets
+  const CompiledGenerator* cgen=DenseDomain();
+  if(cgen) {
+    std::vector<DenseStateSet> dargs(rArgs.Size());
+    DenseStateSetVector xargs;
+    for(StateSetVector::Position pos=0; pos<rArgs.Size(); ++pos) {
+      dargs[pos].FromStateSet(rArgs.At(pos),*cgen);
+      xargs.push_back(&dargs[pos]);
+    }
+    DenseStateSet res(cgen->Size());
+    xargs.push_back(&res);
+    DenseStateSet R;
+    DenseStateSet N;
+    int rank=0;
+    while(true) {
+      LoopCallback();
+      mrOp.Evaluate(xargs,R);
+      N=R;
+      N.EraseSet(res);
+      FD_DF("MuIteration::DoEvaluate(): " << Indent() << res.Size() << "# -> #" << R.Size());
+      res=R;
+      if(N.Empty()) break;
+      for(Idx q=N.Next(0); q!=0; q=N.Next(q))
+        rRMap[cgen->State(q)]=rank;
+      ++rank;
+      FD_WPC(1,2,prog);
+    }
+    if(Verbosity()>=10) {
+      prog=prog + " -> " + mrOp.ArgName(mrOp.ArgCount()-1) + " #" + faudes::ToStringInteger(res.Size());
+      FAUDES_WRITE_CONSOLE("FAUDES_MUNU:  " << prog);
+    }
+    return;
+  }
   StateSet res;
   // actual implementation comes here
   StateSetVector xargs;
@@ -281,6 +558,7 @@ void MuIteration::Rank(StateSetVector& rArgs, std::map<Idx,int>& rRMap) const {
   StateSet::Iterator sit;
   int rank=0;
   while(true) {
+    LoopCallback();
     mrOp.Evaluate(xargs,R);
     N=R-res;
     FD_DF("MuIteration::DoEvaluate(): " << Indent() << res.size() << "# -> #" << R.Size());
@@ -349,8 +627,27 @@ const StateSet& NuIteration::Domain(void) const {
   return mrOp.Domain();
 }  
 
+// inherit dense domain
+const CompiledGenerator* NuIteration::DenseDomain(void) const {
+  return mrOp.DenseDomain();
+}  
+
 // evaluation
 void NuIteration::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
+  // dense operator: convert once at the API boundary
+  const CompiledGenerator* cgen=DenseDomain();
+  if(cgen) {
+    std::vector<DenseStateSet> dargs(rArgs.Size());
+    DenseStateSetVector dargrefs;
+    for(StateSetVector::Position pos=0; pos<rArgs.Size(); ++pos) {
+      dargs[pos].FromStateSet(rArgs.At(pos),*cgen);
+      dargrefs.push_back(&dargs[pos]);
+    }
+    DenseStateSet dres;
+    DoEvaluateDense(dargrefs,dres);
+    dres.ToStateSet(rRes,*cgen);
+    return;
+  }
   // prepare progress message
   std::string prog;
   if(Verbosity()>=10) {
@@ -366,6 +663,7 @@ void NuIteration::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
   rRes=Domain();
   StateSet R;
   while(true) {
+    LoopCallback();
     Idx xsz=rRes.Size();
     mrOp.Evaluate(xargs,R);
     FD_DF("NuIteration::DoEvaluate(): " << Indent() << xsz << "# -> #" << R.Size());
@@ -380,6 +678,42 @@ void NuIteration::DoEvaluate(StateSetVector& rArgs, StateSet& rRes) {
   }
 };
 
+// evaluation on dense state sets
+void NuIteration::DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes) {
+  const CompiledGenerator* cgen=DenseDomain();
+  if(!cgen) {
+    StateSetOperator::DoEvaluateDense(rArgs,rRes);
+    return;
+  }
+  // prepare progress message
+  std::string prog;
+  if(Verbosity()>=10) {
+    prog="NuIteration::DoEvaluate(): " + Indent() + Name() + ": " + ArgStatistics(rArgs);
+    FAUDES_WRITE_CONSOLE("FAUDES_MUNU:  " << prog);
+  }
+  // prepare result
+  rRes.Resize(cgen->Size());
+  rRes.Fill();
+  // actual implementation comes here
+  DenseStateSetVector xargs(rArgs);
+  xargs.push_back(&rRes);
+  DenseStateSet R;
+  while(true) {
+    LoopCallback();
+    Idx xsz=rRes.Size();
+    mrOp.Evaluate(xargs,R);
+    FD_DF("NuIteration::DoEvaluate(): " << Indent() << xsz << "# -> #" << R.Size());
+    rRes=R;
+    if(rRes.Size()==xsz) break;  
+    FD_WPC(1,2,prog);
+  }
+  // say goodby
+  if(Verbosity()>=10) {
+    prog=prog + " -> " + mrOp.ArgName(mrOp.ArgCount()-1) + " #" + faudes::ToStringInteger(rRes.Size());
+    FAUDES_WRITE_CONSOLE("FAUDES_MUNU:  " << prog);
+  }
+};
+
 } // namespace faudes
 
 
@@ -28,6 +28,83 @@
 namespace faudes {
     
 
+/**
+ * Dense state set.
+ *
+ * Bitset representation of a set of states with indices in the range 1 to MaxIndex(), 
+ * to be used within fixpoint iterations. Boolean operations are performed word-wise
+ * on 64-bit words, which compilers map to SIMD instructions, and Exists() is a plain
+ * bit test. This is significantly faster than StateSet for the dense iterates typical for
+ * mu/nu-calculus, but requires memory proportional to MaxIndex().
+ *
+ * Conversion to and from StateSet is provided for the API boundary, either by identity,
+ * i.e. when state indices are consecutive, or via the internal indices of a 
+ * CompiledGenerator. Operations on two DenseStateSets require the same MaxIndex().
+ *
+ * @ingroup SynthesisPlugIn
+ */
+class FAUDES_API DenseStateSet {
+public:
+  /** construct empty with MaxIndex 0 */
+  DenseStateSet(void) : mMaxIndex(0) {};
+  /** construct empty with specified MaxIndex */
+  explicit DenseStateSet(Idx maxidx) { Resize(maxidx); };
+  /** set range of indices and clear */
+  void Resize(Idx maxidx) { mMaxIndex=maxidx; mWords.assign((maxidx>>6)+1,0); };
+  /** max index  */
+  Idx MaxIndex(void) const { return mMaxIndex; };
+  /** clear */
+  void Clear(void) { std::fill(mWords.begin(),mWords.end(),0); };
+  /** set to the full range 1..MaxIndex() */
+  void Fill(void);
+  /** test membership */
+  bool Exists(Idx x) const { return (mWords[x>>6] >> (x&63)) & 1; };
+  /** insert element */
+  void Insert(Idx x) { mWords[x>>6] |= (uint64_t(1) << (x&63)); };
+  /** erase element */
+  void Erase(Idx x) { mWords[x>>6] &= ~(uint64_t(1) << (x&63)); };
+  /** number of elements */
+  Idx Size(void) const;
+  /** test for empty set */
+  bool Empty(void) const;
+  /** smallest element greater than x, or 0 if none (use x=0 to start) */
+  Idx Next(Idx x) const;
+  /** set union */
+  void InsertSet(const DenseStateSet& rOther);
+  /** set intersection */
+  void RestrictSet(const DenseStateSet& rOther);
+  /** set difference */
+  void EraseSet(const DenseStateSet& rOther);
+  /** test equality */
+  bool Equal(const DenseStateSet& rOther) const { return mWords==rOther.mWords; };
+  /** test equality */
+  bool operator==(const DenseStateSet& rOther) const { return Equal(rOther); };
+  /** test inequality */
+  bool operator!=(const DenseStateSet& rOther) const { return !Equal(rOther); };
+  /** 
+   * test whether a state set has consecutive indices 1,2,...,n, i.e., whether
+   * it can be converted by identity
+   */
+  static bool Consecutive(const StateSet& rStates);
+  /** convert from state set by identity (all elements must be within range) */
+  void FromStateSet(const StateSet& rStates);
+  /** convert to state set by identity */
+  void ToStateSet(StateSet& rStates) const;
+  /** convert from state set of compiled generator (other elements are ignored; resizes) */
+  void FromStateSet(const StateSet& rStates, const CompiledGenerator& rCGen);
+  /** convert to state set of compiled generator */
+  void ToStateSet(StateSet& rStates, const CompiledGenerator& rCGen) const;
+protected:
+  /** range */
+  Idx mMaxIndex;
+  /** bits, bit x representing state x */
+  std::vector<uint64_t> mWords;
+};
+
+/** vector of references to dense state sets, used as arguments of StateSetOperator */
+typedef std::vector<DenseStateSet*> DenseStateSetVector;
+
+
 /**
  * Operator on state sets
  *
@@ -61,6 +138,19 @@ public:
    **/
   virtual const StateSet&  Domain(void) const;
 
+  /**
+   * Dense domain
+   *
+   * Operators that can evaluate on dense state sets report the compiled
+   * generator by which state indices are mapped to bit positions. The base class returns
+   * NULL, i.e., dense evaluation is realised by conversion to state sets and back. 
+   * See faudes::CtrlPfxOperator for a derived class.
+   *
+   * @return
+   *   Compiled generator or NULL
+   **/
+  virtual const CompiledGenerator* DenseDomain(void) const;
+
   /**
    * Evaluate opertor on arguments
    *
@@ -98,6 +188,20 @@ public:
    **/
   void Evaluate(StateSet& rRes) const;
 
+  /**
+   * Evaluate opertor on dense arguments
+   *
+   * This is a wrapper for the protected method DoEvaluateDense, to be used
+   * for operators with a non-NULL DenseDomain(). Fixpoint iterations use this
+   * variant to avoid conversions within their loops.
+   *
+   * @param rArgs
+   *   Dense arguments the operator performs on
+   * @param rRes
+   *   Resulting dense state set
+   **/
+  void Evaluate(DenseStateSetVector& rArgs, DenseStateSet& rRes) const;
+
   /** signature, i.e., the number of arguments we expect */
   StateSetVector::Position ArgCount(void) const;
 
@@ -107,6 +211,9 @@ public:
   /** argument stats (debugging/development) */
   std::string ArgStatistics(const StateSetVector& rArgs) const;
 
+  /** argument stats (debugging/development) */
+  std::string ArgStatistics(const DenseStateSetVector& rArgs) const;
+
   /** indent (cosmetic) */
   virtual const std::string& Indent(void) const;
 
@@ -140,6 +247,20 @@ protected:
    **/
   virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes) =0;
 
+  /**
+   * Evaluate opertor on dense arguments (protected virtual)
+   *
+   * The base class converts the arguments by DenseDomain() and invokes DoEvaluate
+   * on state sets. Re-implement this function for operators which evaluate on
+   * dense state sets natively. The result must not refer to any of the arguments.
+   *
+   * @param rArgs
+   *   Dense arguments the operator performs on
+   * @param rRes
+   *   Resulting dense state set
+   **/
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes);
+
 };
 
 /**
@@ -167,6 +288,16 @@ public:
    **/
   virtual const StateSet&  Domain(void) const;
 
+  /**
+   * Dense domain
+   *
+   * Report the compiled generator we evaluate on.
+   *
+   * @return
+   *   Compiled generator
+   **/
+  virtual const CompiledGenerator* DenseDomain(void) const;
+
 protected:
 
   /**
@@ -186,7 +317,19 @@ protected:
    *   Resulting state set
    **/
   virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes);
-  
+
+  /**
+   * Evaluate opertor on dense arguments
+   *
+   * Same as DoEvaluate on state sets, with the arguments and the result
+   * indexed by the compiled generator.
+   *
+   * @param rArgs
+   *   Argument [Y,X] in that order
+   * @param rRes
+   *   Resulting dense state set
+   **/
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes);
 
   /** set up context references */
   const vGenerator& rGen;
@@ -197,8 +340,17 @@ protected:
   /** set up context references */
   const TransSet& rTransRel;
 
-  /** have a reverse transition relation*/
-  TransSetX2EvX1  mRevTransRel;
+  /** compiled generator for dense evaluation */
+  CompiledGenerator mCGen;
+
+  /** controllable events by internal index */
+  std::vector<bool> mCtrlFlags;
+
+  /** marked states, dense */
+  DenseStateSet mMarked;
+
+  /** conversion at the API boundary, dense */
+  DenseStateSet mX, mY, mR;
 
 };  
 
@@ -209,8 +361,8 @@ protected:
  * fixpoint iterations as in the mu-calculus. In tis specific class,
  * we implement the mu-iteration, i.e., we seek for the smallest fixpoint.
  *
- * The implementation is meant for a simple API, we do not care about
- * performance at this stage.
+ * If the operator supports dense evaluation, see StateSetOperator::DenseDomain(),
+ * the iteration converts its arguments once and iterates on dense state sets.
  *
  * @ingroup SynthesisPlugIn
  */
@@ -242,6 +394,16 @@ class FAUDES_API MuIteration : public StateSetOperator {
    **/
   virtual const StateSet&  Domain(void) const;
 
+  /**
+   * Dense domain
+   *
+   * Report the dense domain of the operator we iterate on.
+   *
+   * @return
+   *   Compiled generator or NULL
+   **/
+  virtual const CompiledGenerator* DenseDomain(void) const;
+
   /**
    * Evaluate opertor on arguments and return ranking
    *
@@ -303,6 +465,9 @@ protected:
    *   Resulting state set
    **/
   virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes);
+
+  /** implement the mu-iteration on dense state sets */
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes);
   
   /** the base operator to iterate with */
   const StateSetOperator& mrOp;
@@ -316,8 +481,8 @@ protected:
  * fixpoint iterations as in the mu-calculus. In tis specific class,
  * we implement the nu-iteration, i.e., we seek for the greatest fixpoint.
  *
- * The implementation is meant for a simple API, we do not care about
- * performance at this stage.
+ * If the operator supports dense evaluation, see StateSetOperator::DenseDomain(),
+ * the iteration converts its arguments once and iterates on dense state sets.
  *
  * @ingroup SynthesisPlugIn
  */
@@ -349,6 +514,16 @@ class FAUDES_API NuIteration : public StateSetOperator {
    **/
   virtual const StateSet&  Domain(void) const;
 
+  /**
+   * Dense domain
+   *
+   * Report the dense domain of the operator we iterate on.
+   *
+   * @return
+   *   Compiled generator or NULL
+   **/
+  virtual const CompiledGenerator* DenseDomain(void) const;
+
   
   /** reimplemengt indent */
   using StateSetOperator::Indent;
@@ -374,6 +549,9 @@ protected:
    **/
   virtual void DoEvaluate(StateSetVector& rArgs, StateSet& rRes);
 
+  /** implement the nu-iteration on dense state sets */
+  virtual void DoEvaluateDense(DenseStateSetVector& rArgs, DenseStateSet& rRes);
+
   /** the base operator to iterate on */
   const StateSetOperator& mrOp;
 };
@@ -22,6 +22,8 @@
 
 #include "syn_supcon.h"
 
+#include <algorithm>
+
 
 namespace faudes {
 
@@ -82,9 +84,10 @@ void SupConClosedUnchecked(
      << rSupCandGen.SStr(*rSupCandGen.InitStatesBegin()) << ")");
 
   // process todo stack
+  Idx lcnt=0;
   while (! todog.empty()) {
-    // allow for user interrupt
-    // LoopCallback();
+    // allow for user interrupt, incl cancellation and limits
+    FD_LOOP(lcnt,0);
     // allow for user interrupt, incl progress report
     FD_WPC(1,2,"Controllability(): iterating states"); 
     // get top element from todo stack
@@ -267,9 +270,10 @@ bool IsControllableUnchecked(
      << rSupCandGen.SStr(*rSupCandGen.InitStatesBegin()) << ")");
 
   // process todo stack
+  Idx lcnt=0;
   while (! todo.empty()) {
-    // allow for user interrupt
-    // LoopCallback();
+    // allow for user interrupt, incl cancellation and limits
+    FD_LOOP(lcnt,0);
     // allow for user interrupt, incl progress report
     FD_WPC(1,2,"Controllability(): iterating states"); 
     // get top element from todo stack
@@ -382,6 +386,99 @@ bool IsControllableUnchecked(
 
 
 
+// IsControllableUnchecked(rPlantGen, rCAlph, rSupCandGen, pCounterExample)
+bool IsControllableUnchecked(
+  const Generator& rPlantGen,
+  const EventSet& rCAlph,  
+  const Generator& rSupCandGen, 
+  std::vector<Idx>* pCounterExample) 
+{
+  FD_DF("IsControllableUnchecked(" << &rSupCandGen << "," << &rPlantGen << "): on-the-fly");
+
+  // PREPARE RESULT:
+  if(pCounterExample) pCounterExample->clear();
+
+  // return true (controllable) if there is no initial state
+  if(rPlantGen.InitStatesEmpty() || rSupCandGen.InitStatesEmpty()) 
+    return true;
+
+  // composition states, indexed by order of discovery; the breadth-first
+  // search processes the states in this very order
+  CompositionHashMap cmap;
+  cmap.Reserve(rPlantGen.States().MaxIndex(),rSupCandGen.States().MaxIndex());
+  // parent composition state and event (for counter example only)
+  std::vector<Idx> parent(1,0);
+  std::vector<Idx> pevent(1,0);
+
+  // initial state
+  cmap.Insert(*rPlantGen.InitStatesBegin(),*rSupCandGen.InitStatesBegin(),1);
+  if(pCounterExample) {
+    parent.push_back(0);
+    pevent.push_back(0);
+  }
+
+  // breadth-first search
+  Idx violation=0;
+  Idx vevent=0;
+  Idx lcnt=0;
+  for(Idx x12=1; x12<=cmap.Size(); ++x12) {
+    // allow for user interrupt, incl progress report
+    FD_WPC(x12,cmap.Size(),"Controllability(): iterating states"); 
+    FD_LOOP(lcnt,cmap.Size());
+    Idx currentg = cmap.Entries()[x12-1].X1;
+    Idx currenth = cmap.Entries()[x12-1].X2;
+    // merge plant and candidate transitions (events sorted ascending)
+    TransSet::Iterator titg = rPlantGen.TransRelBegin(currentg);
+    TransSet::Iterator titg_end = rPlantGen.TransRelEnd(currentg);
+    TransSet::Iterator tith = rSupCandGen.TransRelBegin(currenth);
+    TransSet::Iterator tith_end = rSupCandGen.TransRelEnd(currenth);
+    while(titg != titg_end) {
+      // skip candidate events that the plant cannot execute
+      while(tith != tith_end) {
+        if(tith->Ev >= titg->Ev) break;
+        ++tith;
+      }
+      // common event: record successor
+      if((tith != tith_end) && (tith->Ev == titg->Ev)) {
+        Idx next=cmap.Find(titg->X2,tith->X2);
+        if(next==0) {
+          cmap.Insert(titg->X2,tith->X2,cmap.Size()+1);
+          if(pCounterExample) {
+            parent.push_back(x12);
+            pevent.push_back(titg->Ev);
+          }
+        }
+        ++titg;
+        ++tith;
+        continue;
+      }
+      // plant event disabled by candidate: uncontrollable events are a violation
+      if(!rCAlph.Exists(titg->Ev)) {
+        FD_DF("IsControllable: uncontrollable event " << rPlantGen.EStr(titg->Ev) 
+          << " disabled at (" << rPlantGen.SStr(currentg) << "|" << rSupCandGen.SStr(currenth) << ")");
+        violation=x12;
+        vevent=titg->Ev;
+        break;
+      }
+      ++titg;
+    }
+    if(violation) break;
+  }
+
+  // controllable
+  if(violation==0) return true;
+
+  // retrieve counter example
+  if(pCounterExample) {
+    pCounterExample->push_back(vevent);
+    for(Idx x12=violation; parent[x12]!=0; x12=parent[x12])
+      pCounterExample->push_back(pevent[x12]);
+    std::reverse(pCounterExample->begin(),pCounterExample->end());
+  }
+  return false;
+}
+
+
 // SupConProduct(rPlantGen, rCAlph, rSpecGen, rCompositionMap, rResGen)
 void SupConProduct(
   const Generator& rPlantGen, 
@@ -389,6 +486,21 @@ void SupConProduct(
   const Generator& rSpecGen,
   std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
   Generator& rResGen) 
+{
+  // do the composition
+  CompositionHashMap cmap;
+  SupConProduct(rPlantGen, rCAlph, rSpecGen, cmap, rResGen);
+  // convert composition map
+  cmap.StlMap(rCompositionMap);
+}
+
+// SupConProduct(rPlantGen, rCAlph, rSpecGen, rCompositionMap, rResGen)
+void SupConProduct(
+  const Generator& rPlantGen, 
+  const EventSet& rCAlph,
+  const Generator& rSpecGen,
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen) 
 {
   FD_DF("SupConProduct(" << &rPlantGen << "," << &rSpecGen << ")");
 	
@@ -402,13 +514,12 @@ void SupConProduct(
   std::pair<Idx,Idx> currentp, nextp;
   // current state, next state, at result
   Idx currentt, nextt;
-  std::map< std::pair<Idx,Idx>, Idx>::iterator rcmapit;
   StateSet::Iterator lit1, lit2;
   TransSet::Iterator titg, titg_end, tith, tith_end;
 
   // prepare
   rResGen.ClearStates();
-  rCompositionMap.clear();
+  rCompositionMap.Reserve(rPlantGen.States().MaxIndex(),rSpecGen.States().MaxIndex());
 
   // ALGORITHM:  
   if (rPlantGen.InitStatesEmpty()) {
@@ -425,14 +536,15 @@ void SupConProduct(
   // create initial state
   currentp = std::make_pair(*rPlantGen.InitStatesBegin(), *rSpecGen.InitStatesBegin());
   todo.push(currentp);
-  rCompositionMap[currentp] = rResGen.InsInitState();
+  currentt = rResGen.InsInitState();
+  rCompositionMap.Insert(currentp.first, currentp.second, currentt);
   FD_DF("SupConProduct: insert initial state: (" 
      << rPlantGen.SStr(currentp.first) 
      << "|" << rSpecGen.SStr(currentp.second) << ") as idx " 
-     << rCompositionMap[currentp]);
+     << currentt);
   if(rPlantGen.ExistsMarkedState(*rPlantGen.InitStatesBegin()) 
                 && rSpecGen.ExistsMarkedState(*rSpecGen.InitStatesBegin())) {
-    rResGen.SetMarkedState(rCompositionMap[currentp]);
+    rResGen.SetMarkedState(currentt);
      FD_DF("SupConProduct: initial state is marked");
   }
 
@@ -440,15 +552,16 @@ void SupConProduct(
   // this creates an accessible generator
 
   FD_DF("SupConProduct: *** processing reachable states ***");
+  Idx lcnt=0;
   while (! todo.empty()) {
-    // allow for user interrupt
-    // LoopCallback();
+    // allow for user interrupt, incl cancellation and limits
+    FD_LOOP(lcnt,rResGen.Size());
     // allow for user interrupt, incl progress report
-    FD_WPC(rCompositionMap.size(),rCompositionMap.size()+todo.size(),"SupConProduct(): processing"); 
+    FD_WPC(rCompositionMap.Size(),rCompositionMap.Size()+todo.size(),"SupConProduct(): processing"); 
     // get next reachable pair of states from todo stack
     currentp = todo.top();
     todo.pop();
-    currentt = rCompositionMap[currentp];
+    currentt = rCompositionMap.Find(currentp.first, currentp.second);
     FD_DF("SupConProduct: todo pop: (" 
         << rPlantGen.SStr(currentp.first) 
 	<< "|" << rSpecGen.SStr(currentp.second) << ") as idx " 
@@ -482,14 +595,14 @@ void SupConProduct(
       if(titg->Ev == tith->Ev) {
 	FD_DF("SupConProduct: executing common event "  << rPlantGen.EStr(titg->Ev));
 	nextp = std::make_pair(titg->X2, tith->X2);
-	rcmapit = rCompositionMap.find(nextp);
+	nextt = rCompositionMap.Find(nextp.first, nextp.second);
 	// if state is new ...
-	if(rcmapit == rCompositionMap.end()) {
+	if(nextt == 0) {
           // ... add on todo stack
 	  todo.push(nextp);
           // ... insert in result
     	  nextt = rResGen.InsState();
-	  rCompositionMap[nextp] = nextt;
+	  rCompositionMap.Insert(nextp.first, nextp.second, nextt);
 	  FD_DF("SupConProduct: insert state: (" << 
              rPlantGen.SStr(nextp.first) << "|" 
 	     << rSpecGen.SStr(nextp.second) << ") as idx " 
@@ -501,10 +614,6 @@ void SupConProduct(
 	    FD_DF("SupConProduct: marked nes state")
 	  }
 	}
-	// if state already exists
-	else {
-	  nextt = rcmapit->second;
-	}
 	// if successor state is not critical add transition and proceed
 	if(!critical.Exists(nextt)) {
 	  FD_DF("SupConProduct: set transition " << 
@@ -582,6 +691,173 @@ void SupConProduct(
 
 
 
+// SupConFixpointUnchecked(rPlantGen, rCAlph, rCompositionMap, rSupCandGen)
+void SupConFixpointUnchecked(
+  const Generator& rPlantGen,
+  const EventSet& rCAlph,
+  const CompositionHashMap& rCompositionMap,
+  Generator& rSupCandGen)
+{
+  FD_DF("SupConFixpointUnchecked(" << &rPlantGen << "," << &rSupCandGen << ")");
+  if(rSupCandGen.Empty()) return;
+
+  // compile candidate H with reverse transitions, and the plant G
+  CompiledGenerator h(rSupCandGen,true);
+  CompiledGenerator g(rPlantGen,false);
+  Idx n=h.Size();
+
+  // plant state per candidate state
+  std::vector<Idx> hg(rSupCandGen.States().MaxIndex()+1,0);
+  std::vector<CompositionHashMap::Entry>::const_iterator cit=rCompositionMap.Entries().begin();
+  std::vector<CompositionHashMap::Entry>::const_iterator cit_end=rCompositionMap.Entries().end();
+  for(;cit!=cit_end;++cit)
+    if(cit->X12<hg.size()) hg[cit->X12]=cit->X1;
+  std::vector<Idx> plant(n+1,0);
+  for(Idx q=1; q<=n; ++q)
+    plant[q]=g.StateIndex(hg[h.State(q)]);
+
+  // uncontrollable events by candidate event index, plant events by candidate event index
+  std::vector<bool> uncontr(h.AlphabetSize()+1,false);
+  for(Idx e=1; e<=h.AlphabetSize(); ++e)
+    uncontr[e]=!rCAlph.Exists(h.Event(e));
+  std::vector<Idx> gev(g.AlphabetSize()+1,0);
+  for(Idx e=1; e<=g.AlphabetSize(); ++e)
+    gev[e]=h.EventIndex(g.Event(e));
+
+  // worklist of removed states
+  std::vector<bool> dead(n+1,false);
+  std::vector<Idx> todo;
+
+  // initial critical states: an uncontrollable plant event is disabled
+  Idx lcnt=0;
+  for(Idx q=1; q<=n; ++q) {
+    FD_LOOP(lcnt,n);
+    if(plant[q]==0) continue;
+    CompiledGenerator::Iterator git=g.SuccBegin(plant[q]);
+    CompiledGenerator::Iterator git_end=g.SuccEnd(plant[q]);
+    for(;git!=git_end;++git) {
+      Idx e=gev[git->Ev];
+      if(e==0) continue;
+      if(!uncontr[e]) continue;
+      if(h.SuccBegin(q,e)!=h.SuccEnd(q,e)) continue;
+      dead[q]=true;
+      todo.push_back(q);
+      break;
+    }
+  }
+
+  // initial coaccessibility over the entire candidate
+  std::vector<bool> reach(n+1,false);
+  std::vector<Idx> stack;
+  for(Idx q=1; q<=n; ++q) {
+    if(dead[q] || !h.MarkedState(q)) continue;
+    reach[q]=true;
+    stack.push_back(q);
+  }
+  while(!stack.empty()) {
+    Idx q=stack.back();
+    stack.pop_back();
+    CompiledGenerator::Iterator tit=h.PredBegin(q);
+    CompiledGenerator::Iterator tit_end=h.PredEnd(q);
+    for(;tit!=tit_end;++tit) {
+      if(dead[tit->X] || reach[tit->X]) continue;
+      reach[tit->X]=true;
+      stack.push_back(tit->X);
+    }
+  }
+  for(Idx q=1; q<=n; ++q) {
+    if(dead[q] || reach[q]) continue;
+    dead[q]=true;
+    todo.push_back(q);
+  }
+
+  // fixpoint: invariant on entry is that all live states not on the worklist are coaccessible
+  std::vector<bool> region(n+1,false);
+  std::vector<Idx> rstates;
+  std::vector<Idx> removed;
+  while(!todo.empty()) {
+    FD_LOOP(lcnt,n);
+    // propagate removal to uncontrollable predecessors
+    removed.clear();
+    while(!todo.empty()) {
+      Idx q=todo.back();
+      todo.pop_back();
+      removed.push_back(q);
+      CompiledGenerator::Iterator tit=h.PredBegin(q);
+      CompiledGenerator::Iterator tit_end=h.PredEnd(q);
+      for(;tit!=tit_end;++tit) {
+        if(dead[tit->X] || !uncontr[tit->Ev]) continue;
+        dead[tit->X]=true;
+        todo.push_back(tit->X);
+      }
+    }
+    FD_DF("SupConFixpointUnchecked(): removed #" << removed.size());
+    // affected region: live states that may reach a removed state
+    rstates.clear();
+    for(std::size_t i=0; i<removed.size(); ++i) {
+      CompiledGenerator::Iterator tit=h.PredBegin(removed[i]);
+      CompiledGenerator::Iterator tit_end=h.PredEnd(removed[i]);
+      for(;tit!=tit_end;++tit) {
+        if(dead[tit->X] || region[tit->X]) continue;
+        region[tit->X]=true;
+        rstates.push_back(tit->X);
+      }
+    }
+    for(std::size_t i=0; i<rstates.size(); ++i) {
+      FD_LOOP(lcnt,n);
+      CompiledGenerator::Iterator tit=h.PredBegin(rstates[i]);
+      CompiledGenerator::Iterator tit_end=h.PredEnd(rstates[i]);
+      for(;tit!=tit_end;++tit) {
+        if(dead[tit->X] || region[tit->X]) continue;
+        region[tit->X]=true;
+        rstates.push_back(tit->X);
+      }
+    }
+    // re-evaluate coaccessibility within the region; states outside the region
+    // cannot reach a removed state and, hence, remain coaccessible
+    for(std::size_t i=0; i<rstates.size(); ++i) {
+      Idx q=rstates[i];
+      reach[q]=h.MarkedState(q);
+      if(!reach[q]) {
+        CompiledGenerator::Iterator tit=h.SuccBegin(q);
+        CompiledGenerator::Iterator tit_end=h.SuccEnd(q);
+        for(;tit!=tit_end;++tit) {
+          if(dead[tit->X] || region[tit->X]) continue;
+          reach[q]=true;
+          break;
+        }
+      }
+      if(reach[q]) stack.push_back(q);
+    }
+    while(!stack.empty()) {
+      Idx q=stack.back();
+      stack.pop_back();
+      CompiledGenerator::Iterator tit=h.PredBegin(q);
+      CompiledGenerator::Iterator tit_end=h.PredEnd(q);
+      for(;tit!=tit_end;++tit) {
+        if(!region[tit->X] || reach[tit->X]) continue;
+        reach[tit->X]=true;
+        stack.push_back(tit->X);
+      }
+    }
+    for(std::size_t i=0; i<rstates.size(); ++i) {
+      Idx q=rstates[i];
+      region[q]=false;
+      if(reach[q]) continue;
+      dead[q]=true;
+      todo.push_back(q);
+    }
+  }
+
+  // remove dead states and restrict to accessible part
+  StateSet delstates;
+  for(Idx q=1; q<=n; ++q)
+    if(dead[q]) delstates.Insert(h.State(q));
+  FD_DF("SupConFixpointUnchecked(): deleting #" << delstates.Size() << " states");
+  rSupCandGen.DelStates(delstates);
+  rSupCandGen.Accessible();
+}
+
 // SupConUnchecked(rPlantGen, rCAlph, rSpecGen, rCompositionMap, rResGen)
 void SupConUnchecked(
   const Generator& rPlantGen,
@@ -589,6 +865,21 @@ void SupConUnchecked(
   const Generator& rSpecGen,
   std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
   Generator& rResGen) 
+{
+  // do the synthesis
+  CompositionHashMap cmap;
+  SupConUnchecked(rPlantGen, rCAlph, rSpecGen, cmap, rResGen);
+  // convert composition map
+  cmap.StlMap(rCompositionMap);
+}
+
+// SupConUnchecked(rPlantGen, rCAlph, rSpecGen, rCompositionMap, rResGen)
+void SupConUnchecked(
+  const Generator& rPlantGen,
+  const EventSet& rCAlph,  
+  const Generator& rSpecGen,
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen) 
 {
   FD_DF("SupCon(" << &rPlantGen << "," << &rSpecGen << ")");
 
@@ -607,14 +898,8 @@ void SupConUnchecked(
   // ALGORITHM:
   SupConProduct(rPlantGen, rCAlph, rSpecGen, rCompositionMap, *pResGen);
 
-  // make resulting generator trim until it's fully controllable
-  while(true) {
-    if(pResGen->Empty()) break;
-    Idx state_num = pResGen->Size();
-    SupConClosedUnchecked(rPlantGen, rCAlph, *pResGen);
-    pResGen->Trim();
-    if(pResGen->Size() == state_num) break;
-  }
+  // make resulting generator trim and fully controllable
+  SupConFixpointUnchecked(rPlantGen, rCAlph, rCompositionMap, *pResGen);
 
   // convenience state names
   if(rPlantGen.StateNamesEnabled() && rSpecGen.StateNamesEnabled() && rResGen.StateNamesEnabled()) 
@@ -725,14 +1010,27 @@ bool IsControllable(
   // HELPERS:
   FD_DF("IsControllable: controllable events: " << rCAlph.ToString());
 
-  // critical set
-  StateSet critical;
+  // CONSISTENCY CHECKS:
+  ControlProblemConsistencyCheck(rPlantGen, rCAlph, rSupCandGen);
+
+  // ALGORITHM:
+  return IsControllableUnchecked(rPlantGen, rCAlph, rSupCandGen, 0);
+}
+
+// IsControllable(rPlantGen, rCAlph, rSupCandGen, rCounterExample)
+bool IsControllable(
+  const Generator& rPlantGen, 
+  const EventSet& rCAlph, 
+  const Generator& rSupCandGen, 
+  std::vector<Idx>& rCounterExample) 
+{
+  FD_DF("IsControllable(" << &rSupCandGen << "," << &rPlantGen << ")");
 
   // CONSISTENCY CHECKS:
   ControlProblemConsistencyCheck(rPlantGen, rCAlph, rSupCandGen);
 
   // ALGORITHM:
-  return IsControllableUnchecked(rPlantGen, rCAlph, rSupCandGen, critical);
+  return IsControllableUnchecked(rPlantGen, rCAlph, rSupCandGen, &rCounterExample);
 }
 
 
@@ -765,7 +1063,7 @@ void SupCon(
   ControlProblemConsistencyCheck(rPlantGen, rCAlph, rSpecGen);
 
   // HELPERS:
-  std::map< std::pair<Idx,Idx>, Idx> rcmap;
+  CompositionHashMap rcmap;
 
   // ALGORITHM:
   SupConUnchecked(rPlantGen, rCAlph, rSpecGen, rcmap, rResGen);
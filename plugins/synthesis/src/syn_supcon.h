@@ -107,6 +107,49 @@ extern FAUDES_API bool IsControllable(
   StateSet& rCriticalStates);
 
 
+/**
+ * Test controllability.
+ *
+ * Tests whether the candidate supervisor H is controllable w.r.t.
+ * the plant G. The test explores the parallel composition of plant and 
+ * candidate on-the-fly in breadth-first order and stops at the first 
+ * reachable state that disables an uncontrollable plant event.
+ *
+ * If the candidate fails to be controllable, this version will return a
+ * counter example, i.e., a shortest sequence of events that is accepted by
+ * both plant and candidate, extended by an uncontrollable event that is
+ * accepted by the plant but not by the candidate.
+ *
+ * Parameter restrictions: both generators must be deterministic and 
+ * have the same alphabet.
+ *
+ * @param rPlantGen
+ *   Plant G 
+ * @param rCAlph
+ *   Controllable events
+ * @param rSupCandGen
+ *   Supervisor candicate H 
+ * @param rCounterExample
+ *   Sequence of events leading to a violation, empty if controllable
+ *
+ * @exception Exception
+ *   - alphabets of generators don't match (id 100)
+ *   - plant generator nondeterministic (id 201)
+ *   - specification generator nondeterministic (id 203)
+ *   - plant and Spec generator nondeterministic (id 204)
+ *
+ * @return 
+ *   true / false
+ *
+ * @ingroup SynthesisPlugIn
+ */
+extern FAUDES_API bool IsControllable(
+  const Generator& rPlantGen, 
+  const EventSet&  rCAlph,
+  const Generator& rSupCandGen, 
+  std::vector<Idx>& rCounterExample);
+
+
 /**
  * Test controllability. 
  *
@@ -348,6 +391,31 @@ extern FAUDES_API void SupConUnchecked(
   std::map< std::pair<Idx,Idx>,Idx >& rReverseCompositionMap, 
   Generator& rResGen);
 
+/**
+ * Supremal Controllable Sublanguage (internal function)
+ *
+ * Variant of SupConUnchecked(const Generator&, const EventSet&, const Generator&, std::map< std::pair<Idx,Idx>,Idx >&, Generator&) 
+ * with a hash based composition map.
+ * 
+ * @param rPlantGen
+ *   Plant Generator 
+ * @param rCAlph
+ *   Controllable events
+ * @param rSpecGen
+ *   Specification Generator 
+ * @param rCompositionMap
+ *   Composition map as in the parallel composition function
+ * @param rResGen
+ *   Reference to resulting System, the
+ *   minimal restrictive nonblocking supervisor
+ */
+extern FAUDES_API void SupConUnchecked(
+  const Generator& rPlantGen, 
+  const EventSet&  rCAlph,
+  const Generator& rSpecGen, 
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen);
+
 
 
 /**
@@ -407,6 +475,61 @@ extern FAUDES_API void SupConProduct(
   std::map< std::pair<Idx,Idx>, Idx>& rReverseCompositionMap, 
   Generator& rResGen);
 
+/** 
+ * Parallel composition optimized for the purpose of SupCon (internal function)
+ * 
+ * Variant of SupConProduct(const Generator&, const EventSet&, const Generator&, std::map< std::pair<Idx,Idx>,Idx >&, Generator&) 
+ * with a hash based composition map.
+ * 
+ * @param rPlantGen
+ *   Plant Generator 
+ * @param rCAlph
+ *   Uncontrollable Events
+ * @param rSpecGen
+ *   Specification Generator 
+ * @param rCompositionMap
+ *   Composition map as in the parallel composition function
+ * @param rResGen
+ *   Reference to resulting Generator, the
+ *   less restrictive supervisor
+ */
+extern FAUDES_API void SupConProduct(
+  const Generator& rPlantGen, 
+  const EventSet& rCAlph, 
+  const Generator& rSpecGen,
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen);
+
+/**
+ * Controllable and trim fixpoint of a SupCon candidate (internal function)
+ *
+ * Removes states from the candidate until it is both controllable w.r.t. the
+ * plant and trim. The candidate is expected to be set up by SupConProduct, i.e.,
+ * its states must discriminate plant states as recorded in the composition map.
+ *
+ * Other than alternating SupConClosedUnchecked and Trim on the entire candidate,
+ * this function compiles the candidate once with reverse transition indices and
+ * propagates removals from a worklist: uncontrollable predecessors of removed states
+ * become critical and coaccessibility is re-evaluated only for the backward closure of
+ * the removed states.
+ *
+ * This internal function performs no consistency test of the given parameter.
+ *
+ * @param rPlantGen
+ *   Plant Generator
+ * @param rCAlph
+ *   Controllable Events
+ * @param rCompositionMap
+ *   Composition map as obtained from SupConProduct
+ * @param rSupCandGen
+ *   Supervisor candidate, to be reduced to the supremal controllable and trim generator
+ */
+extern FAUDES_API void SupConFixpointUnchecked(
+  const Generator& rPlantGen,
+  const EventSet& rCAlph,
+  const CompositionHashMap& rCompositionMap,
+  Generator& rSupCandGen);
+
 /**
  * Controllability (internal function)
  *
@@ -441,6 +564,34 @@ extern FAUDES_API bool IsControllableUnchecked(
   StateSet& rCriticalStates);
 
 
+/**
+ * Controllability (internal function)
+ *
+ * Checks if language of specification h is controllable with respect to
+ * language of generator g. Only for deterministic plant + spec. The test
+ * explores the composition on-the-fly and stops at the first violation. 
+ *
+ * Controllable event set has to be given as parameter.
+ *
+ * @param rPlantGen
+ *   Plant generator
+ * @param rCAlph
+ *   Controllable events
+ * @param rSpecGen
+ *   Specification generator
+ * @param pCounterExample
+ *   Sequence of events leading to a violation (or 0 to skip the book-keeping)
+ *
+ * @return 
+ *   true / false
+ */
+extern FAUDES_API bool IsControllableUnchecked(
+  const Generator& rPlantGen, 
+  const EventSet& rCAlph, 
+  const Generator& rSpecGen, 
+  std::vector<Idx>* pCounterExample);
+
+
 /**
  * Helper function for IsControllable. The state given as "current" is
  * considered critical. Itself and all uncontrollable predecessor states 
@@ -191,6 +191,7 @@ void ConcatenateFullLanguage(Generator& rGen) {
   sit = rGen.MarkedStatesBegin();
   Idx marked = *sit;
   // clear all transitions the one  marked states
+  rGen.TransRel().Detach();
   tit = rGen.TransRelBegin(marked);
   tit_end = rGen.TransRelEnd(marked);
   while(tit != tit_end)
@@ -436,6 +437,7 @@ bool SupClosed(
   
   // erase all transitions not leading to a marked state
   // todo: depth-first-search could be faster
+  rResult.TransRel().Detach();
   TransSet::Iterator tit=rResult.TransRelBegin();
   TransSet::Iterator tit_end=rResult.TransRelEnd();
   while(tit!=tit_end) {
@@ -494,6 +496,10 @@ void SupConNormClosedUnchecked(
   // Generator K;
   // SupConNormClosed(rPlantGen, rCAlph, rOAlph, rSupCandGen, K);
  
+  // both generators get ClrTransition(tit++) within the loops below
+  rSupCandGen.TransRel().Detach();
+  rObserverGen.TransRel().Detach();
+
   // loop until fixpoint
   while(true) {
     FD_DF("SupConNormClosedUnchecked(" << &rSupCandGen << "," << &rPlantGen << "): until fixpoint #" << rSupCandGen.Size());
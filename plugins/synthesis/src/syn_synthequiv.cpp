@@ -40,31 +40,11 @@ namespace faudes {
 /*
 ****************************************************************
 ****************************************************************
-PART 1: Partition
-****************************************************************
-****************************************************************
-*/
-
-struct Pnode {
-
-  /** unique partition index */
-  Idx index;
-
-  /** Associated set of states */
-  std::set<Idx> states;
-
-  /** number of states in this coset */
-  Idx nsize;
-
-};
-
-/*
-****************************************************************
-****************************************************************
-PART 2: SOE
+PART 1: SOE
 
 The class SOE is used to compute the coarsest synthesis-observation-equivalence
 relation and to maintain relevant data structures required for the particular implementation.
+The current partition is represented by a RefinablePartition, see cfl_partition.h.
 
 ****************************************************************
 ****************************************************************
@@ -76,7 +56,7 @@ public:
 
   /**
    * Contructor: 
-   * keep a reference to the generator and initialize the partition and the W-Tree
+   * keep a reference to the generator and initialize the partition
    * to represent the universal equivalence relation, i.e. every two states are equivalent.
    *
    * @param rGenOrig
@@ -88,11 +68,6 @@ public:
    */
   SOE(const Generator& rGenOrig, const EventSet& rConAlph, const EventSet& rLocAlph);
 
-  /**
-   * Destructor
-   */
-  ~SOE(void);
-
   /**
    * Perform fixpoint iteration to obtain the coarset synthesis-observation-equivalence
    */
@@ -173,24 +148,20 @@ private:
   std::set<Idx> shaconalph;  // shared controllable events
 
   /**
-   * Counter to assign a unique index to each node [debugging/cosmetic only] 
-   */
-  Idx nxidx;
-
-  /**
-   * W-tree contains all blocks ever created [required for destruction]
+   * current partition, elements are internal state indices minus one
    */
-  std::vector<Pnode*> W;
+  RefinablePartition blocks;
 
   /**
-   * set of nodes that form current partition, i.e. leaves of W.
+   * set of blocks that can possibly split blocks of the current partition
    */
-  std::set<Pnode*> ro;
+  std::set<Idx> roDividers;
 
   /**
-   * set of nodes that can possibly split classes in ro
+   * dividers by block: the far part of the equivalent states (case 1 and 3) 
+   * depends on this block and must be re-evaluated when it splits
    */
-  std::set<Pnode*> roDividers;
+  std::map<Idx, std::set<Idx> > farDividers;
 
   /**
    * construct 2st Part of Struct "State"
@@ -202,81 +173,60 @@ private:
    */
   void initStateMember_Pres();
 
-  /**
-   * insert new node in W-tree with empty stateset
-   */
-  Pnode* newnode();
-
   /**
    * refine current partition with respect to coset B
    *
-   * @param B
+   * @param b
    *   coset
    */
-  void partitionClass(Pnode& B);
+  void partitionClass(Idx b);
 
   /**
    * construct all relations with respect to coset B
    *
    * @param B
-   *   coset
+   *   states of coset
    * @param relations
    *   vector of all relations
    */
-  void computeRel(Pnode& B, std::vector<Relation>& relations);
+  void computeRel(const std::set<Idx>& B, std::vector<Relation>& relations);
 
   /**
    * collect all states from coset B which are equivalent to the speicified state
    * and determine the related nodes which is possibly to be splitted
    *
    * @param B
-   *   coset
+   *   states of coset
    * @param rel
    *   a specified relation
    * @param tb
    *   all equivalent states with respect to rel
    * @param todo
-   *   all related nodes which is possibly to be splitted
+   *   all related blocks which is possibly to be splitted
    */
-  void computeEquStates(Pnode& B, Relation& rel, std::set<Idx>& tb, std::stack<Pnode*>& todo);
+  void computeEquStates(const std::set<Idx>& B, Relation& rel, std::set<Idx>& tb, std::vector<Idx>& todo);
 
   /**
    * implementation part for function "computeEquStates"
    * it is organized as follows with respect to various cases:
    */ 
-  void relCase_1(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo);
-  void relCase_2(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo);
-  void relCase_3(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo);
-  void relCase_4(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo);
-
-};
-
-
-// maintain W-tree: new node
-Pnode* SOE::newnode(void)
-{
-  Pnode* nn= new Pnode();
-  nn->nsize=0;
-  nn->index=nxidx;
-  nxidx++;
-  W.push_back(nn);
-  return nn;
-}
+  void relCase_1(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo);
+  void relCase_2(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo);
+  void relCase_3(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo);
+  void relCase_4(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo);
 
+  /**
+   * block of a state (internal index)
+   */
+  Idx block(Idx st) const { return blocks.S[st-1]; };
 
-// destruct
-SOE::~SOE(void) 
-{
-  std::vector<Pnode*>::iterator wit=W.begin();
-  for(; wit!=W.end(); ++wit) delete *wit;
-}
+};
 
 
 // Constructor SOE(rGenOrig, rConAlph, rLocAlph)
 SOE::SOE(const Generator& rGenOrig, const EventSet& rConAlph, const EventSet& rLocAlph)
 {
   gen = &rGenOrig;
-  nxidx=1;
   
   // encode transition relation [effectively buffer log-n search]
   std::map<Idx,Idx> smap;
@@ -335,13 +285,8 @@ SOE::SOE(const Generator& rGenOrig, const EventSet& rConAlph, const EventSet& rL
   initStateMember_Pres();
 
   // create universal partition holding the complete state set
-  Pnode* universe = newnode(); 
-  Idx st=1;
-  for(;st<states.size();++st) universe->states.insert(st); 
-  universe->nsize = universe->states.size();
-
-  ro.insert(universe);
-  roDividers.insert(universe);
+  blocks.Init(states.size()-1);
+  if(blocks.z>0) roDividers.insert(0);
 
 }
 
@@ -453,19 +398,24 @@ void SOE::initStateMember_Pres()
   }
 
 } 
-// SOE::partitionClass(B)
-void SOE::partitionClass(Pnode& B)
+// SOE::partitionClass(b)
+void SOE::partitionClass(Idx b)
 {
 
   // helpers
   vector<Relation> relations;
-  std::stack<Pnode*> todo;  // the related node in a particular relation
-  std::vector<Pnode*> addSet;
-  std::vector<Pnode*> removeSet;
+  std::vector<Idx> todo;  // the related blocks in a particular relation
+  std::vector<Idx> marked;
   // iterators
   vector<Relation>::iterator relIt;
-  std::vector<Pnode*>::iterator addIt;
-  std::vector<Pnode*>::iterator remIt;
+  std::vector<Idx>::iterator todoIt;
+
+  // delete coset B from roDividers (it is re-inserted when split or when its far part is affected)
+  roDividers.erase(b);
+
+  // states of this block
+  std::set<Idx> B;
+  for(Idx i=blocks.F[b]; i<blocks.P[b]; ++i) B.insert(blocks.E[i]+1);
 
   // collect all relations for this block
   computeRel(B, relations);  // *extra funktion:1
@@ -473,85 +423,57 @@ void SOE::partitionClass(Pnode& B)
   // loop over every relation
   relIt=relations.begin();
   for(; relIt!=relations.end(); ++relIt) {
-    //std::cout<<"        now coming to one relation"<<std::endl;
     // compute all equivalent states for the relation
     std::set<Idx> tb;
+    todo.clear();
     computeEquStates(B, *relIt, tb, todo); // *extra funktion:2
-    //std::cout<<" todo is empty ->"<<(true==todo.empty()?"yes":"no")<<std::endl;
-
-    // iteration over all cosets on todo-stack
-    while(!todo.empty()) {
-      Pnode* rop=todo.top();
-      todo.pop();
-      
-      // skip Nr.1:  singletons
-      if(rop->nsize==1) continue;
-      // skip Nr.2:  if it is the last node (repeated), then now is empty
-      if(rop->states.empty()) continue;
-
-      // compute intersection of relstates with current candidate coset
-      std::set<Idx> sXinter;
-      std::set_intersection(rop->states.begin(), rop->states.end(),
-			    tb.begin(), tb.end(),
-			    std::inserter(sXinter, sXinter.begin()));
-      
-      // skip Nr.3 : the current coset is a subset of relstates
-      if(sXinter.size()==rop->states.size()) continue;
-
-      // delete from ro and roDividers
-      roDividers.erase(rop);
-      removeSet.push_back(rop);
-      
-      // set up new node for intersection 
-      Pnode* nXinter= newnode();
-      nXinter->states.swap(sXinter);
-      nXinter->nsize=sXinter.size();
-      
-      // set up new node for difference
-      Pnode* nXdiff = newnode();
-      std::set_difference(rop->states.begin(), rop->states.end(), nXinter->states.begin(),
-			  nXinter->states.end(), 
-			  std::inserter(nXdiff->states, nXdiff->states.begin()));
-      nXdiff->nsize=nXdiff->states.size();
-      
-      // record that the new cosets have to be added to ro and roDividers
-      addSet.push_back(nXinter);
-      addSet.push_back(nXdiff);
-      roDividers.insert(nXinter);                
-      roDividers.insert(nXdiff);
-
-      // delete stateSet of split coset as the states are now stored in the child cosets
-      rop->states.clear();
-
-    } // end loop over all related nodes with the particular relation in todo
-    
-    // delete split partitions from ro
-    for(remIt=removeSet.begin(); remIt!=removeSet.end(); ++remIt) ro.erase(*remIt);
-    removeSet.clear();
+    // record dependency of the far part on the current partition
+    bool far = (shaconalph.find(relIt->ev)!=shaconalph.end()) || (locconalph.find(relIt->ev)!=locconalph.end());
+    if(far && !todo.empty()) farDividers[todo.back()].insert(b);
+
+    // iteration over all blocks on todo-stack
+    bool bsplit=false;
+    for(todoIt=todo.begin(); todoIt!=todo.end(); ++todoIt) {
+      Idx r=*todoIt;
+      // skip singletons
+      if(blocks.Size(r)==1) continue;
+      // mark intersection of relstates with current candidate block
+      marked.clear();
+      for(Idx i=blocks.F[r]; i<blocks.P[r]; ++i) 
+        if(tb.find(blocks.E[i]+1)!=tb.end()) marked.push_back(blocks.E[i]);
+      // skip: the current block is a subset of relstates or disjoint (this includes repeated blocks)
+      if(marked.size()==blocks.Size(r)) continue;
+      if(marked.empty()) continue;
+      // split: both parts become dividers
+      for(std::size_t k=0; k<marked.size(); ++k) blocks.Mark(marked[k]);
+      blocks.Split();
+      roDividers.insert(r);
+      roDividers.insert(blocks.z-1);
+      if(r==b) bsplit=true;
+      // dividers with a far part that depends on the split block need to be re-evaluated
+      std::map<Idx, std::set<Idx> >::iterator fit=farDividers.find(r);
+      if(fit!=farDividers.end()) {
+        roDividers.insert(fit->second.begin(),fit->second.end());
+        farDividers.erase(fit);
+      }
+    } // end loop over all related blocks with the particular relation in todo
     
-    // insert the new cosets into ro
-    for(addIt=addSet.begin(); addIt!=addSet.end(); ++addIt) ro.insert(*addIt);
-    addSet.clear();
-
     // if dividers has been split, then no more continue
-    if(B.states.empty()) return;
+    if(bsplit) return;
 
   } // end loop over all relations
   
-  // delete coset B from roDividers
-  roDividers.erase(&B);
-
 }
 
 // computeRel(B, relations)
 // collect complete relations in this block and save in relations
-void SOE::computeRel(Pnode& B, std::vector<Relation>& relations)
+void SOE::computeRel(const std::set<Idx>& B, std::vector<Relation>& relations)
 {
 
   // helpers
   Relation rel;
   // iterators
-  std::set<Idx>::iterator sit;   // states in node
+  std::set<Idx>::const_iterator sit;   // states in node
   std::set<Idx>::iterator evit;  // event iterator
   std::vector<Idx>::iterator vit; // pre states 
 
@@ -560,7 +482,7 @@ void SOE::computeRel(Pnode& B, std::vector<Relation>& relations)
   // relation case 1: shared controllable
   for(evit=shaconalph.begin(); evit!=shaconalph.end(); ++evit) {
     // loop all states in B
-    for(sit=B.states.begin(); sit!=B.states.end(); ++sit) {
+    for(sit=B.begin(); sit!=B.end(); ++sit) {
       // collect ev and pre if possible
       vit=states[*sit].shaconPre[*evit].begin();
       for(;vit!=states[*sit].shaconPre[*evit].end();++vit) {
@@ -577,7 +499,7 @@ void SOE::computeRel(Pnode& B, std::vector<Relation>& relations)
     rel.pre.clear();
     rel.ev=*evit;
     // loop all states in B
-    for(sit=B.states.begin(); sit!=B.states.end(); ++sit) {
+    for(sit=B.begin(); sit!=B.end(); ++sit) {
       // 
       vit=states[*sit].shauncPre[*evit].begin();
       for(;vit!=states[*sit].shauncPre[*evit].end();++vit) {
@@ -590,7 +512,7 @@ void SOE::computeRel(Pnode& B, std::vector<Relation>& relations)
   // relation case 3: local controllable 
   for(evit=locconalph.begin(); evit!=locconalph.end(); ++evit) {
     // loop all states in B
-    for(sit=B.states.begin(); sit!=B.states.end(); ++sit) {
+    for(sit=B.begin(); sit!=B.end(); ++sit) {
       // collect ev and pre if possible
       vit=states[*sit].locconPre.begin();
       for(;vit!=states[*sit].locconPre.end();++vit) {
@@ -607,7 +529,7 @@ void SOE::computeRel(Pnode& B, std::vector<Relation>& relations)
   for(evit=locuncalph.begin();evit!=locuncalph.end();++evit) {
     rel.ev=*evit;
     // loop all states in B
-    for(sit=B.states.begin(); sit!=B.states.end(); ++sit) {
+    for(sit=B.begin(); sit!=B.end(); ++sit) {
       vit=states[*sit].locuncPre.begin();
       for(;vit!=states[*sit].locuncPre.end();++vit) 
 	rel.pre.insert(*vit);
@@ -619,9 +541,14 @@ void SOE::computeRel(Pnode& B, std::vector<Relation>& relations)
 
 // computeEquStates(B, rel, tb, todo)
 // add info to "tb" and "todo"
-void SOE::computeEquStates(Pnode& B, Relation& rel, std::set<Idx>& tb,
-			    std::stack<Pnode*>& todo)
+void SOE::computeEquStates(const std::set<Idx>& B, Relation& rel, std::set<Idx>& tb,
+			    std::vector<Idx>& todo)
 {
+  // find the related blocks which include the states in "rel"
+  std::set<Idx>::iterator sit=rel.pre.begin();
+  for(; sit!=rel.pre.end(); ++sit) 
+    todo.push_back(block(*sit));
+
   // select one through "rel.ev" from 4 cases 
 
   // case 1: shared controllable event
@@ -643,30 +570,17 @@ void SOE::computeEquStates(Pnode& B, Relation& rel, std::set<Idx>& tb,
 
 // case1: shared controllable
 //relCase_1(B, rel, tb, todo)
-void SOE::relCase_1(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo) 
+void SOE::relCase_1(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo) 
 {
 
   //helpers
   std::stack<Idx> stodo;
-  std::set<Idx>::iterator sit;
+  std::set<Idx>::const_iterator sit;
   std::vector<Idx>::iterator vit;
-  std::set<Pnode*>::iterator roIt;
-
-  // find the related pnode which include the states in "rel"
-  sit=rel.pre.begin();
-  for(; sit!=rel.pre.end(); ++sit) {
-    roIt=ro.begin();
-    for(; roIt!=ro.end(); ++roIt) {
-      if((*roIt)->states.find(*sit)!=(*roIt)->states.end()) {
-	todo.push(*roIt);
-	break;
-      }
-    }
-  }
 
   // part1: near
-  sit=B.states.begin();
-  for(;sit!=B.states.end();++sit) {
+  sit=B.begin();
+  for(;sit!=B.end();++sit) {
     vit=states[*sit].shaconPre[rel.ev].begin();
     for(;vit!=states[*sit].shaconPre[rel.ev].end();++vit) 
       stodo.push(*vit);
@@ -685,7 +599,7 @@ void SOE::relCase_1(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo)
     // local controllable + condition
     vit=states[idx].locconPre.begin();
     for(;vit!=states[idx].locconPre.end();++vit)
-      if(todo.top()->states.find(*vit)!=todo.top()->states.end())
+      if(block(*vit)==todo.back())
 	stodo.push(*vit);
   }
 
@@ -693,32 +607,19 @@ void SOE::relCase_1(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo)
 
 // case2: shared uncontrollable
 // relCase_2(B, rel, tb, todo)
-void SOE::relCase_2(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo) 
+void SOE::relCase_2(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo) 
 {
 
   //helpers
-  std::set<Idx>::iterator sit;
+  std::set<Idx>::const_iterator sit;
   std::vector<Idx>::iterator vit;
-  std::set<Pnode*>::iterator roIt;
-
-  // find the related pnode which include the states in "rel"
-  sit=rel.pre.begin();
-  for(; sit!=rel.pre.end(); ++sit) {
-    roIt=ro.begin();
-    for(; roIt!=ro.end(); ++roIt) {
-      if((*roIt)->states.find(*sit)!=(*roIt)->states.end()) {
-	todo.push(*roIt);
-	break;
-      }
-    }
-  }
 
   // part 1.1 (near)
   tb=rel.pre;
 
   // part 1.2 (far)
-  sit=B.states.begin();
-  for(; sit != B.states.end(); ++sit) {
+  sit=B.begin();
+  for(; sit != B.end(); ++sit) {
     vit=states[*sit].shauncPres[rel.ev].begin();
     for(; vit!=states[*sit].shauncPres[rel.ev].end(); ++vit) tb.insert(*vit);
   }
@@ -734,33 +635,20 @@ void SOE::relCase_2(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo)
 
 // case3: local controllable
 //relCase_3(B, rel, tb, todo)
-void SOE::relCase_3(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo) 
+void SOE::relCase_3(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo) 
 {
 
   //helpers
   std::stack<Idx> stodo;
-  std::set<Idx>::iterator sit;
+  std::set<Idx>::const_iterator sit;
   std::vector<Idx>::iterator vit;
-  std::set<Pnode*>::iterator roIt;
-
-  // find the related pnode which include the states in "rel"
-  sit=rel.pre.begin();
-  for(; sit!=rel.pre.end(); ++sit) {
-    roIt=ro.begin();
-    for(; roIt!=ro.end(); ++roIt) {
-      if((*roIt)->states.find(*sit)!=(*roIt)->states.end()) {
-	todo.push(*roIt);
-	break;
-      }
-    }
-  }
 
   // all states in B belongs to "tb"
-  tb=B.states;
+  tb=B;
 
   // Part1; near 
-  sit=B.states.begin();
-  for(; sit!=B.states.end(); ++sit) {
+  sit=B.begin();
+  for(; sit!=B.end(); ++sit) {
     vit=states[*sit].locconPre.begin();
     for(; vit != states[*sit].locconPre.end(); ++vit) 
       stodo.push(*vit);
@@ -779,7 +667,7 @@ void SOE::relCase_3(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo)
     // local controllable + condition
     vit=states[idx].locconPre.begin();
     for(;vit!=states[idx].locconPre.end();++vit)
-      if(todo.top()->states.find(*vit)!=todo.top()->states.end())
+      if(block(*vit)==todo.back())
 	stodo.push(*vit);
   }
 
@@ -787,32 +675,19 @@ void SOE::relCase_3(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo)
 
 // case 4: local uncontrollable 
 // relCase_4(B, rel, tb, todo)
-void SOE::relCase_4(Pnode& B, Relation& rel, set<Idx>& tb, stack<Pnode*>& todo)
+void SOE::relCase_4(const std::set<Idx>& B, Relation& rel, set<Idx>& tb, vector<Idx>& todo)
 {
 
   // helpers
   std::vector<Idx>::iterator vit;
-  std::set<Idx>::iterator sit;
-  std::set<Pnode*>::iterator roIt;
-
-  // find the related pnode which include the states in "rel"
-  sit=rel.pre.begin();
-  for(; sit!=rel.pre.end(); ++sit) {
-    roIt=ro.begin();
-    for(; roIt!=ro.end(); ++roIt) {
-      if((*roIt)->states.find(*sit)!=(*roIt)->states.end()) {
-	todo.push(*roIt);
-	break;
-      }
-    }
-  }
+  std::set<Idx>::const_iterator sit;
 
   // part1: B himself
-  tb=B.states;
+  tb=B;
 
   // Part2:collect equivalent states to tb w.r.t. this case
-  sit=B.states.begin();
-  for(; sit != B.states.end(); ++sit) {
+  sit=B.begin();
+  for(; sit != B.end(); ++sit) {
     vit=states[*sit].locuncPres.begin();
     for(; vit != states[*sit].locuncPres.end(); ++vit) 
       tb.insert(*vit);
@@ -825,12 +700,9 @@ void SOE::refine()
 {
   FD_DF("SOE::refine()");    
 
-  //helpers
-  std::set<Pnode*>::iterator roDivIt;
-
   while(!roDividers.empty()) {
-    roDivIt=roDividers.begin();
-    partitionClass(**roDivIt);      
+    FD_WPC(blocks.z-roDividers.size(), blocks.z, "SOE: blocks/dividers:   " << blocks.z << " / " << roDividers.size());
+    partitionClass(*roDividers.begin());      
   }
 }
 
@@ -845,38 +717,38 @@ void SOE::partition(std::map<Idx,Idx>& rMapStateToPartition, Generator& rGenPart
   rGenPart.Name(gen->Name());
   rMapStateToPartition.clear();
 
-  // loop over all elements of ro and create a new state for every coset in ro (ro contains the set of equivalence classes)
-  std::set<Pnode*>::iterator cRoIt    = ro.begin();
-  std::set<Pnode*>::iterator cRoItEnd = ro.end();
-  std::set<Idx>::iterator cSIt;
-  std::set<Idx>::iterator cSItEnd;
-
-
-  for(; cRoIt != cRoItEnd; ++cRoIt) {
+  // loop over all blocks in order of their least state and create a new state for every block
+  std::vector<Idx> newstates(blocks.z,0);
+  std::vector<Idx> members;
+  Idx st=1;
+  for(; st<states.size(); ++st) {
+    Idx b=block(st);
+    if(newstates[b]!=0) continue;
     // have a new state
     std::ostringstream ostr;
- 
     Idx newstate = rGenPart.InsState();
+    newstates[b]=newstate;
  
-    // loop over all original states in current coset
-    cSIt=(*cRoIt)->states.begin();
-    cSItEnd=(*cRoIt)->states.end();        
-    for(; cSIt != cSItEnd; ++cSIt)  {
+    // loop over all original states in current block
+    members.assign(blocks.E.begin()+blocks.F[b],blocks.E.begin()+blocks.P[b]);
+    std::sort(members.begin(),members.end());
+    std::vector<Idx>::iterator cSIt=members.begin();
+    for(; cSIt != members.end(); ++cSIt)  {
       // retrieve source state idx
-      Idx st=states[*cSIt].idx;
+      Idx ost=states[*cSIt+1].idx;
       // map every state of the original generator to its equivalence class (= state in rGenPart) 
       // by creating an entry in the map rMapStateToPartition 
-      rMapStateToPartition[st] = newstate;       
+      rMapStateToPartition[ost] = newstate;       
       // set state names for resulting generator
       if(rGenPart.StateNamesEnabled()) { 
-        if(gen->StateName(st)!="") ostr << gen->StateName(st) << ",";
-        else ostr << st << ",";
+        if(gen->StateName(ost)!="") ostr << gen->StateName(ost) << ",";
+        else ostr << ost << ",";
       }
       // set init states
-      if(gen->ExistsInitState(st)) 
+      if(gen->ExistsInitState(ost)) 
   	rGenPart.SetInitState(newstate);
       // set marked states
-      if(gen->ExistsMarkedState(st)) 
+      if(gen->ExistsMarkedState(ost)) 
  	rGenPart.SetMarkedState(newstate);
     }
  
@@ -905,7 +777,7 @@ void SOE::partition(std::map<Idx,Idx>& rMapStateToPartition, Generator& rGenPart
 /*
 ********************************************* 
 ********************************************* 
-PART 3: application interface
+PART 2: application interface
 
 Minimal application interface based on plain functions.
 ********************************************* 
@@ -81,6 +81,49 @@ int main() {
   supervisor.DWrite();
   std::cout << "################################\n";
 
+  // Validate supervisor by alternating closed-loop synthesis and trim until the candidate settles
+  Generator altsup;
+  SupConClosed(cplant,specification,altsup);
+  Idx altsize=0;
+  while(altsize!=altsup.Size()) {
+    altsize=altsup.Size();
+    Trim(altsup);
+    SupConClosed(cplant,altsup,altsup);
+  }
+  bool supeq = LanguageEquality(altsup,supervisor);
+
+  // Report to console
+  std::cout << "################################\n";
+  std::cout << "# tutorial, validate supervisor \n";
+  std::cout << "# alternating closed-loop synthesis and trim: " << (supeq ? "match" : "FAIL") << "\n";
+  std::cout << "################################\n";
+
+  // Test controllability; the specification disables uncontrollable events
+  std::vector<Idx> counterexample;
+  bool ctrl_sup = IsControllable(cplant,contevents,supervisor);
+  bool ctrl_spec = IsControllable(cplant,contevents,specification,counterexample);
+
+  // Report to console
+  std::cout << "################################\n";
+  std::cout << "# tutorial, controllability \n";
+  std::cout << "# supervisor: " << (ctrl_sup ? "controllable" : "not controllable") << "\n";
+  std::cout << "# specification: " << (ctrl_spec ? "controllable" : "not controllable") << "\n";
+  std::string counterexample_str;
+  for(std::size_t i=0; i<counterexample.size(); ++i) 
+    counterexample_str += (i>0 ? " " : "") + cplant.EventName(counterexample[i]);
+  std::cout << "# counter example: " << counterexample_str << "\n";
+  std::cout << "################################\n";
+
+  // Record test case
+  FAUDES_TEST_DUMP("supervisor",supervisor);
+  FAUDES_TEST_DUMP("supervisor validation",supeq);
+  FAUDES_TEST_DUMP("controllable supervisor",ctrl_sup);
+  FAUDES_TEST_DUMP("controllable specification",ctrl_spec);
+  FAUDES_TEST_DUMP("counter example",counterexample_str);
+
+  // Validate result
+  FAUDES_TEST_DIFF();
+
   return 0;
 }
 
@@ -194,6 +194,134 @@ int main() {
   std::cout <<"the supervisor is " << (my_iscon?"":" not ") << "controllable\n";
   std::cout <<"the supervisor is " << (my_isNB?"":" not ") << "nonblocking\n";
 
+  ////////////////////////////////////////////////////////////////
+  // Multiple threads
+  ////////////////////////////////////////////////////////////////
+
+  // run again with 4 worker threads; the result must not depend on the number of threads 
+  std::map<faudes::Idx,faudes::Idx> MapEventsToPlant4;
+  faudes::GeneratorVector DisGenVec4; 
+  faudes::GeneratorVector SupGenVec4; 
+  faudes::Context ctx4;
+  ctx4.Threads(4);
+  {
+    faudes::ContextScope scope4(&ctx4);
+    CompositionalSynthesis(PlantGenVec, ConAlph, SpecGenVec, 
+	     MapEventsToPlant4, DisGenVec4, SupGenVec4);
+  }
+
+  // compare with the sequential run
+  bool my_threads = (MapEventsToPlant4 == MapEventsToPlant) &&
+    (DisGenVec4.Size() == DisGenVec.Size()) && (SupGenVec4.Size() == SupGenVec.Size());
+  for(i=0; my_threads && (i < DisGenVec.Size()); ++i) 
+    my_threads = (DisGenVec4.At(i).TransRel() == DisGenVec.At(i).TransRel());
+  for(i=0; my_threads && (i < SupGenVec.Size()); ++i) 
+    my_threads = (SupGenVec4.At(i).TransRel() == SupGenVec.At(i).TransRel()) &&
+      (SupGenVec4.At(i).MarkedStates() == SupGenVec.At(i).MarkedStates());
+
+  // LOG
+  FAUDES_TEST_DUMP("Threads Test",my_threads);
+
+  // SHOW
+  std::cout <<"the result with 4 threads " << (my_threads?"matches":"does not match") << " the sequential run\n";
+
+  ////////////////////////////////////////////////////////////////
+  // Edge case: plant components that share no events
+  ////////////////////////////////////////////////////////////////
+
+  // three independent machines "take/put", the specification only refers to the first one;
+  // the unrelated machines have local events only and must vanish in the preprocessing,
+  // i.e., there is no subsystem selection with an empty set of candidates 
+  faudes::GeneratorVector IndPlantGenVec;
+  faudes::EventSet IndConAlph;
+  for(int m=1; m<=3; ++m) {
+    faudes::Generator machine;
+    std::string take = "take_" + faudes::ToStringInteger(m);
+    std::string put = "put_" + faudes::ToStringInteger(m);
+    machine.InsEvent(take);
+    machine.InsEvent(put);
+    machine.InsInitState("idle");
+    machine.SetMarkedState("idle");
+    machine.InsState("busy");
+    machine.SetTransition("idle",take,"busy");
+    machine.SetTransition("busy",put,"idle");
+    IndPlantGenVec.PushBack(machine);
+    IndConAlph.Insert(take);
+  }
+  faudes::Generator once;
+  once.InsEvent("take_1");
+  once.InsEvent("put_1");
+  once.InsInitState("ready");
+  once.InsMarkedState("done");
+  once.SetTransition("ready","take_1","done");
+  once.SetTransition("done","put_1","done");
+  faudes::GeneratorVector IndSpecGenVec;
+  IndSpecGenVec.PushBack(once);
+
+  // run algorithm
+  std::map<faudes::Idx,faudes::Idx> IndMapEventsToPlant;
+  faudes::GeneratorVector IndDisGenVec; 
+  faudes::GeneratorVector IndSupGenVec; 
+  CompositionalSynthesis(IndPlantGenVec, IndConAlph, IndSpecGenVec, 
+	   IndMapEventsToPlant, IndDisGenVec, IndSupGenVec);
+
+  // test result
+  faudes::Generator IndPlant, IndClosed;
+  faudes::aParallel(IndPlantGenVec, IndPlant);
+  faudes::aParallel(IndSupGenVec, IndClosed);
+  bool my_indcon = faudes::IsControllable(IndPlant, IndConAlph, IndClosed);
+  bool my_indNB = faudes::IsNonblocking(IndClosed);
+
+  // LOG
+  FAUDES_TEST_DUMP("Independent Monolithic",IndClosed);
+  FAUDES_TEST_DUMP("Independent Controllability",my_indcon);
+  FAUDES_TEST_DUMP("Independent Nonblocking",my_indNB);
+
+  // SHOW
+  std::cout <<"independent components: #" << IndSupGenVec.Size() << " supervisors with #" 
+	    << IndClosed.Size() << " states, controllable " << my_indcon << ", nonblocking " << my_indNB << "\n";
+
+  ////////////////////////////////////////////////////////////////
+  // Synthesis observation equivalence
+  ////////////////////////////////////////////////////////////////
+
+  // state 1 enables the shared controllable event c, state 4 does not; 4 is reached from 1
+  // by a local uncontrollable event, so the refinement must revisit the dividers whose
+  // local controllable far part depends on a block that has been split later on
+  faudes::System soegen;
+  soegen.Name("soe example");
+  soegen.InsEvent("a");
+  soegen.InsEvent("b");
+  soegen.InsControllableEvent("c");
+  soegen.InsControllableEvent("d");
+  soegen.InsControllableEvent("e");
+  for(faudes::Idx s=1; s<=5; ++s) soegen.InsState(s);
+  soegen.SetTransition(1,soegen.EventIndex("b"),4);
+  soegen.SetTransition(1,soegen.EventIndex("c"),3);
+  soegen.SetTransition(1,soegen.EventIndex("c"),5);
+  soegen.SetTransition(2,soegen.EventIndex("e"),1);
+  soegen.SetTransition(3,soegen.EventIndex("d"),2);
+  soegen.SetTransition(4,soegen.EventIndex("a"),2);
+  soegen.SetTransition(4,soegen.EventIndex("a"),3);
+  soegen.SetInitState(1);
+  soegen.SetMarkedState(3);
+  faudes::EventSet soeloc;
+  soeloc.Insert("a");
+  soeloc.Insert("b");
+  soeloc.Insert("e");
+
+  // compute abstraction
+  std::map<faudes::Idx,faudes::Idx> soemap;
+  faudes::Generator soeabs;
+  faudes::ComputeSynthObsEquiv(soegen, soegen.ControllableEvents(), soeloc, soemap, soeabs);
+
+  // LOG
+  FAUDES_TEST_DUMP("SOE Abstraction",soeabs);
+
+  // SHOW
+  std::cout <<"synthesis observation equivalence: #" << soegen.Size() << " states, #" 
+	    << soeabs.Size() << " classes\n";
+
   FAUDES_TEST_DIFF();
 
   return 0;
@@ -885,6 +885,8 @@ TEMP void THIS::InsClocks(const ClockSet& clockset) {
 // DelClock(index)
 TEMP bool THIS::DelClock(Idx clockindex) {
   FD_DG("TimedGenerator(" << this << ")::DelClock(" << clockindex << ")");
+  BASE::pTransRel->Detach();
+  BASE::pStates->Detach();
   TransSet::Iterator tit;
   for(tit=BASE::TransRelBegin(); tit!=BASE::TransRelEnd(); tit++) {
     if(!BASE::pTransRel->Attribute(*tit).IsDefault()) {
@@ -936,7 +936,9 @@ TEMP void THIS::DoCopy(const TaGenerator& rGen) {
   mStateNamesEnabled=rGen.mStateNamesEnabled;
   mReindexOnWrite=rGen.mReindexOnWrite;
   // copy add on stuff
-  mMinStateIndexMap=rGen.mMinStateIndexMap;
+  mMinStateIndexOrder=rGen.mMinStateIndexOrder;
+  mMinStateIndexSect[0]=rGen.mMinStateIndexSect[0];
+  mMinStateIndexSect[1]=rGen.mMinStateIndexSect[1];
 #ifdef FAUDES_DEBUG_CODE
   if(!Valid()) {
     FD_DG("TaGenerator()::DoCopy(): invalid generator");
@@ -0,0 +1,108 @@
+/** @file cfl_allocator.cpp Memory pool for node based STL containers */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#include "cfl_allocator.h"
+
+namespace faudes {
+
+// first and maximum block size (bytes)
+#define FAUDES_POOL_MINBLOCK (16*1024)
+#define FAUDES_POOL_MAXBLOCK (4*1024*1024)
+
+// pool of the innermost scope, per thread
+static thread_local MemoryPool* gCurrentPool=0;
+
+// construct
+MemoryPool::MemoryPool(void) :
+  mPos(0),
+  mEnd(0),
+  mBlockSize(FAUDES_POOL_MINBLOCK),
+  mCapacity(0),
+  mRefCount(0)
+{
+  for(std::size_t i=0; i<ClassCount; ++i) mFree[i]=0;
+}
+
+// destruct
+MemoryPool::~MemoryPool(void) {
+  for(std::size_t i=0; i<mBlocks.size(); ++i)
+    ::operator delete(mBlocks[i]);
+}
+
+// carve chunk from current block
+void* MemoryPool::Carve(std::size_t size) {
+  if(mPos+size > mEnd) {
+    // put the remainder of the current block to use
+    while(mPos+16 <= mEnd) {
+      std::size_t rem=mEnd-mPos;
+      std::size_t cls= rem>>4;
+      if(cls>=ClassCount) cls=ClassCount-1;
+      *reinterpret_cast<void**>(mPos)=mFree[cls];
+      mFree[cls]=mPos;
+      mPos+=cls<<4;
+    }
+    // get new block, double size up to max
+    char* block=static_cast<char*>(::operator new(mBlockSize));
+    mBlocks.push_back(block);
+    mCapacity+=mBlockSize;
+    mPos=block;
+    mEnd=block+mBlockSize;
+    if(mBlockSize<FAUDES_POOL_MAXBLOCK) mBlockSize*=2;
+  }
+  void* res=mPos;
+  mPos+=size;
+  return res;
+}
+
+// current pool
+MemoryPool* MemoryPool::Current(void) {
+  return gCurrentPool;
+}
+
+// install current pool
+void MemoryPool::Current(MemoryPool* pool) {
+  gCurrentPool=pool;
+}
+
+// open scope with fresh pool
+MemoryPoolScope::MemoryPoolScope(void) {
+  pPool=new MemoryPool();
+  pPool->Reference();
+  pPrevious=MemoryPool::Current();
+  MemoryPool::Current(pPool);
+}
+
+// open scope with existing pool
+MemoryPoolScope::MemoryPoolScope(MemoryPool* pool) {
+  pPool=pool;
+  if(pPool) pPool->Reference();
+  pPrevious=MemoryPool::Current();
+  MemoryPool::Current(pPool);
+}
+
+// close scope
+MemoryPoolScope::~MemoryPoolScope(void) {
+  MemoryPool::Current(pPrevious);
+  if(pPool) pPool->Release();
+}
+
+} // namespace faudes
@@ -0,0 +1,258 @@
+/** @file cfl_allocator.h Memory pool for node based STL containers */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#ifndef FAUDES_ALLOCATOR_H
+#define FAUDES_ALLOCATOR_H
+
+#include "cfl_definitions.h"
+#include "cfl_platform.h"
+
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace faudes {
+
+/**
+ * Memory pool for container nodes.
+ *
+ * A MemoryPool hands out small chunks of memory carved from large blocks. Chunks
+ * are organised in size classes (multiples of 16 bytes up to 256 bytes); deallocated
+ * chunks are kept on a free list per class for re-use, and all blocks are given back
+ * to the system in one go when the pool is destroyed. Larger requests are passed on to
+ * the global operator new.
+ *
+ * Pools are meant to back the STL sets and maps that implement TBaseSet and TAttrMap,
+ * see PoolAllocator and MemoryPoolScope. They are reference counted: any container
+ * that allocates from a pool holds a reference, so the pool lives as long as the last
+ * such container. The reference count is atomic, i.e., allocators referring to a pool
+ * may be created and destroyed concurrently by different threads. Allocation and
+ * deallocation are not synchronised, i.e., all containers that allocate from a pool must
+ * be operated by one thread at a time.
+ *
+ * @ingroup ContainerClasses
+ */
+class FAUDES_API MemoryPool {
+
+public:
+
+  /** Construct empty pool (reference count 0) */
+  MemoryPool(void);
+
+  /** Destruct pool, release all blocks */
+  ~MemoryPool(void);
+
+  /** Allocate chunk of specified size */
+  void* Allocate(std::size_t size) {
+    std::size_t cls=(size+15)>>4;
+    if(cls>=ClassCount) return ::operator new(size);
+    void* res=mFree[cls];
+    if(res) { mFree[cls]=*static_cast<void**>(res); return res;}
+    return Carve(cls<<4);
+  }
+
+  /** Deallocate chunk of specified size */
+  void Deallocate(void* p, std::size_t size) {
+    std::size_t cls=(size+15)>>4;
+    if(cls>=ClassCount) { ::operator delete(p); return;}
+    *static_cast<void**>(p)=mFree[cls];
+    mFree[cls]=p;
+  }
+
+  /** Register a reference */
+  void Reference(void) { mRefCount.fetch_add(1,std::memory_order_relaxed); }
+
+  /** Unregister a reference, destroy pool when not referenced anymore */
+  void Release(void) { if(mRefCount.fetch_sub(1,std::memory_order_acq_rel)==1) delete this; }
+
+  /** Total size of blocks obtained from the system (bytes) */
+  std::size_t Capacity(void) const { return mCapacity; }
+
+  /**
+   * Pool to use for new containers.
+   *
+   * @return
+   *   Pool installed by the innermost active MemoryPoolScope of the calling
+   *   thread, or NULL for the global heap.
+   */
+  static MemoryPool* Current(void);
+
+  /** Install current pool (see MemoryPoolScope) */
+  static void Current(MemoryPool* pool);
+
+private:
+
+  /** Number of size classes */
+  static const std::size_t ClassCount=17;
+
+  /** Get chunk from current block, allocate a new block if required */
+  void* Carve(std::size_t size);
+
+  /** Free list heads per size class */
+  void* mFree[ClassCount];
+
+  /** Blocks obtained from the system */
+  std::vector<char*> mBlocks;
+
+  /** Remaining range in current block */
+  char* mPos;
+  char* mEnd;
+
+  /** Size of next block */
+  std::size_t mBlockSize;
+
+  /** Accumulated block size */
+  std::size_t mCapacity;
+
+  /** Reference count (atomic) */
+  std::atomic<std::size_t> mRefCount;
+
+  /** Not copyable */
+  MemoryPool(const MemoryPool&);
+  MemoryPool& operator=(const MemoryPool&);
+};
+
+
+/**
+ * Scope for container memory.
+ *
+ * While a MemoryPoolScope is alive, any TBaseSet or TAttrMap that allocates its
+ * STL container uses the scope's pool for all its nodes. Note that, due to copy-on-write,
+ * sets allocate their container on the first write access, not on construction.
+ * Typically, a scope is opened for one algorithm run or for the construction
+ * of one large generator:
+ *
+ * @code
+ * Generator res;
+ * {
+ *   MemoryPoolScope scope;
+ *   Generator tmp;
+ *   Parallel(g1,g2,tmp);       // sets of tmp allocate from the pool
+ *   Project(tmp,sigo,res);     // so do the sets of res
+ * }                            // tmp is gone, its nodes are recycled within the pool
+ * res.Clear();                 // last reference gone, blocks are released in one go
+ * @endcode
+ *
+ * Containers hold a reference to the pool they allocate from, so it is safe for
+ * them to outlive the scope; the pool is then released with the last container.
+ * Scopes nest and are local to the calling thread.
+ *
+ * @ingroup ContainerClasses
+ */
+class FAUDES_API MemoryPoolScope {
+public:
+  /** Open scope with a fresh pool */
+  MemoryPoolScope(void);
+  /** Open scope with a pool from another scope */
+  explicit MemoryPoolScope(MemoryPool* pool);
+  /** Close scope, restore previous pool */
+  ~MemoryPoolScope(void);
+  /** Pool of this scope */
+  MemoryPool* Pool(void) const { return pPool; }
+private:
+  MemoryPool* pPool;
+  MemoryPool* pPrevious;
+  MemoryPoolScope(const MemoryPoolScope&);
+  MemoryPoolScope& operator=(const MemoryPoolScope&);
+};
+
+
+/**
+ * STL allocator to operate on a MemoryPool.
+ *
+ * The pool is taken from MemoryPoolScope when the allocator is default
+ * constructed, and is passed on by copy and rebind. A NULL pool refers to
+ * the global heap. Allocators compare equal if they refer to the same pool.
+ *
+ * @ingroup ContainerClasses
+ */
+template<class T>
+class PoolAllocator {
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  template<class U> struct rebind { typedef PoolAllocator<U> other; };
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+  /** Construct with pool from current scope */
+  PoolAllocator(void) : pPool(MemoryPool::Current()) { if(pPool) pPool->Reference(); }
+  /** Construct with explicit pool */
+  explicit PoolAllocator(MemoryPool* pool) : pPool(pool) { if(pPool) pPool->Reference(); }
+  /** Copy construct */
+  PoolAllocator(const PoolAllocator& rOther) : pPool(rOther.pPool) { if(pPool) pPool->Reference(); }
+  /** Rebind construct */
+  template<class U>
+  PoolAllocator(const PoolAllocator<U>& rOther) : pPool(rOther.Pool()) { if(pPool) pPool->Reference(); }
+  /** Assign */
+  PoolAllocator& operator=(const PoolAllocator& rOther) {
+    if(rOther.pPool) rOther.pPool->Reference();
+    if(pPool) pPool->Release();
+    pPool=rOther.pPool;
+    return *this;
+  }
+  /** Destruct */
+  ~PoolAllocator(void) { if(pPool) pPool->Release(); }
+  /** Allocate memory for n objects */
+  T* allocate(std::size_t n, const void* hint=0) {
+    (void) hint;
+    if(!pPool) return static_cast<T*>(::operator new(n*sizeof(T)));
+    return static_cast<T*>(pPool->Allocate(n*sizeof(T)));
+  }
+  /** Deallocate memory for n objects */
+  void deallocate(T* p, std::size_t n) {
+    if(!pPool) { ::operator delete(p); return; }
+    pPool->Deallocate(p,n*sizeof(T));
+  }
+  /** Max size */
+  std::size_t max_size(void) const { return std::size_t(-1) / sizeof(T); }
+  /** Construct object (pre C++11 interface) */
+  template<class U, class... Args>
+  void construct(U* p, Args&&... args) { ::new((void*)p) U(std::forward<Args>(args)...); }
+  /** Destroy object (pre C++11 interface) */
+  template<class U>
+  void destroy(U* p) { p->~U(); }
+  /** Pool to allocate from */
+  MemoryPool* Pool(void) const { return pPool; }
+private:
+  MemoryPool* pPool;
+};
+
+/** Allocators are equal if they share the pool */
+template<class T, class U>
+bool operator==(const PoolAllocator<T>& rA, const PoolAllocator<U>& rB) { return rA.Pool()==rB.Pool(); }
+
+/** Allocators are equal if they share the pool */
+template<class T, class U>
+bool operator!=(const PoolAllocator<T>& rA, const PoolAllocator<U>& rB) { return rA.Pool()!=rB.Pool(); }
+
+
+} // namespace faudes
+
+#endif
@@ -374,9 +374,8 @@ TEMP bool THIS::Erase(const T& rElem) {
 
 //Erase(it)
 TEMP  typename TBaseSet<T,Cmp>::Iterator THIS::Erase(const typename TBaseSet<T,Cmp>::Iterator& pos) {
-  pBaseSet->Detach();
-  iterator del= pos.StlIterator(); 
-  pBaseSet->DoAttribute(*pos,(const AttributeVoid*) 0);
+  iterator del= pBaseSet->DetachPos(pos); 
+  pBaseSet->DoAttribute(*del,(const AttributeVoid*) 0);
   pBaseSet->pSet->erase(del++);
   return pBaseSet->ThisIterator(del); 
 }
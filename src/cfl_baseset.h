@@ -31,6 +31,7 @@
 #include "cfl_registry.h"
 #include "cfl_types.h"
 #include "cfl_attributes.h"
+#include "cfl_allocator.h"
 #include <set>
 #include <algorithm>
 
@@ -111,6 +112,12 @@ public:
   /** allow access to attribute interface class */
   template<class TP, class AP, class CP> friend class TAttrMap;
 
+  /** STL set to hold elements, nodes allocated from the current MemoryPool */
+  typedef std::set<T,Cmp,PoolAllocator<T> > StlSet;
+
+  /** STL map to hold attributes, nodes allocated from the current MemoryPool */
+  typedef std::map<T,AttributeVoid*,std::less<T>,PoolAllocator< std::pair<const T,AttributeVoid*> > > StlAttributeMap;
+
 
   /**
    * Constructor. 
@@ -399,13 +406,22 @@ public:
   /** Some validation of deferred copy mechanism (provoke abort)*/
   void DValid(const std::string& rMessage="") const;
 
-  /** Detach from extern storage (incl allocation and true copy) */
+  /**
+   * Detach from extern storage (incl allocation and true copy).
+   *
+   * Any write access detaches the set implicitly. Call Detach() explicitly before you
+   * modify a set (incl. its attributes) while holding further iterators on it, e.g., a
+   * cached end iterator or the erase(it++) idiom. Otherwise, the first write may reallocate
+   * the set and, with FAUDES_ITERATOR_EPOCH, invalidate those iterators.
+   */
   enum DetachMode { SetOnly, AttrIncl };  
   void Detach(DetachMode flag=AttrIncl) const;
 
   /** Detach and lock any further reallocation (not reversable)*/
   void Lock(void) const;
 
+#ifndef FAUDES_ITERATOR_EPOCH
+
   /** 
    * Iterator class for high-level API to TBaseSet.
    * This class is derived from STL iterators to additionally provide a reference of the
@@ -419,11 +435,11 @@ public:
    * class, you may turn to public inheritance. Make sure to Lock the relevant sets befor
    * applying any STL algorithms.
    */
-   class Iterator : private std::set<T,Cmp>::const_iterator {
+   class Iterator : private StlSet::const_iterator {
      public: 
      /** Default constructor, container unknown */
      Iterator() : 
-       std::set<T,Cmp>::const_iterator() , 
+       StlSet::const_iterator() , 
        pBaseSet(NULL),
        mAttached(false) 
      {};
@@ -431,9 +447,9 @@ public:
      /** Construct by members (used by TBaseSet to create temporary iterators) */
      Iterator(
        const TBaseSet<T,Cmp>* pBaseSet,
-       const typename std::set<T,Cmp>::const_iterator& sit,
+       const typename StlSet::const_iterator& sit,
        bool att=false) : 
-       std::set<T,Cmp>::const_iterator(sit), 
+       StlSet::const_iterator(sit), 
        pBaseSet(pBaseSet),
        mAttached(false)  
      {
@@ -445,7 +461,7 @@ public:
 
      /** Copy constructor, copies container reference, incl attach */
      Iterator(const Iterator& fit) : 
-       std::set<T,Cmp>::const_iterator(fit),
+       StlSet::const_iterator(fit),
        pBaseSet(fit.pBaseSet), 
        mAttached(false) 
      {
@@ -479,12 +495,12 @@ public:
 #endif
        // performance relevant std case 
        if(mAttached) if(pBaseSet==rSrc.pBaseSet) {
-         std::set<T,Cmp>::const_iterator::operator= (rSrc);
+         StlSet::const_iterator::operator= (rSrc);
          return *this;
        }
        // general case
        if(mAttached) pBaseSet->DetachIterator(this);
-       std::set<T,Cmp>::const_iterator::operator= (rSrc);
+       StlSet::const_iterator::operator= (rSrc);
        pBaseSet = rSrc.pBaseSet;
        if(pBaseSet) {
          pBaseSet->AttachIterator(this);
@@ -496,12 +512,12 @@ public:
      };
 
      /** Set STL iterator only */
-     void  StlIterator(const typename std::set<T,Cmp>::const_iterator& sit) {
-       std::set<T,Cmp>::const_iterator::operator= (sit);
+     void  StlIterator(const typename StlSet::const_iterator& sit) {
+       StlSet::const_iterator::operator= (sit);
      };
 
      /** Get STL iterator only */
-     const typename std::set<T,Cmp>::const_iterator& StlIterator(void) const {
+     const typename StlSet::const_iterator& StlIterator(void) const {
        return *this;
      };
 
@@ -539,7 +555,7 @@ public:
          abort();
        }
 #endif
-       return std::set<T,Cmp>::const_iterator::operator-> ();
+       return StlSet::const_iterator::operator-> ();
      };
 
      /** Reimplement dereference */
@@ -550,7 +566,7 @@ public:
          abort();
        }
 #endif
-       return std::set<T,Cmp>::const_iterator::operator* ();
+       return StlSet::const_iterator::operator* ();
      };
 
      /** Reimplement == */
@@ -561,7 +577,7 @@ public:
          abort();
        }
 #endif
-       return *static_cast< const typename std::set<T,Cmp>::const_iterator *>(this) == rOther;
+       return *static_cast< const typename StlSet::const_iterator *>(this) == rOther;
      };
 
      /** Reimplement != */
@@ -572,7 +588,7 @@ public:
          abort();
        }
 #endif
-       return *static_cast< const typename std::set<T,Cmp>::const_iterator *>(this) != rOther;
+       return *static_cast< const typename StlSet::const_iterator *>(this) != rOther;
      };
 
      /** Reimplement postfix ++ */
@@ -584,7 +600,7 @@ public:
        }
 #endif
        Iterator old(pBaseSet,*this, true); // (tmoor 201308: very tricky issue in "erase(it++)" construct)
-       std::set<T,Cmp>::const_iterator::operator++ (step);
+       StlSet::const_iterator::operator++ (step);
        return old;
      };
 
@@ -596,7 +612,7 @@ public:
          abort();
        }
 #endif
-       std::set<T,Cmp>::const_iterator::operator++ ();
+       StlSet::const_iterator::operator++ ();
        return *this;
      };
 
@@ -609,7 +625,7 @@ public:
        }
 #endif
        Iterator old(pBaseSet, *this, true);
-       std::set<T,Cmp>::const_iterator::operator-- (step);
+       StlSet::const_iterator::operator-- (step);
        return old;
      };
 
@@ -621,7 +637,7 @@ public:
          abort();
        }
 #endif
-       std::set<T,Cmp>::const_iterator::operator-- ();
+       StlSet::const_iterator::operator-- ();
        return *this;
      };
 
@@ -640,53 +656,178 @@ public:
      bool mAttached;
    };
 
-#ifdef DONT_TRACK_REFERENCES
+#else
 
   /** 
-   * Iterator class for high-level api to TBaseSet.
-   * This version is a dummy and does not provide any additional features.
-   * Note: As of v2.34e Python bindings need the ityerator to at least track their BaseSet.
+   * Iterator class for high-level API to TBaseSet, lightweight version.
+   * With the compile-time option FAUDES_ITERATOR_EPOCH, iterators do not register with
+   * their container. Thus, construction, copy and destruction come at the cost of an STL
+   * iterator plus a reference to the container. On the downside, iterators can not be adjusted
+   * when the set gets reallocated due to a Detach() operation, i.e., on the first write access to
+   * a set that shares its data with other sets. Instead, each set maintains an epoch counter
+   * that is advanced on every reallocation, and all iterators obtained before become invalid. 
+   * In debug builds (FAUDES_DEBUG_CODE), iterators record the epoch of their container and
+   * abort on use after invalidation; release builds do not pay any per-iterator bookkeeping. 
+   * Set operations that take an iterator argument, e.g. Erase(pos), relocate their argument
+   * and are safe to use; i.e., use it=Erase(it) rather than the erase(it++) idiom, since the
+   * latter keeps the incremented iterator in the old data. If you need to keep further iterators
+   * while modifying a set, make sure to Detach() or Lock() the set beforehand.
    */
-   class Iterator : public std::set<T,Cmp>::const_iterator {
-     public:
-
-     /** Default contructor */
-     Iterator(void) : 
-       std::set<T,Cmp>::const_iterator()  
-     {}; 
-
-     /** Copy constructor  */
-     Iterator(const Iterator& fit) : 
-       std::set<T,Cmp>::const_iterator(fit)
-     {};
-
-     /** Copy constructor  */
-     Iterator(const typename std::set<T,Cmp>::const_iterator& sit) : 
-       std::set<T,Cmp>::const_iterator(sit)
+   class Iterator : private StlSet::const_iterator {
+     public: 
+     /** Default constructor, container unknown */
+     Iterator() : 
+       StlSet::const_iterator() , 
+       pBaseSet(NULL)
+#ifdef FAUDES_DEBUG_CODE
+       , mEpoch(0)
+#endif
      {};
 
-     /** Copy constructor, compatibility  */
+     /** Construct by members (used by TBaseSet to create temporary iterators) */
      Iterator(
        const TBaseSet<T,Cmp>* pBaseSet,
-       const typename std::set<T,Cmp>::const_iterator& sit) : 
-       std::set<T,Cmp>::const_iterator(sit) 
-     {};
+       const typename StlSet::const_iterator& sit,
+       bool att=false) : 
+       StlSet::const_iterator(sit), 
+       pBaseSet(pBaseSet)
+#ifdef FAUDES_DEBUG_CODE
+       , mEpoch(pBaseSet ? pBaseSet->mEpoch : 0)
+#endif
+     {
+       (void) att;
+     };
 
-     /** Copy STL iterator only, compatibility */
-     void  StlIterator(const typename std::set<T,Cmp>::const_iterator& sit) {
-       std::set<T,Cmp>::const_iterator::operator= (sit);
+     /** Report (debugging) */
+     std::string DStr(void) const {
+       std::stringstream rstr;
+       rstr << "[dit base " << pBaseSet;
+       if(pBaseSet) rstr << " data " << pBaseSet->pSet << " elem " << pBaseSet->Str(**this);
+       rstr << "]";
+       return rstr.str();
+     }
+
+     /** Set STL iterator only */
+     void  StlIterator(const typename StlSet::const_iterator& sit) {
+       StlSet::const_iterator::operator= (sit);
+     };
+
+     /** Get STL iterator only */
+     const typename StlSet::const_iterator& StlIterator(void) const {
+       return *this;
+     };
+
+     /** Invalidate */
+     void Invalidate(void) {
+       pBaseSet=NULL;
+     }; 
+
+     /** Detach (compatibility, nothing to do) */
+     void  Detach(void) {}; 
+
+     /** Check validity (no exception/abort*/
+     bool Valid(void) const {
+       if(pBaseSet==NULL) return false;
+       return !pBaseSet->IsEnd(*this);
+     }; 
+
+     /** Check validity (provoke abort error) */
+     void DValid(void) const {
+       DCheck("DValid()");
+       pBaseSet->DValid("Iterator");
      }; 
 
-     /** Get STL iterator only, compatibility */
-     const typename std::set<T,Cmp>::const_iterator& StlIterator(void) const {
+     /** Reimplement dereference */ 
+     const T* operator-> (void) const {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator->");
+#endif
+       return StlSet::const_iterator::operator-> ();
+     };
+
+     /** Reimplement dereference */
+     const T& operator* (void) const {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator*");
+#endif
+       return StlSet::const_iterator::operator* ();
+     };
+
+     /** Reimplement == */
+     bool operator== (const Iterator& rOther) const {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator==");
+#endif
+       return *static_cast< const typename StlSet::const_iterator *>(this) == rOther;
+     };
+
+     /** Reimplement != */
+     bool operator!= (const Iterator& rOther) const {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator!=");
+#endif
+       return *static_cast< const typename StlSet::const_iterator *>(this) != rOther;
+     };
+
+     /** Reimplement postfix ++ */
+     Iterator operator++ (int step) {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator++");
+#endif
+       Iterator old(*this);
+       StlSet::const_iterator::operator++ (step);
+       return old;
+     };
+
+     /** Reimplement prefix ++ */
+     const Iterator& operator++ (void) {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator++");
+#endif
+       StlSet::const_iterator::operator++ ();
        return *this;
      };
 
-     /** Invalidate (compatibility, not implemented) */
-     void  Invalidate(void) {};
+     /** Reimplement postfix -- */
+     Iterator operator-- (int step) {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator--");
+#endif
+       Iterator old(*this);
+       StlSet::const_iterator::operator-- (step);
+       return old;
+     };
+
+     /** Reimplement prefix -- */
+     const Iterator& operator-- (void) {
+#ifdef FAUDES_DEBUG_CODE
+       DCheck("operator--");
+#endif
+       StlSet::const_iterator::operator-- ();
+       return *this;
+     };
+
+     /** Abort on invalid iterator (debugging) */
+     void DCheck(const char* op) const {
+       if(pBaseSet==NULL) {
+         FD_ERR("TBaseSet<T,Cmp>::Iterator(" << this << "):" << op << ": invalid iterator: no baseset");
+         abort();
+       }
+#ifdef FAUDES_DEBUG_CODE
+       if(mEpoch!=pBaseSet->mEpoch) {
+         FD_ERR("TBaseSet<T,Cmp>::Iterator(" << this << "):" << op << ": invalid iterator: set reallocated since");
+         abort();
+       }
+#endif
+     };
+
+     /** Maintaine container reference */
+     const TBaseSet<T,Cmp>* pBaseSet;
 
-     /** Check validity (compatibitity, cannot tell) */
-     bool Valid(void) const {return false;};
+#ifdef FAUDES_DEBUG_CODE
+     /** Epoch of container when this iterator was obtained */
+     Idx mEpoch;
+#endif
    };
 
 #endif
@@ -1023,33 +1164,36 @@ protected:
 
 
   /** Pointer on STL set to operate on */
-  std::set<T,Cmp>* pSet;
+  StlSet* pSet;
 
   /** STL set, if this object hosts data (else NULL) */
-  std::set<T,Cmp>* mpSet;
+  StlSet* mpSet;
 
   /** STL iterator, non-const version */
-  typedef typename std::set<T,Cmp>::iterator iterator;
+  typedef typename StlSet::iterator iterator;
 
   /** STL iterator, const version */
-  typedef typename std::set<T,Cmp>::const_iterator const_iterator;
+  typedef typename StlSet::const_iterator const_iterator;
 
   /** Convert STL iterator to API iterator*/
-  typename TBaseSet<T,Cmp>::Iterator ThisIterator(const typename std::set<T,Cmp>::const_iterator& sit) const;
+  typename TBaseSet<T,Cmp>::Iterator ThisIterator(const typename StlSet::const_iterator& sit) const;
+
+  /** Detach and convert API iterator to STL iterator, relocated if the STL set was reallocated */
+  iterator DetachPos(const Iterator& pos, DetachMode flag=AttrIncl) const;
 
 
 
   /** Pointer to attribute map to operate on */
-  std::map<T,AttributeVoid*>* pAttributes;
+  StlAttributeMap* pAttributes;
 
   /** Attribute map, if this object hosts data (else NULL). */
-  std::map<T,AttributeVoid*>* mpAttributes;
+  StlAttributeMap* mpAttributes;
 
   /** STL attribute iterator, non-const version */
-  typedef typename std::map<T,AttributeVoid*>::iterator aiterator;
+  typedef typename StlAttributeMap::iterator aiterator;
 
   /** STL attribute iterator, const version */
-  typedef typename std::map<T,AttributeVoid*>::const_iterator const_aiterator;
+  typedef typename StlAttributeMap::const_iterator const_aiterator;
 
 
 
@@ -1078,6 +1222,7 @@ protected:
   /** Record that we stop providing data for some TBaseSet */
   void DetachClient(TBaseSet* pRef) const;
 
+#ifndef FAUDES_ITERATOR_EPOCH
   /** Iterators that refer to this TBaseSet */
   std::set< Iterator* > mIterators;
 
@@ -1086,18 +1231,22 @@ protected:
 
   /** Record that an iterator stops to refer to this TBaseSet */
   void DetachIterator(Iterator* pFit) const;
+#else
+  /** Epoch counter, advanced whenever pSet gets reallocated (invalidates iterators) */
+  Idx mEpoch;
+#endif
 
   /** construct and record static members (the fiasco) */
-  static std::set< T, Cmp > * GlobalEmptySet(void);
+  static StlSet* GlobalEmptySet(void);
 
   /** construct and record static members (the fiasco) */
-  static std::map< T, AttributeVoid* > * GlobalEmptyAttributes(void);
+  static StlAttributeMap* GlobalEmptyAttributes(void);
 
   /** construct and record static members (the fiasco) */
-  std::set< T, Cmp >* pGes;
+  StlSet* pGes;
 
   /** construct and record static members (the fiasco) */
-  std::map< T, AttributeVoid*  >* pGea;
+  StlAttributeMap* pGea;
 
 };
 
@@ -1267,9 +1416,9 @@ FAUDES_TYPE_TIMPLEMENTATION_MOVE(Void,THIS,ExtType,TEMP)
 FAUDES_TYPE_TIMPLEMENTATION_EQUAL(Void,THIS,ExtType,TEMP)
 
 
-// template static members (initialisation fiasco)
-TEMP std::set<T,Cmp> * THIS::GlobalEmptySet(void) {
-  static std::set<T,Cmp> ges;
+// template static members (initialisation fiasco; dont use the current pool)
+TEMP typename THIS::StlSet* THIS::GlobalEmptySet(void) {
+  static StlSet ges(Cmp(),PoolAllocator<T>(NULL));
 #ifdef FAUDES_DEBUG_CODE
   static bool done=false;
   if(!done) {
@@ -1280,9 +1429,9 @@ TEMP std::set<T,Cmp> * THIS::GlobalEmptySet(void) {
   return &ges;
 }  
 
-// template static members (initialisation fiasco)
-TEMP std::map< T,AttributeVoid* > * THIS::GlobalEmptyAttributes(void) {
-  static std::map<T,AttributeVoid*> gea;
+// template static members (initialisation fiasco; dont use the current pool)
+TEMP typename THIS::StlAttributeMap* THIS::GlobalEmptyAttributes(void) {
+  static StlAttributeMap gea(std::less<T>(),PoolAllocator< std::pair<const T,AttributeVoid*> >(NULL));
 #ifdef FAUDES_DEBUG_CODE
   static bool done=false;
   if(!done) {
@@ -1305,6 +1454,9 @@ TEMP THIS::TBaseSet(void) :
   mpClients(new std::list< TBaseSet<T,Cmp>* >),
   mDetached(false), 
   mLocked(false),
+#ifdef FAUDES_ITERATOR_EPOCH
+  mEpoch(0),
+#endif
   pGes(GlobalEmptySet()),
   pGea(GlobalEmptyAttributes())
 {
@@ -1353,11 +1505,13 @@ TEMP THIS::~TBaseSet(void) {
   pHostSet->DetachClient(this);
   if(mpClients) delete mpClients;
   mpClients=NULL;
+#ifndef FAUDES_ITERATOR_EPOCH
   // unlink iterators (mandatory, since referenced object will be destructed)
   typename std::set< Iterator* >::const_iterator iit;
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
     (**iit).Invalidate();
   }
+#endif
   // delete if we still own data
   if(mpSet) delete mpSet;
   if(mpAttributes) {
@@ -1412,10 +1566,10 @@ TEMP void THIS::DoCopy(const THIS& rSourceSet) {
   }
   // else do a deep copy (avoid mixed typed attribute maps)
   else {
-    mpSet = new std::set<T,Cmp>();
+    mpSet = new StlSet();
     *mpSet = *rSourceSet.pSet;     
     pSet = mpSet;
-    mpAttributes = new std::map<T,AttributeVoid*>();
+    mpAttributes = new StlAttributeMap();
     if(typeid(*this->AttributeType()) != typeid(const AttributeVoid)) {
       for(aiterator ait=rSourceSet.pAttributes->begin(); ait!=rSourceSet.pAttributes->end(); ++ait) {
         AttributeVoid* attr= ait->second->NewCpy();
@@ -1428,13 +1582,17 @@ TEMP void THIS::DoCopy(const THIS& rSourceSet) {
     mpClients= new std::list< TBaseSet<T,Cmp>* >; // still fixing bugs in 2025 (?)
   }
   // fix iterators (invalidate)
+#ifndef FAUDES_ITERATOR_EPOCH
   typename std::set< Iterator* >::iterator iit;
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
     (**iit).Invalidate();
   }
   mIterators.clear();
-  // record state
-  mDetached=false; 
+#else
+  mEpoch++;
+#endif
+  // record state (a deep copy owns its data)
+  mDetached=(pHostSet==this);
   // if we were locked, relock (i.e. do the copy)
   if(mLocked) {
     mLocked=false;
@@ -1482,11 +1640,11 @@ TEMP void THIS::Detach(DetachMode flag) const {
 #endif
 
   // prepare: construct a copy of my data -- the set
-  std::set<T,Cmp>* scopy = new std::set<T,Cmp>();
+  StlSet* scopy = new StlSet();
   *scopy = *pSet;     
 
   // prepare: construct a copy of my data -- the attribute map (optional)
-  std::map<T,AttributeVoid*>* acopy = new std::map<T,AttributeVoid*>();
+  StlAttributeMap* acopy = new StlAttributeMap();
   if(flag==AttrIncl) {
     for(aiterator ait=pAttributes->begin(); ait!=pAttributes->end(); ++ait) {
       AttributeVoid* attr= ait->second->NewCpy();
@@ -1522,6 +1680,7 @@ TEMP void THIS::Detach(DetachMode flag) const {
       (*rit)->pAttributes=newhost->pAttributes;
     }
     // fix newhost clients iterators 
+#ifndef FAUDES_ITERATOR_EPOCH
     typename std::set< Iterator* >::iterator iit;
     for(rit=newhost->mpClients->begin(); rit!=newhost->mpClients->end(); ++rit) {
       for(iit=(*rit)->mIterators.begin(); iit!=(*rit)->mIterators.end(); ++iit) {
@@ -1538,15 +1697,23 @@ TEMP void THIS::Detach(DetachMode flag) const {
       else
         **iit=Iterator(this, scopy->find(***iit));
     }
+#else
+    // invalidate newhost and clients iterators
+    for(rit=newhost->mpClients->begin(); rit!=newhost->mpClients->end(); ++rit) 
+      (*rit)->mEpoch++;
+    newhost->mEpoch++;
+#endif
     // make myself own the old data 
     fake_const->mpSet=pSet;
     fake_const->mpAttributes=pAttributes;
     fake_const->mpClients= new std::list< TBaseSet<T,Cmp>* >;
     fake_const->mDetached=true;    
+#ifndef FAUDES_ITERATOR_EPOCH
     // stop tracking my iterators
     for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) 
       (**iit).Detach();
     fake_const->mIterators.clear();
+#endif
 
 
   // stragie B: this baseset gets the copy; thus, the clients iterators
@@ -1562,6 +1729,7 @@ TEMP void THIS::Detach(DetachMode flag) const {
     fake_const->mpSet = scopy;
     fake_const->mpAttributes=acopy;  
     // fix my iterators
+#ifndef FAUDES_ITERATOR_EPOCH
     typename std::set< Iterator* >::iterator iit;
     for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
       if((**iit).StlIterator()==pSet->end()) 
@@ -1569,6 +1737,9 @@ TEMP void THIS::Detach(DetachMode flag) const {
       else
         **iit=Iterator(this, mpSet->find(***iit));
     }
+#else
+    fake_const->mEpoch++;
+#endif
     // record myself as my newhost
     fake_const->pHostSet=fake_const;
     fake_const->pSet=mpSet;
@@ -1601,11 +1772,13 @@ TEMP  void THIS::Lock(void) const {
   THIS* fake_const = const_cast< THIS* >(this);
 
   // stop tracking iterators
+#ifndef FAUDES_ITERATOR_EPOCH
   typename std::set< Iterator* >::const_iterator iit;
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
     (**iit).Detach();
   }
   fake_const->mIterators.clear();
+#endif
 
   // stop detach from reallocating
   fake_const->mLocked=true;
@@ -1616,6 +1789,24 @@ TEMP  void THIS::Lock(void) const {
 }
 
 
+// DetachPos()
+TEMP typename THIS::iterator THIS::DetachPos(const Iterator& pos, DetachMode flag) const {
+#ifdef FAUDES_ITERATOR_EPOCH
+  // untracked iterators must be relocated manually
+  if(!mDetached) {
+    StlSet* oldset=pSet;
+    typename StlSet::const_iterator sit=pos.StlIterator();
+    Detach(flag);
+    if(pSet!=oldset) {
+      if(sit==oldset->end()) return pSet->end();
+      return pSet->find(*sit);
+    }
+  }
+#endif
+  Detach(flag);
+  return pos.StlIterator();
+}
+
 // if i am a host to others, make someone else the host
 TEMP inline void THIS::RelinkClients(void) {
   FD_DC("TBaseSet::RelinkClients(" << this << ")")
@@ -1715,6 +1906,8 @@ TEMP inline void THIS::DetachClient(TBaseSet* pRef) const {
 }
 
 
+#ifndef FAUDES_ITERATOR_EPOCH
+
 // record an iterator
 TEMP inline void THIS::AttachIterator(Iterator* pFit) const {
   if(mLocked) return;
@@ -1729,9 +1922,13 @@ TEMP inline void THIS::DetachIterator(Iterator* pFit) const {
   const_cast< THIS* >(this)->mIterators.erase(pFit);
 }
 
+#endif
+
 // test some validity
 TEMP void THIS::DValid(const std::string& rMessage) const {
+#ifndef FAUDES_ITERATOR_EPOCH
   typename std::set< Iterator* >::const_iterator iit;
+#endif
   typename std::list< THIS* >::const_iterator rit;
 #ifdef FAUDES_DEBUG_CONTAINER
   std::cerr << "TBaseSet(" << this << ")::DValid(): " << rMessage <<
@@ -1743,9 +1940,13 @@ TEMP void THIS::DValid(const std::string& rMessage) const {
   if(pHostSet->mpClients)
   for(rit=pHostSet->mpClients->begin(); rit!=pHostSet->mpClients->end(); ++rit)
     std::cerr << *rit << " ";
+#ifndef FAUDES_ITERATOR_EPOCH
   std::cerr << "-- its ";
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit)
     std::cerr << *iit << " ";
+#else
+  std::cerr << "-- epoch " << mEpoch << " ";
+#endif
   std::cerr << "-- attr at " << pAttributes;
   std::cerr << "(#" << pAttributes->size() << ") ";
   if(mpAttributes) std::cerr << "(" << mpAttributes->size() << ") ";
@@ -1757,6 +1958,7 @@ TEMP void THIS::DValid(const std::string& rMessage) const {
     FD_WARN("BaseSet("<< this << "," << rMessage <<"): lost empty set: " << pGes);
     abort();
   }
+#ifndef FAUDES_ITERATOR_EPOCH
   // iterators, that dont refer to me as basset
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
     if((*iit)->pBaseSet!=this) {
@@ -1773,7 +1975,7 @@ TEMP void THIS::DValid(const std::string& rMessage) const {
   }
   // iterators, that are invalid stl iterators
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
-    typename std::set<T,Cmp>::const_iterator vit;
+    typename StlSet::const_iterator vit;
     for(vit=pSet->begin(); vit!= pSet->end(); ++vit) {
       if(vit==(**iit).StlIterator()) break;
     }
@@ -1783,6 +1985,7 @@ TEMP void THIS::DValid(const std::string& rMessage) const {
       abort(); // strict version: abort
     }
   }
+#endif
   // must have some base 
   if(pHostSet==NULL) {
     FD_WARN("BaseSet(" << this << "," << rMessage << "): no host found");
@@ -2007,8 +2210,13 @@ TEMP void THIS::DoDWrite(TokenWriter& rTw, const std::string& rLabel, const Type
   rTw.WriteComment("");
   rTw.WriteComment(" Size/Attributes: " + ToStringInteger(this->Size()) 
 		   + "/" + ToStringInteger((Idx) pHostSet->pAttributes->size()));
+#ifndef FAUDES_ITERATOR_EPOCH
   rTw.WriteComment(" Shares/Iterators: " + ToStringInteger((Idx) shares) 
 		   + "/" + ToStringInteger((Idx) mIterators.size()));
+#else
+  rTw.WriteComment(" Shares/Epoch: " + ToStringInteger((Idx) shares) 
+		   + "/" + ToStringInteger(mEpoch));
+#endif
   rTw.WriteComment("");
 #ifdef FAUDES_DEBUG_CODE
   DValid();
@@ -2098,7 +2306,7 @@ TEMP void THIS::DoRead(TokenReader& rTr, const std::string& rLabel, const Type*
 }
 
 // ThisIterator (tmoor 201308: this is by default an attached iterator)
-TEMP typename THIS::Iterator THIS::ThisIterator(const typename std::set<T,Cmp>::const_iterator& sit) const {
+TEMP typename THIS::Iterator THIS::ThisIterator(const typename StlSet::const_iterator& sit) const {
   return Iterator(this,sit,true);
 }
 
@@ -2151,11 +2359,15 @@ TEMP void THIS::Clear(void) {
   pSet=pGes;
   pAttributes=GlobalEmptyAttributes();
   // fix iterators (invalidate)
+#ifndef FAUDES_ITERATOR_EPOCH
   typename std::set< Iterator* >::iterator iit;
   for(iit=mIterators.begin(); iit!=mIterators.end(); ++iit) {
     (**iit).Invalidate();
   }
   mIterators.clear();
+#else
+  mEpoch++;
+#endif
   mDetached=false;
   mLocked=false;
 #ifdef FAUDES_DEBUG_CODE
@@ -2196,8 +2408,7 @@ TEMP bool THIS::Insert(const T& rElem) {
 
 //Inject(elem)
 TEMP typename THIS::Iterator  THIS::Inject(const Iterator& pos, const T& rElem) {
-  if(!mDetached) Detach();
-  iterator dst= pos.StlIterator(); 
+  iterator dst= DetachPos(pos); 
   return ThisIterator(pSet->insert(dst,rElem));
 }
 
@@ -2215,7 +2426,7 @@ TEMP void THIS::InsertSet(const TBaseSet& rOtherSet) {
   /*
   rm: cannot use stl since result overlaps with arguments
 
-  std::insert_iterator< std::set<T,Cmp> > insit(*pSet, rpSet->begin());
+  std::insert_iterator< StlSet > insit(*pSet, rpSet->begin());
   std::set_union(pSet->begin(), pSet->end(), rOtherSet.pSet->begin(), rOtherSet.pSet->end(), insit);
   */
   iterator it1 = pSet->begin();
@@ -2256,8 +2467,7 @@ TEMP typename THIS::Iterator THIS::Erase(const Iterator& pos) {
     throw Exception("BaseSet::Erase", errstr.str(), 62);
   }
 #endif
-  Detach();
-  iterator del= pos.StlIterator(); 
+  iterator del= DetachPos(pos); 
   pSet->erase(del++);
   return ThisIterator(del); 
 }
@@ -2631,7 +2841,8 @@ TEMP void THIS::FromStl(const std::set<T,Cmp>& rStlSet) {
 
 // write STL
 TEMP void THIS::ToStl(std::set<T,Cmp>& rStlSet) const {
-  rStlSet= *pSet;
+  rStlSet.clear();
+  rStlSet.insert(pSet->begin(),pSet->end());
 }
 
 
@@ -97,8 +97,8 @@ extern FAUDES_API void InstallSelfloops(Generator &rGen, const EventSet& rEvs);
 extern FAUDES_API void ComputeBisimulationCTA(const Generator& rGen, std::list<StateSet>& rResult);
 
 /*!
- * \brief ComputeBisimulationCTA
- * bisimulation partition based on change-tracking algorithm and topo sort
+ * \brief ComputeDelayedBisimulationCTA
+ * delayed bisimulation partition based on change-tracking algorithm
  * \param rGen
  *      input gen
  * \param rSilent
@@ -106,11 +106,11 @@ extern FAUDES_API void ComputeBisimulationCTA(const Generator& rGen, std::list<S
  * \param rResult
  *      state partition without trivial classes
  */
-extern FAUDES_API void ComputeBisimulationCTA(const Generator& rGen, const EventSet& rSilent, std::list<StateSet>& rResult);
+extern FAUDES_API void ComputeDelayedBisimulationCTA(const Generator& rGen, const EventSet& rSilent, std::list<StateSet>& rResult);
 
 /*!
  * \brief ComputeWeakBisimulationCTA
- * weak bisimulation (aka observation eq) partition based on change-tracking algorithm and topo sort
+ * weak bisimulation (aka observation eq) partition based on change-tracking algorithm
  * \param rGen
  *      input gen
  * \param rSilent
@@ -134,7 +134,7 @@ extern FAUDES_API void ComputeBisimulationCTA(const Generator& rGen, std::list<S
 
 /*!
  * \brief ComputeDelayedBisimulationCTA
- * delayed bisimulation partition under prepartition based on change-tracking algorithm and topo sort
+ * delayed bisimulation partition under prepartition based on change-tracking algorithm
  * \param rGen
  *      input gen
  * \param rSilent
@@ -148,7 +148,7 @@ extern FAUDES_API void ComputeDelayedBisimulationCTA(const Generator& rGen, cons
 
 /*!
  * \brief ComputeWeakBisimulationCTA
- * weak bisimulation (aka observation eq) partition under prepartition based on change-tracking algorithm and topo sort
+ * weak bisimulation (aka observation eq) partition under prepartition based on change-tracking algorithm
  * \param rGen
  *      input gen
  * \param rSilent
@@ -206,7 +206,7 @@ extern FAUDES_API void ComputeWeakBisimulationSatCTA(const Generator& rGen, cons
 
 
 /*!
- * \brief ComputeDelayedBisimulationCTA
+ * \brief ComputeDelayedBisimulationSatCTA
  * delayed bisimulation partition under prepartition based on change-tracking algorithm and saturation
  * \param rGen
  *      input gen
@@ -217,7 +217,7 @@ extern FAUDES_API void ComputeWeakBisimulationSatCTA(const Generator& rGen, cons
  * \param rPrePartition
  *      prepartition (trivial classes MUST be included)
  */
-extern FAUDES_API void ComputeDelayedBisimulationCTA(const Generator& rGen, const EventSet& rSilent, std::list<StateSet>& rResult, const std::vector<StateSet>& rPrePartition);
+extern FAUDES_API void ComputeDelayedBisimulationSatCTA(const Generator& rGen, const EventSet& rSilent, std::list<StateSet>& rResult, const std::vector<StateSet>& rPrePartition);
 
 /*!
  * \brief ComputeComputeWeakBisimulationSatCTA
@@ -49,10 +49,11 @@ namespace faudes {
 /**
 * Computation of the coarsest bisimulation relation for a specified generator. 
 *
-* This funtcion creates an instance of the class Bisimulation and triggers the computation
-* of the coarsest quasi-congruence on the given generator by calling the function Bisimulation::partition. 
-* The result is returned as a map from original state idicess to partion indicees.
-* The implementation is derived from J.-C. Fernandez, “An implementation of an efficient 
+* This funtcion uses the partition refinement kernel SignatureRefinement to compute
+* the coarsest quasi-congruence on the given generator. 
+* The result is returned as a map from original state idicess to partion indicees,
+* where partitions are numbered consecutively in the order of their least state.
+* The implementation used to be derived from J.-C. Fernandez, “An implementation of an efficient 
 * algorithm for bisimulation equivalence,” Science of Computer Programming, vol. 13, pp. 219-236, 1990.
 *
 * This interface is neither used nor tested. 
@@ -0,0 +1,281 @@
+/** @file cfl_compiledgen.cpp Compiled read-only representation of a generator */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#include "cfl_compiledgen.h"
+
+#include <algorithm>
+
+namespace faudes {
+
+// helper: set up original->internal lookup table if indices are reasonably dense
+static void cg_setup_map(const std::vector<Idx>& rOrig, std::vector<Idx>& rMap) {
+  rMap.clear();
+  if(rOrig.size()<=1) return;
+  Idx max=rOrig.back();
+  if(max > 4*rOrig.size()+64) return;
+  rMap.resize(max+1,0);
+  for(Idx i=1; i<rOrig.size(); ++i)
+    rMap[rOrig[i]]=i;
+}
+
+// helper: lookup original->internal
+static Idx cg_lookup(const std::vector<Idx>& rOrig, const std::vector<Idx>& rMap, Idx x) {
+  if(!rMap.empty()) {
+    if(x>=rMap.size()) return 0;
+    return rMap[x];
+  }
+  if(rOrig.size()<=1) return 0;
+  std::vector<Idx>::const_iterator pos=std::lower_bound(rOrig.begin()+1,rOrig.end(),x);
+  if(pos==rOrig.end()) return 0;
+  if(*pos!=x) return 0;
+  return (Idx) (pos-rOrig.begin());
+}
+
+// helper: find first edge with event >= e within sorted range
+static CompiledGenerator::Iterator cg_lower(CompiledGenerator::Iterator begin, CompiledGenerator::Iterator end, Idx e) {
+  // short ranges: linear scan
+  if(end-begin < 16) {
+    while(begin!=end) {
+      if(begin->Ev>=e) break;
+      ++begin;
+    }
+    return begin;
+  }
+  // long ranges: bisection
+  while(begin<end) {
+    CompiledGenerator::Iterator mid=begin + (end-begin)/2;
+    if(mid->Ev<e) begin=mid+1;
+    else end=mid;
+  }
+  return begin;
+}
+
+
+// construct
+CompiledGenerator::CompiledGenerator(void) {
+  Clear();
+}
+
+// construct
+CompiledGenerator::CompiledGenerator(const vGenerator& rGen, bool backward) {
+  Compile(rGen,backward);
+}
+
+// destruct
+CompiledGenerator::~CompiledGenerator(void) {
+}
+
+// clear
+void CompiledGenerator::Clear(void) {
+  mStates.assign(1,0);
+  mEvents.assign(1,0);
+  mStateMap.clear();
+  mEventMap.clear();
+  mFlags.assign(1,0);
+  mInitStates.clear();
+  mMarkedStates.clear();
+  mFwdBegin.assign(2,0);
+  mFwdEdges.clear();
+  mBwdBegin.clear();
+  mBwdEdges.clear();
+}
+
+// lookup
+Idx CompiledGenerator::StateIndex(Idx x) const {
+  return cg_lookup(mStates,mStateMap,x);
+}
+
+// lookup
+Idx CompiledGenerator::EventIndex(Idx ev) const {
+  return cg_lookup(mEvents,mEventMap,ev);
+}
+
+// compile
+void CompiledGenerator::Compile(const vGenerator& rGen, bool backward) {
+  FD_DF("CompiledGenerator::Compile(" << rGen.Name() << ")");
+  Clear();
+  // re-index states (StateSet iterates in ascending order)
+  mStates.reserve(rGen.Size()+1);
+  StateSet::Iterator sit=rGen.StatesBegin();
+  StateSet::Iterator sit_end=rGen.StatesEnd();
+  for(;sit!=sit_end;++sit)
+    mStates.push_back(*sit);
+  cg_setup_map(mStates,mStateMap);
+  // re-index events
+  mEvents.reserve(rGen.Alphabet().Size()+1);
+  EventSet::Iterator eit=rGen.AlphabetBegin();
+  EventSet::Iterator eit_end=rGen.AlphabetEnd();
+  for(;eit!=eit_end;++eit)
+    mEvents.push_back(*eit);
+  cg_setup_map(mEvents,mEventMap);
+  // flags
+  Idx n=Size();
+  mFlags.assign(n+1,0);
+  for(sit=rGen.InitStatesBegin(); sit!=rGen.InitStatesEnd(); ++sit) {
+    Idx q=StateIndex(*sit);
+    if(q==0) continue;
+    mFlags[q] |= InitFlag;
+    mInitStates.push_back(q);
+  }
+  for(sit=rGen.MarkedStatesBegin(); sit!=rGen.MarkedStatesEnd(); ++sit) {
+    Idx q=StateIndex(*sit);
+    if(q==0) continue;
+    mFlags[q] |= MarkedFlag;
+    mMarkedStates.push_back(q);
+  }
+  // forward relation: TransSet iterates by (x1,ev,x2) and re-indexing is monotone,
+  // so a single pass yields the sorted CSR arrays
+  mFwdBegin.assign(n+2,0);
+  mFwdEdges.reserve(rGen.TransRelSize());
+  TransSet::Iterator tit=rGen.TransRelBegin();
+  TransSet::Iterator tit_end=rGen.TransRelEnd();
+  Idx q1=0;
+  Idx x1=0;
+  for(;tit!=tit_end;++tit) {
+    if(tit->X1!=x1) {
+      x1=tit->X1;
+      q1=StateIndex(x1);
+    }
+    Edge edge;
+    edge.Ev=EventIndex(tit->Ev);
+    edge.X=StateIndex(tit->X2);
+#ifdef FAUDES_CHECKED
+    if(q1==0 || edge.Ev==0 || edge.X==0) {
+      std::stringstream errstr;
+      errstr << "transition relation inconsistent with states/alphabet in generator \"" << rGen.Name() << "\"";
+      throw Exception("CompiledGenerator::Compile()", errstr.str(), 95);
+    }
+#endif
+    mFwdBegin[q1+1]++;
+    mFwdEdges.push_back(edge);
+  }
+  for(Idx q=1; q<=n+1; ++q)
+    mFwdBegin[q]+=mFwdBegin[q-1];
+  // backward
+  if(backward) CompileBackward();
+  FD_DF("CompiledGenerator::Compile(" << rGen.Name() << "): done with #" << n << " states");
+}
+
+// compile backward relation
+void CompiledGenerator::CompileBackward(void) {
+  if(HasBackward()) return;
+  Idx n=Size();
+  Idx m=TransRelSize();
+  Idx k=AlphabetSize();
+  // pass 1: stable counting sort of forward edge positions by event
+  std::vector<Idx> count(k+2,0);
+  for(Idx i=0; i<m; ++i) count[mFwdEdges[i].Ev+1]++;
+  for(Idx e=1; e<=k+1; ++e) count[e]+=count[e-1];
+  std::vector<Idx> order(m);
+  for(Idx i=0; i<m; ++i)
+    order[count[mFwdEdges[i].Ev]++]=i;
+  // recover x1 per forward edge position
+  std::vector<Idx> src(m);
+  for(Idx q=1; q<=n; ++q)
+    for(Idx i=mFwdBegin[q]; i<mFwdBegin[q+1]; ++i)
+      src[i]=q;
+  // pass 2: stable counting sort by x2 yields (x2,ev,x1)
+  mBwdBegin.assign(n+2,0);
+  for(Idx i=0; i<m; ++i) mBwdBegin[mFwdEdges[i].X+1]++;
+  for(Idx q=1; q<=n+1; ++q) mBwdBegin[q]+=mBwdBegin[q-1];
+  std::vector<Idx> pos(mBwdBegin.begin(),mBwdBegin.end());
+  mBwdEdges.resize(m);
+  for(Idx j=0; j<m; ++j) {
+    Idx i=order[j];
+    Edge& edge=mBwdEdges[pos[mFwdEdges[i].X]++];
+    edge.Ev=mFwdEdges[i].Ev;
+    edge.X=src[i];
+  }
+}
+
+// edges by event
+CompiledGenerator::Iterator CompiledGenerator::SuccBegin(Idx q, Idx e) const {
+  return cg_lower(SuccBegin(q),SuccEnd(q),e);
+}
+
+// edges by event
+CompiledGenerator::Iterator CompiledGenerator::SuccEnd(Idx q, Idx e) const {
+  return cg_lower(SuccBegin(q),SuccEnd(q),e+1);
+}
+
+// edges by event
+CompiledGenerator::Iterator CompiledGenerator::PredBegin(Idx q, Idx e) const {
+  return cg_lower(PredBegin(q),PredEnd(q),e);
+}
+
+// edges by event
+CompiledGenerator::Iterator CompiledGenerator::PredEnd(Idx q, Idx e) const {
+  return cg_lower(PredBegin(q),PredEnd(q),e+1);
+}
+
+// accessible states
+void CompiledGenerator::Accessible(std::vector<bool>& rAcc) const {
+  rAcc.assign(Size()+1,false);
+  std::vector<Idx> todo(mInitStates.begin(),mInitStates.end());
+  for(std::size_t i=0; i<todo.size(); ++i) rAcc[todo[i]]=true;
+  while(!todo.empty()) {
+    Idx q=todo.back();
+    todo.pop_back();
+    Iterator eit=SuccBegin(q);
+    Iterator eit_end=SuccEnd(q);
+    for(;eit!=eit_end;++eit) {
+      if(rAcc[eit->X]) continue;
+      rAcc[eit->X]=true;
+      todo.push_back(eit->X);
+    }
+  }
+}
+
+// coaccessible states
+void CompiledGenerator::Coaccessible(std::vector<bool>& rCoacc) const {
+#ifdef FAUDES_CHECKED
+  if(!HasBackward())
+    throw Exception("CompiledGenerator::Coaccessible()", "backward relation not compiled", 99);
+#endif
+  rCoacc.assign(Size()+1,false);
+  std::vector<Idx> todo(mMarkedStates.begin(),mMarkedStates.end());
+  for(std::size_t i=0; i<todo.size(); ++i) rCoacc[todo[i]]=true;
+  while(!todo.empty()) {
+    Idx q=todo.back();
+    todo.pop_back();
+    Iterator eit=PredBegin(q);
+    Iterator eit_end=PredEnd(q);
+    for(;eit!=eit_end;++eit) {
+      if(rCoacc[eit->X]) continue;
+      rCoacc[eit->X]=true;
+      todo.push_back(eit->X);
+    }
+  }
+}
+
+// convert to StateSet
+void CompiledGenerator::StateSetFromFlags(const std::vector<bool>& rFlags, StateSet& rStates) const {
+  rStates.Clear();
+  if(rFlags.empty()) return;
+  Idx n=Size();
+  if(rFlags.size()<n+1) n=(Idx) rFlags.size()-1;
+  for(Idx q=1; q<=n; ++q)
+    if(rFlags[q]) rStates.Insert(mStates[q]);
+}
+
+
+} // namespace faudes
@@ -0,0 +1,223 @@
+/** @file cfl_compiledgen.h Compiled read-only representation of a generator */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#ifndef FAUDES_COMPILEDGEN_H
+#define FAUDES_COMPILEDGEN_H
+
+#include "cfl_definitions.h"
+#include "cfl_generator.h"
+
+#include <vector>
+
+namespace faudes {
+
+/**
+ * Compiled read-only representation of a generator.
+ *
+ * A CompiledGenerator takes a snapshot of the transition structure of a vGenerator
+ * and re-indexes states and events to consecutive integers. Transitions are stored
+ * in compressed-sparse-row format, i.e., as one plain array of edges per direction,
+ * with forward edges sorted by (x1,ev,x2) and backward edges sorted by (x2,ev,x1).
+ * Thus, iterating the successors or predecessors of a state amounts to a plain
+ * array scan, as opposed to tree traversal with iterator tracking for the TransSet.
+ *
+ * Internal indices start at 1 and preserve the order of the original indices, such
+ * that 0 can be used to indicate "no such state/event". Symbolic names and attributes
+ * are not recorded. The compiled representation does not track subsequent changes
+ * of the source generator, i.e., algorithms are meant to compile once and then work
+ * on the snapshot.
+ *
+ * Technically, this class generalizes the ad-hoc re-indexing used within
+ * implementations of state minimization and bisimulation.
+ *
+ * @ingroup GeneratorClasses
+ */
+class FAUDES_API CompiledGenerator {
+
+public:
+
+  /**
+   * Edge record: event and other end of the transition (internal indices). For forward
+   * edges, X refers to the successor state, for backward edges to the predecessor state.
+   */
+  struct Edge {
+    Idx Ev;
+    Idx X;
+  };
+
+  /** Convenience typedef for edge iteration */
+  typedef const Edge* Iterator;
+
+  /**
+   * Construct empty
+   */
+  CompiledGenerator(void);
+
+  /**
+   * Construct from generator
+   *
+   * @param rGen
+   *   Generator to compile
+   * @param backward
+   *   Set true to also compile the backward relation
+   */
+  CompiledGenerator(const vGenerator& rGen, bool backward=true);
+
+  /**
+   * Destruct
+   */
+  ~CompiledGenerator(void);
+
+  /**
+   * Compile from generator
+   *
+   * @param rGen
+   *   Generator to compile
+   * @param backward
+   *   Set true to also compile the backward relation
+   */
+  void Compile(const vGenerator& rGen, bool backward=true);
+
+  /**
+   * Compile backward relation (if not yet present)
+   */
+  void CompileBackward(void);
+
+  /**
+   * Clear all data
+   */
+  void Clear(void);
+
+  /** Number of states */
+  Idx Size(void) const { return (Idx) mStates.size()-1; };
+
+  /** Number of events */
+  Idx AlphabetSize(void) const { return (Idx) mEvents.size()-1; };
+
+  /** Number of transitions */
+  Idx TransRelSize(void) const { return (Idx) mFwdEdges.size(); };
+
+  /** Test for backward relation */
+  bool HasBackward(void) const { return mBwdBegin.size()>0; };
+
+  /** Original state index for internal index q */
+  Idx State(Idx q) const { return mStates[q]; };
+
+  /** Original event index for internal index e */
+  Idx Event(Idx e) const { return mEvents[e]; };
+
+  /** Internal index of original state, or 0 if not a state */
+  Idx StateIndex(Idx x) const;
+
+  /** Internal index of original event, or 0 if not an event */
+  Idx EventIndex(Idx ev) const;
+
+  /** Test whether internal state q is initial */
+  bool InitState(Idx q) const { return (mFlags[q] & InitFlag) != 0; };
+
+  /** Test whether internal state q is marked */
+  bool MarkedState(Idx q) const { return (mFlags[q] & MarkedFlag) != 0; };
+
+  /** Internal initial states, ascending */
+  const std::vector<Idx>& InitStates(void) const { return mInitStates; };
+
+  /** Internal marked states, ascending */
+  const std::vector<Idx>& MarkedStates(void) const { return mMarkedStates; };
+
+  /** Forward edges of state q, sorted by event and successor */
+  Iterator SuccBegin(Idx q) const { return mFwdEdges.empty() ? 0 : &mFwdEdges[0] + mFwdBegin[q]; };
+  Iterator SuccEnd(Idx q) const { return mFwdEdges.empty() ? 0 : &mFwdEdges[0] + mFwdBegin[q+1]; };
+
+  /** Forward edges of state q with event e */
+  Iterator SuccBegin(Idx q, Idx e) const;
+  Iterator SuccEnd(Idx q, Idx e) const;
+
+  /** Backward edges of state q, sorted by event and predecessor (requires backward relation) */
+  Iterator PredBegin(Idx q) const { return mBwdEdges.empty() ? 0 : &mBwdEdges[0] + mBwdBegin[q]; };
+  Iterator PredEnd(Idx q) const { return mBwdEdges.empty() ? 0 : &mBwdEdges[0] + mBwdBegin[q+1]; };
+
+  /** Backward edges of state q with event e (requires backward relation) */
+  Iterator PredBegin(Idx q, Idx e) const;
+  Iterator PredEnd(Idx q, Idx e) const;
+
+  /**
+   * Accessible states, flags indexed by internal state index
+   *
+   * @param rAcc
+   *   Result: rAcc[q] is true iff q is accessible
+   */
+  void Accessible(std::vector<bool>& rAcc) const;
+
+  /**
+   * Coaccessible states, flags indexed by internal state index
+   * (requires backward relation)
+   *
+   * @param rCoacc
+   *   Result: rCoacc[q] is true iff q is coaccessible
+   */
+  void Coaccessible(std::vector<bool>& rCoacc) const;
+
+  /**
+   * Convert state flags to a StateSet of original indices
+   *
+   * @param rFlags
+   *   Flags indexed by internal state index
+   * @param rStates
+   *   Result
+   */
+  void StateSetFromFlags(const std::vector<bool>& rFlags, StateSet& rStates) const;
+
+protected:
+
+  /** Flags per state */
+  static const unsigned char InitFlag=0x01;
+  static const unsigned char MarkedFlag=0x02;
+
+  /** Original indices by internal index [starting with 1] */
+  std::vector<Idx> mStates;
+  std::vector<Idx> mEvents;
+
+  /** Dense lookup original->internal, or empty to fall back to binary search */
+  std::vector<Idx> mStateMap;
+  std::vector<Idx> mEventMap;
+
+  /** State flags by internal index */
+  std::vector<unsigned char> mFlags;
+
+  /** Initial and marked states */
+  std::vector<Idx> mInitStates;
+  std::vector<Idx> mMarkedStates;
+
+  /** Forward relation in CSR format */
+  std::vector<Idx> mFwdBegin;
+  std::vector<Edge> mFwdEdges;
+
+  /** Backward relation in CSR format */
+  std::vector<Idx> mBwdBegin;
+  std::vector<Edge> mBwdEdges;
+
+};
+
+
+} // namespace faudes
+
+#endif
@@ -22,6 +22,9 @@
 #include "cfl_bisimcta.h"
 #include "cfl_regular.h"
 #include "cfl_graphfncts.h"
+#include "cfl_parallel.h"
+#include "cfl_context.h"
+#include "cfl_tasks.h"
 
 
 /** Two debug levels for functions in this source file **/
@@ -326,6 +329,7 @@ void EnabledContinuationRule(Generator &g, const EventSet &silent){
 
 // simple function removing tau self loops
 void RemoveTauSelfloops(Generator &g, const EventSet &silent){
+  g.TransRel().Detach();
   TransSet::Iterator tit = g.TransRelBegin();
   TransSet::Iterator tit_end = g.TransRelEnd();
   while(tit!=tit_end){
@@ -345,6 +349,7 @@ void MergeSilentLoops(Generator &g, const EventSet &silent){
 
   // have a generator copy where only silent transitions are preserved
   Generator copyg(g);
+  copyg.TransRel().Detach(); // the copy shares its transitions with the original
   TransSet::Iterator tit = copyg.TransRel().Begin();
   while (tit!=copyg.TransRelEnd()){
     if (!silent.Exists(tit->Ev)) // if not a silent trans, delete
@@ -371,6 +376,7 @@ void MergeSilentLoops(Generator &g, const EventSet &silent){
 // -- remove outgoing transitions from not coaccessible states
 void RemoveNonCoaccessibleOut(Generator& g){
   StateSet notcoaccSet=g.States()-g.CoaccessibleSet();
+  g.TransRel().Detach();
   StateSet::Iterator sit=notcoaccSet.Begin();
   StateSet::Iterator sit_end=notcoaccSet.End();
   for(;sit!=sit_end;++sit){
@@ -400,6 +406,7 @@ void BlockingSilentEvent(Generator& g,const EventSet& silent){
         sblock.Insert(tit->X1);
   }
   // unmark blocking states and eliminate possible future
+  g.TransRel().Detach();
   sit=sblock.Begin();
   sit_end=sblock.End();
   for(;sit!=sit_end;++sit) {
@@ -539,6 +546,7 @@ EventSet HidePriviateEvs(Generator& rGen, EventSet& silent){
   silent.EraseSet(msilentevs);
   if (msilentevs.Empty()) // in this case, only one silent event is set to tau and no need to hide
     return result;
+  rGen.TransRel().Detach();
   TransSet::Iterator tit=rGen.TransRelBegin();
   TransSet::Iterator tit_end=rGen.TransRelEnd();
   for(;tit!=tit_end;) {
@@ -614,89 +622,248 @@ void ConflictEquivalentAbstraction(vGenerator& rGen, EventSet& rSilentEvents){
 }  
 
 
+/*
+Compositional verification
+
+The family of generators is maintained in place: the composition of a candidate
+pair is inserted as the first generator and the pair is erased, all other
+generators are kept by reference in their original order. Silent events are
+identified by an event index that records for each event the number of generators
+which have the event in their alphabet; the index is updated when generators are
+composed or when abstraction hides events. The initial abstraction of the individual
+generators is independent per generator and can be run on worker threads.
+*/
+
+// count events shared by two generators
+static Idx cfe_shared(const Generator& rGen1, const Generator& rGen2) {
+  Idx res=0;
+  EventSet::Iterator eit=rGen1.AlphabetBegin();
+  EventSet::Iterator eit_end=rGen1.AlphabetEnd();
+  for(;eit!=eit_end;++eit)
+    if(rGen2.ExistsEvent(*eit)) ++res;
+  return res;
+}
+
+// generator with fewest transitions 'minT'
+static Idx cfe_mint(const GeneratorVector& rGvec) {
+  Idx imin=0;
+  Idx git=1;
+  for(;git<rGvec.Size();git++)
+    if(rGvec.At(git).TransRelSize()<rGvec.At(imin).TransRelSize())
+      imin=git;
+  return imin;
+}
+
+// heuristic 'minT/maxC'
+void ConflictCandidateMinTMaxC(const GeneratorVector& rGvec, const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ) {
+  (void) rEventCount;
+  rI=cfe_mint(rGvec);
+  // candidat with most common events 'maxC'
+  rJ=rI;
+  Int score=-1;
+  Idx git=0;
+  for(;git<rGvec.Size();git++){
+    if(git==rI) continue;
+    Int sharedsize = (Int) cfe_shared(rGvec.At(rI),rGvec.At(git));
+    if(sharedsize > score){
+      rJ = git;
+      score = sharedsize;
+    }
+  }
+}
+
+// heuristic 'minT/maxL'
+void ConflictCandidateMinTMaxL(const GeneratorVector& rGvec, const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ) {
+  rI=cfe_mint(rGvec);
+  const Generator& gi=rGvec.At(rI);
+  // candidat with most events that become local 'maxL'
+  rJ=rI;
+  Int score=-1;
+  Idx git=0;
+  for(;git<rGvec.Size();git++){
+    if(git==rI) continue;
+    const Generator& gj=rGvec.At(git);
+    // an event becomes local if it is used by no other generator than gi and gj
+    Int local=0;
+    EventSet::Iterator eit=gi.AlphabetBegin();
+    EventSet::Iterator eit_end=gi.AlphabetEnd();
+    for(;eit!=eit_end;++eit) {
+      std::map<Idx,Idx>::const_iterator cit=rEventCount.find(*eit);
+      if(cit==rEventCount.end()) continue;
+      if(cit->second == (gj.ExistsEvent(*eit) ? 2 : 1)) ++local;
+    }
+    eit=gj.AlphabetBegin();
+    eit_end=gj.AlphabetEnd();
+    for(;eit!=eit_end;++eit) {
+      if(gi.ExistsEvent(*eit)) continue;
+      std::map<Idx,Idx>::const_iterator cit=rEventCount.find(*eit);
+      if(cit==rEventCount.end()) continue;
+      if(cit->second == 1) ++local;
+    }
+    if(local > score){
+      rJ = git;
+      score = local;
+    }
+  }
+}
+
+// heuristic 'minS'
+void ConflictCandidateMinS(const GeneratorVector& rGvec, const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ) {
+  (void) rEventCount;
+  rI=0;
+  rJ=1;
+  bool sync=false;
+  double score=-1;
+  Idx i,j;
+  for(i=0;i<rGvec.Size();++i) {
+    for(j=i+1;j<rGvec.Size();++j) {
+      Idx shared=cfe_shared(rGvec.At(i),rGvec.At(j));
+      // prefer pairs that synchronise 
+      if(sync && (shared==0)) continue;
+      // rough estimate of the composed state count
+      double est= ((double) rGvec.At(i).Size()) * ((double) rGvec.At(j).Size()) / (shared+1);
+      if((!sync && shared>0) || (score<0) || (est<score)) {
+        rI=i;
+        rJ=j;
+        score=est;
+        if(shared>0) sync=true;
+      }
+    }
+  }
+}
+
+// silent events of a generator, i.e., events not used by any other generator
+static void cfe_silent(const Generator& rGen, const std::map<Idx,Idx>& rEventCount, EventSet& rSilent) {
+  rSilent.Clear();
+  EventSet::Iterator eit=rGen.AlphabetBegin();
+  EventSet::Iterator eit_end=rGen.AlphabetEnd();
+  for(;eit!=eit_end;++eit) {
+    std::map<Idx,Idx>::const_iterator cit=rEventCount.find(*eit);
+    if(cit!=rEventCount.end()) if(cit->second==1) rSilent.Insert(*eit);
+  }
+}
+
+// abstraction task for one generator
+typedef struct {
+  Generator* pGen;
+  EventSet mAlphabet;
+  EventSet mSilent;
+} cfe_task;
+
+// abstract and record hidden events 
+static void cfe_abstract(cfe_task& rTask) {
+  rTask.mAlphabet=rTask.pGen->Alphabet();
+  ConflictEquivalentAbstraction(*rTask.pGen, rTask.mSilent);
+  rTask.mAlphabet.EraseSet(rTask.pGen->Alphabet());
+}
+
+// update event index for hidden events
+static void cfe_hidden(const EventSet& rHidden, std::map<Idx,Idx>& rEventCount) {
+  EventSet::Iterator eit=rHidden.Begin();
+  EventSet::Iterator eit_end=rHidden.End();
+  for(;eit!=eit_end;++eit) 
+    if(--rEventCount[*eit]==0) rEventCount.erase(*eit);
+}
+
+// abstraction task function
+static void cfe_abstract_task(void* pData, std::size_t worker, std::size_t task) {
+  if(worker==0) LoopCallback();
+  cfe_abstract((*((std::vector<cfe_task>*) pData))[task]);
+}
+
+// run abstraction tasks, optionally on worker threads, see RunTasks()
+static void cfe_run(std::vector<cfe_task>& rTasks) {
+  Idx threads=TaskThreads(Context::Current()->Threads(),rTasks.size());
+  FD_CV0("Abstracting #" << rTasks.size() << " automata on #" << threads << " threads");
+  RunTasks(threads,rTasks.size(),&cfe_abstract_task,&rTasks);
+}
+
 // API wrapper  
 bool IsNonconflicting(const GeneratorVector& rGvec) {
 
-  GeneratorVector gvec = rGvec;
+  // trivial case
+  if(rGvec.Size()==0) return true;
 
+  // local copy with own data, since we may operate on worker threads
   FD_CV0("Appending Omega event")
-    Idx git = 0;
-  for(;git!=gvec.Size();git++){
+  GeneratorVector gvec;
+  Generator gen;
+  Idx git = 0;
+  for(;git!=rGvec.Size();git++){
+    gvec.PushBack(gen);
+    TaskCopy(rGvec.At(git),gvec.At(git));
     AppendOmegaTermination(gvec.At(git));
   }
+  if(gvec.Size()==1) return IsNonblocking(gvec.At(0));
+
+  // event index: number of generators per event
+  std::map<Idx,Idx> evcount;
+  for(git=0;git!=gvec.Size();git++){
+    EventSet::Iterator eit=gvec.At(git).AlphabetBegin();
+    EventSet::Iterator eit_end=gvec.At(git).AlphabetEnd();
+    for(;eit!=eit_end;++eit) ++evcount[*eit];
+  }
 
-  bool firstCycle = true;
-  while (true){
-    FD_CV0("========================================")
-    FD_CV0("Remaining automata: #"<<gvec.Size())
+  // normalize for one silent event per generator, and then abstract; the
+  // generators are independent and are processed on worker threads
+  std::vector<cfe_task> tasks(gvec.Size());
+  EventSet silent;
+  for(git=0;git!=gvec.Size();git++){
+    tasks[git].pGen=&gvec.At(git);
+    cfe_silent(gvec.At(git),evcount,silent);
+    TaskCopy(silent,tasks[git].mSilent);
+  }
+  cfe_run(tasks);
+  for(git=0;git!=gvec.Size();git++){
+    FD_CV0("State count after abstraction of "<<gvec.At(git).Name()<<": "<<gvec.At(git).Size())
+    cfe_hidden(tasks[git].mAlphabet,evcount);
+  }
+  tasks.clear();
 
-    // trivial cases
-    if(gvec.Size()==0) return true;
-    if(gvec.Size()==1) break;
+  // candidate heuristic of the current context
+  ConflictCandidateFnct candidate=Context::Current()->ConflictCandidate();
+  if(!candidate) candidate=&ConflictCandidateMinTMaxC;
 
-    // figure silent events
-    EventSet silent, all, shared;
-    Idx git = 0;
-    while(true){
-      all = all+gvec.At(git).Alphabet();
-      Idx git_next = git+1;
-      if (git_next == gvec.Size()) break;
-      for(;git_next!=gvec.Size();git_next++){
-	shared = shared
-	  + (gvec.At(git).Alphabet())
-	  * (gvec.At(git_next).Alphabet());
-      }
-      git++;
-    }
-    silent=all-shared; // all silent events in all current candidates
-
-    // normalize for one silent event per generator, and then abstract.
-    // note from the second iteration, this is only necessary for the
-    // automaton composed from former candidates. This is realized by
-    // the break at the end
-    git = 0;
-    for(;git!=gvec.Size();git++){
-      // abstraction
-      FD_CV0("Abstracting Automaton "<<gvec.At(git).Name()<<", with state count: "<<gvec.At(git).Size())
-      ConflictEquivalentAbstraction(gvec.At(git), silent);
-      FD_CV0("State count after abstraction: "<<gvec.At(git).Size())
-      if(!firstCycle) break;
-    }
-    firstCycle = false;
+  // loop until resolved
+  cfe_task task;
+  while(gvec.Size()>1) {
+    FD_CV0("========================================")
+    FD_CV0("Remaining automata: #"<<gvec.Size())
 
-    // candidate choice heuritics. Branch by different tasks
+    // candidate choice heuristics 
     Idx imin = 0;
     Idx jmin = 0;
-
-    // candidat with fewest transitions 'minT'
-    git = 1;
-    for(;git!=gvec.Size();git++){
-      if(gvec.At(git).TransRelSize()<gvec.At(imin).TransRelSize())
-	imin = git;
+    candidate(gvec,evcount,imin,jmin);
+    if((imin==jmin) || (imin>=gvec.Size()) || (jmin>=gvec.Size())) {
+      throw Exception("IsNonconflicting", "candidate heuristic failed to select a pair of generators", 100);
     }
-    // candidat with most common events 'maxC'
-    git = jmin;
-    Int score=-1;
-    for(; git!=gvec.Size(); git++){
-      if(git==imin) continue;
-      Int sharedsize = (gvec.At(git).Alphabet() * gvec.At(imin).Alphabet()).Size();
-      if ( sharedsize > score){
-	jmin = git;
-	score = sharedsize;
-      }
-    }
-    // compose candidate pair
-    Generator gij;
+
+    // compose candidate pair and update event index; the composition becomes the
+    // first element, all other generators are kept in order without copying
     FD_CV0("Composing automata "<<gvec.At(imin).Name()<<" and "<<gvec.At(jmin).Name())
-      Parallel(gvec.At(imin),gvec.At(jmin),gij);
-    GeneratorVector newgvec;
-    newgvec.Append(gij); // the composed generator is always the first element
-    git = 0;
-    for(;git!=gvec.Size();git++){
-      if (git == imin || git == jmin) continue;
-      newgvec.Append(gvec.At(git)); // all other candidates are just copied to the next iteraion
-    }
-    gvec = newgvec;
+    const Generator& gi=gvec.At(imin);
+    const Generator& gj=gvec.At(jmin);
+    EventSet::Iterator eit=gj.AlphabetBegin();
+    EventSet::Iterator eit_end=gj.AlphabetEnd();
+    for(;eit!=eit_end;++eit)
+      if(gi.ExistsEvent(*eit)) --evcount[*eit];
+    Generator* pgij=new Generator();
+    gvec.Insert(0,pgij);
+    gvec.TakeOwnership();
+    Parallel(gvec.At(imin+1),gvec.At(jmin+1),*pgij);
+    if(imin<jmin) std::swap(imin,jmin);
+    gvec.Erase(imin+1);
+    gvec.Erase(jmin+1);
+    LoopCheck(pgij->Size());
+
+    // abstract the composition
+    if(gvec.Size()==1) break;
+    task.pGen=pgij;
+    cfe_silent(*task.pGen,evcount,task.mSilent);
+    FD_CV0("Abstracting Automaton "<<task.pGen->Name()<<", with state count: "<<task.pGen->Size())
+    cfe_abstract(task);
+    cfe_hidden(task.mAlphabet,evcount);
+    FD_CV0("State count after abstraction: "<<task.pGen->Size())
   }
   return IsNonblocking(gvec.At(0));
 }
@@ -750,6 +917,7 @@ bool IsNonblocking(const GeneratorVector& rGenVec) {
     sili.Erase(esi);
     silent.EraseSet(sili);
     all.EraseSet(sili);
+    gi.TransRel().Detach();
     TransSet::Iterator tit=gi.TransRelBegin();
     TransSet::Iterator tit_end=gi.TransRelEnd();
     for(;tit!=tit_end;) {
@@ -840,6 +1008,7 @@ bool IsNonblocking(const GeneratorVector& rGenVec) {
       Idx esi=*(sili.Begin());
       sili.Erase(esi);
       silent.EraseSet(sili);
+      gimin.TransRel().Detach();
       TransSet::Iterator tit=gimin.TransRelBegin();
       TransSet::Iterator tit_end=gimin.TransRelEnd();
       for(;tit!=tit_end;) {
@@ -42,6 +42,11 @@ namespace faudes {
  * The current implementation is based on Michael Meyer's
  * BSc Thesis and repaired/optimized by Yiheng Tang
  *
+ * When libFAUDES is configured with the option core_threads, the individual input
+ * generators are abstracted concurrently by the number of threads specified by the
+ * current Context, see Context::Threads(). The result does not depend on the number of threads.
+ * The pair of generators composed in each step is chosen by the candidate heuristic of the
+ * current Context, see Context::ConflictCandidate(ConflictCandidateFnct).
  *
  * @param rGenVec
  *   Vector of input generators
@@ -54,6 +59,35 @@ namespace faudes {
 extern FAUDES_API bool IsNonconflicting(const GeneratorVector& rGenVec);
 extern FAUDES_API bool IsNonblocking(const GeneratorVector& rGvec);
 
+/**
+ * Candidate heuristic 'minT/maxC' (default).
+ * Pick the generator with the fewest transitions and pair it with the
+ * generator with the most events in common.
+ * See also ConflictCandidateFnct.
+ */
+extern FAUDES_API void ConflictCandidateMinTMaxC(const GeneratorVector& rGenVec,
+  const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ);
+
+/**
+ * Candidate heuristic 'minT/maxL'.
+ * Pick the generator with the fewest transitions and pair it with the
+ * generator such that the most events become local to the composition.
+ * See also ConflictCandidateFnct.
+ */
+extern FAUDES_API void ConflictCandidateMinTMaxL(const GeneratorVector& rGenVec,
+  const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ);
+
+/**
+ * Candidate heuristic 'minS'.
+ * Pick the pair of generators with the smallest estimated number of states
+ * when composed. The estimate is the product of the individual state counts,
+ * divided by the number of shared events plus one. Pairs that do not share
+ * any events are only considered if there is no other choice.
+ * See also ConflictCandidateFnct.
+ */
+extern FAUDES_API void ConflictCandidateMinS(const GeneratorVector& rGenVec,
+  const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ);
+
 /**
  * Conflict equivalent abstraction.
  *
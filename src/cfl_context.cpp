@@ -0,0 +1,148 @@
+/** @file cfl_context.cpp Library context to isolate concurrent computations */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#include "cfl_context.h"
+#include "cfl_registry.h"
+
+#include <chrono>
+
+
+namespace faudes {
+
+// context of the innermost scope, per thread (NULL for global context)
+static thread_local Context* gCurrentContext=0;
+
+// monotonic time in ms (never 0)
+static long long ctx_now(void) {
+  std::chrono::steady_clock::duration since=std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(since).count()+1;
+}
+
+// construct
+Context::Context(void) :
+  pEventSymbolTable(0),
+  pConsole(0),
+  pBreakFnct(0),
+  mCancelled(false),
+  mDeadline(0),
+  mStateLimit(0),
+  mThreads(1),
+  pConflictCandidate(0),
+  pParent(0)
+{}
+
+// destruct
+Context::~Context(void) {
+}
+
+// global context (initialize on first use pattern)
+Context* Context::G(void) {
+  static Context fctx;
+  return &fctx;
+}
+
+// current context
+Context* Context::Current(void) {
+  if(gCurrentContext) return gCurrentContext;
+  return G();
+}
+
+// install current context
+void Context::Current(Context* pContext) {
+  gCurrentContext=pContext;
+}
+
+// clear limits
+void Context::Reset(void) {
+  mCancelled=false;
+  mDeadline=0;
+  mStateLimit=0;
+}
+
+// set deadline
+void Context::Deadline(long int msecs) {
+  mDeadline = msecs>0 ? ctx_now()+msecs : 0;
+}
+
+// test deadline
+bool Context::DeadlineExceeded(void) const {
+  long long deadline=mDeadline.load();
+  if(deadline!=0) 
+  if(ctx_now() > deadline) return true;
+  if(pParent) return pParent->DeadlineExceeded();
+  return false;
+}
+
+// shared registries
+TypeRegistry* Context::TypeRegistryp(void) const {
+  return TypeRegistry::G();
+}
+
+// shared registries
+FunctionRegistry* Context::FunctionRegistryp(void) const {
+  return FunctionRegistry::G();
+}
+
+// open scope
+ContextScope::ContextScope(Context* pContext) {
+  pPrevious=gCurrentContext;
+  Context::Current(pContext);
+}
+
+// close scope
+ContextScope::~ContextScope(void) {
+  Context::Current(pPrevious);
+}
+
+// open budget scope
+BudgetScope::BudgetScope(long int msecs, Idx states) {
+  Context* parent=Context::Current();
+  // derive context
+  mContext.pEventSymbolTable=parent->pEventSymbolTable;
+  mContext.pConsole=parent->pConsole;
+  mContext.pBreakFnct=parent->pBreakFnct;
+  mContext.mThreads.store(parent->Threads());
+  mContext.pConflictCandidate=parent->pConflictCandidate;
+  mContext.pParent=parent;
+  // tighten deadline
+  long long deadline=parent->mDeadline.load();
+  if(msecs>0) {
+    long long mydeadline=ctx_now()+msecs;
+    if((deadline==0) || (mydeadline<deadline)) deadline=mydeadline;
+  }
+  mContext.mDeadline.store(deadline);
+  // tighten state limit
+  Idx limit=parent->StateLimit();
+  if(states>0) 
+  if((limit==0) || (states<limit)) limit=states;
+  mContext.mStateLimit.store(limit);
+  // install
+  pPrevious=gCurrentContext;
+  Context::Current(&mContext);
+}
+
+// close budget scope
+BudgetScope::~BudgetScope(void) {
+  Context::Current(pPrevious);
+}
+
+} // namespace faudes
@@ -0,0 +1,340 @@
+/** @file cfl_context.h Library context to isolate concurrent computations */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#ifndef FAUDES_CONTEXT_H
+#define FAUDES_CONTEXT_H
+
+#include "cfl_definitions.h"
+#include "cfl_platform.h"
+
+#include <atomic>
+#include <map>
+
+namespace faudes {
+
+// forward
+class SymbolTable;
+class ConsoleOut;
+class TypeRegistry;
+class FunctionRegistry;
+class vGenerator;
+template<class T> class TBaseVector;
+
+/**
+ * Candidate heuristic for compositional conflict verification.
+ *
+ * In each step, IsNonconflicting(const GeneratorVector&) composes a pair of
+ * generators from the remaining family. The pair is chosen by a heuristic with
+ * the below signature, as specified by the current Context. A heuristic is meant
+ * to be cheap, i.e., it should base its choice on sizes and alphabets rather than
+ * on actual compositions.
+ *
+ * @param rGenVec
+ *   Remaining family of generators, at least two
+ * @param rEventCount
+ *   Number of generators in rGenVec per event
+ * @param rI
+ *   Position of first generator to compose
+ * @param rJ
+ *   Position of second generator to compose, must differ from rI
+ */
+typedef void (*ConflictCandidateFnct)(const TBaseVector<vGenerator>& rGenVec,
+  const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ);
+
+/**
+ * Library context.
+ *
+ * A Context bundles the state that libFAUDES otherwise keeps in process-wide
+ * singletons, i.e., the event symbol table used by newly constructed generators and
+ * alphabets, the console used for progress reports and error messages, and the
+ * break function polled by LoopCallback(). Each thread operates on a current context,
+ * which defaults to the global context Context::G(). The global context refers to
+ * the traditional singletons, so applications that do not use contexts
+ * are not affected.
+ *
+ * To run an isolated computation, set up a context and install it for the
+ * calling thread by a ContextScope:
+ *
+ * @code
+ * SymbolTable events(*SymbolTable::GlobalEventSymbolTablep()); // own copy of event names
+ * Context ctx;
+ * ctx.EventSymbolTablep(&events);
+ * ctx.BreakFnct(&MyBreakFnct);                                  // own progress callback
+ * {
+ *   ContextScope scope(&ctx);
+ *   Generator g1("g1.gen"), g2("g2.gen"), res;                  // refer to events
+ *   Parallel(g1,g2,res);                                        // polls MyBreakFnct
+ * }
+ * @endcode
+ *
+ * A context does not own the objects it refers to, and it must not be destroyed
+ * while a scope installs it. Objects constructed within a scope keep referring to the
+ * event symbol table of the context; thus, the table must outlive the objects. The event
+ * table should be initialised as a copy of the global table, since plugins may have
+ * registered static symbols before the context was set up. Any item that is not set
+ * explicitly (i.e. NULL) falls back to the corresponding global singleton.
+ *
+ * In addition, a context carries the limits that LoopCallback() and LoopCheck() enforce
+ * on behalf of the application, i.e., a cancellation flag that may be set from any
+ * thread by Cancel(), a deadline and a limit on the number of states of intermediate
+ * results; see also BudgetScope. Note that limits set on the global context apply to
+ * all threads that have not installed a context of their own.
+ *
+ * Likewise, a context carries the number of worker threads that algorithms with a
+ * multi-threaded implementation may use, e.g. Parallel(), StateMin() or the computation of
+ * bisimulations; see Threads(Idx). Thus, concurrent requests can be configured
+ * independently. The setting is ignored when libFAUDES is configured without the option
+ * core_threads.
+ *
+ * Similarly, the candidate heuristic used by IsNonconflicting(const GeneratorVector&) is
+ * a per-context setting; see ConflictCandidate(ConflictCandidateFnct).
+ *
+ * The type- and function registries are populated once at program start-up and
+ * are operated read-only thereafter. Hence, they are shared among all contexts and
+ * the respective accessors refer to the global instances.
+ *
+ * @ingroup ContainerClasses
+ */
+class FAUDES_API Context {
+public:
+  /** Construct context with all items set to fall back to the global singletons */
+  Context(void);
+
+  /** Destruct */
+  ~Context(void);
+
+  /** Global default context */
+  static Context* G(void);
+
+  /**
+   * Current context.
+   *
+   * @return
+   *   Context installed by the innermost active ContextScope of the calling
+   *   thread, or the global context.
+   */
+  static Context* Current(void);
+
+  /** Install current context of the calling thread, NULL for the global context (see ContextScope) */
+  static void Current(Context* pContext);
+
+  /** Event symbol table for new generators and alphabets (NULL for global table) */
+  SymbolTable* EventSymbolTablep(void) const { return pEventSymbolTable; }
+
+  /**
+   * Set event symbol table.
+   *
+   * The table is configured for concurrent access, see SymbolTable::Concurrent(), since
+   * multiple threads may operate within this context, e.g. the workers of RunTasks().
+   * Thus, the table must not be in use by other threads when installed.
+   *
+   * @param pSymTab
+   *   Event symbol table, or NULL for the global table
+   */
+  void EventSymbolTablep(SymbolTable* pSymTab);
+
+  /** Console for progress and error reports (NULL for ConsoleOut singleton) */
+  ConsoleOut* Console(void) const { return pConsole; }
+
+  /** Set console */
+  void Console(ConsoleOut* pCout) { pConsole=pCout; }
+
+  /** Break function polled by LoopCallback() (NULL for the global break function) */
+  bool (*BreakFnct(void) const)(void) { return pBreakFnct; }
+
+  /** Set break function */
+  void BreakFnct(bool (*pBreak)(void)) { pBreakFnct=pBreak; }
+
+  /**
+   * Request cancellation.
+   *
+   * Algorithms that operate within this context will throw an exception (id 110)
+   * on their next LoopCallback(). This function is thread-safe and is meant to
+   * be called by a supervising thread.
+   */
+  void Cancel(void) { mCancelled=true; }
+
+  /** Test whether cancellation has been requested, incl. the context a BudgetScope derived from */
+  bool Cancelled(void) const { return mCancelled || (pParent && pParent->Cancelled()); }
+
+  /** Clear cancellation request, deadline and state limit */
+  void Reset(void);
+
+  /**
+   * Set deadline.
+   *
+   * @param msecs
+   *   Time in ms from now, or 0 for no deadline
+   */
+  void Deadline(long int msecs);
+
+  /** Test whether the deadline has passed, incl. the context a BudgetScope derived from */
+  bool DeadlineExceeded(void) const;
+
+  /** Set limit on the number of states (0 for no limit) */
+  void StateLimit(Idx cnt) { mStateLimit.store(cnt); }
+
+  /** Limit on the number of states (0 for no limit) */
+  Idx StateLimit(void) const { return mStateLimit.load(); }
+
+  /**
+   * Set number of worker threads.
+   *
+   * Algorithms that offer a multi-threaded implementation consult this setting of the
+   * current context to figure the number of workers, see also TaskThreads(). The results
+   * do not depend on the number of threads.
+   *
+   * @param n
+   *   Number of threads; 0 for the number of available processors,
+   *   1 (default) for sequential operation
+   */
+  void Threads(Idx n) { mThreads.store(n); }
+
+  /** Number of worker threads (0 for number of available processors) */
+  Idx Threads(void) const { return mThreads.load(); }
+
+  /**
+   * Set candidate heuristic for compositional conflict verification.
+   *
+   * @param pFnct
+   *   Heuristic to use, or NULL for the default ConflictCandidateMinTMaxC
+   */
+  void ConflictCandidate(ConflictCandidateFnct pFnct) { pConflictCandidate=pFnct; }
+
+  /** Candidate heuristic for compositional conflict verification (NULL for the default) */
+  ConflictCandidateFnct ConflictCandidate(void) const { return pConflictCandidate; }
+
+  /** Type registry (shared, refers to TypeRegistry::G()) */
+  TypeRegistry* TypeRegistryp(void) const;
+
+  /** Function registry (shared, refers to FunctionRegistry::G()) */
+  FunctionRegistry* FunctionRegistryp(void) const;
+
+private:
+  /** Event symbol table */
+  SymbolTable* pEventSymbolTable;
+
+  /** Console */
+  ConsoleOut* pConsole;
+
+  /** Break function */
+  bool (*pBreakFnct)(void);
+
+  /** Cancellation request */
+  std::atomic<bool> mCancelled;
+
+  /** Deadline in ms on a monotonic clock (0 for none) */
+  std::atomic<long long> mDeadline;
+
+  /** State limit */
+  std::atomic<Idx> mStateLimit;
+
+  /** Number of worker threads */
+  std::atomic<Idx> mThreads;
+
+  /** Candidate heuristic */
+  ConflictCandidateFnct pConflictCandidate;
+
+  /** Context we derive from (BudgetScope only) */
+  Context* pParent;
+
+  /** BudgetScope sets up a derived context */
+  friend class BudgetScope;
+
+  /** Not copyable */
+  Context(const Context&);
+  Context& operator=(const Context&);
+};
+
+
+/**
+ * Scope for a library context.
+ *
+ * While a ContextScope is alive, the specified context is the current context of
+ * the calling thread; see Context. Scopes nest and are local to the calling thread.
+ *
+ * @ingroup ContainerClasses
+ */
+class FAUDES_API ContextScope {
+public:
+  /** Open scope with specified context */
+  explicit ContextScope(Context* pContext);
+  /** Close scope, restore previous context */
+  ~ContextScope(void);
+private:
+  Context* pPrevious;
+  ContextScope(const ContextScope&);
+  ContextScope& operator=(const ContextScope&);
+};
+
+
+/**
+ * Scope for a time and state budget.
+ *
+ * While a BudgetScope is alive, the calling thread operates on a context derived from
+ * its previous current context, which is subject to the specified deadline and state limit.
+ * The derived context refers to the same event symbol table, console, break function, thread count
+ * and candidate heuristic,
+ * and it follows any cancellation request on the previous context. Since the previous context
+ * is not modified, budgets of different threads do not interfere, even when the threads 
+ * share a context such as the global context. This is meant to bound a single call to a
+ * long-running function:
+ *
+ * @code
+ * try {
+ *   BudgetScope budget(5000,100000);  // 5sec, 100000 states
+ *   SupConNB(plant,spec,sup);
+ * } catch(Exception& ex) {
+ *   // ex.Id() is 111 for timeout and 112 for too many states
+ * }
+ * @endcode
+ *
+ * Budgets nest, i.e., an inner scope can only tighten the limits. When the scope is
+ * closed, the previous context is restored. Worker threads of RunTasks() operate on
+ * the derived context and, hence, are subject to the same limits.
+ *
+ * @ingroup ContainerClasses
+ */
+class FAUDES_API BudgetScope {
+public:
+  /**
+   * Open scope
+   *
+   * @param msecs
+   *   Time in ms from now, or 0 for no time limit
+   * @param states
+   *   Limit on the number of states, or 0 for no limit
+   */
+  BudgetScope(long int msecs, Idx states=0);
+  /** Close scope, restore previous context */
+  ~BudgetScope(void);
+private:
+  Context mContext;
+  Context* pPrevious;
+  BudgetScope(const BudgetScope&);
+  BudgetScope& operator=(const BudgetScope&);
+};
+
+
+} // namespace faudes
+
+#endif
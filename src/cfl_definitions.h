@@ -108,6 +108,11 @@ typedef double Float;
 #define FD_WPC(cntnow, contdone, message)
 #endif
 
+/** Application callback: cancellation, deadline and state limit, amortised over FAUDES_LOOP_PERIOD iterations */
+#define FAUDES_LOOP_PERIOD 0x3ff
+#define FD_LOOP(cnt, cntstates) \
+  { if(((++(cnt)) & FAUDES_LOOP_PERIOD)==0) faudes::LoopCheck(cntstates); }
+
 /** Alternative progessreport for development */
 #ifdef FAUDES_SYSTIME  
 #define FD_WPD(cntnow, cntdone, message)  { \
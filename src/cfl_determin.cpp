@@ -22,6 +22,8 @@
 
 #include "cfl_determin.h"
 
+#include <algorithm>
+
 namespace faudes {
 
 // UniqueInit(rGen&)
@@ -66,10 +68,8 @@ void UniqueInit(const Generator& rGen, Generator& rResGen) {
 
 // Deterministic(rGen&, rResGen&)
 void Deterministic(const Generator& rGen, Generator& rResGen) {
-  // temporary vectors
-  std::vector<StateSet> power_states;
-  std::vector<Idx> det_states;
-  Deterministic(rGen, power_states, det_states, rResGen);
+  SubsetConstruction subcon;
+  subcon.Compute(rGen, rResGen);
 }
 
 
@@ -110,13 +110,156 @@ void Deterministic(const Generator& rGen, std::map<Idx,StateSet>& rEntryStatesMa
 }
 
 
+// Deterministic(rGen&, rPowerStates&, rDetStates&, rResGen&)
 void Deterministic(const Generator& rGen, std::vector<StateSet>& rPowerStates,
 		   std::vector<Idx>& rDetStates, Generator& rResGen) {
+  // run subset construction
+  SubsetConstruction subcon;
+  subcon.Compute(rGen, rResGen);
+  // convert power states
+  rPowerStates.clear();
+  rDetStates.clear();
+  rPowerStates.resize(subcon.Size());
+  rDetStates.resize(subcon.Size());
+  for(Idx k=0; k<subcon.Size(); ++k) {
+    subcon.PowerState(k,rPowerStates[k]);
+    rDetStates[k]=subcon.DetState(k);
+  }
+}
+
+
+/*
+*********************************************************
+Subset construction engine
+*********************************************************
+*/
+
+// hash function for power states (sorted arrays of indices)
+static inline uint64_t subcon_hash(const Idx* pBegin, const Idx* pEnd) {
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ ((uint64_t) (pEnd-pBegin));
+  for(;pBegin!=pEnd;++pBegin) {
+    h ^= (uint64_t) *pBegin;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 32;
+  }
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// construct
+SubsetConstruction::SubsetConstruction(void) {
+  Clear();
+}
 
-  // note: there is a demonstrative description of the multiway merge
-  // algorithm in the master thesis. (Bernd Opitz)
+// clear
+void SubsetConstruction::Clear(void) {
+  mCGen.Clear();
+  mHidden.Clear();
+  mHiddenFlags.clear();
+  mArena.clear();
+  mBegin.assign(1,0);
+  mHash.clear();
+  mDetStates.clear();
+  mTable.clear();
+  mScratch.clear();
+  mMarks.clear();
+  mMarkStamp=0;
+  mStack.clear();
+}
+
+// hidden events
+void SubsetConstruction::Hide(const EventSet& rEvents) {
+  mHidden.Clear();
+  mHidden.InsertSet(rEvents);
+}
 
-  FD_DF("Deterministic(): core function #" << rGen.Size());
+// lookup power state in scratch
+Idx SubsetConstruction::Find(uint64_t hash) const {
+  std::size_t mask=mTable.size()-1;
+  std::size_t pos=((std::size_t) hash) & mask;
+  std::size_t len=mScratch.size();
+  while(true) {
+    Idx kk=mTable[pos];
+    if(kk==0) return 0;
+    if(mHash[kk-1]==hash) 
+    if(mBegin[kk]-mBegin[kk-1]==len) 
+    if(std::equal(mScratch.begin(),mScratch.end(),mArena.begin()+mBegin[kk-1])) 
+      return kk;
+    pos=(pos+1) & mask;
+  }
+}
+
+// insert power state from scratch
+Idx SubsetConstruction::Insert(uint64_t hash) {
+  mArena.insert(mArena.end(),mScratch.begin(),mScratch.end());
+  mBegin.push_back(mArena.size());
+  mHash.push_back(hash);
+  Idx k=(Idx) mHash.size()-1;
+  // grow index and re-hash at load factor 1/2
+  if(2*mHash.size() > mTable.size()) {
+    mTable.assign(2*mTable.size(),0);
+    for(Idx kk=0; kk<=k; ++kk) Place(kk);
+  } else {
+    Place(k);
+  }
+  return k;
+}
+
+// record in index
+void SubsetConstruction::Place(Idx k) {
+  std::size_t mask=mTable.size()-1;
+  std::size_t pos=((std::size_t) mHash[k]) & mask;
+  while(mTable[pos]!=0) pos=(pos+1) & mask;
+  mTable[pos]=k+1;
+}
+
+// close scratch w.r.t. hidden events and sort
+void SubsetConstruction::Closure(void) {
+  // trivial case
+  if(mHidden.Empty()) {
+    std::sort(mScratch.begin(),mScratch.end());
+    return;
+  }
+  // advance stamp (reset marks on overflow)
+  ++mMarkStamp;
+  if(mMarkStamp==0) {
+    std::fill(mMarks.begin(),mMarks.end(),0);
+    mMarkStamp=1;
+  }
+  // depth first search
+  mStack.clear();
+  for(std::size_t i=0; i<mScratch.size(); ++i) {
+    mMarks[mScratch[i]]=mMarkStamp;
+    mStack.push_back(mScratch[i]);
+  }
+  while(!mStack.empty()) {
+    Idx q=mStack.back();
+    mStack.pop_back();
+    CompiledGenerator::Iterator eit=mCGen.SuccBegin(q);
+    CompiledGenerator::Iterator eit_end=mCGen.SuccEnd(q);
+    for(;eit!=eit_end;++eit) {
+      if(!mHiddenFlags[eit->Ev]) continue;
+      if(mMarks[eit->X]==mMarkStamp) continue;
+      mMarks[eit->X]=mMarkStamp;
+      mScratch.push_back(eit->X);
+      mStack.push_back(eit->X);
+    }
+  }
+  std::sort(mScratch.begin(),mScratch.end());
+}
+
+// report power state
+void SubsetConstruction::PowerState(Idx k, StateSet& rStates) const {
+  rStates.Clear();
+  for(std::size_t i=mBegin[k]; i<mBegin[k+1]; ++i) 
+    rStates.Insert(mCGen.State(mArena[i]));
+}
+
+// subset construction
+void SubsetConstruction::Compute(const Generator& rGen, Generator& rResGen) {
+  FD_DF("SubsetConstruction::Compute(): #" << rGen.Size() << " hiding #" << mHidden.Size());
 
   // use pointer pResGen to result rResGen
   Generator* pResGen = &rResGen;
@@ -126,245 +269,120 @@ void Deterministic(const Generator& rGen, std::vector<StateSet>& rPowerStates,
 
   // prepare result
   pResGen->Clear();  
-  rPowerStates.clear();
-  rDetStates.clear();
-  // set the name
   pResGen->Name(CollapsString("Det(" + rGen.Name() + ")"));
-  // copy alphabet
-  FD_DF("Deterministic A " << rGen.Alphabet().ToString());
-  pResGen->InjectAlphabet(rGen.Alphabet());
-  FD_DF("Deterministic B");
-
-  // bail out on empty input 
-  if(rGen.InitStatesEmpty()) {
-    if(pResGen != &rResGen) {
-      rResGen.Move(*pResGen);
-      delete pResGen;
-    }
-    FD_DF("Deterministic(): done (empty)"); 
-    return;
+  if(mHidden.Empty()) pResGen->InjectAlphabet(rGen.Alphabet());
+  else pResGen->InjectAlphabet(rGen.Alphabet() - mHidden);
+
+  // reset data
+  mArena.clear();
+  mBegin.assign(1,0);
+  mHash.clear();
+  mDetStates.clear();
+  mTable.assign(1024,0);
+  mScratch.clear();
+  mStack.clear();
+
+  // compile input
+  mCGen.Compile(rGen,false);
+  mHiddenFlags.assign(mCGen.AlphabetSize()+1,false);
+  EventSet::Iterator eit=mHidden.Begin();
+  EventSet::Iterator eit_end=mHidden.End();
+  for(;eit!=eit_end;++eit) {
+    Idx e=mCGen.EventIndex(*eit);
+    if(e!=0) mHiddenFlags[e]=true;
   }
-
-  // helpers
-  typedef std::multimap< Idx,std::vector<StateSet>::size_type > T_HASHMAP;
-  T_HASHMAP hashmap;
-  std::vector<StateSet>::size_type current_vecindex;
-  std::pair< std::map<StateSet,Idx>::iterator,bool > result;
-  TransSet::Iterator transrel_end = rGen.TransRelEnd();
-  StateSet newset;
-  StateSet::Iterator lit;
-  const Idx max_idx = std::numeric_limits<Idx>::max();
-
-  // lock transrel to prevent iterator tracking (tmoor 201403)
-  rGen.TransRel().Lock();
-  
-  // initialize rPowerStates with subset of initial states
-  Idx newstate = pResGen->InsInitState();
-  for (lit = rGen.InitStatesBegin(); lit != rGen.InitStatesEnd(); ++lit) {
-    // clear set and insert single state
-    newset.Insert(*lit);
-    // if marked state set in res generator
-    if (rGen.ExistsMarkedState(*lit)) {
-      pResGen->SetMarkedState(newstate);
-      FD_DF("Deterministic: setting as mstate: " << rGen.SStr(newstate));
+  mMarks.assign(mCGen.Size()+1,0);
+  mMarkStamp=0;
+
+  // power state of initial states
+  if(!mCGen.InitStates().empty()) {
+    mScratch=mCGen.InitStates();
+    Closure();
+    Idx x0=pResGen->InsInitState();
+    Insert(subcon_hash(&mScratch[0],&mScratch[0]+mScratch.size()));
+    mDetStates.push_back(x0);
+    for(std::size_t i=0; i<mScratch.size(); ++i) {
+      if(!mCGen.MarkedState(mScratch[i])) continue;
+      pResGen->SetMarkedState(x0);
+      break;
     }
   }
-  FD_DF("Deterministic: created subset of initial states {"
-	<< newset.ToString() << "} with deterministic state index "
-	<< rGen.SStr(newstate));
-  // internally record newset 
-  rPowerStates.push_back(newset);
-  rDetStates.push_back(newstate);
-  hashmap.insert(std::make_pair(newset.Signature(), (Idx)rPowerStates.size() - 1));
-
-  // iteration over all states
-  for (current_vecindex = 0; current_vecindex < rPowerStates.size(); 
-       ++current_vecindex) {
-    FD_WPC(current_vecindex,rPowerStates.size(), "Deterministic(): current/size: "<<  current_vecindex << " / " << rPowerStates.size());
-    FD_DF("Deterministic: current power set: {" 
-	  << rPowerStates[current_vecindex].ToString() << "} -> " 
-	  << rDetStates[current_vecindex]);
-
-    std::vector<StateSet> newset_vec;
-    std::vector<Idx> event_vec;
-
-    // multiway merge begin
-    FD_DF("Deterministic: starting multiway merge...");
-    std::list<TransSet::Iterator> merge_iterators;
-    std::vector<Transition> trans_vec;
-
-    // add transset iterator at begin of each state's transitions
-    TransSet::Iterator tit;
-    for (lit = rPowerStates[current_vecindex].Begin(); 
-	 lit != rPowerStates[current_vecindex].End(); ++lit) {
-      tit = rGen.TransRelBegin(*lit);
-      if (tit != rGen.TransRelEnd(*lit)) {
-	merge_iterators.push_back(tit);
-	FD_DF("Deterministic: added merge iterator: " << rGen.SStr(tit->X1) 
-	      << "-" << rGen.EStr(tit->Ev) << "-" << rGen.SStr(tit->X2));
-      }
-    }
 
-    // find first iterator with lowest event
-    while (! merge_iterators.empty()) {
-      Idx currentevent = max_idx;
-      std::list<TransSet::Iterator>::iterator i; 
-      std::list<TransSet::Iterator>::iterator currentit = merge_iterators.end();
-      for (i = merge_iterators.begin(); i != merge_iterators.end(); ++i) {
-	if ((*i)->Ev < currentevent) {
-	  currentevent = (*i)->Ev;
-	  currentit = i;
-	}
-      }
-      // currentit now holds the iterator
-      // currentevent holds the lowest event (lowest Idx)
-
-      // merge all transitions with currentevent at each iterator in a row;
-      // this is a modification of multiway merge as after projection the
-      // automaton most likely holds states with many transitions that share 
-      // the same event; only merging the lowest transition and continue with
-      // search for the lowest event again would be to slow here (because
-      // of too much iterator dereferencing).
-      Idx currentstate;
-      while (currentit != merge_iterators.end()) {
-	currentstate = (*currentit)->X1;
-	TransSet::Iterator& j = *currentit;
-	while (1) {
-	  // remove iterator if it reaches the end of the transition set
-	  if (j == transrel_end) {
-	    merge_iterators.erase(currentit++);
-	    break;
-	  }
-	  // if current iterator is in its original state
-	  else if (j->X1 == currentstate) {
-	    // if the event is still the same add the transition
-	    if (j->Ev == currentevent) {
-	      trans_vec.push_back(*j); 
-	      FD_DF("Deterine: adding transition to list: " 
-		    << rGen.SStr(j->X1) << "-" << rGen.EStr(j->Ev) << "-"
-		    << rGen.SStr(j->X2));
-	    }
-	    // else go to next iterator
-	    else {
-	      ++currentit;
-	      break;
-	    }
-	  }
-	  // if the iterator is beyond its original state remove it
-	  else {
-	    merge_iterators.erase(currentit++);
-	    break;
-	  }
-	  ++j;
-	}
-      }
-    }
-
-    // partition transition vector by events. optimizable? 
-    FD_DF("Deterministic: partitioning the transition vector...");
-    std::vector<Transition>::iterator tv_it;
-    StateSet newset;
-    Idx lastevent = 0;
-    for (tv_it = trans_vec.begin(); tv_it != trans_vec.end(); ++tv_it) {
-      if ((tv_it->Ev == lastevent) || (lastevent == 0)) {
-	newset.Insert(tv_it->X2);
-	lastevent = tv_it->Ev;
-      }
-      else {
-	FD_DF("Deterministic: partition: {" << newset.ToString() 
-	      << "} with event " << rGen.EStr(lastevent));
-	newset_vec.push_back(newset);
-	event_vec.push_back(lastevent);
-	newset.Clear();
-	newset.Insert(tv_it->X2);
-	lastevent = tv_it->Ev;
+  // iterate over power states in order of discovery
+  std::vector<uint64_t> edges;
+  Idx lcnt=0;
+  for(Idx k=0; k<mHash.size(); ++k) {
+    FD_WPC(k,mHash.size(), "Deterministic(): current/size: "<<  k << " / " << mHash.size());
+    FD_LOOP(lcnt,(Idx) mHash.size());
+    // collect (ev,x2) pairs from all members
+    edges.clear();
+    for(std::size_t i=mBegin[k]; i<mBegin[k+1]; ++i) {
+      CompiledGenerator::Iterator tit=mCGen.SuccBegin(mArena[i]);
+      CompiledGenerator::Iterator tit_end=mCGen.SuccEnd(mArena[i]);
+      for(;tit!=tit_end;++tit) {
+        if(mHiddenFlags[tit->Ev]) continue;
+        edges.push_back((((uint64_t) tit->Ev) << 32) | ((uint64_t) tit->X));
       }
     }
-    if (! newset.Empty()) {
-      FD_DF("Deterministic: partition: {" << newset.ToString() 
-	    << "} with event " << rGen.EStr(lastevent));
-      newset_vec.push_back(newset);
-      event_vec.push_back(lastevent);
-    }
-    FD_DF("Deterministic: partitioning the transition vector finished");
-    FD_DF("Deterministic: multiway merge finished");
-    // multiway merge end
-
-
-    std::vector<StateSet>::size_type nsv_index;
-    for (nsv_index = 0; nsv_index < newset_vec.size(); ++nsv_index) {
-      StateSet& currentset = newset_vec[nsv_index];
-      Idx currentevent = event_vec[nsv_index];
-      Idx tmp_x2 = 0;
-      Idx sig = currentset.Signature();
-      // test if newset signature is already known
-      std::pair<T_HASHMAP::iterator,T_HASHMAP::iterator> phit
-	= hashmap.equal_range(sig);
-      T_HASHMAP::iterator hit = phit.first;
-      for (hit = phit.first; hit != phit.second; ++hit) {
-	// test set of every matching signature for equality
-	if (currentset == rPowerStates[hit->second]) {
-	  tmp_x2 = rDetStates[hit->second];
-	  break;
-	}
+    std::sort(edges.begin(),edges.end());
+    edges.erase(std::unique(edges.begin(),edges.end()),edges.end());
+    // one successor power state per event
+    std::size_t j=0;
+    while(j<edges.size()) {
+      Idx ev=(Idx) (edges[j] >> 32);
+      mScratch.clear();
+      for(;j<edges.size(); ++j) {
+        if((Idx) (edges[j] >> 32) != ev) break;
+        mScratch.push_back((Idx) (edges[j] & 0xffffffffULL));
       }
-
-      // if new set is unique within the existing power sets
-      if (tmp_x2 == 0) {
-	// create new state in res generator
-	tmp_x2 = pResGen->InsState();
-	// insert newset in rPowerStates and get iterator,bool pair
-	rPowerStates.push_back(currentset);
-	rDetStates.push_back(tmp_x2);
-	hashmap.insert(std::make_pair(sig, (Idx)rPowerStates.size() - 1));
-	FD_DF("Deterministic: added new state " 
-	      << rGen.SStr(tmp_x2) 
-	      << " for new subset {" <<	currentset.ToString() << "}");
-	// set marked if one of the states in current set is marked
-	for (lit = currentset.Begin(); lit != currentset.End(); ++lit) {
-	  if (rGen.ExistsMarkedState(*lit)) {
-	    pResGen->SetMarkedState(tmp_x2);
-	    break;
-	  }
-	}
+      Closure();
+      uint64_t hash=subcon_hash(&mScratch[0],&mScratch[0]+mScratch.size());
+      Idx kk=Find(hash);
+      Idx x2;
+      if(kk!=0) {
+        x2=mDetStates[kk-1];
+      } else {
+        x2=pResGen->InsState();
+        Insert(hash);
+        mDetStates.push_back(x2);
+        for(std::size_t i=0; i<mScratch.size(); ++i) {
+          if(!mCGen.MarkedState(mScratch[i])) continue;
+          pResGen->SetMarkedState(x2);
+          break;
+        }
       }
-      // introduce transition
-      pResGen->SetTransition(rDetStates[current_vecindex], currentevent, tmp_x2);
+      pResGen->SetTransition(mDetStates[k], mCGen.Event(ev), x2);
     }
   }
 
-
   // fix names
-  if (rGen.StateNamesEnabled() && pResGen->StateNamesEnabled()) {
-    FD_DF("Deterministic: fixing names...");
-    // rPowerStates / rDetStates index "iterator"
-    std::vector<StateSet>::size_type i;
-    // iterate target states
-    for (i = 0; i < rPowerStates.size(); ++i) {
-      // temporary state name
+  if(rGen.StateNamesEnabled() && pResGen->StateNamesEnabled()) {
+    FD_DF("SubsetConstruction::Compute(): fixing names...");
+    for(Idx k=0; k<mHash.size(); ++k) {
       std::string name = "{";
-      for (lit = rPowerStates[i].Begin();  lit != rPowerStates[i].End(); ++lit) {
-	if (rGen.StateName(*lit) != "") name = name + rGen.StateName(*lit) + ",";
-	else name = name + ToStringInteger(*lit) + ",";
+      for(std::size_t i=mBegin[k]; i<mBegin[k+1]; ++i) {
+        Idx x=mCGen.State(mArena[i]);
+        std::string xname=rGen.StateName(x);
+        if(xname != "") name = name + xname + ",";
+        else name = name + ToStringInteger(x) + ",";
       }
       name.erase(name.length() - 1);
       name = name + "}";
-      FD_DF("Deterministic: setting state name \"" << name << "\" for index "
-	    << rDetStates[i]);
-      pResGen->StateName(rDetStates[i], name);
+      pResGen->StateName(mDetStates[k], name);
     }
   }
-  
+
+  // release scratch
+  mTable.clear();
+  mMarks.clear();
+
   // move pResGen to rResGen
   if(pResGen != &rResGen) {
     rResGen.Move(*pResGen);
     delete pResGen;
   }
-
-  FD_DF("Deterministic(): core function: done");
-    
+  FD_DF("SubsetConstruction::Compute(): done #" << Size());
 }
 
 
-
 } // namespace faudes
@@ -26,6 +26,7 @@
 
 #include "cfl_definitions.h"
 #include "cfl_agenerator.h"
+#include "cfl_compiledgen.h"
 
 namespace faudes {
 
@@ -69,11 +70,10 @@ extern FAUDES_API void UniqueInit(const Generator& rGen, Generator& rResGen);
 /**
  * Make generator deterministic.
  * Constructs a deterministic generator while preserving the generated and marked languages.
- * The implementation is based on the so called multiway merge variant of subset construction, 
- * in which the new state set becomes a subset of the power set og the given state set. It is of
- * exponential complexity. For details on the multiway merge algorithm see
- * "Ted Leslie, Efficient Approaches to Subset Construction, 
- *  Computer Science, University of Waterloo, 1995".
+ * The implementation is based on subset construction, in which the new state set becomes a 
+ * subset of the power set of the given state set. It is of exponential complexity. Power states
+ * are maintained by the SubsetConstruction engine, i.e., packed into one arena and looked up
+ * by hash value.
  *
  * See also 
  * Deterministic(const Generator&,std::map<Idx,StateSet>&,Generator& rResGen) and
@@ -156,6 +156,122 @@ extern FAUDES_API void Deterministic(const Generator& rGen, std::vector<StateSet
 			 std::vector<Idx>& rDetStates, Generator& rResGen);
 
 
+/**
+ * Subset construction engine.
+ *
+ * This class implements the subset construction used by Deterministic(). Power states are
+ * kept as sorted arrays of compiled state indices within one contiguous arena, and they
+ * are looked up by a 64-bit hash in an open addressing index. Thus, the memory footprint
+ * per power state amounts to its elements plus a few words of bookkeeping, as opposed to
+ * one StateSet per power state.
+ *
+ * Optionally, the construction hides a specified set of events on the fly: each power state is
+ * closed w.r.t. transitions labeled by hidden events, and hidden events are removed from the
+ * alphabet of the result. Hence, the result realises the natural projection of the generated and 
+ * marked languages to the remaining events, without the preprocessing by ProjectNonDet().
+ *
+ * Example:
+ * \code
+ * SubsetConstruction subcon;
+ * subcon.Hide(rGen.Alphabet() - rProjectAlphabet);  // optional
+ * subcon.Compute(rGen,rResGen);
+ * \endcode
+ *
+ * @ingroup GeneratorFunctions
+ */
+class FAUDES_API SubsetConstruction {
+
+public:
+
+  /** Construct */
+  SubsetConstruction(void);
+
+  /** Clear all data incl. hidden events */
+  void Clear(void);
+
+  /**
+   * Specify events to hide (on-the-fly closure)
+   *
+   * @param rEvents
+   *   Events to hide, empty for plain subset construction 
+   */
+  void Hide(const EventSet& rEvents);
+
+  /**
+   * Run subset construction 
+   *
+   * Performs the subset construction, starting with the (closure of the) set of initial states.
+   * The resulting states are numbered consecutively in the order of their discovery,
+   * and, if state names are enabled for both generators, the result state names 
+   * refer to the respective power state. Technical detail: if the input has no 
+   * initial state, then so has the output.
+   *
+   * @param rGen
+   *   Input generator
+   * @param rResGen
+   *   Reference to resulting deterministic generator
+   */
+  void Compute(const Generator& rGen, Generator& rResGen);
+
+  /** Number of power states (equals the number of states of the result) */
+  Idx Size(void) const { return (Idx) mDetStates.size(); };
+
+  /** State of the result that corresponds to the k-th power state (k=0,1,...) */
+  Idx DetState(Idx k) const { return mDetStates[k]; };
+
+  /** Original states of the k-th power state (k=0,1,...)  */
+  void PowerState(Idx k, StateSet& rStates) const;
+
+protected:
+
+  /** Lookup power state from mScratch, return index+1 or 0 if not found */
+  Idx Find(uint64_t hash) const;
+
+  /** Insert power state from mScratch, return index */
+  Idx Insert(uint64_t hash);
+
+  /** Record power state index at its hash position */
+  void Place(Idx k);
+
+  /** Close mScratch w.r.t. hidden events and sort */
+  void Closure(void);
+
+  /** Compiled input */
+  CompiledGenerator mCGen;
+
+  /** Events to hide (original indices) */
+  EventSet mHidden;
+
+  /** Hidden events by compiled event index */
+  std::vector<bool> mHiddenFlags;
+
+  /** Arena of power state elements (compiled state indices) */
+  std::vector<Idx> mArena;
+
+  /** Begin of k-th power state in arena (with sentinel) */
+  std::vector<std::size_t> mBegin;
+
+  /** Hash of k-th power state */
+  std::vector<uint64_t> mHash;
+
+  /** Corresponding result state */
+  std::vector<Idx> mDetStates;
+
+  /** Open addressing index, entries refer to power states by index+1 */
+  std::vector<Idx> mTable;
+
+  /** Scratch: power state under construction */
+  std::vector<Idx> mScratch;
+
+  /** Scratch: closure marks and stack */
+  std::vector<Idx> mMarks;
+  Idx mMarkStamp;
+  std::vector<Idx> mStack;
+
+};
+
+
+
 
 } // namespace faudes
 
@@ -0,0 +1,636 @@
+/** @file cfl_genbinary.cpp Binary file format for generators */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#include "cfl_genbinary.h"
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#ifdef FAUDES_POSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace faudes {
+
+// file format version
+#define FAUDES_BGEN_VERSION 1
+
+// byte order mark
+#define FAUDES_BGEN_BOM 0x01020304U
+
+// flags
+#define FAUDES_BGEN_STATENAMES 0x01
+
+// write buffer (number of Idx)
+#define FAUDES_BGEN_CHUNK (1<<16)
+
+// signature
+static const char bgen_magic[8]={'F','A','U','D','E','S','B','G'};
+
+// fixed size header, all offsets in bytes relative to the begin of the file
+struct BGenHeader {
+  char mMagic[8];
+  uint32_t mVersion;
+  uint32_t mByteOrder;
+  uint32_t mFlags;
+  uint32_t mName;
+  uint64_t mStatesSize;
+  uint64_t mAlphabetSize;
+  uint64_t mTransRelSize;
+  uint64_t mInitStatesSize;
+  uint64_t mMarkedStatesSize;
+  uint64_t mStatesOffset;
+  uint64_t mAlphabetOffset;
+  uint64_t mTransRelOffset;
+  uint64_t mInitStatesOffset;
+  uint64_t mMarkedStatesOffset;
+  uint64_t mStateNamesOffset;
+  uint64_t mStringsOffset;
+  uint64_t mStringsSize;
+  uint64_t mAttributesOffset;
+  uint64_t mAttributesSize;
+};
+
+// section alignment
+static uint64_t bgen_align(uint64_t pos) {
+  return (pos+7) & ~((uint64_t) 7);
+}
+
+
+// construct
+BinaryGenerator::BinaryGenerator(void) :
+  mpData(0), mSize(0), mMapped(false)
+{
+  Close();
+}
+
+// construct
+BinaryGenerator::BinaryGenerator(const std::string& rFileName) :
+  mpData(0), mSize(0), mMapped(false)
+{
+  Close();
+  Open(rFileName);
+}
+
+// destruct
+BinaryGenerator::~BinaryGenerator(void) {
+  Close();
+}
+
+// close
+void BinaryGenerator::Close(void) {
+#ifdef FAUDES_POSIX
+  if(mMapped) munmap((void*) mpData, mSize);
+#endif
+  mBuffer.clear();
+  mpData=0;
+  mSize=0;
+  mMapped=false;
+  mStatesSize=0;
+  mpStates=0;
+  mAlphabetSize=0;
+  mpAlphabet=0;
+  mTransRelSize=0;
+  mpTransRel=0;
+  mInitStatesSize=0;
+  mpInitStates=0;
+  mMarkedStatesSize=0;
+  mpMarkedStates=0;
+  mpStateNames=0;
+  mpStrings=0;
+  mStringsSize=0;
+  mpAttributes=0;
+  mAttributesSize=0;
+  mName=0;
+}
+
+// open
+void BinaryGenerator::Open(const std::string& rFileName) {
+  FD_DG("BinaryGenerator::Open(" << rFileName << ")");
+  Close();
+  bool ok=false;
+#ifdef FAUDES_POSIX
+  // map file to memory
+  int fd=open(rFileName.c_str(),O_RDONLY);
+  if(fd>=0) {
+    struct stat st;
+    if(fstat(fd,&st)==0)
+    if(st.st_size>0) {
+      void* addr=mmap(0,(std::size_t) st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+      if(addr!=MAP_FAILED) {
+        mpData=static_cast<const char*>(addr);
+        mSize=(std::size_t) st.st_size;
+        mMapped=true;
+        ok=true;
+      }
+    }
+    close(fd);
+  }
+#endif
+  // fallback: read file to buffer
+  if(!ok) {
+    std::ifstream fin(rFileName.c_str(), std::ios::in | std::ios::binary);
+    if(fin.good()) {
+      fin.seekg(0,std::ios::end);
+      std::streamoff size=fin.tellg();
+      fin.seekg(0,std::ios::beg);
+      if(size>0) {
+        mBuffer.resize((std::size_t) size);
+        fin.read(&mBuffer[0],size);
+        if(fin.good()) {
+          mpData=&mBuffer[0];
+          mSize=mBuffer.size();
+          ok=true;
+	}
+      }
+    }
+  }
+  if(!ok) {
+    Close();
+    std::stringstream errstr;
+    errstr << "cannot open binary generator file \"" << rFileName << "\"";
+    throw Exception("BinaryGenerator::Open", errstr.str(), 1);
+  }
+  // set up sections
+  try {
+    Validate(rFileName);
+  } catch (faudes::Exception&) {
+    Close();
+    throw;
+  }
+}
+
+// validate header and set up sections
+void BinaryGenerator::Validate(const std::string& rFileName) {
+  std::stringstream errstr;
+  errstr << "invalid binary generator file \"" << rFileName << "\": ";
+  // header
+  if(mSize<sizeof(BGenHeader)) {
+    errstr << "missing header";
+    throw Exception("BinaryGenerator::Open", errstr.str(), 50);
+  }
+  BGenHeader hdr;
+  std::memcpy(&hdr,mpData,sizeof(BGenHeader));
+  if(std::memcmp(hdr.mMagic,bgen_magic,8)!=0) {
+    errstr << "signature mismatch";
+    throw Exception("BinaryGenerator::Open", errstr.str(), 50);
+  }
+  if(hdr.mByteOrder!=FAUDES_BGEN_BOM) {
+    errstr << "byte order mismatch";
+    throw Exception("BinaryGenerator::Open", errstr.str(), 50);
+  }
+  if(hdr.mVersion!=FAUDES_BGEN_VERSION) {
+    errstr << "unsupported version " << hdr.mVersion;
+    throw Exception("BinaryGenerator::Open", errstr.str(), 50);
+  }
+  // sections: test range and alignment
+  uint64_t size=mSize;
+  bool err=false;
+  // (record counts are tested before any multiplication, so a forged size cannot wrap)
+  const uint64_t num[7]={hdr.mStatesSize, hdr.mAlphabetSize, hdr.mTransRelSize,
+    hdr.mInitStatesSize, hdr.mMarkedStatesSize,
+    (hdr.mFlags & FAUDES_BGEN_STATENAMES) ? hdr.mStatesSize : 0, 0};
+  const uint64_t wdt[7]={1, 1, 3, 1, 1, 1, 1};
+  const uint64_t off[7]={hdr.mStatesOffset, hdr.mAlphabetOffset, hdr.mTransRelOffset,
+    hdr.mInitStatesOffset, hdr.mMarkedStatesOffset, hdr.mStateNamesOffset, hdr.mStringsOffset};
+  for(int i=0; i<7; ++i) {
+    if(num[i] > FAUDES_IDX_MAX) err=true;
+    if(off[i] % 8 !=0) err=true;
+    if(off[i] > size) err=true;
+    else if(num[i] > (size-off[i])/(wdt[i]*sizeof(Idx))) err=true;
+  }
+  if(!err) {
+    if(hdr.mStringsSize > size-hdr.mStringsOffset) err=true;
+    if(hdr.mAttributesOffset > size) err=true;
+    else if(hdr.mAttributesSize > size-hdr.mAttributesOffset) err=true;
+    if(hdr.mStringsSize==0) err=true;
+    else if(mpData[hdr.mStringsOffset+hdr.mStringsSize-1]!=0) err=true;
+    if(hdr.mName >= hdr.mStringsSize) err=true;
+  }
+  if(err) {
+    errstr << "section out of range";
+    throw Exception("BinaryGenerator::Open", errstr.str(), 50);
+  }
+  // set up
+  mStatesSize=(Idx) hdr.mStatesSize;
+  mpStates=reinterpret_cast<const Idx*>(mpData+hdr.mStatesOffset);
+  mAlphabetSize=(Idx) hdr.mAlphabetSize;
+  mpAlphabet=reinterpret_cast<const Idx*>(mpData+hdr.mAlphabetOffset);
+  mTransRelSize=(Idx) hdr.mTransRelSize;
+  mpTransRel=reinterpret_cast<const Idx*>(mpData+hdr.mTransRelOffset);
+  mInitStatesSize=(Idx) hdr.mInitStatesSize;
+  mpInitStates=reinterpret_cast<const Idx*>(mpData+hdr.mInitStatesOffset);
+  mMarkedStatesSize=(Idx) hdr.mMarkedStatesSize;
+  mpMarkedStates=reinterpret_cast<const Idx*>(mpData+hdr.mMarkedStatesOffset);
+  if(hdr.mFlags & FAUDES_BGEN_STATENAMES)
+    mpStateNames=reinterpret_cast<const Idx*>(mpData+hdr.mStateNamesOffset);
+  mpStrings=mpData+hdr.mStringsOffset;
+  mStringsSize=(std::size_t) hdr.mStringsSize;
+  mpAttributes=mpData+hdr.mAttributesOffset;
+  mAttributesSize=(std::size_t) hdr.mAttributesSize;
+  mName=hdr.mName;
+  // string references
+  for(Idx e=0; e<mAlphabetSize; ++e)
+    if(mpAlphabet[e]>=mStringsSize) err=true;
+  if(mpStateNames)
+  for(Idx i=0; i<mStatesSize; ++i)
+    if(mpStateNames[i]>=mStringsSize) err=true;
+  if(err) {
+    errstr << "string reference out of range";
+    throw Exception("BinaryGenerator::Open", errstr.str(), 50);
+  }
+}
+
+// sense
+bool BinaryGenerator::Sense(const std::string& rFileName) {
+  std::ifstream fin(rFileName.c_str(), std::ios::in | std::ios::binary);
+  char buf[8];
+  fin.read(buf,8);
+  if(!fin.good()) return false;
+  return std::memcmp(buf,bgen_magic,8)==0;
+}
+
+// name
+const char* BinaryGenerator::Name(void) const {
+  if(!mpStrings) return "";
+  return mpStrings+mName;
+}
+
+// event name
+const char* BinaryGenerator::EventName(Idx e) const {
+  return mpStrings+mpAlphabet[e];
+}
+
+// state name
+const char* BinaryGenerator::StateName(Idx i) const {
+  if(!mpStateNames) return "";
+  return mpStrings+mpStateNames[i];
+}
+
+// extract
+void BinaryGenerator::Extract(vGenerator& rGen) const {
+  FD_DG("BinaryGenerator::Extract(" << &rGen << ")");
+  rGen.Clear();
+  if(!mpData) return;
+  rGen.Name(Name());
+  // alphabet, record global event indices
+  std::vector<Idx> events(mAlphabetSize);
+  for(Idx e=0; e<mAlphabetSize; ++e)
+    events[e]=rGen.InsEvent(EventName(e));
+  // states (file is sorted, so the std::set inserts at its end)
+  StateSet states;
+  for(Idx i=0; i<mStatesSize; ++i)
+    states.Insert(mpStates[i]);
+  rGen.InjectStates(states);
+  // transitions
+  TransSet trans;
+  const Idx* tit=mpTransRel;
+  const Idx* tit_end=mpTransRel+3*((std::size_t) mTransRelSize);
+  for(;tit!=tit_end; tit+=3) {
+    if(tit[1]>=mAlphabetSize) {
+      std::stringstream errstr;
+      errstr << "transition refers to event " << tit[1] << " out of range";
+      throw Exception("BinaryGenerator::Extract", errstr.str(), 50);
+    }
+    trans.Insert(tit[0],events[tit[1]],tit[2]);
+  }
+  rGen.InjectTransRel(trans);
+  // initial and marked states
+  StateSet init;
+  for(Idx i=0; i<mInitStatesSize; ++i)
+    init.Insert(mpInitStates[i]);
+  rGen.InjectInitStates(init);
+  StateSet marked;
+  for(Idx i=0; i<mMarkedStatesSize; ++i)
+    marked.Insert(mpMarkedStates[i]);
+  rGen.InjectMarkedStates(marked);
+  // consistency
+#ifdef FAUDES_CHECKED
+  if(!rGen.Valid()) {
+    std::stringstream errstr;
+    errstr << "binary file \"" << Name() << "\" does not represent a valid generator";
+    rGen.Clear();
+    throw Exception("BinaryGenerator::Extract", errstr.str(), 50);
+  }
+#endif
+  // state names
+  if(mpStateNames)
+  for(Idx i=0; i<mStatesSize; ++i) {
+    const char* name=StateName(i);
+    if(*name!=0) rGen.StateName(mpStates[i],name);
+  }
+  // attributes: read from token stream
+  if(mAttributesSize==0) return;
+  TokenReader tr(TokenReader::String,std::string(mpAttributes,mAttributesSize));
+  tr.ReadBegin("Attributes");
+  AttributeVoid* attr;
+  // .. global attribute
+  if(tr.ExistsBegin("GlobalAttribute")) {
+    tr.ReadBegin("GlobalAttribute");
+    attr=dynamic_cast<AttributeVoid*>(rGen.GlobalAttribute().New());
+    attr->Read(tr,"",&rGen);
+    rGen.GlobalAttribute(*attr);
+    delete attr;
+    tr.ReadEnd("GlobalAttribute");
+  }
+  // .. event attributes
+  tr.ReadBegin("EventAttributes");
+  while(!tr.Eos("EventAttributes")) {
+    tr.ReadBegin("A");
+    Idx e= (Idx) tr.ReadInteger();
+    if(e>=mAlphabetSize) {
+      std::stringstream errstr;
+      errstr << "attribute refers to event " << e << " out of range";
+      throw Exception("BinaryGenerator::Extract", errstr.str(), 50);
+    }
+    attr=dynamic_cast<AttributeVoid*>(rGen.EventAttribute(events[e]).New());
+    attr->Read(tr,"",&rGen);
+    rGen.EventAttribute(events[e],*attr);
+    delete attr;
+    tr.ReadEnd("A");
+  }
+  tr.ReadEnd("EventAttributes");
+  // .. state attributes
+  tr.ReadBegin("StateAttributes");
+  while(!tr.Eos("StateAttributes")) {
+    tr.ReadBegin("A");
+    Idx x= (Idx) tr.ReadInteger();
+    if(!rGen.ExistsState(x)) {
+      std::stringstream errstr;
+      errstr << "attribute refers to unknown state " << x;
+      throw Exception("BinaryGenerator::Extract", errstr.str(), 50);
+    }
+    attr=dynamic_cast<AttributeVoid*>(rGen.StateAttribute(x).New());
+    attr->Read(tr,"",&rGen);
+    rGen.StateAttribute(x,*attr);
+    delete attr;
+    tr.ReadEnd("A");
+  }
+  tr.ReadEnd("StateAttributes");
+  // .. transition attributes
+  tr.ReadBegin("TransAttributes");
+  while(!tr.Eos("TransAttributes")) {
+    tr.ReadBegin("A");
+    Idx x1= (Idx) tr.ReadInteger();
+    Idx e= (Idx) tr.ReadInteger();
+    Idx x2= (Idx) tr.ReadInteger();
+    if(e>=mAlphabetSize) {
+      std::stringstream errstr;
+      errstr << "attribute refers to event " << e << " out of range";
+      throw Exception("BinaryGenerator::Extract", errstr.str(), 50);
+    }
+    Transition t(x1,events[e],x2);
+    if(!rGen.ExistsTransition(t)) {
+      std::stringstream errstr;
+      errstr << "attribute refers to unknown transition";
+      throw Exception("BinaryGenerator::Extract", errstr.str(), 50);
+    }
+    attr=dynamic_cast<AttributeVoid*>(rGen.TransAttribute(t).New());
+    attr->Read(tr,"",&rGen);
+    rGen.TransAttribute(t,*attr);
+    delete attr;
+    tr.ReadEnd("A");
+  }
+  tr.ReadEnd("TransAttributes");
+  tr.ReadEnd("Attributes");
+}
+
+
+// helper: write array section with padding
+static void bgen_write(std::ofstream& rOut, uint64_t& rPos, const char* pData, std::size_t len) {
+  static const char zeros[8]={0,0,0,0,0,0,0,0};
+  rOut.write(pData,len);
+  rPos+=len;
+  uint64_t apos=bgen_align(rPos);
+  rOut.write(zeros,apos-rPos);
+  rPos=apos;
+}
+
+// helper: write state set
+static void bgen_write(std::ofstream& rOut, uint64_t& rPos, const StateSet& rStates) {
+  std::vector<Idx> buf;
+  buf.reserve(std::min<std::size_t>(rStates.Size(),FAUDES_BGEN_CHUNK));
+  StateSet::Iterator sit=rStates.Begin();
+  StateSet::Iterator sit_end=rStates.End();
+  uint64_t pos=rPos;
+  while(sit!=sit_end) {
+    buf.clear();
+    for(;sit!=sit_end && buf.size()<FAUDES_BGEN_CHUNK; ++sit)
+      buf.push_back(*sit);
+    rOut.write((const char*) &buf[0],buf.size()*sizeof(Idx));
+    pos+=buf.size()*sizeof(Idx);
+  }
+  bgen_write(rOut,pos,0,0);
+  rPos=pos;
+}
+
+// write
+void BinaryGenerator::Write(const vGenerator& rGen, const std::string& rFileName) {
+  FD_DG("BinaryGenerator::Write(" << rGen.Name() << ", " << rFileName << ")");
+  // string pool: empty string, generator name, event names, state names
+  std::string strings;
+  strings.push_back(0);
+  BGenHeader hdr;
+  std::memset(&hdr,0,sizeof(BGenHeader));
+  hdr.mName=(Idx) strings.size();
+  strings.append(rGen.Name());
+  strings.push_back(0);
+  std::vector<Idx> events;
+  std::vector<Idx> alphabet;
+  EventSet::Iterator eit=rGen.AlphabetBegin();
+  EventSet::Iterator eit_end=rGen.AlphabetEnd();
+  for(;eit!=eit_end; ++eit) {
+    events.push_back(*eit);
+    alphabet.push_back((Idx) strings.size());
+    strings.append(rGen.EventName(*eit));
+    strings.push_back(0);
+  }
+  std::vector<Idx> statenames;
+  if(rGen.StateNamesEnabled()) {
+    StateSet::Iterator sit=rGen.StatesBegin();
+    StateSet::Iterator sit_end=rGen.StatesEnd();
+    for(;sit!=sit_end; ++sit) {
+      std::string name=rGen.StateName(*sit);
+      if(name=="") { statenames.push_back(0); continue;}
+      statenames.push_back((Idx) strings.size());
+      strings.append(name);
+      strings.push_back(0);
+    }
+    bool any=false;
+    for(std::size_t i=0; i<statenames.size() && !any; ++i)
+      any= statenames[i]!=0;
+    if(!any) statenames.clear();
+  }
+  if(strings.size() > FAUDES_IDX_MAX) {
+    std::stringstream errstr;
+    errstr << "string pool exceeds the format limit when writing \"" << rFileName << "\"";
+    throw Exception("BinaryGenerator::Write", errstr.str(), 2);
+  }
+  // attributes in token format
+  std::string attributes;
+  if((!rGen.GlobalAttribute().IsDefault()) || (rGen.Alphabet().AttributesSize()>0) ||
+     (rGen.States().AttributesSize()>0) || (rGen.TransRel().AttributesSize()>0)) {
+    TokenWriter tw(TokenWriter::String);
+    tw.WriteBegin("Attributes");
+    if(!rGen.GlobalAttribute().IsDefault()) {
+      tw.WriteBegin("GlobalAttribute");
+      rGen.GlobalAttribute().Write(tw,"",&rGen);
+      tw.WriteEnd("GlobalAttribute");
+    }
+    tw.WriteBegin("EventAttributes");
+    if(rGen.Alphabet().AttributesSize()>0)
+    for(std::size_t e=0; e<events.size(); ++e) {
+      const AttributeVoid& attr=rGen.EventAttribute(events[e]);
+      if(attr.IsDefault()) continue;
+      tw.WriteBegin("A");
+      tw.WriteInteger((Idx) e);
+      attr.Write(tw,"",&rGen);
+      tw.WriteEnd("A");
+    }
+    tw.WriteEnd("EventAttributes");
+    tw.WriteBegin("StateAttributes");
+    if(rGen.States().AttributesSize()>0) {
+      StateSet::Iterator sit=rGen.StatesBegin();
+      StateSet::Iterator sit_end=rGen.StatesEnd();
+      for(;sit!=sit_end; ++sit) {
+        const AttributeVoid& attr=rGen.StateAttribute(*sit);
+        if(attr.IsDefault()) continue;
+        tw.WriteBegin("A");
+        tw.WriteInteger(*sit);
+        attr.Write(tw,"",&rGen);
+        tw.WriteEnd("A");
+      }
+    }
+    tw.WriteEnd("StateAttributes");
+    tw.WriteBegin("TransAttributes");
+    if(rGen.TransRel().AttributesSize()>0) {
+      TransSet::Iterator tit=rGen.TransRelBegin();
+      TransSet::Iterator tit_end=rGen.TransRelEnd();
+      for(;tit!=tit_end; ++tit) {
+        const AttributeVoid& attr=rGen.TransAttribute(*tit);
+        if(attr.IsDefault()) continue;
+        tw.WriteBegin("A");
+        tw.WriteInteger(tit->X1);
+        tw.WriteInteger((Idx) (std::lower_bound(events.begin(),events.end(),tit->Ev)-events.begin()));
+        tw.WriteInteger(tit->X2);
+        attr.Write(tw,"",&rGen);
+        tw.WriteEnd("A");
+      }
+    }
+    tw.WriteEnd("TransAttributes");
+    tw.WriteEnd("Attributes");
+    attributes=tw.Str();
+  }
+  // open file
+  std::ofstream fout(rFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!fout.good()) {
+    std::stringstream errstr;
+    errstr << "cannot open file \"" << rFileName << "\"";
+    throw Exception("BinaryGenerator::Write", errstr.str(), 2);
+  }
+  // header (preliminary)
+  std::memcpy(hdr.mMagic,bgen_magic,8);
+  hdr.mVersion=FAUDES_BGEN_VERSION;
+  hdr.mByteOrder=FAUDES_BGEN_BOM;
+  hdr.mFlags= statenames.empty() ? 0 : FAUDES_BGEN_STATENAMES;
+  hdr.mStatesSize=rGen.Size();
+  hdr.mAlphabetSize=events.size();
+  hdr.mTransRelSize=rGen.TransRelSize();
+  hdr.mInitStatesSize=rGen.InitStatesSize();
+  hdr.mMarkedStatesSize=rGen.MarkedStatesSize();
+  uint64_t pos=0;
+  bgen_write(fout,pos,(const char*) &hdr,sizeof(BGenHeader));
+  // states
+  hdr.mStatesOffset=pos;
+  bgen_write(fout,pos,rGen.States());
+  // alphabet
+  hdr.mAlphabetOffset=pos;
+  if(!alphabet.empty())
+    bgen_write(fout,pos,(const char*) &alphabet[0],alphabet.size()*sizeof(Idx));
+  // transitions: chunks of triples (events in the alphabet and in TransRel are sorted alike)
+  hdr.mTransRelOffset=pos;
+  std::vector<Idx> buf;
+  buf.reserve(3*FAUDES_BGEN_CHUNK);
+  TransSet::Iterator tit=rGen.TransRelBegin();
+  TransSet::Iterator tit_end=rGen.TransRelEnd();
+  Idx ev=0, e=0;
+  while(tit!=tit_end) {
+    buf.clear();
+    for(;tit!=tit_end && buf.size()<3*FAUDES_BGEN_CHUNK; ++tit) {
+      if(tit->Ev!=ev) {
+        ev=tit->Ev;
+        e= (Idx) (std::lower_bound(events.begin(),events.end(),ev)-events.begin());
+      }
+      buf.push_back(tit->X1);
+      buf.push_back(e);
+      buf.push_back(tit->X2);
+    }
+    fout.write((const char*) &buf[0],buf.size()*sizeof(Idx));
+    pos+=buf.size()*sizeof(Idx);
+  }
+  bgen_write(fout,pos,0,0);
+  // initial and marked states
+  hdr.mInitStatesOffset=pos;
+  bgen_write(fout,pos,rGen.InitStates());
+  hdr.mMarkedStatesOffset=pos;
+  bgen_write(fout,pos,rGen.MarkedStates());
+  // state names
+  hdr.mStateNamesOffset=pos;
+  if(!statenames.empty())
+    bgen_write(fout,pos,(const char*) &statenames[0],statenames.size()*sizeof(Idx));
+  // strings
+  hdr.mStringsOffset=pos;
+  hdr.mStringsSize=strings.size();
+  bgen_write(fout,pos,strings.data(),strings.size());
+  // attributes
+  hdr.mAttributesOffset=pos;
+  hdr.mAttributesSize=attributes.size();
+  bgen_write(fout,pos,attributes.data(),attributes.size());
+  // header (final)
+  fout.seekp(0);
+  fout.write((const char*) &hdr,sizeof(BGenHeader));
+  fout.close();
+  if(fout.fail()) {
+    std::stringstream errstr;
+    errstr << "cannot write file \"" << rFileName << "\"";
+    throw Exception("BinaryGenerator::Write", errstr.str(), 2);
+  }
+}
+
+
+// convenience: write
+void WriteGeneratorBinary(const vGenerator& rGen, const std::string& rFileName) {
+  BinaryGenerator::Write(rGen,rFileName);
+}
+
+// convenience: read
+void ReadGeneratorBinary(vGenerator& rGen, const std::string& rFileName) {
+  BinaryGenerator bgen(rFileName);
+  bgen.Extract(rGen);
+}
+
+} // namespace faudes
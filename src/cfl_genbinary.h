@@ -0,0 +1,260 @@
+/** @file cfl_genbinary.h Binary file format for generators */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#ifndef FAUDES_GENBINARY_H
+#define FAUDES_GENBINARY_H
+
+#include "cfl_definitions.h"
+#include "cfl_generator.h"
+
+#include <string>
+#include <vector>
+
+namespace faudes {
+
+/**
+ * Memory mapped binary generator file.
+ *
+ * The token format read and written by vGenerator::Read() and vGenerator::Write()
+ * is human readable, but parsing is costly for large generators. As an alternative,
+ * libFAUDES provides a compact binary format, in which all items are stored as
+ * plain arrays of 32-bit integers:
+ *
+ * - a fixed size header with format version, byte order mark, item counts and section offsets;
+ * - the state set in ascending order;
+ * - the alphabet as offsets into a string pool, i.e., events are referred to by their
+ *   position within the alphabet, starting with 0;
+ * - the transition relation as triples (x1,ev,x2), with the event given by its position
+ *   within the alphabet;
+ * - initial and marked states in ascending order;
+ * - optional state names as offsets into the string pool;
+ * - the string pool with null terminated generator name, event names and state names;
+ * - optional non-default attributes in token format.
+ *
+ * All sections are 8-byte aligned, and the file uses the byte order of the writing platform.
+ *
+ * A BinaryGenerator opens a file by mapping it to memory, i.e., opening amounts to the
+ * validation of the header, regardless of the file size. The content can then be inspected
+ * by direct array access, or extracted to a vGenerator by Extract(). On platforms
+ * without memory mapping, the file is read to a buffer as a whole.
+ *
+ * Example:
+ * @code
+ * WriteGeneratorBinary(gen,"plant.bgen");  // write binary file
+ * BinaryGenerator bgen("plant.bgen");      // map to memory
+ * Idx n = bgen.TransRelSize();            // inspect ...
+ * bgen.Extract(gen);                       // ... or convert to generator
+ * @endcode
+ *
+ * @ingroup GeneratorClasses
+ */
+class FAUDES_API BinaryGenerator {
+
+public:
+
+  /** Construct closed */
+  BinaryGenerator(void);
+
+  /**
+   * Construct and open file
+   *
+   * @param rFileName
+   *   File to open
+   * @exception Exception
+   *   - cannot open file (id 1)
+   *   - invalid file format (id 50)
+   */
+  BinaryGenerator(const std::string& rFileName);
+
+  /** Destruct, incl. unmapping the file */
+  ~BinaryGenerator(void);
+
+  /**
+   * Open file
+   *
+   * @param rFileName
+   *   File to open
+   * @exception Exception
+   *   - cannot open file (id 1)
+   *   - invalid file format (id 50)
+   */
+  void Open(const std::string& rFileName);
+
+  /** Close file */
+  void Close(void);
+
+  /** Test whether a file is open */
+  bool IsOpen(void) const { return mpData!=0; };
+
+  /**
+   * Test whether the specified file is a binary generator file
+   *
+   * @param rFileName
+   *   File to test
+   * @return
+   *   True if the file starts with the binary format signature
+   */
+  static bool Sense(const std::string& rFileName);
+
+  /** Generator name */
+  const char* Name(void) const;
+
+  /** Number of states */
+  Idx Size(void) const { return mStatesSize; };
+
+  /** States, ascending */
+  const Idx* States(void) const { return mpStates; };
+
+  /** Number of events */
+  Idx AlphabetSize(void) const { return mAlphabetSize; };
+
+  /** Name of event at position e within the alphabet, starting with 0 */
+  const char* EventName(Idx e) const;
+
+  /** Number of transitions */
+  Idx TransRelSize(void) const { return mTransRelSize; };
+
+  /**
+   * Transitions as triples (x1,ev,x2), with event positions within the alphabet;
+   * the array is sorted lexicographically.
+   */
+  const Idx* TransRel(void) const { return mpTransRel; };
+
+  /** Number of initial states */
+  Idx InitStatesSize(void) const { return mInitStatesSize; };
+
+  /** Initial states, ascending */
+  const Idx* InitStates(void) const { return mpInitStates; };
+
+  /** Number of marked states */
+  Idx MarkedStatesSize(void) const { return mMarkedStatesSize; };
+
+  /** Marked states, ascending */
+  const Idx* MarkedStates(void) const { return mpMarkedStates; };
+
+  /** Test whether state names are present */
+  bool StateNames(void) const { return mpStateNames!=0; };
+
+  /** Name of the state at position i within the state set, or "" */
+  const char* StateName(Idx i) const;
+
+  /** Test whether attributes are present */
+  bool Attributes(void) const { return mAttributesSize>0; };
+
+  /**
+   * Extract generator
+   *
+   * Attributes are extracted as far as supported by the attribute types of
+   * the specified generator; i.e., when extracting to a plain Generator, any
+   * attributes are ignored.
+   *
+   * @param rGen
+   *   Generator to set up
+   * @exception Exception
+   *   - invalid attributes (id 50)
+   */
+  void Extract(vGenerator& rGen) const;
+
+  /**
+   * Write generator to binary file
+   *
+   * @param rGen
+   *   Generator to write
+   * @param rFileName
+   *   File to write
+   * @exception Exception
+   *   - cannot write file (id 2)
+   */
+  static void Write(const vGenerator& rGen, const std::string& rFileName);
+
+private:
+
+  /** Mapped file or buffer */
+  const char* mpData;
+  std::size_t mSize;
+  bool mMapped;
+  std::vector<char> mBuffer;
+
+  /** Sections */
+  Idx mStatesSize;
+  const Idx* mpStates;
+  Idx mAlphabetSize;
+  const Idx* mpAlphabet;
+  Idx mTransRelSize;
+  const Idx* mpTransRel;
+  Idx mInitStatesSize;
+  const Idx* mpInitStates;
+  Idx mMarkedStatesSize;
+  const Idx* mpMarkedStates;
+  const Idx* mpStateNames;
+  const char* mpStrings;
+  std::size_t mStringsSize;
+  const char* mpAttributes;
+  std::size_t mAttributesSize;
+  Idx mName;
+
+  /** Validate header and set up sections */
+  void Validate(const std::string& rFileName);
+
+  /** Not copyable */
+  BinaryGenerator(const BinaryGenerator&);
+  BinaryGenerator& operator=(const BinaryGenerator&);
+};
+
+
+/**
+ * Write generator to binary file.
+ *
+ * Convenience wrapper for BinaryGenerator::Write().
+ *
+ * @param rGen
+ *   Generator to write
+ * @param rFileName
+ *   File to write
+ * @exception Exception
+ *   - cannot write file (id 2)
+ *
+ * @ingroup GeneratorFunctions
+ */
+extern FAUDES_API void WriteGeneratorBinary(const vGenerator& rGen, const std::string& rFileName);
+
+/**
+ * Read generator from binary file.
+ *
+ * Convenience wrapper for BinaryGenerator::Open() and BinaryGenerator::Extract().
+ *
+ * @param rGen
+ *   Generator to set up
+ * @param rFileName
+ *   File to read
+ * @exception Exception
+ *   - cannot open file (id 1)
+ *   - invalid file format (id 50)
+ *
+ * @ingroup GeneratorFunctions
+ */
+extern FAUDES_API void ReadGeneratorBinary(vGenerator& rGen, const std::string& rFileName);
+
+
+} // namespace faudes
+
+#endif
@@ -22,6 +22,7 @@
 
 
 #include "cfl_generator.h"
+#include "cfl_compiledgen.h"
 #include <stack>
 
 //local debug
@@ -95,6 +96,7 @@ vGenerator::vGenerator(void) :
   mObjectName="Generator",
   // allocate core members
   NewCore();
+  ClearMinStateIndexMap();
   // fix std names
   mInitStates.Name("InitStates");
   mMarkedStates.Name("MarkedStates");
@@ -130,6 +132,7 @@ vGenerator::vGenerator(const vGenerator& rOtherGen) :
   mObjectName="Generator",
   // allocate core members
   NewCore();
+  ClearMinStateIndexMap();
   // perform copy
   DoCopy(rOtherGen);
 }
@@ -164,6 +167,7 @@ vGenerator::vGenerator(const std::string& rFileName) :
   mObjectName="Generator",
   // allocate core members
   NewCore();
+  ClearMinStateIndexMap();
   // fix std names
   mInitStates.Name("InitStates");
   mMarkedStates.Name("MarkedStates");
@@ -236,6 +240,7 @@ void vGenerator::NewCore(void) {
   // allocate (use prototypes, fallback to void attributes)
   if(pAlphabetPrototype) mpAlphabet= pAlphabetPrototype->New();
   else mpAlphabet = new EventSet();
+  mpAlphabet->SymbolTablep(mpEventSymbolTable); // prototypes refer to the global table, see Context
   if(pStatesPrototype) mpStates=pStatesPrototype->New();
   else mpStates = new StateSet();
   if(pTransRelPrototype) mpTransRel= pTransRelPrototype->New();
@@ -697,12 +702,9 @@ void vGenerator::ClearMinStateIndexMap(void) const {
   FD_DG("vGenerator::ClearMinStateIndexMap()");
   // fake const
   vGenerator* fakeconst = const_cast<vGenerator*>(this);
-  fakeconst->mMinStateIndexMap.clear();
-}
-
-// MinStateIndexMap()
-const std::map<Idx,Idx>& vGenerator::MinStateIndexMap(void) const {
-  return mMinStateIndexMap;
+  fakeconst->mMinStateIndexOrder.clear();
+  fakeconst->mMinStateIndexSect[0]=0;
+  fakeconst->mMinStateIndexSect[1]=0;
 }
 
 
@@ -714,48 +716,54 @@ void vGenerator::SetMinStateIndexMap(void) const {
   // clear map
   fakeconst->ClearMinStateIndexMap();
   StateSet::Iterator it;
-  Idx minindex = 0;
+  // bail out if re-indexing amounts to the identity, i.e., if states are consecutive 
+  // and already come in the order of named initial states, other named states and 
+  // anonymous states (resp. initial states first, if all states are anonymous)
+  bool identity = (MaxStateIndex() == Size());
+  int order=0;
+  for(it = StatesBegin(); identity && (it != StatesEnd()); ++it) {
+    int cls = ExistsInitState(*it) ? 0 : 1;
+    if(StateNamesEnabled()) 
+      if(StateName(static_cast<Idx>(*it)) == "") cls=2; 
+    if(cls < order) identity=false;
+    order=cls;
+  }
+  if(identity) return;
+  // record states in the order of their new index: since each class of states is
+  // collected by iterating a sorted set, the order consists of three sorted sections;
+  // this takes one index per state and no map
+  std::vector<Idx>& minorder=fakeconst->mMinStateIndexOrder;
+  minorder.reserve(Size());
   // if generator states get names
   if(StateNamesEnabled()) {
     // named initial states first
-    for(it = InitStatesBegin(); it != InitStatesEnd(); ++it) {
-      if(StateName(static_cast<Idx>(*it)) != "") {
-	fakeconst->mMinStateIndexMap[*it] = ++minindex;
-      }
-    }
+    for(it = InitStatesBegin(); it != InitStatesEnd(); ++it) 
+      if(StateName(static_cast<Idx>(*it)) != "") minorder.push_back(*it);
+    fakeconst->mMinStateIndexSect[0]=minorder.size();
     // then all other named states
-    for(it = StatesBegin(); it != StatesEnd(); ++it) {
-      if(mMinStateIndexMap.count(*it) == 0) {
-	if(StateName(static_cast<Idx>(*it)) != "") {
-	  fakeconst->mMinStateIndexMap[*it] = ++minindex;
-	}
-      }
-    }
+    for(it = StatesBegin(); it != StatesEnd(); ++it) 
+      if(!ExistsInitState(*it))
+      if(StateName(static_cast<Idx>(*it)) != "") minorder.push_back(*it);
+    fakeconst->mMinStateIndexSect[1]=minorder.size();
     // at last all anonymous states
-    for(it = StatesBegin(); it != StatesEnd(); ++it) {
-      if(mMinStateIndexMap.count(*it) == 0) {
-	fakeconst->mMinStateIndexMap[*it] = ++minindex;
-      }
-    }
+    for(it = StatesBegin(); it != StatesEnd(); ++it) 
+      if(StateName(static_cast<Idx>(*it)) == "") minorder.push_back(*it);
   }
   // if generator states are all anonymous
   else {
     // all initial states first
-    for(it = InitStatesBegin(); it != InitStatesEnd(); ++it) {
-      fakeconst->mMinStateIndexMap[*it] = ++minindex;
-    }
+    for(it = InitStatesBegin(); it != InitStatesEnd(); ++it) 
+      minorder.push_back(*it);
+    fakeconst->mMinStateIndexSect[0]=minorder.size();
     // then the rest
-    for(it = StatesBegin(); it != StatesEnd(); ++it) {
-      if(mMinStateIndexMap.count(*it) == 0) {
-	fakeconst->mMinStateIndexMap[*it] = ++minindex;
-      }
-    }
+    for(it = StatesBegin(); it != StatesEnd(); ++it) 
+      if(!ExistsInitState(*it)) minorder.push_back(*it);
+    fakeconst->mMinStateIndexSect[1]=minorder.size();
   }
 #ifdef FAUDES_DEBUG_CONTAINER
-  std::map<Idx,Idx>::const_iterator _it;
-  for(_it = mMinStateIndexMap.begin(); _it != mMinStateIndexMap.end(); ++_it) {
-    FD_DC("vGenerator::MinStateIndexMap: " << _it->first
-	  << " <-- " << SStr(_it->second));
+  for(std::size_t pos=0; pos<minorder.size(); ++pos) {
+    FD_DC("vGenerator::MinStateIndexMap: " << minorder[pos]
+	  << " <-- " << SStr((Idx) pos+1));
   }
 #endif
 }
@@ -763,11 +771,14 @@ void vGenerator::SetMinStateIndexMap(void) const {
 
 // MinStateIndex(index)
 Idx vGenerator::MinStateIndex(Idx index) const {
-  std::map<Idx,Idx>::const_iterator minit;
-  minit = mMinStateIndexMap.find(index);
-  if(minit != mMinStateIndexMap.end()) {
-    return minit->second;
-  } 
+  if(mMinStateIndexOrder.empty()) return index;
+  // binary search in each sorted section of the order
+  std::vector<Idx>::const_iterator beg=mMinStateIndexOrder.begin();
+  std::size_t sect[4]={0, mMinStateIndexSect[0], mMinStateIndexSect[1], mMinStateIndexOrder.size()};
+  for(int k=0; k<3; ++k) {
+    std::vector<Idx>::const_iterator pos=std::lower_bound(beg+sect[k],beg+sect[k+1],index);
+    if((pos!=beg+sect[k+1]) && (*pos==index)) return (Idx) (pos-beg)+1;
+  }
   return index;
 }
 
@@ -914,7 +925,7 @@ bool vGenerator::EventRename(Idx event, const std::string& rNewName) {
     Transition trans= Transition(tit->X1, newidx, tit->X2);
     newtrans->Insert(trans);
     newtrans->Attribute(trans,TransAttribute(*tit));
-    ClrTransition(tit++);
+    tit=ClrTransition(tit);
   }
   // merge transitions
   for(tit=newtrans->Begin(); tit!=newtrans->End(); tit++) {
@@ -2018,32 +2029,14 @@ Idx vGenerator::SuccessorState(Idx x1, Idx ev) const {
 
 // AccessibleSet()
 StateSet vGenerator::AccessibleSet(void) const {
-  // initialize todo stack
-  std::stack<Idx> todo;
-  StateSet::Iterator sit;
-  for(sit = InitStatesBegin(); sit != InitStatesEnd(); ++sit) 
-    todo.push(*sit);
-  // loop variables
+  // compile forward relation
+  CompiledGenerator cgen(*this,false);
+  // search on plain arrays
+  std::vector<bool> acc;
+  cgen.Accessible(acc);
+  // convert
   StateSet accessibleset;
-  TransSet::Iterator tit;
-  TransSet::Iterator tit_end;
-  // loop
-  while(!todo.empty()) {
-    // pop
-    Idx x1=todo.top();
-    todo.pop();
-    // sense known
-    if(accessibleset.Exists(x1)) continue; 
-    // record
-    accessibleset.Insert(x1);
-    // iterate/push
-    tit=TransRelBegin(x1);
-    tit_end=TransRelEnd(x1);
-    for(; tit != tit_end; ++tit) 
-      if(tit->X2 != x1) 
-        todo.push(tit->X2);
-  }
-  // done
+  cgen.StateSetFromFlags(acc,accessibleset);
   accessibleset.Name("AccessibleSet");
   return accessibleset;
 }
@@ -2074,35 +2067,14 @@ bool vGenerator::IsAccessible(void) const {
 
 // CoaccessibleSet()
 StateSet vGenerator::CoaccessibleSet(void) const {
-  // build reverse transition relation
-  TransSetX2EvX1 rtrel;
-  TransRel(rtrel);
-  // initialize todo stack
-  StateSet::Iterator sit;
-  std::stack<Idx> todo;
-  for(sit = MarkedStatesBegin(); sit != MarkedStatesEnd(); ++sit) 
-    todo.push(*sit);
-  // loop variables
+  // compile incl. backward relation (avoids a reverse sorted TransSet)
+  CompiledGenerator cgen(*this,true);
+  // search on plain arrays
+  std::vector<bool> coacc;
+  cgen.Coaccessible(coacc);
+  // convert
   StateSet coaccessibleset;
-  TransSetX2EvX1::Iterator tit;
-  TransSetX2EvX1::Iterator tit_end;
-  // loop
-  while(!todo.empty()) {
-    // pop
-    Idx x2=todo.top();
-    todo.pop();
-    // sense known
-    if(coaccessibleset.Exists(x2)) continue; 
-    // record
-    coaccessibleset.Insert(x2);
-    // iterate/push
-    tit=rtrel.BeginByX2(x2);
-    tit_end=rtrel.EndByX2(x2);
-    for(; tit != tit_end; ++tit) 
-      if(tit->X1 != x2) 
-        todo.push(tit->X1);
-  }
-  // done
+  cgen.StateSetFromFlags(coacc,coaccessibleset);
   coaccessibleset.Name("CoaccessibleSet");
   return coaccessibleset;
 }
@@ -2550,45 +2522,37 @@ void vGenerator::WriteStates(TokenWriter& rTw) const {
   // have my section
   rTw.WriteBegin("States");
   // test whether we reindex
-  bool reindex=mMinStateIndexMap.size()>0;
-  // if we reindex, setup reverse map to write in strategic order
-  // to allow for consisten read (i.e. states with symbolic name first, starting
-  // with index 1); this is the plain faudes file format from 2005
+  bool reindex=!mMinStateIndexOrder.empty();
+  // if we reindex, write in strategic order to allow for consisten read (i.e. states 
+  // with symbolic name first, starting with index 1); this is the plain faudes file
+  // format from 2005; the order of all states is the reverse map
   if(reindex) {
-    // reverse map
-    std::map<Idx,Idx> reversemap;
-    std::map<Idx,Idx>::const_iterator minit;
-    StateSet::Iterator sit;
-    for (sit = StatesBegin(); sit != StatesEnd(); ++sit) 
-      reversemap[MinStateIndex(*sit)] = *sit;
-    // iterate states to write 
-    for(minit = reversemap.begin(); minit != reversemap.end(); ++minit) {
+    const std::vector<Idx>& order=mMinStateIndexOrder;
+    // iterate states to write, new index pos+1 
+    for(std::size_t pos=0; pos < order.size(); ++pos) {
       // identify anonymous block (consecutive state indices)
-      std::map<Idx,Idx>::const_iterator conit=minit;
-      Idx start = conit->first;
-      Idx anoncount = 0;
-      for(; conit != reversemap.end(); ++conit) {
-        if(StateName(conit->second) != "") break;
-        if(!StateAttribute(conit->second).IsDefault()) break;
-        if(conit->first != start+anoncount) break;
-        ++anoncount;
+      std::size_t conpos=pos;
+      for(; conpos < order.size(); ++conpos) {
+        if(StateName(order[conpos]) != "") break;
+        if(!StateAttribute(order[conpos]).IsDefault()) break;
       }
+      Idx anoncount = (Idx) (conpos-pos);
       // write anonymous block
       if(anoncount > FD_CONSECUTIVE) {
         rTw.WriteBegin("Consecutive");
-        rTw << start;
-        rTw << start+anoncount-1;
+        rTw << (Idx) pos+1;
+        rTw << (Idx) pos+anoncount;
         rTw.WriteEnd("Consecutive");
-        minit=conit;
+        pos=conpos;
       } 
       // break loop
-      if(minit == reversemap.end()) break;
+      if(pos == order.size()) break;
       // write non anonymous state name/idx
-      std::string statename = StateName(minit->second);
+      std::string statename = StateName(order[pos]);
       if (statename != "") rTw << statename;
-      else rTw << minit->first;
+      else rTw << (Idx) pos+1;
       // write state attribute
-      const AttributeVoid& attr=StateAttribute(minit->second);
+      const AttributeVoid& attr=StateAttribute(order[pos]);
       attr.Write(rTw);
     }
   }
@@ -2645,21 +2609,23 @@ void vGenerator::WriteStateSet(TokenWriter& rTw, const StateSet&  rStateSet, con
   if(label.empty()) label=rStateSet.Name();
   rTw.WriteBegin(label);
   // test whether we reindex
-  bool reindex=mMinStateIndexMap.size()>0;
+  bool reindex=!mMinStateIndexOrder.empty();
   // if we reindex, setup reverse map to write in strategic order;
   // reading back is no issue for external states, however, we would like
   // to provoke large consecutive blocks as a benefit from re-indexing
   if(reindex) {
-    // reverse map
-    std::map<Idx,Idx> reversemap;
-    std::map<Idx,Idx>::const_iterator minit;
+    // reverse map, sorted vector of pairs (fileidx,idx)
+    std::vector< std::pair<Idx,Idx> > reversemap;
+    std::vector< std::pair<Idx,Idx> >::const_iterator minit;
+    reversemap.reserve(rStateSet.Size());
     StateSet::Iterator sit;
     for (sit = rStateSet.Begin(); sit != rStateSet.End(); ++sit) 
-      reversemap[MinStateIndex(*sit)] = *sit;
+      reversemap.push_back(std::make_pair(MinStateIndex(*sit),*sit));
+    std::sort(reversemap.begin(),reversemap.end());
     // iterate states to write 
     for(minit = reversemap.begin(); minit != reversemap.end(); ++minit) {
       // identify anonymous block (consecutive state indices)
-      std::map<Idx,Idx>::const_iterator conit=minit;
+      std::vector< std::pair<Idx,Idx> >::const_iterator conit=minit;
       Idx start = conit->first;
       Idx anoncount = 0;
       for(; conit != reversemap.end(); ++conit) {
@@ -2750,16 +2716,19 @@ void vGenerator::XWriteStateSet(TokenWriter& rTw, const StateSet&  rStateSet, co
   // build reverse index map of states to write ( fileidx->idx )
   // -- this ensures named states to be written first; see SetMinStateIndexMap()
   // -- this is required to figure consecutive blocks
-  std::map<Idx,Idx> reversemap;
-  std::map<Idx,Idx>::const_iterator minit;
+  std::vector< std::pair<Idx,Idx> > reversemap;
+  std::vector< std::pair<Idx,Idx> >::const_iterator minit;
+  reversemap.reserve(rStateSet.Size());
   StateSet::Iterator sit;
   for (sit = rStateSet.Begin(); sit != rStateSet.End(); ++sit) {
-    reversemap[MinStateIndex(*sit)] = *sit;
+    reversemap.push_back(std::make_pair(MinStateIndex(*sit),*sit));
   }
+  if(!mMinStateIndexOrder.empty()) 
+    std::sort(reversemap.begin(),reversemap.end());
   // iterate states to write 
   for(minit = reversemap.begin(); minit != reversemap.end(); ++minit) {
     // identify anonymous block (consecutive state indices, no names, no attributes)
-    std::map<Idx,Idx>::const_iterator conit=minit;
+    std::vector< std::pair<Idx,Idx> >::const_iterator conit=minit;
     Idx start = conit->first;
     Idx anoncount = 0;
     for(; conit != reversemap.end(); ++conit) {
@@ -2855,6 +2824,14 @@ void vGenerator::WriteTransRel(TokenWriter& rTw) const {
   rTw.WriteBegin("TransRel");
   bool smalltransrel = (Size() < FD_SMALLTRANSREL);
 
+  // void attributes are not written
+  bool voidattr = (typeid(*mpTransRel->AttributeType())==typeid(AttributeVoid));
+
+  // event names are formatted once
+  std::map<Idx,std::string> evstr;
+  std::map<Idx,std::string>::iterator evit=evstr.end();
+  Token evtoken;
+
   // loop all transitions
   for(tit = mpTransRel->Begin(); tit != mpTransRel->End(); ++tit) {
 
@@ -2872,7 +2849,14 @@ void vGenerator::WriteTransRel(TokenWriter& rTw) const {
     }
 
     // write ev
-    rTw << EventName(tit->Ev);
+    if((evit==evstr.end()) || (evit->first!=tit->Ev)) {
+      evit=evstr.find(tit->Ev);
+      if(evit==evstr.end()) {
+        evtoken.SetString(EventName(tit->Ev));
+        evit=evstr.insert(std::make_pair(tit->Ev,TokenWriter::Format(evtoken))).first;
+      }
+    }
+    rTw.WriteFormatted(evit->second);
 
     // write x2
     Idx x2=MinStateIndex(tit->X2);
@@ -2888,7 +2872,7 @@ void vGenerator::WriteTransRel(TokenWriter& rTw) const {
     }
 
     // write attributes
-    TransAttribute(*tit).Write(rTw);
+    if(!voidattr) TransAttribute(*tit).Write(rTw);
 
   }
   rTw.WriteEnd("TransRel");
@@ -3321,40 +3305,58 @@ void vGenerator::ReadStates(TokenReader& rTr) {
   bool symimpl=false;
   bool symexpl=false;
   Idx  symnext=1;
+  // void attributes are not read (skip unknown attributes only when required)
+  bool voidattr = (typeid(*attrp)==typeid(AttributeVoid));
+  Idx index;
+  std::string statename;
   // loop section
   rTr.ReadBegin(label);  
-  while(!rTr.Eos(label)) {
-    // peek
-    rTr.Peek(token);
+  while(true) {
+    // fast path: plain index or name
+    bool plain=rTr.ReadPlain(index,statename);
+    bool byindex= plain && (index!=0);
+    // std path: peek
+    if(!plain) {
+      if(voidattr) AttributeVoid::Skip(rTr);
+      if(rTr.Eos(label)) break;
+      rTr.Peek(token);
+      if(token.IsInteger()) {
+        rTr.Get(token);
+        index=token.IntegerValue();
+        plain=true;
+        byindex=true;
+      } else if(token.IsString()) {
+        rTr.Get(token);
+        statename=token.StringValue();
+        plain=true;
+      }
+    }
     // read state by index
-    if(token.IsInteger()) {
-      rTr.Get(token);
-      Idx index = token.IntegerValue();
+    if(byindex) {
       FD_DG("vGenerator(" << this << ")::ReadStates(\"" << rTr.FileName() << "\"): by index " << index);
       if(mpStates->Exists(index)) {
         delete attrp;
 	std::stringstream errstr;
-	errstr << "Token " << token.IntegerValue() << " appears twice in stateset"
+	errstr << "Token " << index << " appears twice in stateset"
 	       << rTr.FileLine();
 	throw Exception("vGenerator::ReadStates", errstr.str(), 80);
       }
-      // read attribute
-      attrp->Read(rTr,"",this);
-      // skip unknown attributes
-      AttributeVoid::Skip(rTr);
+      // read attribute, skip unknown attributes
+      if(!voidattr) {
+        attrp->Read(rTr,"",this);
+        AttributeVoid::Skip(rTr);
+      }
       // insert element with attribute
       InsState(index); 
-      StateAttribute(index,*attrp);
+      if(!voidattr) StateAttribute(index,*attrp);
       symnext++;
       continue;
     } 
     // read state by name
-    if(token.IsString()) {
-      rTr.Get(token);
-      FD_DG("vGenerator(" << this << ")::ReadStates(\"" << rTr.FileName() << "\"): by name " << token.StringValue());
+    if(plain) {
+      FD_DG("vGenerator(" << this << ")::ReadStates(\"" << rTr.FileName() << "\"): by name " << statename);
       // interpret name, sense index suffx if present
-      std::string statename=token.StringValue();
-      Idx index=symnext;
+      index=symnext;
       std::size_t pos= statename.find_first_of('#');
       if(pos==std::string::npos) symimpl=true;
       if(pos!=std::string::npos) symexpl=true;
@@ -3362,7 +3364,7 @@ void vGenerator::ReadStates(TokenReader& rTr) {
 	std::string suffix=statename.substr(pos+1);
         index=ToIdx(suffix);
         statename=statename.substr(0,pos);
-        FD_DG("vGenerator(" << this << ")::ReadStates(\"" << rTr.FileName() << "\"): extracted suffix from  " << token.StringValue() << ": " << statename << " idx " << index);
+        FD_DG("vGenerator(" << this << ")::ReadStates(\"" << rTr.FileName() << "\"): extracted suffix: " << statename << " idx " << index);
       }      
       // no doublets
       if(ExistsState(statename) || ExistsState(index)) {
@@ -3372,14 +3374,15 @@ void vGenerator::ReadStates(TokenReader& rTr) {
 	       << rTr.FileLine();
 	throw Exception("vGenerator::ReadStates", errstr.str(), 80);
       }
-      // read attribute
-      attrp->Read(rTr,"",this);
-      // skip unknown attributes
-      AttributeVoid::Skip(rTr);
+      // read attribute, skip unknown attributes
+      if(!voidattr) {
+        attrp->Read(rTr,"",this);
+        AttributeVoid::Skip(rTr);
+      }
       // insert element with attribute
       InsState(index); 
       StateName(index,statename);
-      StateAttribute(index,*attrp);
+      if(!voidattr) StateAttribute(index,*attrp);
       symnext++;
       continue;
     } 
@@ -3768,73 +3771,104 @@ void vGenerator::ReadTransRel(TokenReader& rTr) {
   bool isn = StateSet().Empty();
   bool ien = Alphabet().Empty();
 
-  // read section
-  try {
-  while(!rTr.Eos(label)) {
+  // void attributes are not read (skip unknown attributes only when required)
+  bool voidattr = (typeid(*attrp)==typeid(AttributeVoid));
 
-    // local vars
-    Token x1t;
-    Token x2t;
-    Token evt;
+  // local vars
+  Idx x1 = 0, ev = 0, x2 = 0;
+  Idx x1i, evi, x2i;
+  bool x1byi, x2byi;
+  std::string x1n, evn, x2n;
+  std::string lastevn;
+  Idx lastev=0;
 
-    // clear my transition
-    Idx x1 = 0, ev = 0, x2 = 0;
+  // read section
+  try {
+  while(true) {
 
-    // 1: the x1 token
-    rTr >> x1t;
-    if(x1t.IsInteger()) {
-      x1=x1t.IntegerValue();
+    // 1: the x1 token (fast path: plain index or name)
+    if(rTr.ReadPlain(x1i,x1n)) {
+      x1byi= (x1i!=0);
+    } else {
+      if(voidattr) AttributeVoid::Skip(rTr);
+      if(rTr.Eos(label)) break;
+      rTr >> token;
+      if(token.IsInteger()) { x1i=token.IntegerValue(); x1byi=true; }
+      else if(token.IsString()) { x1n=token.StringValue(); x1byi=false; }
+      else break;
+    }
+    if(x1byi) {
+      x1=x1i;
       if((!ExistsState(x1)) &&  isx) {InsState(x1); isn=false; };
-    } else if(x1t.IsString()) {
-      x1=StateIndex(x1t.StringValue());
-      if(x1==0 && isn) { x1=InsState(x1t.StringValue()); isx=false; };
-    } else break;
-
-    // 2: the event token
-    rTr >> evt;
-    if(evt.IsString()) {
-      evt.StringValue();
-      ev=EventIndex(evt.StringValue());
-      if((!ExistsEvent(ev)) &&  ien) {ev = InsEvent(evt.StringValue());};
-    } else break;
+    } else {
+      x1=StateIndex(x1n);
+      if(x1==0 && isn) { x1=InsState(x1n); isx=false; };
+    } 
+
+    // 2: the event token (by name only, cache last event)
+    if(rTr.ReadPlain(evi,evn)) {
+      if(evi!=0) break;
+    } else {
+      rTr >> token;
+      if(token.IsString()) evn=token.StringValue();
+      else break;
+    }
+    if(evn!=lastevn || lastev==0) {
+      ev=EventIndex(evn);
+      if((!ExistsEvent(ev)) &&  ien) {ev = InsEvent(evn);};
+      lastevn=evn;
+      lastev=ev;
+    } else {
+      ev=lastev;
+    }
 
     // 3: the x2 token
-    rTr >> x2t;
-    if(x2t.IsInteger()) {
-      x2=x2t.IntegerValue();
+    if(rTr.ReadPlain(x2i,x2n)) {
+      x2byi= (x2i!=0);
+    } else {
+      rTr >> token;
+      if(token.IsInteger()) { x2i=token.IntegerValue(); x2byi=true; }
+      else if(token.IsString()) { x2n=token.StringValue(); x2byi=false; }
+      else break;
+    }
+    if(x2byi) {
+      x2=x2i;
       if((!ExistsState(x2)) &&  isx) {InsState(x2); isn=false; };
-    } else if(x2t.IsString()) {
-      x2=StateIndex(x2t.StringValue());
-      if(x2==0 && isn) { x2=InsState(x2t.StringValue()); isx=false; };
-    } else break;
+    } else {
+      x2=StateIndex(x2n);
+      if(x2==0 && isn) { x2=InsState(x2n); isx=false; };
+    } 
 
     // 4: attributes
-    attrp->Read(rTr,"",this);
+    if(!voidattr) attrp->Read(rTr,"",this);
 
     // 5: skip unknown attributes
-    AttributeVoid::Skip(rTr);
+    if(!voidattr) AttributeVoid::Skip(rTr);
 
-    // check values
+    // check values (on errors, skip void attributes anyway to report a consistent line)
+    if(voidattr)
+    if(!ExistsState(x1) || !ExistsState(x2) || !ExistsEvent(ev))
+      AttributeVoid::Skip(rTr);
     if(!ExistsState(x1)){
       std::stringstream errstr;
-      errstr << "invalid state x1 " << x1t.StringValue() << " " << rTr.FileLine();
+      errstr << "invalid state x1 " << (x1byi ? ToStringInteger(x1i) : x1n) << " " << rTr.FileLine();
       throw Exception("vGenerator::ReadTransRel", errstr.str(), 85);
     } 
     if(!ExistsState(x2)){
       std::stringstream errstr;
-      errstr << "invalid state x2 " << x2t.StringValue() << " " << rTr.FileLine();
+      errstr << "invalid state x2 " << (x2byi ? ToStringInteger(x2i) : x2n) << " " << rTr.FileLine();
       throw Exception("vGenerator::ReadTransRel", errstr.str(), 85);
     } 
     if(!ExistsEvent(ev)) {
       std::stringstream errstr;
-      errstr << "invalid event " << evt.StringValue() << " " << rTr.FileLine();
+      errstr << "invalid event " << evn << " " << rTr.FileLine();
       throw Exception("vGenerator::ReadTransRel", errstr.str(), 85);
     } 
 
     // insert transition
     Transition trans=Transition(x1,ev,x2);
     SetTransition(trans);
-    TransAttribute(trans,*attrp);
+    if(!voidattr) TransAttribute(trans,*attrp);
 
   } // end while
   } // end try
@@ -36,6 +36,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
 #include "cfl_tokenwriter.h"
 
 #include <map>
+#include <vector>
 #include <set>
 #include <sstream>
 #include <cstdlib>
@@ -132,7 +133,8 @@ namespace faudes {
  * However, it requires a re-indexing when writing the generator. As of libFAUDES 2.20j, the token format was extended to 
  * allow for explicit symbol table entries in the format "symbolic_state_name#index". Whether or not re-indexing
  * is applied can be configured via ReindexOnWrite(bool). The default is not to re-index. If you want to read your token 
- * stream with libFAUDES pre 2.20j, you must turn re-index on.
+ * stream with libFAUDES pre 2.20j, you must turn re-index on. Re-indexing is skipped when it amounts to the identity;
+ * otherwise, it temporarily takes one index per state to record the new order, see SetMinStateIndexMap().
  *
  *
  * Technical Detail: The generator name, the alphabet and the state set are optional. The generator
@@ -2446,7 +2448,7 @@ class FAUDES_API vGenerator : public ExtType  {
    * to symbolic names. Thus, it is only the context of a Generator that provides
    * the symbolic names for file output. 
    * 
-   * Output of state sets always uses the mMinStateIndexMap to re-index states. 
+   * Output of state sets always uses the minimal state index map to re-index states. 
    * However, this map is only set up automatically for file output. If You require
    * re-indexed output to e.g. a string, you must set up the map by calling SetMinStateIndexMap().
    * To ensure that no re-indexing takes place, call ClearMinStateIndexMap().
@@ -2555,7 +2557,7 @@ class FAUDES_API vGenerator : public ExtType  {
    * Write transition relation to tokenwriter.
    * Re-indexing and symbolic state names are handled in the same way
    * as with state sets: this function refers to the generators state symboltable to
-   * obtain state names and  uses the mMinStateIndexMap to re-index the output.
+   * obtain state names and  uses the minimal state index map to re-index the output.
    *
    * @param rTw
    *   Reference to TokenWriter
@@ -2775,6 +2777,8 @@ class FAUDES_API vGenerator : public ExtType  {
   /**
    * Set minimal index map for file io of generator states
    *
+   * The map is represented by the states in the order of their new index, i.e.
+   * one index per state; it is left empty if re-indexing amounts to the identity.
    * This function is implemented as fake-const to allow for
    * const Write function.
    *
@@ -2824,15 +2828,6 @@ class FAUDES_API vGenerator : public ExtType  {
   Idx MaxStateIndex(void) const;
 
 
-  /**
-   * Get state index translation map
-   *
-   * @return
-   *   minimal index map
-   */
-  const std::map<Idx,Idx>& MinStateIndexMap(void) const;
-
-
   /**
    * Pretty printable event name for index (eg for debugging).
    *
@@ -2969,8 +2964,11 @@ class FAUDES_API vGenerator : public ExtType  {
   /** Marked states */
   StateSet mMarkedStates;
 
-  /** Map State indices to consecutive indices */
-  std::map<Idx,Idx> mMinStateIndexMap;
+  /** Minimal state index map: states by consecutive index, three sorted sections */
+  std::vector<Idx> mMinStateIndexOrder;
+
+  /** Minimal state index map: end of the first and the second section */
+  std::size_t mMinStateIndexSect[2];
 
   /** Allocate my heap members (attribute dependent types) */
   virtual void NewCore(void);
@@ -21,6 +21,7 @@
 
 
 #include "cfl_graphfncts.h"
+#include "cfl_compiledgen.h"
 
 
 namespace faudes {
@@ -343,6 +344,209 @@ void SearchScc(
 }
 
 
+// IterativeScc(CompiledGenerator, Todo, EdgeFilter, Record, Data, Backward)
+// Non-recursive variant of SearchScc() on dense arrays. Given the edge filter of the
+// SccFilter, it reproduces the exact same order of SCCs incl. the find-first mode.
+void IterativeScc(
+  const CompiledGenerator& rCGen,
+  std::vector<bool>& rTodo,
+  SccEdgeFilter pFilter,
+  SccRecordFnct pRecord,
+  void* pData,
+  bool backward)
+{
+  Idx n=rCGen.Size();
+  FD_DF("IterativeScc(): states #" << n);
+  rTodo.resize(n+1,false);
+  rTodo[0]=false;
+  // depth-first numbers and low-links by internal index (0 for not visited)
+  std::vector<int> dfn(n+1,0);
+  std::vector<int> lowlnk(n+1,0);
+  int count=1;
+  // stack of currently considered states
+  std::vector<Idx> stack;
+  std::vector<bool> onstack(n+1,false);
+  // emulate recursion: current state and edge to investigate per level
+  std::vector< std::pair<Idx,CompiledGenerator::Iterator> > dfs;
+  std::vector<Idx> scc;
+  bool stop=false;
+  // loop all states in todo list
+  Idx next=1;
+  while(true) {
+    while((next<=n) && (!rTodo[next])) ++next;
+    if(next>n) break;
+    // enter root state
+    Idx q=next;
+    rTodo[q]=false;
+    if(stop) continue;
+    dfn[q]=lowlnk[q]=count++;
+    stack.push_back(q);
+    onstack[q]=true;
+    dfs.push_back(std::make_pair(q,backward ? rCGen.PredBegin(q) : rCGen.SuccBegin(q)));
+    // depth-first search
+    while(!dfs.empty()) {
+      q=dfs.back().first;
+      CompiledGenerator::Iterator tit=dfs.back().second;
+      CompiledGenerator::Iterator tit_end= backward ? rCGen.PredEnd(q) : rCGen.SuccEnd(q);
+      bool descend=false;
+      for(; tit!=tit_end; ++tit) {
+        // ignore filter
+        if(pFilter) if(!pFilter(pData,q,*tit)) continue;
+        // sucessor to investigate
+        Idx ls=tit->X;
+        // successors that are on the todo list get searched recursively
+        if(rTodo[ls]) {        
+          rTodo[ls]=false;
+          // stopped: the recursion returns immediately with low-link 0
+          if(stop) {
+            lowlnk[q]=0;
+            continue;
+	  }
+          dfn[ls]=lowlnk[ls]=count++;
+          stack.push_back(ls);
+          onstack[ls]=true;
+          dfs.back().second=tit;
+          dfs.push_back(std::make_pair(ls,backward ? rCGen.PredBegin(ls) : rCGen.SuccBegin(ls)));
+          descend=true;
+          break;
+        }
+        // successors that are not on the todo list may update the low-link
+        if(dfn[ls]<dfn[q]) 
+        if(onstack[ls]) 
+        if(dfn[ls]<lowlnk[q]) lowlnk[q]=dfn[ls];
+      }
+      if(descend) continue;
+      // if the current state is the root of a SCC, report the result
+      if(lowlnk[q]==dfn[q]) {
+        scc.clear();
+        Idx ls;
+        do {
+          ls=stack.back();
+          stack.pop_back();
+          onstack[ls]=false;
+          scc.push_back(ls);
+        } while(ls!=q);
+        if(!pRecord(pData,q,scc)) stop=true;
+      }
+      // return to calling level, update low-link and proceed with next edge
+      dfs.pop_back();
+      if(!dfs.empty()) {
+        Idx p=dfs.back().first;
+        if(lowlnk[q]<lowlnk[p]) lowlnk[p]=lowlnk[q];
+        ++dfs.back().second;
+      }
+    }
+  }
+}
+
+// SccFilter by internal indices, as data for the IterativeScc() callbacks
+typedef struct {
+  const CompiledGenerator* pCGen;
+  int mMode;
+  std::vector<bool> mStatesAvoid;
+  std::vector<bool> mStatesRequire;
+  std::vector<bool> mEventsAvoid;
+  std::list<StateSet>* pSccList;
+  StateSet* pRoots;
+} scc_filter;
+
+// edge filter: avoid states and events
+static bool scc_filter_edge(void* pData, Idx q, const CompiledGenerator::Edge& rEdge) {
+  (void) q;
+  scc_filter* pFilter=(scc_filter*) pData;
+  if(pFilter->mStatesAvoid[rEdge.X]) return false;
+  if(pFilter->mEventsAvoid[rEdge.Ev]) return false;
+  return true;
+}
+
+// record SCC unless invalidated by the filter; stop on first for the find-first mode
+static bool scc_filter_record(void* pData, Idx root, const std::vector<Idx>& rScc) {
+  scc_filter* pFilter=(scc_filter*) pData;
+  int mode=pFilter->mMode;
+  bool fl=false;
+  // .. required states.
+  if(mode & SccFilter::FmStatesRequire) {
+    fl=true;
+    for(std::size_t i=0; i<rScc.size(); ++i)
+      if(pFilter->mStatesRequire[rScc[i]]) { fl=false; break; }
+  }
+  // .. ignore trivial (singleton without relevant selfloop)
+  if(mode & SccFilter::FmIgnoreTrivial) {
+    if((!fl) && (rScc.size()==1)) {
+      fl=true;
+      CompiledGenerator::Iterator lit=pFilter->pCGen->SuccBegin(root);
+      CompiledGenerator::Iterator lit_end=pFilter->pCGen->SuccEnd(root);
+      for(; lit!=lit_end; ++lit) {
+        if(lit->X!=root) continue;
+        if(pFilter->mEventsAvoid[lit->Ev]) continue;
+        fl=false;
+        break;
+      }
+    }
+  }
+  if(fl) return true;
+  // record result
+  pFilter->pSccList->push_back(StateSet());
+  StateSet& rRes=pFilter->pSccList->back();
+  for(std::size_t i=0; i<rScc.size(); ++i)
+    rRes.Insert(pFilter->pCGen->State(rScc[i]));
+  pFilter->pRoots->Insert(pFilter->pCGen->State(root));
+  return (mode & SccFilter::FmFindFirst)==0;
+}
+
+// Iterative search for SCCs with an SccFilter; performs the search from all states in rTodo.
+static void IterativeScc(
+  const vGenerator& rGen,       // Graph to inspect
+  const SccFilter& rFilter,     // Filter to ignore transitions with specified events
+  const StateSet& rTodo,        // States to inspect
+  std::list<StateSet>& rSccList,// Record result: list of SCCs 
+  StateSet& rRoots)             // Record result: one state per SCC
+{
+  FD_DF("IterativeScc(" << rGen.Name() << "): todo #" << rTodo.Size());
+  // compile forward transition relation
+  CompiledGenerator cgen(rGen,false);
+  Idx n=cgen.Size();
+  // filter by internal indices
+  scc_filter filter;
+  filter.pCGen=&cgen;
+  filter.mMode=rFilter.Mode();
+  filter.mStatesAvoid.assign(n+1,false);
+  filter.mStatesRequire.assign(n+1,false);
+  filter.mEventsAvoid.assign(cgen.AlphabetSize()+1,false);
+  filter.pSccList=&rSccList;
+  filter.pRoots=&rRoots;
+  StateSet::Iterator sit, sit_end;
+  EventSet::Iterator eit, eit_end;
+  if(filter.mMode & SccFilter::FmStatesAvoid) {
+    sit=rFilter.StatesAvoid().Begin();
+    sit_end=rFilter.StatesAvoid().End();
+    for(;sit!=sit_end;++sit) filter.mStatesAvoid[cgen.StateIndex(*sit)]=true;
+  }
+  if(filter.mMode & SccFilter::FmStatesRequire) {
+    sit=rFilter.StatesRequire().Begin();
+    sit_end=rFilter.StatesRequire().End();
+    for(;sit!=sit_end;++sit) filter.mStatesRequire[cgen.StateIndex(*sit)]=true;
+  }
+  if(filter.mMode & SccFilter::FmEventsAvoid) {
+    eit=rFilter.EventsAvoid().Begin();
+    eit_end=rFilter.EventsAvoid().End();
+    for(;eit!=eit_end;++eit) filter.mEventsAvoid[cgen.EventIndex(*eit)]=true;
+  }
+  filter.mStatesAvoid[0]=false;
+  filter.mStatesRequire[0]=false;
+  filter.mEventsAvoid[0]=false;
+  // todo list by internal index, excluding states to avoid
+  std::vector<bool> todo(n+1,false);
+  sit=rTodo.Begin();
+  sit_end=rTodo.End();
+  for(;sit!=sit_end;++sit) todo[cgen.StateIndex(*sit)]=true;
+  for(Idx q=1; q<=n; ++q) 
+    if(filter.mStatesAvoid[q]) todo[q]=false;
+  // run search
+  IterativeScc(cgen,todo,&scc_filter_edge,&scc_filter_record,&filter);
+}
+
+
 // ComputeScc(Generator, SccList, Roots)
 bool ComputeScc(
   const Generator& rGen,
@@ -356,15 +560,8 @@ bool ComputeScc(
   rRoots.Clear();
   rSccList.clear();
 
-  // initialize counter for depthfirstnumbers(DFN):
-  int count=1;
-
   // provide local variables 
-  std::stack<Idx> stack;
-  StateSet stackstates;
   StateSet todostates;
-  std::map<const Idx, int> dfn;
-  std::map<const Idx, int> lowlnk;
 
   // initialise todo list
   if(rFilter.Mode() & SccFilter::FmIgnoreUnaccessible)
@@ -374,14 +571,8 @@ bool ComputeScc(
   if(rFilter.Mode() & SccFilter::FmStatesAvoid)
     todostates = todostates - rFilter.StatesAvoid();
 
-  // each recursion level keeps transition iterators
-  rGen.TransRel().Lock();
-
-  // start recursive depth-first search for Scc's:
-  while(!todostates.Empty()) {
-    SearchScc(*todostates.Begin(), count, rGen, rFilter, todostates, stack, stackstates, 
-      dfn, lowlnk,rSccList, rRoots);
-  }
+  // depth-first search for Scc's:
+  IterativeScc(rGen, rFilter, todostates, rSccList, rRoots);
 
   // done
   return !rSccList.empty();
@@ -415,15 +606,8 @@ bool  ComputeScc(
   // inititalize result
   rScc.Clear();
 
-  // initialize counter for depthfirstnumbers:
-  int count=1;
-
   // provide local variables 
-  std::stack<Idx> stack;
-  StateSet stackstates;
   StateSet todostates;
-  std::map<const Idx, int> dfn;
-  std::map<const Idx, int> lowlnk;
   std::list<StateSet> scclist;
   StateSet roots;
 
@@ -442,14 +626,8 @@ bool  ComputeScc(
   reqstate.Insert(q0);
   filter.StatesRequire(reqstate);
 
-  // each recursion level keeps transition iterators
-  rGen.TransRel().Lock();
-
-  // start recursive depth-first search for Scc's:
-  while(!todostates.Empty()) {
-    SearchScc(*todostates.Begin(), count, rGen, filter, todostates, stack, stackstates, 
-      dfn, lowlnk, scclist, roots);
-  }
+  // depth-first search for Scc's:
+  IterativeScc(rGen, filter, todostates, scclist, roots);
 
   // copy (!) result
   if(!scclist.empty()) rScc=*scclist.begin();
@@ -470,15 +648,8 @@ bool ComputeScc(
   // inititalize result
   rScc.Clear();
 
-  // initialize counter for depthfirstnumbers:
-  int count=1;
-
   // provide local variables 
-  std::stack<Idx> stack;
-  StateSet stackstates;
   StateSet todostates;
-  std::map<const Idx, int> dfn;
-  std::map<const Idx, int> lowlnk;
   std::list<StateSet> scclist;
   StateSet roots;
 
@@ -494,14 +665,8 @@ bool ComputeScc(
   SccFilter filter(rFilter);
   filter.FindFirst(true);
 
-  // each recursion level keeps transition iterators
-  rGen.TransRel().Lock();
-
-  // start recursive depth-first search for Scc's:
-  while(!todostates.Empty()) {
-    SearchScc(*todostates.Begin(), count, rGen, filter, todostates, stack, stackstates, 
-      dfn, lowlnk, scclist, roots);
-  }
+  // depth-first search for Scc's:
+  IterativeScc(rGen, filter, todostates, scclist, roots);
 
   // copy (!) result
   if(!scclist.empty()) rScc=*scclist.begin();
@@ -517,15 +682,8 @@ bool HasScc(
 {
   FD_DF("HasScc(" << rGen.Name() << ") [boolean only]");
 
-  // initialize counter for depthfirstnumbers:
-  int count=1;
-
   // provide local variables 
-  std::stack<Idx> stack;
-  StateSet stackstates;
   StateSet todostates;
-  std::map<const Idx, int> dfn;
-  std::map<const Idx, int> lowlnk;
   std::list<StateSet> scclist;
   StateSet roots;
 
@@ -541,14 +699,8 @@ bool HasScc(
   SccFilter filter(rFilter);
   filter.FindFirst(true);
 
-  // each recursion level keeps transition iterators
-  rGen.TransRel().Lock();
-
-  // start recursive depth-first search for Scc's:
-  while(!todostates.Empty()) {
-    SearchScc(*todostates.Begin(), count, rGen, filter, todostates, stack, stackstates, 
-      dfn, lowlnk, scclist, roots);
-  }
+  // depth-first search for Scc's:
+  IterativeScc(rGen, filter, todostates, scclist, roots);
 
   // done
   return !scclist.empty();
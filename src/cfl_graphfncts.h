@@ -25,6 +25,7 @@
 
 #include "cfl_definitions.h"
 #include "cfl_generator.h"
+#include "cfl_compiledgen.h"
 #include <stack>
 
 namespace faudes {
@@ -132,6 +133,9 @@ public:
   /** Member access */
   const StateSet& StatesRequire(void) const { return *pStatesRequire;};
 
+  /** Member access */
+  const EventSet& EventsAvoid(void) const { return *pEventsAvoid;};
+
   /** Edit filter (RTI): no filter */
   void Clear(void);
 
@@ -202,8 +206,9 @@ protected:
  * configurations to be good for a depth of about 80000 (Mac OSX 10.6, Debian 7.4). 
  * For SCCs exceeding the default stack size, you may adjust the operating system 
  * parameters accordingly. On Unix/Linux/MacOsX this is done by the shell command 
- * "ulimit -s hard". A future revision of SearchSCC() may be re-designed to
- * circumvent this inconvenient issue.
+ * "ulimit -s hard". The API wrappers ComputeScc(), HasScc() and ComputeNextScc()
+ * use an iterative variant of the same algorithm that does not depend on the
+ * stack size.
  *
  * Note: for a convenience API see also ComputeScc()
  *
@@ -247,11 +252,79 @@ extern FAUDES_API void SearchScc(
   StateSet& rRoots);       
 
 
+/**
+ * Edge filter for IterativeScc().
+ *
+ * @param pData
+ *   Data passed on to IterativeScc()
+ * @param q
+ *   State (internal index) the edge originates from in the direction of search
+ * @param rEdge
+ *   Edge to test
+ * @return
+ *   True, if the edge is to be followed
+ */
+typedef bool (*SccEdgeFilter)(void* pData, Idx q, const CompiledGenerator::Edge& rEdge);
+
+/**
+ * Record function for IterativeScc().
+ *
+ * @param pData
+ *   Data passed on to IterativeScc()
+ * @param root
+ *   Root of the SCC (internal index)
+ * @param rScc
+ *   States of the SCC (internal indices)
+ * @return
+ *   False, if the search should not enter any further states
+ */
+typedef bool (*SccRecordFnct)(void* pData, Idx root, const std::vector<Idx>& rScc);
+
+/**
+ * Search for strongly connected components (SCC) on a compiled generator. 
+ *
+ * This function implements the algorithm of SearchScc() iteratively, i.e., 
+ * without limitation on the depth of the search. The transition structure is given
+ * as a CompiledGenerator and the search is configured by callbacks: the edge filter
+ * determines which edges are followed and the record function is called once for
+ * each SCC found. SCCs are reported in the order they are completed by the depth-first
+ * search, i.e., any SCC reachable from a reported SCC has been reported before. 
+ *
+ * The search is started from the states on the todo list in the order of their
+ * internal index. States are removed from the todo list when visited. When the record
+ * function returns false, no further states are entered; SCCs that are completed
+ * thereafter are still reported. The API wrappers ComputeScc(), HasScc() and
+ * ComputeNextScc() use this mechanism for the filter mode FindFirst.
+ *
+ * @param rCGen
+ *   Transition system to investigate
+ * @param rTodo
+ *   States to start the search from, by internal index (resized to Size()+1)
+ * @param pFilter
+ *   Edge filter, or NULL to follow all edges
+ * @param pRecord
+ *   Record function
+ * @param pData
+ *   Data passed on to the callbacks
+ * @param backward
+ *   Follow edges backwards (requires the compiled generator to provide predecessors)
+ *
+ * @ingroup GeneratorFunctions
+ */
+extern FAUDES_API void IterativeScc(
+  const CompiledGenerator& rCGen,
+  std::vector<bool>& rTodo,
+  SccEdgeFilter pFilter,
+  SccRecordFnct pRecord,
+  void* pData,
+  bool backward=false);
+
+
 /**
  * Compute strongly connected components (SCC) 
  *
- * This function is a API wrapper that calls the recursive implementation
- * SearchScc().
+ * This function is a API wrapper that runs the algorithm of SearchScc()
+ * iteratively, i.e., without limitation on the depth of the search.
  *
  * 
  * @param rGen
@@ -279,8 +352,8 @@ extern FAUDES_API bool ComputeScc(
 /**
  * Compute strongly connected components (SCC) 
  *
- * This function is a API wrapper that calls the recursive implementation
- * SearchScc().
+ * This function is a API wrapper that runs the algorithm of SearchScc()
+ * iteratively, i.e., without limitation on the depth of the search.
  *
  * @param rGen
  *   Generator under investigation
@@ -307,8 +380,8 @@ extern FAUDES_API bool ComputeScc(
 /**
  * Compute strongly connected component (SCC) 
  *
- * This function is a API wrapper that calls the recursive implementation
- * SearchScc(). It internally edits the filter to require the specified
+ * This function is a API wrapper that runs the algorithm of
+ * SearchScc() iteratively. It internally edits the filter to require the specified
  * initial state and to stop on the first SCC found. In particular, any
  * other state requirement will be ignored.
  *
@@ -342,8 +415,8 @@ extern FAUDES_API bool ComputeScc(
  * This functions searchs for the first SCC of the generator rGen 
  * while applying the filter rFilter; see SCCFilter for details.
  *
- * Technically, this function is a API wrapper that calls the recursive implementation
- * SearchScc() as presented in 
+ * Technically, this function is a API wrapper that runs the algorithm of
+ * SearchScc() iteratively, as presented in 
  *
  * -- Aho, Hopcroft, Ullman: The Design and Analysis of Computer Algorithms --
  * 
@@ -373,8 +446,8 @@ extern FAUDES_API bool ComputeScc(
  * This functions searchs for the first SCC of the generator rGen 
  * while applying the filter rFilter; see SCCFilter for details.
  *
- * Technically, this function is an API wrapper that calls the recursive implementation
- * SearchScc() as presented in 
+ * Technically, this function is an API wrapper that runs the algorithm of
+ * SearchScc() iteratively, as presented in 
  * 
  * -- Aho, Hopcroft, Ullman: The Design and Analysis of Computer Algorithms --
  *
@@ -22,6 +22,12 @@
 
 #include "cfl_parallel.h"
 #include "cfl_conflequiv.h"
+#include "cfl_compiledgen.h"
+#include "cfl_context.h"
+#include "cfl_tasks.h"
+
+#include <algorithm>
+#include <atomic>
 
 /* turn on debugging for this file */
 //#undef FD_DF
@@ -29,10 +35,19 @@
 
 namespace faudes {
 
+// forward: multi-threaded exploration (see below)
+#ifdef FAUDES_THREADS
+static bool cmt_compose(
+  const Generator& rGen1, const Generator& rGen2, 
+  bool product, bool live_only,
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen);
+#endif
+
 // Parallel(rGen1, rGen2, res)
 void Parallel(const Generator& rGen1, const Generator& rGen2, Generator& rResGen) {
   // helpers:
-  std::map< std::pair<Idx,Idx>, Idx> cmap;
+  CompositionHashMap cmap;
   // prepare result
   Generator* pResGen = &rResGen;
   if(&rResGen== &rGen1 || &rResGen== &rGen2) {
@@ -48,29 +63,277 @@ void Parallel(const Generator& rGen1, const Generator& rGen2, Generator& rResGen
 }
  
 
+/*
+*********************************************************
+N-ary composition
+*********************************************************
+*/
+
+// hash function for state tuples
+static inline std::size_t nary_hash(const Idx* pTuple, std::size_t n) {
+  uint64_t h = 0x9e3779b97f4a7c15ULL;
+  for(std::size_t i=0; i<n; ++i) {
+    h ^= (uint64_t) pTuple[i];
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 32;
+  }
+  return (std::size_t) h;
+}
+
+// set of state tuples, indexed 1,2,... in insertion order
+class nary_tuples {
+public:
+  nary_tuples(std::size_t n) : mN(n), mSize(0), mTable(1024,0) {}
+  // number of tuples
+  Idx Size(void) const { return mSize; }
+  // access tuple by index
+  const Idx* At(Idx idx) const { return &mTuples[(idx-1)*mN]; }
+  // lookup, return 0 if not present
+  Idx Find(const Idx* pTuple) const {
+    std::size_t mask=mTable.size()-1;
+    std::size_t pos=nary_hash(pTuple,mN) & mask;
+    while(true) {
+      Idx idx=mTable[pos];
+      if(idx==0) return 0;
+      if(std::equal(pTuple,pTuple+mN,At(idx))) return idx;
+      pos=(pos+1) & mask;
+    }
+  }
+  // insert (tuple must not yet be present), return index
+  Idx Insert(const Idx* pTuple) {
+    mTuples.insert(mTuples.end(),pTuple,pTuple+mN);
+    ++mSize;
+    if(2*((std::size_t) mSize) > mTable.size()) {
+      Rehash(2*mTable.size());
+      return mSize;
+    }
+    Place(mSize);
+    return mSize;
+  }
+protected:
+  void Place(Idx idx) {
+    std::size_t mask=mTable.size()-1;
+    std::size_t pos=nary_hash(At(idx),mN) & mask;
+    while(mTable[pos]!=0) pos=(pos+1) & mask;
+    mTable[pos]=idx;
+  }
+  void Rehash(std::size_t cap) {
+    mTable.assign(cap,0);
+    for(Idx idx=1; idx<=mSize; ++idx) Place(idx);
+  }
+  std::size_t mN;
+  Idx mSize;
+  std::vector<Idx> mTuples;
+  std::vector<Idx> mTable;
+};
+
+// n-ary parallel or product composition
+static void nary_parallel(
+  const GeneratorVector& rGenVec,
+  bool product, bool live_only,
+  Generator& rResGen)
+{
+  std::size_t n=rGenVec.Size();
+  FD_DF("Parallel(): n-ary composition of #" << n << " generators");
+  // compile components
+  std::vector<CompiledGenerator> comps(n);
+  std::vector< std::vector<bool> > live(n);
+  for(std::size_t i=0; i<n; ++i) {
+    comps[i].Compile(rGenVec.At(i),live_only);
+    if(live_only) comps[i].Coaccessible(live[i]);
+  }
+  // overall alphabet (product: shared by all components)
+  EventSet alph;
+  for(std::size_t i=0; i<n; ++i) 
+    alph.InsertSet(rGenVec.At(i).Alphabet());
+  if(product)
+    for(std::size_t i=0; i<n; ++i) 
+      alph.RestrictSet(rGenVec.At(i).Alphabet());
+  std::vector<Idx> events;
+  events.reserve(alph.Size());
+  EventSet::Iterator ait=alph.Begin();
+  for(;ait!=alph.End();++ait) 
+    events.push_back(*ait);
+  // per component: internal event to overall event position
+  std::vector< std::vector<Idx> > evpos(n);
+  // per overall event: participating components and their internal event
+  // (product: events not shared by all components are mapped to the extra position)
+  std::vector< std::vector< std::pair<std::size_t,Idx> > > sync(events.size()+1);
+  for(std::size_t i=0; i<n; ++i) {
+    evpos[i].assign(comps[i].AlphabetSize()+1,0);
+    for(Idx e=1; e<=comps[i].AlphabetSize(); ++e) {
+      std::vector<Idx>::iterator git=std::lower_bound(events.begin(),events.end(),comps[i].Event(e));
+      if((git==events.end()) || (*git!=comps[i].Event(e))) {
+        evpos[i][e]=(Idx) events.size();
+        continue;
+      }
+      Idx g= (Idx) (git - events.begin());
+      evpos[i][e]=g;
+      sync[g].push_back(std::make_pair(i,e));
+    }
+  }
+  // prepare result
+  Generator* pResGen = &rResGen;
+  for(std::size_t i=0; i<n; ++i) {
+    if(&rResGen != &rGenVec.At(i)) continue;
+    pResGen=rResGen.New();
+    break;
+  }
+  bool names=rResGen.StateNamesEnabled();
+  for(std::size_t i=0; i<n; ++i) 
+    names = names && rGenVec.At(i).StateNamesEnabled();
+  std::string name=rGenVec.At(0).Name();
+  for(std::size_t i=1; i<n; ++i) 
+    name=CollapsString(name+"||"+rGenVec.At(i).Name());
+  pResGen->Clear();
+  pResGen->Name(name);
+  pResGen->InjectAlphabet(alph);
+  // todo stack and visited tuples
+  std::stack<Idx> todo;
+  nary_tuples tuples(n);
+  std::vector<Idx> ctuple(n), ntuple(n);
+  // all combinations of initial states
+  bool noinit=false;
+  for(std::size_t i=0; i<n; ++i) 
+    if(comps[i].InitStates().empty()) noinit=true;
+  std::vector<std::size_t> ipos(n,0);
+  while(!noinit) {
+    for(std::size_t i=0; i<n; ++i) 
+      ntuple[i]=comps[i].InitStates()[ipos[i]];
+    Idx idx=tuples.Insert(&ntuple[0]);
+    pResGen->InsInitState(idx);
+    bool expand=true;
+    for(std::size_t i=0; live_only && i<n; ++i) 
+      if(!live[i][ntuple[i]]) expand=false;
+    if(expand) todo.push(idx);
+    std::size_t k=n;
+    while(k>0) {
+      --k;
+      if(++ipos[k] < comps[k].InitStates().size()) break;
+      ipos[k]=0;
+      if(k==0) noinit=true;
+    }
+  }
+  // explore reachable tuples
+  std::vector<Idx> cand;
+  std::vector<Idx> stamp(events.size()+1,0);
+  Idx cstamp=0;
+  std::vector<CompiledGenerator::Iterator> ebegin(n), eend(n), eit(n);
+  Idx lcnt=0;
+  while(!todo.empty()) {
+    FD_WPC(tuples.Size()-todo.size(),tuples.Size(),"Parallel(): processing"); 
+    FD_LOOP(lcnt,tuples.Size());
+    Idx cidx=todo.top();
+    todo.pop();
+    std::copy(tuples.At(cidx),tuples.At(cidx)+n,ctuple.begin());
+    // candidate events
+    cand.clear();
+    ++cstamp;
+    for(std::size_t i=0; i<n; ++i) {
+      CompiledGenerator::Iterator it=comps[i].SuccBegin(ctuple[i]);
+      CompiledGenerator::Iterator it_end=comps[i].SuccEnd(ctuple[i]);
+      for(;it!=it_end;++it) {
+        Idx g=evpos[i][it->Ev];
+        if(g==events.size()) continue;
+        if(stamp[g]==cstamp) continue;
+        stamp[g]=cstamp;
+        cand.push_back(g);
+      }
+    }
+    std::sort(cand.begin(),cand.end());
+    // iterate candidate events
+    for(std::size_t c=0; c<cand.size(); ++c) {
+      const std::vector< std::pair<std::size_t,Idx> >& part=sync[cand[c]];
+      std::size_t m=part.size();
+      // all participating components must be able to execute
+      bool enabled=true;
+      for(std::size_t k=0; k<m; ++k) {
+        std::size_t i=part[k].first;
+        ebegin[k]=comps[i].SuccBegin(ctuple[i],part[k].second);
+        eend[k]=comps[i].SuccEnd(ctuple[i],part[k].second);
+        eit[k]=ebegin[k];
+        if(ebegin[k]==eend[k]) { enabled=false; break; }
+      }
+      if(!enabled) continue;
+      // iterate all combinations of successors
+      ntuple=ctuple;
+      bool more=true;
+      while(more) {
+        for(std::size_t k=0; k<m; ++k) 
+          ntuple[part[k].first]=eit[k]->X;
+        Idx nidx=tuples.Find(&ntuple[0]);
+        if(nidx==0) {
+          nidx=tuples.Insert(&ntuple[0]);
+          pResGen->InsState(nidx);
+          bool expand=true;
+          for(std::size_t i=0; live_only && i<n; ++i) 
+            if(!live[i][ntuple[i]]) expand=false;
+          if(expand) todo.push(nidx);
+        }
+        pResGen->SetTransition(cidx,events[cand[c]],nidx);
+        std::size_t k=m;
+        while(k>0) {
+          --k;
+          if(++eit[k]!=eend[k]) break;
+          eit[k]=ebegin[k];
+          if(k==0) more=false;
+        }
+      }
+    }
+  }
+  // marking
+  for(Idx idx=1; idx<=tuples.Size(); ++idx) {
+    const Idx* tuple=tuples.At(idx);
+    bool marked=true;
+    for(std::size_t i=0; marked && i<n; ++i) 
+      marked=comps[i].MarkedState(tuple[i]);
+    if(marked) pResGen->SetMarkedState(idx);
+  }
+  // state names
+  if(names) {
+    for(Idx idx=1; idx<=tuples.Size(); ++idx) {
+      const Idx* tuple=tuples.At(idx);
+      std::string sname;
+      for(std::size_t i=0; i<n; ++i) {
+        Idx x=comps[i].State(tuple[i]);
+        std::string xname=rGenVec.At(i).StateName(x);
+        if(xname=="") xname=ToStringInteger(x);
+        if(i>0) sname+="|";
+        sname+=xname;
+      }
+      pResGen->StateName(idx,pResGen->UniqueStateName(sname));
+    }
+  } else {
+    pResGen->StateNamesEnabled(false);
+  }
+  // copy result
+  if(pResGen != &rResGen) {
+    rResGen.Move(*pResGen);
+    delete pResGen;
+  }
+  FD_DF("Parallel(): n-ary composition: done with #" << rResGen.Size() << " states");
+}
+
+
 // Parallel for multiple Generators
 void Parallel(
   const GeneratorVector& rGenVec,
   Generator& rResGen)
 {
-  // helpers:
-  std::map< std::pair<Idx,Idx>, Idx> cmap;
-  // prepare result
-  rResGen.Clear();
-  bool rnames=rResGen.StateNamesEnabled();
   // ignore empty
   if(rGenVec.Size()==0) {
+    rResGen.Clear();
     return;
   }
   // copy one 
-  rResGen=rGenVec.At(0);
-  rResGen.StateNamesEnabled(rnames);
-  // run parallel 
-  for(GeneratorVector::Position i=1; i<rGenVec.Size(); i++) {
-    Parallel(rResGen,rGenVec.At(i),cmap,rResGen);
-    FD_DF("Parallel() cnt " << i << " states " << rResGen.Size());
-    FD_DF("Parallel() cnt " << i << " coreach " << rResGen.CoaccessibleSet().Size());
+  if(rGenVec.Size()==1) {
+    bool rnames=rResGen.StateNamesEnabled();
+    rResGen=rGenVec.At(0);
+    rResGen.StateNamesEnabled(rnames);
+    return;
   }
+  // explore overall reachable state set
+  nary_parallel(rGenVec,false,false,rResGen);
 }
 
 // Parallel for multiple Generators, nonblocking part only
@@ -78,24 +341,23 @@ void ParallelLive(
   const GeneratorVector& rGenVec,
   Generator& rResGen)
 {
-  // prepare result
-  rResGen.Clear();
-  bool rnames=rResGen.StateNamesEnabled();
   // ignore empty
   if(rGenVec.Size()==0) {
+    rResGen.Clear();
     return;
   }
   // copy one 
-  rResGen=rGenVec.At(0);
-  rResGen.StateNamesEnabled(rnames);
-  // run parallel 
-  for(GeneratorVector::Position i=1; i<rGenVec.Size(); i++) {
-    FD_DF("ParallelLive() cnt " << i << " current trans #" << rResGen.TransRel().Size());
-    RemoveNonCoaccessibleOut(rResGen);
-    FD_DF("ParallelLive() cnt " << i << " certconf trans #" << rResGen.TransRel().Size());
-    ParallelLive(rResGen,rGenVec.At(i),rResGen);
-    FD_DF("ParallelLive() cnt " << i << " parallel trans #" << rResGen.TransRel().Size());
+  if(rGenVec.Size()==1) {
+    bool rnames=rResGen.StateNamesEnabled();
+    rResGen=rGenVec.At(0);
+    rResGen.StateNamesEnabled(rnames);
+    return;
   }
+  // explore overall reachable state set, skip tuples with blocking components
+  nary_parallel(rGenVec,false,true,rResGen);
+  // trim: blocking tuples have no successors, tuples only reachable via blocking ones are removed
+  RemoveNonCoaccessibleOut(rResGen);
+  Accessible(rResGen);
 }
 
 // Parallel for Generators, transparent for event attributes.
@@ -190,7 +452,7 @@ void aParallel(
   }
 
   // make product composition of inputs
-  Parallel(rGen1,rGen2,rCompositionMap.StlMap(),*pResGen);
+  Parallel(rGen1,rGen2,rCompositionMap.HashMap(),*pResGen);
 
   // copy all attributes of input alphabets
   if(careattr) {
@@ -214,7 +476,7 @@ void Parallel(
   Generator& rResGen) 
 {
   // make product composition of inputs
-  Parallel(rGen1,rGen2,rCompositionMap.StlMap(),rResGen);
+  Parallel(rGen1,rGen2,rCompositionMap.HashMap(),rResGen);
 }
 
 // Parallel(rGen1, rGen2, rCompositionMap, mark1, mark2, res)
@@ -266,6 +528,20 @@ void Parallel(
   std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
   Generator& rResGen,
   bool live_only)
+{
+  // do the composition
+  CompositionHashMap cmap;
+  Parallel(rGen1,rGen2,cmap,rResGen,live_only);
+  // convert composition map
+  cmap.StlMap(rCompositionMap);
+}
+
+// Parallel(rGen1, rGen2, rCompositionMap, res, live_only)
+void Parallel(
+  const Generator& rGen1, const Generator& rGen2, 
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen,
+  bool live_only)
 {
   FD_DF("Parallel(" << &rGen1 << "," << &rGen2 << ")");
 
@@ -304,7 +580,7 @@ void Parallel(
   }
   pResGen->Clear();
   pResGen->Name(CollapsString(rGen1.Name()+"||"+rGen2.Name()));
-  rCompositionMap.clear();
+  rCompositionMap.Reserve(rGen1.States().MaxIndex(),rGen2.States().MaxIndex());
 
   // create res alphabet
   EventSet::Iterator eit;
@@ -317,9 +593,15 @@ void Parallel(
   FD_DF("Parallel: inserted indices in rResGen.alphabet( "
       << pResGen->AlphabetToString() << ")");
 
+  // try multi-threaded exploration
+  bool done=false;
+#ifdef FAUDES_THREADS
+  done=cmt_compose(rGen1,rGen2,false,live_only,rCompositionMap,*pResGen);
+#endif
+
   // know each aruments coaccessible set
   StateSet gen1live, gen2live;
-  if(live_only) {
+  if(live_only && !done) {
     gen1live=rGen1.CoaccessibleSet();
     gen2live=rGen2.CoaccessibleSet();
   }
@@ -333,44 +615,43 @@ void Parallel(
   // current pair, new pair
   std::pair<Idx,Idx> currentstates, newstates;
   // state
-  Idx tmpstate;
+  Idx tmpstate, currentstate;
   StateSet::Iterator lit1,lit2;
   TransSet::Iterator tit1, tit1_end, tit2, tit2_end;
-  std::map< std::pair<Idx,Idx>, Idx>::iterator rcit;
 
   // push all combinations of initial states on todo stack
   FD_DF("Parallel: adding all combinations of initial states to todo:");
+  if(!done)
   for (lit1 = rGen1.InitStatesBegin(); lit1 != rGen1.InitStatesEnd(); ++lit1) {
     for (lit2 = rGen2.InitStatesBegin(); lit2 != rGen2.InitStatesEnd(); ++lit2) {
       newstates = std::make_pair(*lit1, *lit2);
       tmpstate = pResGen->InsInitState();
-      rCompositionMap[newstates] = tmpstate;
-      FD_DF("Parallel:   (" << *lit1 << "|" << *lit2 << ") -> " 
-          << rCompositionMap[newstates]);
+      rCompositionMap.Insert(*lit1, *lit2, tmpstate);
+      FD_DF("Parallel:   (" << *lit1 << "|" << *lit2 << ") -> " << tmpstate);
       if(live_only) {
 	if(!gen1live.Exists(newstates.first)) continue;
 	if(!gen2live.Exists(newstates.second)) continue;
       }
       todo.push(newstates);
       FD_DF("Parallel:   todo push: (" << newstates.first << "|" 
-         << newstates.second << ") -> " 
-         << rCompositionMap[newstates]);
+         << newstates.second << ") -> " << tmpstate);
     }
   }
 
   // start algorithm
   FD_DF("Parallel: processing reachable states:");
+  Idx lcnt=0;
   while (! todo.empty()) {
-    // allow for user interrupt
-    // LoopCallback();
+    // allow for user interrupt, incl cancellation and limits
+    FD_LOOP(lcnt,pResGen->Size());
     // allow for user interrupt, incl progress report
-    FD_WPC(rCompositionMap.size(),rCompositionMap.size()+todo.size(),"Parallel(): processing"); 
+    FD_WPC(rCompositionMap.Size(),rCompositionMap.Size()+todo.size(),"Parallel(): processing"); 
     // get next reachable state from todo stack
     currentstates = todo.top();
     todo.pop();
+    currentstate = rCompositionMap.Find(currentstates.first, currentstates.second);
     FD_DF("Parallel: processing (" << currentstates.first << "|" 
-        << currentstates.second << ") -> " 
-        << rCompositionMap[currentstates]);
+        << currentstates.second << ") -> " << currentstate);
     // iterate over all rGen1 transitions 
     // (includes execution of shared events)
     tit1 = rGen1.TransRelBegin(currentstates.first);
@@ -381,10 +662,10 @@ void Parallel(
         FD_DF("Parallel:   exists only in rGen1");
         newstates = std::make_pair(tit1->X2, currentstates.second);
         // add to result if composition state is new
-        rcit = rCompositionMap.find(newstates);
-        if(rcit == rCompositionMap.end()) {
+        tmpstate = rCompositionMap.Find(newstates.first, newstates.second);
+        if(tmpstate == 0) {
           tmpstate = pResGen->InsState();
-          rCompositionMap[newstates] = tmpstate;
+          rCompositionMap.Insert(newstates.first, newstates.second, tmpstate);
 	  bool dopush=true;
 	  if(live_only) {
 	    dopush= gen1live.Exists(newstates.first) && gen2live.Exists(newstates.second);
@@ -392,15 +673,12 @@ void Parallel(
 	  if(dopush) {
             todo.push(newstates);
             FD_DF("Parallel:   todo push: (" << newstates.first << "|" 
-                << newstates.second << ") -> " 
-                << rCompositionMap[newstates]);
+                << newstates.second << ") -> " << tmpstate);
 	  }
-        } else {
-          tmpstate = rcit->second;
         }
-        pResGen->SetTransition(rCompositionMap[currentstates], tit1->Ev, tmpstate);
+        pResGen->SetTransition(currentstate, tit1->Ev, tmpstate);
         FD_DF("Parallel:   add transition to new generator: " 
-            << rCompositionMap[currentstates] << "-" << tit1->Ev << "-" 
+            << currentstate << "-" << tit1->Ev << "-" 
             << tmpstate);
       }
       // if shared event
@@ -412,10 +690,10 @@ void Parallel(
         for (; tit2 != tit2_end; ++tit2) {
           newstates = std::make_pair(tit1->X2, tit2->X2);
           // add to result if composition state is new
-          rcit = rCompositionMap.find(newstates);
-          if (rcit == rCompositionMap.end()) {
+          tmpstate = rCompositionMap.Find(newstates.first, newstates.second);
+          if (tmpstate == 0) {
             tmpstate = pResGen->InsState();
-            rCompositionMap[newstates] = tmpstate;
+            rCompositionMap.Insert(newstates.first, newstates.second, tmpstate);
 	    bool dopush=true;
 	    if(live_only) {
 	      dopush= gen1live.Exists(newstates.first) && gen2live.Exists(newstates.second);
@@ -423,16 +701,13 @@ void Parallel(
 	    if(dopush) {
               todo.push(newstates);
               FD_DF("Parallel:   todo push: (" << newstates.first << "|" 
-                  << newstates.second << ") -> " 
-                  << rCompositionMap[newstates]);
+                  << newstates.second << ") -> " << tmpstate);
 	    }
-          } else {
-            tmpstate = rcit->second;
           }
-          pResGen->SetTransition(rCompositionMap[currentstates], 
+          pResGen->SetTransition(currentstate, 
               tit1->Ev, tmpstate);
           FD_DF("Parallel:   add transition to new generator: " 
-              << rCompositionMap[currentstates] << "-" 
+              << currentstate << "-" 
               << tit1->Ev << "-" << tmpstate);
         }
       }
@@ -446,10 +721,10 @@ void Parallel(
         FD_DF("Parallel:   exists only in rGen2");
         newstates = std::make_pair(currentstates.first, tit2->X2);
         // add to todo list if composition state is new
-        rcit = rCompositionMap.find(newstates);
-        if(rcit == rCompositionMap.end()) {
+        tmpstate = rCompositionMap.Find(newstates.first, newstates.second);
+        if(tmpstate == 0) {
           tmpstate = pResGen->InsState();
-          rCompositionMap[newstates] = tmpstate;
+          rCompositionMap.Insert(newstates.first, newstates.second, tmpstate);
 	  bool dopush=true;
 	  if(live_only) {
 	    dopush= gen1live.Exists(newstates.first) && gen2live.Exists(newstates.second);
@@ -457,28 +732,25 @@ void Parallel(
 	  if(dopush) {
             todo.push(newstates);
             FD_DF("Parallel:   todo push: (" << newstates.first << "|" 
-                << newstates.second << ") -> " 
-                << rCompositionMap[newstates]);
+                << newstates.second << ") -> " << tmpstate);
 	  }
-        } else {
-          tmpstate = rcit->second;
         }
-        pResGen->SetTransition(rCompositionMap[currentstates], 
+        pResGen->SetTransition(currentstate, 
             tit2->Ev, tmpstate);
         FD_DF("Parallel:   add transition to new generator: " 
-            << rCompositionMap[currentstates] << "-" 
+            << currentstate << "-" 
             << tit2->Ev << "-" << tmpstate);
       }
     }
   }
 
   // set marked states
-  rcit=rCompositionMap.begin();
-  while(rcit!=rCompositionMap.end()) {    
-    if(rGen1.ExistsMarkedState(rcit->first.first))
-      if(rGen2.ExistsMarkedState(rcit->first.second))
-        pResGen->SetMarkedState(rcit->second);
-    ++rcit;
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit=rCompositionMap.Entries().begin();
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit_end=rCompositionMap.Entries().end();
+  for(;rcit!=rcit_end;++rcit) {
+    if(rGen1.ExistsMarkedState(rcit->X1))
+      if(rGen2.ExistsMarkedState(rcit->X2))
+        pResGen->SetMarkedState(rcit->X12);
   }
   FD_DF("Parallel: marked states: " << pResGen->MarkedStatesToString());
 
@@ -511,17 +783,38 @@ void ParallelLive(
   Generator& rResGen)
 {
   FD_DF("ParallelLive(" << &rGen1 << "," << &rGen2 << ")");
-  std::map< std::pair<Idx,Idx>, Idx> cmap;
+  CompositionHashMap cmap;
   Parallel(rGen1,rGen2,cmap,rResGen,true);
 }  
 
 // Product(rGen1, rGen2, res)
 void Product(const Generator& rGen1, const Generator& rGen2, Generator& rResGen) {
-  std::map< std::pair<Idx,Idx>, Idx> cmap;
+  CompositionHashMap cmap;
   // doit
   Product(rGen1, rGen2, cmap, rResGen);
 }
 
+// Product for multiple Generators
+void Product(
+  const GeneratorVector& rGenVec,
+  Generator& rResGen)
+{
+  // ignore empty
+  if(rGenVec.Size()==0) {
+    rResGen.Clear();
+    return;
+  }
+  // copy one 
+  if(rGenVec.Size()==1) {
+    bool rnames=rResGen.StateNamesEnabled();
+    rResGen=rGenVec.At(0);
+    rResGen.StateNamesEnabled(rnames);
+    return;
+  }
+  // explore overall reachable state set, synchronise on all events
+  nary_parallel(rGenVec,true,false,rResGen);
+}
+
 
 // Product for Generators, transparent for event attributes.
 void aProduct(
@@ -574,7 +867,7 @@ void aProduct(
   }
 
   // make product composition of inputs
-  Product(rGen1,rGen2,rCompositionMap.StlMap(),*pResGen);
+  Product(rGen1,rGen2,rCompositionMap.HashMap(),*pResGen);
 
   // copy all attributes of input alphabets
   if(careattr) {
@@ -620,6 +913,19 @@ void Product(
   const Generator& rGen1, const Generator& rGen2, 
   std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
   Generator& rResGen)
+{
+  // do the composition
+  CompositionHashMap cmap;
+  Product(rGen1,rGen2,cmap,rResGen);
+  // convert composition map
+  cmap.StlMap(rCompositionMap);
+}
+
+// Product(rGen1, rGen2, rCompositionMap, res)
+void Product(
+  const Generator& rGen1, const Generator& rGen2, 
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen)
 {
   FD_DF("Product(" << rGen1.Name() << "," << rGen2.Name() << ")");
   FD_DF("Product(): state counts " << rGen1.Size() << "/" << rGen2.Size());
@@ -630,7 +936,7 @@ void Product(
     pResGen= rResGen.New();
   }
   pResGen->Clear();
-  rCompositionMap.clear();
+  rCompositionMap.Reserve(rGen1.States().MaxIndex(),rGen2.States().MaxIndex());
 
   // shared alphabet
   pResGen->InjectAlphabet(rGen1.Alphabet() * rGen2.Alphabet());
@@ -642,38 +948,46 @@ void Product(
   // current pair, new pair
   std::pair<Idx,Idx> currentstates, newstates;
   // state
-  Idx tmpstate;
+  Idx tmpstate, currentstate;
   
   StateSet::Iterator lit1, lit2;
   TransSet::Iterator tit1, tit1_end, tit2, tit2_end, tit2_begin;
-  std::map< std::pair<Idx,Idx>, Idx>::iterator rcit;
+
+  // try multi-threaded exploration
+  bool done=false;
+#ifdef FAUDES_THREADS
+  done=cmt_compose(rGen1,rGen2,true,false,rCompositionMap,*pResGen);
+#endif
 
   // push all combinations of initial states on todo stack
   FD_DF("Product: adding all combinations of initial states to todo:");
+  if(!done)
   for (lit1 = rGen1.InitStatesBegin(); 
       lit1 != rGen1.InitStatesEnd(); ++lit1) {
     for (lit2 = rGen2.InitStatesBegin(); 
         lit2 != rGen2.InitStatesEnd(); ++lit2) {
       currentstates = std::make_pair(*lit1, *lit2);
       todo.push(currentstates);
-      rCompositionMap[currentstates] = pResGen->InsInitState();
-      FD_DF("Product:   (" << *lit1 << "|" << *lit2 << ") -> " 
-          << rCompositionMap[currentstates]);
+      tmpstate = pResGen->InsInitState();
+      rCompositionMap.Insert(*lit1, *lit2, tmpstate);
+      FD_DF("Product:   (" << *lit1 << "|" << *lit2 << ") -> " << tmpstate);
     }
   }
 
   // start algorithm
   FD_DF("Product: processing reachable states:");
+  Idx lcnt=0;
   while (! todo.empty()) {
-    // allow for user interrupt
-    // LoopCallback();
+    // allow for user interrupt, incl cancellation and limits
+    FD_LOOP(lcnt,pResGen->Size());
     // allow for user interrupt, incl progress report
-    FD_WPC(rCompositionMap.size(),rCompositionMap.size()+todo.size(),"Product(): processing"); 
+    FD_WPC(rCompositionMap.Size(),rCompositionMap.Size()+todo.size(),"Product(): processing"); 
     // get next reachable state from todo stack
     currentstates = todo.top();
     todo.pop();
+    currentstate = rCompositionMap.Find(currentstates.first, currentstates.second);
     FD_DF("Product: processing (" << currentstates.first << "|" 
-        << currentstates.second << ") -> " << rCompositionMap[currentstates]);
+        << currentstates.second << ") -> " << currentstate);
     // iterate over all rGen1 and rGen2 transitions
     tit1 = rGen1.TransRelBegin(currentstates.first);
     tit1_end = rGen1.TransRelEnd(currentstates.first);
@@ -698,21 +1012,19 @@ void Product(
         // successor composition state
         newstates = std::make_pair(tit1->X2, tit2->X2);
         // add to todo list if composition state is new
-        rcit = rCompositionMap.find(newstates);
-        if(rcit == rCompositionMap.end()) {
+        tmpstate = rCompositionMap.Find(newstates.first, newstates.second);
+        if(tmpstate == 0) {
           todo.push(newstates);
           tmpstate = pResGen->InsState();
-          rCompositionMap[newstates] = tmpstate;
+          rCompositionMap.Insert(newstates.first, newstates.second, tmpstate);
 	  //if(tmpstate%1000==0)
           FD_DF("Product: todo push: (" << newstates.first << "|" 
-		  << newstates.second << ") -> " << rCompositionMap[newstates] << " todo #" << todo.size());
-        } else {
-          tmpstate = rcit->second;
+		  << newstates.second << ") -> " << tmpstate << " todo #" << todo.size());
         }
         // set transition in result
-        pResGen->SetTransition(rCompositionMap[currentstates], tit1->Ev, tmpstate);
+        pResGen->SetTransition(currentstate, tit1->Ev, tmpstate);
         FD_DF("Product: add transition to new generator: " 
-            << rCompositionMap[currentstates] << "-" << tit1->Ev << "-" << tmpstate);
+            << currentstate << "-" << tit1->Ev << "-" << tmpstate);
         ++tit2;
       }
       // increment tit1 
@@ -726,12 +1038,12 @@ void Product(
 
 
   // set marked states (tmoor 2024: reorganised for performance)
-  rcit=rCompositionMap.begin();
-  while(rcit!=rCompositionMap.end()) {    
-    if(rGen1.ExistsMarkedState(rcit->first.first))
-      if(rGen2.ExistsMarkedState(rcit->first.second))
-        pResGen->SetMarkedState(rcit->second);
-    ++rcit;
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit=rCompositionMap.Entries().begin();
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit_end=rCompositionMap.Entries().end();
+  for(;rcit!=rcit_end;++rcit) {
+    if(rGen1.ExistsMarkedState(rcit->X1))
+      if(rGen2.ExistsMarkedState(rcit->X2))
+        pResGen->SetMarkedState(rcit->X12);
   }
   FD_DF("Parallel: marked states: " << pResGen->MarkedStatesToString());
 
@@ -774,6 +1086,32 @@ void SetComposedStateNames(
 }
 
 
+// SetParallelStateNames
+void SetComposedStateNames(
+  const Generator& rGen1, const Generator& rGen2, 
+  const CompositionHashMap& rCompositionMap, 
+  Generator& rGen12)
+{
+  // iterate sorted by argument states, since unique names depend on the order
+  std::vector<CompositionHashMap::Entry> entries;
+  rCompositionMap.SortedEntries(entries);
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit;
+  for(rcit=entries.begin(); rcit!=entries.end(); rcit++) {
+    Idx x1=rcit->X1;
+    Idx x2=rcit->X2;
+    Idx x12=rcit->X12;
+    if(!rGen12.ExistsState(x12)) continue;
+    std::string name1= rGen1.StateName(x1);
+    if(name1=="") name1=ToStringInteger(x1);
+    std::string name2= rGen2.StateName(x2);
+    if(name2=="") name2=ToStringInteger(x2);
+    std::string name12= name1 + "|" + name2;
+    name12=rGen12.UniqueStateName(name12);
+    rGen12.StateName(x12,name12);
+  }
+}
+
+
 // CompositionMap1
 void CompositionMap1(
   const std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
@@ -810,6 +1148,8 @@ FAUDES_TYPE_IMPLEMENTATION(ProductCompositionMap,ProductCompositionMap,Type)
 
 // construct
 ProductCompositionMap::ProductCompositionMap(void) : Type() { 
+  mHashValid=true;
+  mStlValid=true;
   mCompiled=true;
 }
 
@@ -824,7 +1164,10 @@ ProductCompositionMap::~ProductCompositionMap(void) {
 
 // clear
 void ProductCompositionMap::Clear(void) { 
+  mHashMap.Clear();
+  mHashValid=true;
   mCompositionMap.clear(); 
+  mStlValid=true;
   mCompiled=true;
   mArg1Map.clear(); 
   mArg2Map.clear(); 
@@ -832,7 +1175,10 @@ void ProductCompositionMap::Clear(void) {
 
 // assignment
 void ProductCompositionMap::DoCopy(const ProductCompositionMap& rSrc) {
+  mHashMap=rSrc.mHashMap;
+  mHashValid=rSrc.mHashValid;
   mCompositionMap=rSrc.mCompositionMap;
+  mStlValid=rSrc.mStlValid;
   mCompiled=rSrc.mCompiled;
   mArg1Map=rSrc.mArg1Map; 
   mArg2Map=rSrc.mArg2Map;  
@@ -840,16 +1186,25 @@ void ProductCompositionMap::DoCopy(const ProductCompositionMap& rSrc) {
 
 // equality
 bool ProductCompositionMap::DoEqual(const ProductCompositionMap& rOther) const { 
-  return mCompositionMap==rOther.mCompositionMap;
+  return StlMap()==rOther.StlMap();
 }
 
 // C++/STL access
 const std::map< std::pair<Idx,Idx> , Idx >& ProductCompositionMap::StlMap(void) const { 
+  if(!mStlValid) {
+    mHashMap.StlMap(mCompositionMap);
+    mStlValid=true;
+  }
   return mCompositionMap;
 }
 
-// C++/STL access
+// C++/STL access (std::map becomes the primary representation)
 std::map< std::pair<Idx,Idx> , Idx >& ProductCompositionMap::StlMap(void) { 
+  if(!mStlValid) {
+    mHashMap.StlMap(mCompositionMap);
+    mStlValid=true;
+  }
+  mHashValid=false;
   mCompiled=false;
   return mCompositionMap;
 }
@@ -857,29 +1212,54 @@ std::map< std::pair<Idx,Idx> , Idx >& ProductCompositionMap::StlMap(void) {
 // C++/STL access
 void ProductCompositionMap::StlMap(const std::map< std::pair<Idx,Idx> , Idx >& rMap) { 
   mCompositionMap=rMap;
+  mStlValid=true;
+  mHashValid=false;
   mCompiled=false;
 }
 
+// internal access
+const CompositionHashMap& ProductCompositionMap::HashMap(void) const { 
+  if(!mHashValid) {
+    mHashMap.FromStlMap(mCompositionMap);
+    mHashValid=true;
+  }
+  return mHashMap;
+}
+
+// internal access (hash map becomes the primary representation)
+CompositionHashMap& ProductCompositionMap::HashMap(void) { 
+  if(!mHashValid) {
+    mHashMap.FromStlMap(mCompositionMap);
+    mHashValid=true;
+  }
+  mStlValid=false;
+  mCompositionMap.clear();
+  mCompiled=false;
+  return mHashMap;
+}
+
 // access
 Idx ProductCompositionMap::CompState(Idx x1, Idx x2) const {
-  std::pair<Idx,Idx> x12(x1,x2);
-  std::map< std::pair<Idx,Idx> , Idx >::const_iterator x12it=mCompositionMap.find(x12);
-  if(x12it==mCompositionMap.end()) return 0;
-  return x12it->second;
+  return HashMap().Find(x1,x2);
+}
+
+// compile reverse maps
+void ProductCompositionMap::Compile(void) const {
+  if(mCompiled) return;
+  mArg1Map.clear();
+  mArg2Map.clear();
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit=HashMap().Entries().begin();
+  std::vector<CompositionHashMap::Entry>::const_iterator rcit_end=HashMap().Entries().end();
+  for(; rcit!=rcit_end; ++rcit) {
+    mArg1Map.insert(std::pair<Idx,Idx>(rcit->X12,rcit->X1));
+    mArg2Map.insert(std::pair<Idx,Idx>(rcit->X12,rcit->X2));
+  }
+  mCompiled=true;
 }
 
 // access
 Idx ProductCompositionMap::Arg1State(Idx x1) const {
-  if(!mCompiled) {
-    mArg1Map.clear();
-    mArg2Map.clear();
-    std::map< std::pair<Idx,Idx>, Idx>::const_iterator rcit;
-    for(rcit=mCompositionMap.begin(); rcit!=mCompositionMap.end(); rcit++) {
-      mArg1Map.insert(std::pair<Idx,Idx>(rcit->second,rcit->first.first));
-      mArg2Map.insert(std::pair<Idx,Idx>(rcit->second,rcit->first.second));
-    }
-    mCompiled=true;
-  }
+  Compile();
   std::map< Idx , Idx >::const_iterator x1it=mArg1Map.find(x1);
   if(x1it==mArg1Map.end()) return 0;
   return x1it->second;
@@ -887,21 +1267,557 @@ Idx ProductCompositionMap::Arg1State(Idx x1) const {
 
 // access
 Idx ProductCompositionMap::Arg2State(Idx x2) const {
-  if(!mCompiled) {
-    mArg1Map.clear();
-    mArg2Map.clear();
-    std::map< std::pair<Idx,Idx>, Idx>::const_iterator rcit;
-    for(rcit=mCompositionMap.begin(); rcit!=mCompositionMap.end(); rcit++) {
-      mArg1Map.insert(std::pair<Idx,Idx>(rcit->second,rcit->first.first));
-      mArg2Map.insert(std::pair<Idx,Idx>(rcit->second,rcit->first.second));
-    }
-    mCompiled=true;
-  }
+  Compile();
   std::map< Idx , Idx >::const_iterator x2it=mArg2Map.find(x2);
   if(x2it==mArg2Map.end()) return 0;
   return x2it->second;
 }
 
 
+/*
+*********************************************************
+Hash based composition map
+*********************************************************
+*/
+
+// max entries for dense lookup table (4MB)
+#define FAUDES_CMAP_DENSE (1<<20)
+
+// hash function for pairs of indices (64bit finalizer)
+static inline std::size_t cmap_hash(Idx x1, Idx x2) {
+  uint64_t h = (((uint64_t) x1) << 32) ^ ((uint64_t) x2);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return (std::size_t) h;
+}
+
+// construct
+CompositionHashMap::CompositionHashMap(void) {
+  Clear();
+}
+
+// clear
+void CompositionHashMap::Clear(void) {
+  mEntries.clear();
+  mDenseWidth=0;
+  mDenseHeight=0;
+  mMax1=0;
+  mMax2=0;
+  mTable.assign(16,0);
+}
+
+// clear and record ranges for a dense table; we start with a hash table
+// and allocate the dense table on growth, see Rehash()
+void CompositionHashMap::Reserve(Idx max1, Idx max2) {
+  Clear();
+  uint64_t dsize = ((uint64_t) max1+1) * ((uint64_t) max2+1);
+  if(dsize <= FAUDES_CMAP_DENSE) {
+    mMax1=max1;
+    mMax2=max2;
+  }
+}
+
+// convert to hash table with specified capacity (power of two), or to 
+// the dense table if that is at most four times the size of the hash table 
+void CompositionHashMap::Rehash(std::size_t cap) {
+  mDenseWidth=0;
+  mDenseHeight=0;
+  std::size_t dsize = ((std::size_t) mMax1+1) * ((std::size_t) mMax2+1);
+  if((mMax1>0) && (mMax2>0) && (dsize <= 4*cap)) {
+    mDenseWidth= (std::size_t) mMax2+1;
+    mDenseHeight= (std::size_t) mMax1+1;
+    mTable.assign(dsize,0);
+    for(std::size_t i=0; i<mEntries.size(); ++i) 
+      mTable[mEntries[i].X1*mDenseWidth+mEntries[i].X2]= (Idx) i+1;
+    return;
+  }
+  mTable.assign(cap,0);
+  std::size_t mask=cap-1;
+  for(std::size_t i=0; i<mEntries.size(); ++i) {
+    std::size_t pos=cmap_hash(mEntries[i].X1,mEntries[i].X2) & mask;
+    while(mTable[pos]!=0) pos=(pos+1) & mask;
+    mTable[pos]= (Idx) i+1;
+  }
+}
+
+// lookup
+Idx CompositionHashMap::Find(Idx x1, Idx x2) const {
+  // dense table
+  if(mDenseWidth>0) {
+    if(x1>=mDenseHeight || x2>=mDenseWidth) return 0;
+    Idx pos=mTable[x1*mDenseWidth+x2];
+    if(pos==0) return 0;
+    return mEntries[pos-1].X12;
+  }
+  // hash table with linear probing
+  std::size_t mask=mTable.size()-1;
+  std::size_t pos=cmap_hash(x1,x2) & mask;
+  while(true) {
+    Idx epos=mTable[pos];
+    if(epos==0) return 0;
+    const Entry& entry=mEntries[epos-1];
+    if(entry.X1==x1 && entry.X2==x2) return entry.X12;
+    pos=(pos+1) & mask;
+  }
+}
+
+// insert
+void CompositionHashMap::Insert(Idx x1, Idx x2, Idx x12) {
+  Entry entry;
+  entry.X1=x1;
+  entry.X2=x2;
+  entry.X12=x12;
+  mEntries.push_back(entry);
+  // out of range: fall back to hash table for good
+  if(x1>mMax1 || x2>mMax2) {
+    mMax1=0;
+    mMax2=0;
+  }
+  // dense table
+  if(mDenseWidth>0) {
+    if(x1<mDenseHeight && x2<mDenseWidth) {
+      mTable[x1*mDenseWidth+x2]= (Idx) mEntries.size();
+      return;
+    }
+    std::size_t cap=1024;
+    while(cap < 2*mEntries.size()) cap*=2;
+    Rehash(cap);
+    return;
+  }
+  // hash table: keep load factor below 1/2
+  if(2*mEntries.size() > mTable.size()) {
+    Rehash(2*mTable.size());
+    return;
+  }
+  std::size_t mask=mTable.size()-1;
+  std::size_t pos=cmap_hash(x1,x2) & mask;
+  while(mTable[pos]!=0) pos=(pos+1) & mask;
+  mTable[pos]= (Idx) mEntries.size();
+}
+
+// order of entries by argument states
+static bool cmap_less(const CompositionHashMap::Entry& rA, const CompositionHashMap::Entry& rB) {
+  if(rA.X1 < rB.X1) return true;
+  if(rA.X1 > rB.X1) return false;
+  return rA.X2 < rB.X2;
+}
+
+// sorted entries
+void CompositionHashMap::SortedEntries(std::vector<Entry>& rEntries) const {
+  rEntries=mEntries;
+  std::sort(rEntries.begin(),rEntries.end(),cmap_less);
+}
+
+// convert to std::map
+void CompositionHashMap::StlMap(std::map< std::pair<Idx,Idx>, Idx>& rMap) const {
+  rMap.clear();
+  std::vector<Entry> entries;
+  SortedEntries(entries);
+  std::vector<Entry>::const_iterator eit=entries.begin();
+  for(; eit!=entries.end(); ++eit)
+    rMap.insert(rMap.end(),std::make_pair(std::make_pair(eit->X1,eit->X2),eit->X12));
+}
+
+// convert from std::map
+void CompositionHashMap::FromStlMap(const std::map< std::pair<Idx,Idx>, Idx>& rMap) {
+  Clear();
+  std::map< std::pair<Idx,Idx>, Idx>::const_iterator rcit=rMap.begin();
+  for(; rcit!=rMap.end(); ++rcit)
+    Insert(rcit->first.first,rcit->first.second,rcit->second);
+}
+
+
+/*
+*********************************************************
+Multi-threaded exploration of composition states
+*********************************************************
+
+The exploration is organised in two phases. In the first phase, a number of
+workers, see RunTasks(), compute the reachable composition states and, per state, the
+list of outgoing edges. Workers operate on compiled snapshots of the arguments,
+i.e., plain arrays that are safe for concurrent read access, and maintain
+a local todo stack; surplus work is donated to a shared pool of work packages
+from which idle workers fetch. The set of visited composition states is split in
+shards with one mutex each. In the second phase, the main thread replays
+the sequential algorithm on the recorded edges. Thus, the resulting
+state numbering does not depend on the number of threads nor on their scheduling.
+The number of workers is taken from the current Context, see Context::Threads().
+
+*/
+
+#ifdef FAUDES_THREADS
+
+// min product of argument sizes to go multi-threaded
+#define FAUDES_CMAP_MTMIN 1000000
+// number of shards of the visited set (power of two, at most 256)
+#define FAUDES_CMAP_SHARDS 64
+// size of work packages
+#define FAUDES_CMAP_CHUNK 64
+
+// reference to a composition state: position within shard (upper bits) and shard (lower 8 bits)
+typedef uint64_t cmt_ref;
+
+// work item: pair of (internal) argument states and reference
+typedef struct {
+  Idx X1;
+  Idx X2;
+  cmt_ref Ref;
+} cmt_item;
+
+// expansion record: range of edges recorded by a worker
+typedef struct {
+  cmt_ref Ref;
+  std::size_t Begin;
+  std::size_t End;
+} cmt_record;
+
+// shard of visited set: maps pairs of internal argument states to position+1
+typedef struct {
+  faudes_mutex_t mMutex;
+  CompositionHashMap mMap;
+} cmt_shard;
+
+// per worker data
+typedef struct {
+  bool mBusy;
+  std::vector<cmt_item> mTodo;
+  std::vector<Idx> mEvents;
+  std::vector<cmt_ref> mTargets;
+  std::vector<cmt_record> mRecords;
+} cmt_worker;
+
+// shared data
+class cmt_context {
+public:
+  // construct/destruct
+  cmt_context(void) {
+    mShards.resize(FAUDES_CMAP_SHARDS);
+    for(std::size_t s=0; s<mShards.size(); ++s) faudes_mutex_init(&mShards[s].mMutex);
+    faudes_mutex_init(&mPoolMutex);
+    faudes_cond_init(&mPoolCond);
+    mBusy=0;
+    mDone=false;
+    mAbort=false;
+    mCount=0;
+    pCaller=Context::Current();
+  }
+  ~cmt_context(void) {
+    for(std::size_t s=0; s<mShards.size(); ++s) faudes_mutex_destroy(&mShards[s].mMutex);
+    faudes_mutex_destroy(&mPoolMutex);
+    faudes_cond_destroy(&mPoolCond);
+  }
+  // arguments
+  CompiledGenerator mGen1;
+  CompiledGenerator mGen2;
+  // events of rGen1 mapped to rGen2, 0 if not shared
+  std::vector<Idx> mEvents1To2;
+  // shared events of rGen2
+  std::vector<bool> mShared2;
+  // coaccessible states (live only)
+  std::vector<bool> mLive1;
+  std::vector<bool> mLive2;
+  // mode
+  bool mProduct;
+  bool mLiveOnly;
+  // visited set
+  std::vector<cmt_shard> mShards;
+  // work pool
+  faudes_mutex_t mPoolMutex;
+  faudes_cond_t mPoolCond;
+  std::vector< std::vector<cmt_item> > mPool;
+  int mBusy;
+  bool mDone;
+  // workers
+  std::vector<cmt_worker> mWorkers;
+  // cancellation and limits of the calling thread
+  Context* pCaller;
+  std::atomic<bool> mAbort;
+  std::atomic<std::size_t> mCount;
+  // test whether to expand composition state
+  bool Expand(Idx q1, Idx q2) const {
+    if(!mLiveOnly) return true;
+    return mLive1[q1] && mLive2[q2];
+  }
+  // lookup/insert composition state
+  cmt_ref Insert(Idx q1, Idx q2, bool& rNew) {
+    std::size_t s= cmap_hash(q2,q1) & (FAUDES_CMAP_SHARDS-1);
+    cmt_shard& shard=mShards[s];
+    faudes_mutex_lock(&shard.mMutex);
+    Idx pos=0;
+    try {
+      pos=shard.mMap.Find(q1,q2);
+      rNew= (pos==0);
+      if(rNew) {
+        pos=shard.mMap.Size()+1;
+        shard.mMap.Insert(q1,q2,pos);
+        ++mCount;
+      }
+    } catch(...) {
+      faudes_mutex_unlock(&shard.mMutex);
+      throw;
+    }
+    faudes_mutex_unlock(&shard.mMutex);
+    return ( ((cmt_ref) pos-1) << 8 ) | ((cmt_ref) s);
+  }
+  // donate work package
+  void Donate(std::vector<cmt_item>& rTodo) {
+    std::vector<cmt_item> chunk(rTodo.end()-FAUDES_CMAP_CHUNK,rTodo.end());
+    rTodo.resize(rTodo.size()-FAUDES_CMAP_CHUNK);
+    faudes_mutex_lock(&mPoolMutex);
+    try {
+      mPool.push_back(std::vector<cmt_item>());
+    } catch(...) {
+      faudes_mutex_unlock(&mPoolMutex);
+      throw;
+    }
+    mPool.back().swap(chunk);
+    faudes_cond_signal(&mPoolCond);
+    faudes_mutex_unlock(&mPoolMutex);
+  }
+  // test for cancellation/limits of the caller; abort exploration if so
+  bool Abort(void) {
+    if(mAbort) return true;
+    Idx limit=pCaller->StateLimit();
+    bool abort = pCaller->Cancelled() || pCaller->DeadlineExceeded();
+    if((limit>0) && (mCount>limit)) abort=true;
+    if(!abort) return false;
+    faudes_mutex_lock(&mPoolMutex);
+    mAbort=true;
+    mDone=true;
+    faudes_cond_broadcast(&mPoolCond);
+    faudes_mutex_unlock(&mPoolMutex);
+    return true;
+  }
+  // abort exploration when a worker fails, i.e., release workers waiting in Fetch()
+  void Fail(void) {
+    faudes_mutex_lock(&mPoolMutex);
+    mAbort=true;
+    mDone=true;
+    faudes_cond_broadcast(&mPoolCond);
+    faudes_mutex_unlock(&mPoolMutex);
+  }
+  // fetch work package, return false when exploration is complete, i.e., when
+  // no work is left and no worker holds any; this does not depend on the number 
+  // of workers that actually run concurrently
+  bool Fetch(cmt_worker* pWorker) {
+    bool res=false;
+    faudes_mutex_lock(&mPoolMutex);
+    if(pWorker->mBusy) {
+      pWorker->mBusy=false;
+      mBusy--;
+    }
+    while(mPool.empty() && !mDone) {
+      if(mBusy==0) {
+        mDone=true;
+        faudes_cond_broadcast(&mPoolCond);
+        break;
+      }
+      faudes_cond_wait(&mPoolCond,&mPoolMutex);
+    }
+    if(!mPool.empty()) {
+      pWorker->mTodo.swap(mPool.back());
+      mPool.pop_back();
+      pWorker->mBusy=true;
+      mBusy++;
+      res=true;
+    }
+    faudes_mutex_unlock(&mPoolMutex);
+    return res;
+  }
+};
+
+// record one edge
+static inline void cmt_edge(cmt_context* pCtx, cmt_worker* pWorker, Idx ev, Idx q1, Idx q2) {
+  bool isnew;
+  cmt_ref ref=pCtx->Insert(q1,q2,isnew);
+  pWorker->mEvents.push_back(ev);
+  pWorker->mTargets.push_back(ref);
+  if(!isnew) return;
+  if(!pCtx->Expand(q1,q2)) return;
+  cmt_item item;
+  item.X1=q1;
+  item.X2=q2;
+  item.Ref=ref;
+  pWorker->mTodo.push_back(item);
+}
+
+// expand one composition state (same edge order as sequential Parallel()/Product())
+static void cmt_expand(cmt_context* pCtx, cmt_worker* pWorker, const cmt_item& rItem) {
+  const CompiledGenerator& gen1=pCtx->mGen1;
+  const CompiledGenerator& gen2=pCtx->mGen2;
+  cmt_record rec;
+  rec.Ref=rItem.Ref;
+  rec.Begin=pWorker->mEvents.size();
+  // rGen1 transitions, incl. shared events
+  CompiledGenerator::Iterator eit1=gen1.SuccBegin(rItem.X1);
+  CompiledGenerator::Iterator eit1_end=gen1.SuccEnd(rItem.X1);
+  for(;eit1!=eit1_end;++eit1) {
+    Idx ev2=pCtx->mEvents1To2[eit1->Ev];
+    if(ev2==0) {
+      if(pCtx->mProduct) continue;
+      cmt_edge(pCtx,pWorker,gen1.Event(eit1->Ev),eit1->X,rItem.X2);
+      continue;
+    }
+    CompiledGenerator::Iterator eit2=gen2.SuccBegin(rItem.X2,ev2);
+    CompiledGenerator::Iterator eit2_end=gen2.SuccEnd(rItem.X2,ev2);
+    for(;eit2!=eit2_end;++eit2)
+      cmt_edge(pCtx,pWorker,gen1.Event(eit1->Ev),eit1->X,eit2->X);
+  }
+  // rGen2 transitions, excl. shared events
+  if(!pCtx->mProduct) {
+    CompiledGenerator::Iterator eit2=gen2.SuccBegin(rItem.X2);
+    CompiledGenerator::Iterator eit2_end=gen2.SuccEnd(rItem.X2);
+    for(;eit2!=eit2_end;++eit2) {
+      if(pCtx->mShared2[eit2->Ev]) continue;
+      cmt_edge(pCtx,pWorker,gen2.Event(eit2->Ev),rItem.X1,eit2->X);
+    }
+  }
+  rec.End=pWorker->mEvents.size();
+  pWorker->mRecords.push_back(rec);
+}
+
+// worker task
+static void cmt_worker_task(void* pData, std::size_t worker, std::size_t task) {
+  (void) worker;
+  cmt_context* pCtx=(cmt_context*) pData;
+  cmt_worker* pWorker=&pCtx->mWorkers[task];
+  Idx lcnt=0;
+  // on failure, e.g. out of memory, the other workers must not wait for our work
+  try {
+    while(true) {
+      if(pCtx->mAbort) break;
+      if(((++lcnt) & FAUDES_LOOP_PERIOD)==0)
+        if(pCtx->Abort()) break;
+      if(pWorker->mTodo.empty())
+        if(!pCtx->Fetch(pWorker)) break;
+      cmt_item item=pWorker->mTodo.back();
+      pWorker->mTodo.pop_back();
+      cmt_expand(pCtx,pWorker,item);
+      while(pWorker->mTodo.size() >= 2*FAUDES_CMAP_CHUNK)
+        pCtx->Donate(pWorker->mTodo);
+    }
+  } catch(...) {
+    pCtx->Fail();
+    throw;
+  }
+}
+
+// multi-threaded exploration, returns false if not applicable
+static bool cmt_compose(
+  const Generator& rGen1, const Generator& rGen2, 
+  bool product, bool live_only,
+  CompositionHashMap& rCompositionMap, 
+  Generator& rResGen)
+{
+  // figure number of threads (sequential when invoked by a task)
+  Idx threads=TaskThreads(Context::Current()->Threads(),64);
+  if(threads<=1) return false;
+  // skip small problems
+  if( ((double) rGen1.Size()) * ((double) rGen2.Size()) < FAUDES_CMAP_MTMIN) return false;
+  if(rGen1.InitStatesEmpty() || rGen2.InitStatesEmpty()) return false;
+  FD_DF("Parallel: multi-threaded exploration with #" << threads << " threads");
+  // compile arguments
+  cmt_context ctx;
+  ctx.mGen1.Compile(rGen1,live_only);
+  ctx.mGen2.Compile(rGen2,live_only);
+  ctx.mProduct=product;
+  ctx.mLiveOnly=live_only;
+  if(live_only) {
+    ctx.mGen1.Coaccessible(ctx.mLive1);
+    ctx.mGen2.Coaccessible(ctx.mLive2);
+  }
+  ctx.mEvents1To2.assign(ctx.mGen1.AlphabetSize()+1,0);
+  for(Idx e1=1; e1<=ctx.mGen1.AlphabetSize(); ++e1)
+    ctx.mEvents1To2[e1]=ctx.mGen2.EventIndex(ctx.mGen1.Event(e1));
+  ctx.mShared2.assign(ctx.mGen2.AlphabetSize()+1,false);
+  for(Idx e2=1; e2<=ctx.mGen2.AlphabetSize(); ++e2)
+    ctx.mShared2[e2]= ctx.mGen1.EventIndex(ctx.mGen2.Event(e2))!=0;
+  // initial states
+  std::vector<cmt_item> inits;
+  std::vector<cmt_item> todo;
+  const std::vector<Idx>& init1=ctx.mGen1.InitStates();
+  const std::vector<Idx>& init2=ctx.mGen2.InitStates();
+  for(std::size_t i1=0; i1<init1.size(); ++i1) {
+    for(std::size_t i2=0; i2<init2.size(); ++i2) {
+      bool isnew;
+      cmt_item item;
+      item.X1=init1[i1];
+      item.X2=init2[i2];
+      item.Ref=ctx.Insert(item.X1,item.X2,isnew);
+      inits.push_back(item);
+      if(ctx.Expand(item.X1,item.X2)) todo.push_back(item);
+    }
+  }
+  if(!todo.empty()) ctx.mPool.push_back(todo);
+  // run workers, one task each
+  ctx.mWorkers.resize(threads);
+  for(Idx w=0; w<threads; ++w) ctx.mWorkers[w].mBusy=false;
+  RunTasks(threads,threads,&cmt_worker_task,&ctx);
+  const std::vector<cmt_worker>& workers=ctx.mWorkers;
+  // pass on cancellation and limits
+  if(ctx.mAbort) {
+    LoopCheck((Idx) ctx.mCount);
+    throw Exception("Parallel()", "exploration aborted", 110);
+  }
+  FD_DF("Parallel: multi-threaded exploration: replay");
+  // global index of composition states: shard offsets
+  std::vector<std::size_t> offset(FAUDES_CMAP_SHARDS+1,0);
+  for(std::size_t s=0; s<FAUDES_CMAP_SHARDS; ++s)
+    offset[s+1]=offset[s]+ctx.mShards[s].mMap.Size();
+  std::size_t total=offset[FAUDES_CMAP_SHARDS];
+#define FAUDES_CMAP_GIDX(ref) (offset[(ref) & 0xff] + ((std::size_t) ((ref) >> 8)))
+  // global index of composition states: edge ranges
+  std::vector<int> rworker(total,-1);
+  std::vector<std::size_t> rbegin(total,0);
+  std::vector<std::size_t> rend(total,0);
+  for(std::size_t w=0; w<workers.size(); ++w) {
+    std::vector<cmt_record>::const_iterator rit=workers[w].mRecords.begin();
+    for(;rit!=workers[w].mRecords.end();++rit) {
+      std::size_t gidx=FAUDES_CMAP_GIDX(rit->Ref);
+      rworker[gidx]=(int) w;
+      rbegin[gidx]=rit->Begin;
+      rend[gidx]=rit->End;
+    }
+  }
+  // replay sequential algorithm
+  std::vector<Idx> state(total,0);
+  std::stack<std::size_t> stack;
+  for(std::size_t i=0; i<inits.size(); ++i) {
+    std::size_t gidx=FAUDES_CMAP_GIDX(inits[i].Ref);
+    state[gidx]=rResGen.InsInitState();
+    rCompositionMap.Insert(ctx.mGen1.State(inits[i].X1),ctx.mGen2.State(inits[i].X2),state[gidx]);
+    if(rworker[gidx]>=0) stack.push(gidx);
+  }
+  Idx lcnt=0;
+  while(!stack.empty()) {
+    FD_WPC(rCompositionMap.Size(),total,"Parallel(): processing"); 
+    FD_LOOP(lcnt,rResGen.Size());
+    std::size_t gidx=stack.top();
+    stack.pop();
+    Idx cstate=state[gidx];
+    const cmt_worker& worker=workers[rworker[gidx]];
+    for(std::size_t i=rbegin[gidx]; i<rend[gidx]; ++i) {
+      cmt_ref ref=worker.mTargets[i];
+      std::size_t tidx=FAUDES_CMAP_GIDX(ref);
+      if(state[tidx]==0) {
+        state[tidx]=rResGen.InsState();
+        const CompositionHashMap::Entry& entry=
+          ctx.mShards[ref & 0xff].mMap.Entries()[(std::size_t) (ref >> 8)];
+        rCompositionMap.Insert(ctx.mGen1.State(entry.X1),ctx.mGen2.State(entry.X2),state[tidx]);
+        if(rworker[tidx]>=0) stack.push(tidx);
+      }
+      rResGen.SetTransition(cstate,worker.mEvents[i],state[tidx]);
+    }
+  }
+#undef FAUDES_CMAP_GIDX
+  FD_DF("Parallel: multi-threaded exploration: done with #" << total << " states");
+  return true;
+}
+
+#endif // threads
+
 
 } // name space
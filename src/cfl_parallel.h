@@ -27,11 +27,97 @@
 #include <stack>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace faudes {
 
 
-/** 
+/**
+ * Hash based composition map.
+ *
+ * Product-like compositions record the pairs of argument states encountered so far
+ * in order to identify the corresponding state in the result. While the std::map
+ * variant of the composition map is part of the historic API, the internal
+ * implementation of Parallel(), Product() and related functions uses this
+ * class instead: pairs are recorded in insertion order in one plain vector, and
+ * the lookup uses either a dense two dimensional table (if the product of the
+ * argument index ranges is small) or an open addressing hash table.
+ * A std::map representation is only generated on request by StlMap().
+ *
+ * This class is not registered with the run-time interface.
+ */
+class FAUDES_API CompositionHashMap {
+public:
+
+  /** Record of one composition state */
+  struct Entry {
+    Idx X1;
+    Idx X2;
+    Idx X12;
+  };
+
+  /** Construct empty */
+  CompositionHashMap(void);
+
+  /** Clear all entries */
+  void Clear(void);
+
+  /**
+   * Clear and prepare for the specified argument index ranges. If the product of
+   * ranges is small, this will use a dense table for lookup, once the number of
+   * entries justifies its size.
+   *
+   * @param max1
+   *   Maximum state index of first argument
+   * @param max2
+   *   Maximum state index of second argument
+   */
+  void Reserve(Idx max1, Idx max2);
+
+  /** Number of entries */
+  Idx Size(void) const { return (Idx) mEntries.size(); };
+
+  /** Test whether the dense table is used for lookup */
+  bool Dense(void) const { return mDenseWidth>0; };
+
+  /** Lookup composition state, returns 0 if not present */
+  Idx Find(Idx x1, Idx x2) const;
+
+  /** Insert new composition state (pair must not yet be present) */
+  void Insert(Idx x1, Idx x2, Idx x12);
+
+  /** Access all entries in insertion order */
+  const std::vector<Entry>& Entries(void) const { return mEntries; };
+
+  /** Access all entries sorted by argument states */
+  void SortedEntries(std::vector<Entry>& rEntries) const;
+
+  /** Convert to std::map representation */
+  void StlMap(std::map< std::pair<Idx,Idx>, Idx>& rMap) const;
+
+  /** Convert from std::map representation */
+  void FromStlMap(const std::map< std::pair<Idx,Idx>, Idx>& rMap);
+
+protected:
+
+  /** Convert to hash table representation */
+  void Rehash(std::size_t cap);
+
+  /** Entries in insertion order */
+  std::vector<Entry> mEntries;
+  /** Dense table width (max2+1) or 0 for hash table */
+  std::size_t mDenseWidth;
+  /** Dense table height (max1+1) */
+  std::size_t mDenseHeight;
+  /** Argument index ranges for a dense table, or 0 if not applicable */
+  Idx mMax1;
+  Idx mMax2;
+  /** Lookup table: position in mEntries plus 1, or 0 for empty slot */
+  std::vector<Idx> mTable;
+};
+
+
+/**
  * Rti-wrapper for composition maps
  *
  * Parallel-composition and related functions provide an optional
@@ -53,10 +139,13 @@ public:
   ProductCompositionMap(const ProductCompositionMap& rOther);
   virtual ~ProductCompositionMap(void);
   virtual void Clear(void);
-  // access C++/STL data
+  // access C++/STL data (generated on request)
   const std::map< std::pair<Idx,Idx> , Idx >& StlMap(void) const;
   std::map< std::pair<Idx,Idx> , Idx >& StlMap(void);
   void StlMap(const std::map< std::pair<Idx,Idx> , Idx >& rMap);
+  // access internal data
+  const CompositionHashMap& HashMap(void) const;
+  CompositionHashMap& HashMap(void);
   // translate states (return 0 on out-of-range)
   Idx CompState(Idx s1, Idx s2) const;
   Idx Arg1State(Idx s12) const;
@@ -65,8 +154,13 @@ protected:
   // std faudes type
   void DoCopy(const ProductCompositionMap& rSrc);
   bool DoEqual(const ProductCompositionMap& rOther) const;
-  // my data (primary)
-  std::map< std::pair<Idx,Idx> , Idx > mCompositionMap; 
+  // compile reverse maps
+  void Compile(void) const;
+  // my data (primary, either representation may be outdated)
+  mutable CompositionHashMap mHashMap;
+  mutable bool mHashValid;
+  mutable std::map< std::pair<Idx,Idx> , Idx > mCompositionMap;
+  mutable bool mStlValid;
   // my data (derived)
   mutable bool mCompiled;
   mutable std::map<Idx,Idx> mArg1Map; 
@@ -83,6 +177,9 @@ protected:
  * The resulting generators alphabet is the union of the argument alphabets.
  * In this implementation, only accessible states are generated. 
  * On deterministic input this functions constructs a deterministic output.
+ * When libFAUDES is configured with the option core_threads, large compositions are
+ * explored by the number of threads specified by the current Context, see Context::Threads(); 
+ * the result, including the state numbering, does not depend on the number of threads.
  * See also Parallel(const Generator&,std::map< std::pair<Idx,Idx>, Idx>&,const Generator&, Generator&).
  *
  * @param rGen1
@@ -151,8 +248,9 @@ extern FAUDES_API void ParallelLive(const Generator& rGen1, const Generator& rGe
  * See also Parallel(const Generator&, const Generator&, Generator&).
  * This version takes a vector of generators as argument to perform
  * a synchronous composition of multiple generators. The implementation
- * calls the std Parallel multiple times, future implementations may
- * explore the overall reachable state set.
+ * explores the overall reachable set of state tuples directly, i.e., no
+ * intermediate compositions are computed. State names are composed from
+ * the component state names, if enabled for all components and the result.
  *
  * @param rGenVec
  *   Vector of input generators
@@ -169,8 +267,12 @@ extern FAUDES_API void Parallel(const GeneratorVector& rGenVec, Generator& rResG
  * See also Parallel(const Generator&, const Generator&, Generator&).
  * This version takes a vector of generators as argument to perform
  * a synchronous composition of multiple generators. The implementation
- * calls the std Parallel multiple times, and, at each stage, removes outgoing transitions
- * from blocking states. Thus, the result will be accurate for non-blocking part only.
+ * explores the overall reachable set of state tuples directly and does not
+ * expand tuples with a component state that is not coaccessible in the respective
+ * component. The result is then trimmed in that outgoing transitions of blocking
+ * states are removed and states that thereby become unreachable are removed, too.
+ * This is at least as strict as removing blocking states at each stage of a pairwise
+ * composition. Thus, the result will be accurate for non-blocking part only.
  *
  * @param rGenVec
  *   Vector of input generators
@@ -264,6 +366,28 @@ extern FAUDES_API void Parallel(
     std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
     Generator& rResGen, bool live_only=false);
 
+/**
+ * Parallel composition.
+ * See Parallel(const Generator&, const Generator&, Generator&).
+ * This version fills a hash based composition map to map pairs of old states
+ * to new states. It is the actual implementation of parallel composition and
+ * should be preferred over the std::map variant for large generators.
+ * @param rGen1
+ *   First generator
+ * @param rGen2
+ *   Second generator
+ * @param rCompositionMap
+ *   Composition map
+ * @param rResGen
+ *   Reference to resulting parallel composition generator
+ * @param live_only
+ *   Stop exploration at non-coaccessible argument states
+ */
+extern FAUDES_API void Parallel(
+    const Generator& rGen1, const Generator& rGen2,
+    CompositionHashMap& rCompositionMap, 
+    Generator& rResGen, bool live_only=false);
+
 
 /**
  * Parallel composition.
@@ -335,6 +459,24 @@ extern FAUDES_API void Parallel(
  */
 extern FAUDES_API void Product(const Generator& rGen1, const Generator& rGen2, Generator& rResGen);
 
+/**
+ * Product composition.
+ *
+ * See also Product(const Generator&, const Generator&, Generator&).
+ * This version takes a vector of generators as argument to perform
+ * a product composition of multiple generators. As with 
+ * Parallel(const GeneratorVector&, Generator&), the overall reachable set of state
+ * tuples is explored directly. The result alphabet consists of the events shared
+ * by all generators.
+ *
+ * @param rGenVec
+ *   Vector of input generators
+ * @param rResGen
+ *   Reference to resulting product composition generator
+ *
+ */
+extern FAUDES_API void Product(const GeneratorVector& rGenVec, Generator& rResGen);
+
 
 /**
  * Product composition.
@@ -357,6 +499,25 @@ extern FAUDES_API void Product(
     std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
     Generator& rResGen);
 
+/**
+ * Product composition.
+ * See Product(const Generator&, const Generator&, Generator&).
+ * This version fills a hash based composition map to map pairs of old states
+ * to new states. It is the actual implementation of the product composition.
+ * @param rGen1
+ *   First generator
+ * @param rGen2
+ *   Second generator
+ * @param rCompositionMap
+ *   Composition map
+ * @param rResGen
+ *   Reference to resulting product composition generator
+ */
+extern FAUDES_API void Product(
+    const Generator& rGen1, const Generator& rGen2,
+    CompositionHashMap& rCompositionMap, 
+    Generator& rResGen);
+
 
 /**
  * Product composition.
@@ -446,6 +607,24 @@ extern FAUDES_API void SetComposedStateNames(
     const std::map< std::pair<Idx,Idx>, Idx>& rCompositionMap, 
     Generator& rGen12);
 
+/**
+ * Helper: uses composition map to track state names
+ * in a paralell composition. Purely cosmetic.
+ * @param rGen1
+ *   First generator
+ * @param rGen2
+ *   Second generator
+ * @param rCompositionMap
+ *   Composition map
+ * @param rGen12
+ *   Reference to resulting parallel composition generator
+ */
+extern FAUDES_API void SetComposedStateNames(
+    const Generator& rGen1, const Generator& rGen2,
+    const CompositionHashMap& rCompositionMap, 
+    Generator& rGen12);
+
+
 } // namespace faudes
 
 
@@ -0,0 +1,641 @@
+/** @file cfl_partition.cpp Partition refinement kernel */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#include "cfl_partition.h"
+#include "cfl_utils.h"
+#include "cfl_context.h"
+#include "cfl_tasks.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace faudes {
+
+// min number of states per round to go multi-threaded
+#define FAUDES_PARTITION_MTMIN 20000
+// states per task in data-parallel phases
+#define FAUDES_PARTITION_CHUNK 2048
+
+// hash of a signature (deterministic)
+static uint64_t sig_hash(const uint64_t* pBeg, const uint64_t* pEnd) {
+  uint64_t h=0x9e3779b97f4a7c15ULL ^ ((uint64_t) (pEnd-pBeg));
+  for(; pBeg!=pEnd; ++pBeg) {
+    h ^= *pBeg + 0x9e3779b97f4a7c15ULL + (h<<6) + (h>>2);
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+  }
+  return h;
+}
+
+// order positions by hash of signature and then by signature (lexicographic)
+class SigOrder {
+public:
+  SigOrder(const std::vector<uint64_t>& rBuf, const std::vector<Idx>& rBeg, const std::vector<Idx>& rEnd,
+    const std::vector<uint64_t>& rHash) :
+    mrBuf(rBuf), mrBeg(rBeg), mrEnd(rEnd), mrHash(rHash) {};
+  bool operator()(Idx p1, Idx p2) const {
+    if(mrHash[p1]!=mrHash[p2]) return mrHash[p1]<mrHash[p2];
+    return std::lexicographical_compare(
+      mrBuf.begin()+mrBeg[p1], mrBuf.begin()+mrEnd[p1],
+      mrBuf.begin()+mrBeg[p2], mrBuf.begin()+mrEnd[p2]);
+  }
+  bool Equal(Idx p1, Idx p2) const {
+    if(mrHash[p1]!=mrHash[p2]) return false;
+    if(mrEnd[p1]-mrBeg[p1] != mrEnd[p2]-mrBeg[p2]) return false;
+    return std::equal(mrBuf.begin()+mrBeg[p1], mrBuf.begin()+mrEnd[p1], mrBuf.begin()+mrBeg[p2]);
+  }
+private:
+  const std::vector<uint64_t>& mrBuf;
+  const std::vector<Idx>& mrBeg;
+  const std::vector<Idx>& mrEnd;
+  const std::vector<uint64_t>& mrHash;
+};
+
+// per worker scratch memory for saturation
+typedef struct {
+  std::vector<Idx> mStamp;
+  std::vector<Idx> mStamp2;
+  Idx mTag;
+  std::vector<Idx> mClosure;
+  std::vector<Idx> mStack;
+  std::vector<CompiledGenerator::Edge> mEdges;
+} sr_scratch;
+
+// context of data-parallel phases
+typedef struct {
+  int mPhase;                                                // 1: saturate, 2: signatures, 3: sort
+  std::size_t mChunk;                                        // states/positions per task
+  // saturate
+  const std::vector<bool>* pSilent;                          // silent flags by event
+  const std::vector<Idx>* pSilentEvs;                        // silent events
+  int mMode;                                                 // 1: delayed, 2: weak
+  bool mSelfloops;                                           // install silent selfloops
+  std::vector<sr_scratch> mScratch;                          // per worker
+  std::vector< std::vector<CompiledGenerator::Edge> > mSuc;  // per task: saturated successors 
+  std::vector<Idx> mSucCount;                                // per state: number of successors
+  // signatures
+  const std::vector<Idx>* pStates;                           // state by position
+  std::vector< std::vector<uint64_t> > mSigs;                // per task: signatures
+  // sort
+  std::vector<Idx>* pOrder;                                  // positions to sort
+  const SigOrder* pSigOrder;                                 // order
+  std::vector< std::pair<Idx,Idx> > mRanges;                 // per task: range in order
+  // refinement
+  SignatureRefinement* pRef;
+} sr_context;
+
+// sorted ranges [first,middle) and [middle,last) to merge
+typedef struct {
+  Idx first;
+  Idx middle;
+  Idx last;
+} sr_merge;
+
+// figure number of threads
+static Idx sr_threads(Idx threads, std::size_t size) {
+  if(size < FAUDES_PARTITION_MTMIN) return 1;
+  return TaskThreads(threads,64);
+}
+
+// construct
+SignatureRefinement::SignatureRefinement(void) : mThreads(Context::Current()->Threads()) {
+}
+
+// destruct
+SignatureRefinement::~SignatureRefinement(void) {
+}
+
+// internal index (binary search, states are ordered)
+Idx SignatureRefinement::StateIndex(Idx x) const {
+  std::vector<Idx>::const_iterator sit=std::lower_bound(mStates.begin(),mStates.end(),x);
+  if(sit==mStates.end()) return (Idx) mStates.size();
+  if(*sit!=x) return (Idx) mStates.size();
+  return (Idx) (sit-mStates.begin());
+}
+
+// set up
+void SignatureRefinement::Compile(const vGenerator& rGen) {
+  FD_DF("SignatureRefinement::Compile(): " << rGen.Name());
+  CompiledGenerator cgen(rGen,false);
+  Idx n=cgen.Size();
+  mStates.resize(n);
+  for(Idx q=1; q<=n; ++q) mStates[q-1]=cgen.State(q);
+  mEvents.resize(cgen.AlphabetSize()+1);
+  mEvents[0]=0;
+  for(Idx e=1; e<mEvents.size(); ++e) mEvents[e]=cgen.Event(e);
+  // successors, with internal states starting at 0
+  mSucBegin.resize(n+1);
+  mSuc.clear();
+  mSuc.reserve(cgen.TransRelSize());
+  for(Idx q=1; q<=n; ++q) {
+    mSucBegin[q-1]=(Idx) mSuc.size();
+    CompiledGenerator::Iterator eit=cgen.SuccBegin(q);
+    CompiledGenerator::Iterator eit_end=cgen.SuccEnd(q);
+    for(; eit!=eit_end; ++eit) {
+      Edge edge;
+      edge.Ev=eit->Ev;
+      edge.X=eit->X-1;
+      mSuc.push_back(edge);
+    }
+  }
+  mSucBegin[n]=(Idx) mSuc.size();
+  CompilePredecessors();
+  // one class
+  mBlocks.Init(n);
+}
+
+// predecessors, events neglected
+void SignatureRefinement::CompilePredecessors(void) {
+  Idx n=(Idx) mStates.size();
+  mPreBegin.assign(n+1,0);
+  mPre.clear();
+  // count with duplicates removed per source, relies on successors sorted by event
+  std::vector<Idx> last(n,n);
+  for(Idx q=0; q<n; ++q) {
+    for(Idx i=mSucBegin[q]; i<mSucBegin[q+1]; ++i) {
+      Idx x=mSuc[i].X;
+      if(last[x]==q) continue;
+      last[x]=q;
+      ++mPreBegin[x+1];
+    }
+  }
+  for(Idx q=0; q<n; ++q) mPreBegin[q+1]+=mPreBegin[q];
+  mPre.resize(mPreBegin[n]);
+  std::vector<Idx> pos(mPreBegin.begin(),mPreBegin.end()-1);
+  last.assign(n,n);
+  for(Idx q=0; q<n; ++q) {
+    for(Idx i=mSucBegin[q]; i<mSucBegin[q+1]; ++i) {
+      Idx x=mSuc[i].X;
+      if(last[x]==q) continue;
+      last[x]=q;
+      mPre[pos[x]++]=q;
+    }
+  }
+}
+
+// edge order
+static bool edge_less(const CompiledGenerator::Edge& e1, const CompiledGenerator::Edge& e2) {
+  if(e1.Ev<e2.Ev) return true;
+  if(e1.Ev>e2.Ev) return false;
+  return e1.X < e2.X;
+}
+static bool edge_equal(const CompiledGenerator::Edge& e1, const CompiledGenerator::Edge& e2) {
+  return (e1.Ev==e2.Ev) && (e1.X==e2.X);
+}
+
+// data-parallel tasks
+void SignatureRefinement::Task(void* pContext, std::size_t worker, std::size_t task) {
+  sr_context* pCtx=(sr_context*) pContext;
+  SignatureRefinement* pRef=pCtx->pRef;
+  // saturate: silent closure per state by dfs, visited flags by stamp
+  if(pCtx->mPhase==1) {
+    Idx n=(Idx) pRef->mStates.size();
+    const std::vector<bool>& silent=*pCtx->pSilent;
+    const std::vector<Idx>& silentevs=*pCtx->pSilentEvs;
+    const std::vector<Idx>& sucbegin=pRef->mSucBegin;
+    const std::vector<Edge>& suc=pRef->mSuc;
+    sr_scratch& scratch=pCtx->mScratch[worker];
+    if(scratch.mStamp.size()!=n) {
+      scratch.mStamp.assign(n,0);
+      scratch.mStamp2.assign(n,0);
+      scratch.mTag=0;
+    }
+    std::vector<Idx>& stamp=scratch.mStamp;
+    std::vector<Idx>& stamp2=scratch.mStamp2;
+    std::vector<Idx>& closure=scratch.mClosure;
+    std::vector<Idx>& stack=scratch.mStack;
+    std::vector<Edge>& edges=scratch.mEdges;
+    std::vector<Edge>& res=pCtx->mSuc[task];
+    res.clear();
+    Idx qbeg= (Idx) (task*pCtx->mChunk);
+    Idx qend= (Idx) std::min((std::size_t) n,(task+1)*pCtx->mChunk);
+    Idx lcnt=0;
+    for(Idx q=qbeg; q<qend; ++q) {
+      // allow for user interrupt, polled by the calling thread only
+      if(worker==0) FD_LOOP(lcnt,0);
+      // tau*(q)
+      closure.clear();
+      stack.clear();
+      stack.push_back(q);
+      stamp[q]=q+1;
+      while(!stack.empty()) {
+        Idx r=stack.back();
+        stack.pop_back();
+        closure.push_back(r);
+        for(Idx i=sucbegin[r]; i<sucbegin[r+1]; ++i) {
+          if(!silent[suc[i].Ev]) continue;
+          Idx s=suc[i].X;
+          if(stamp[s]==q+1) continue;
+          stamp[s]=q+1;
+          stack.push_back(s);
+        }
+      }
+      // collect edges
+      edges.clear();
+      for(std::size_t k=0; k<closure.size(); ++k) {
+        Idx r=closure[k];
+        for(Idx i=sucbegin[r]; i<sucbegin[r+1]; ++i) {
+          const Edge& edge=suc[i];
+          edges.push_back(edge);
+          if(pCtx->mMode!=2) continue;
+          if(silent[edge.Ev]) continue;
+          // visible event followed by silent events
+          Idx tag=++scratch.mTag;
+          stack.clear();
+          stack.push_back(edge.X);
+          stamp2[edge.X]=tag;
+          while(!stack.empty()) {
+            Idx s=stack.back();
+            stack.pop_back();
+            for(Idx j=sucbegin[s]; j<sucbegin[s+1]; ++j) {
+              if(!silent[suc[j].Ev]) continue;
+              Idx t=suc[j].X;
+              if(stamp2[t]==tag) continue;
+              stamp2[t]=tag;
+              stack.push_back(t);
+              Edge xedge;
+              xedge.Ev=edge.Ev;
+              xedge.X=t;
+              edges.push_back(xedge);
+            }
+          }
+        }
+      }
+      // silent selfloops
+      if(pCtx->mSelfloops) {
+        for(std::size_t k=0; k<silentevs.size(); ++k) {
+          Edge xedge;
+          xedge.Ev=silentevs[k];
+          xedge.X=q;
+          edges.push_back(xedge);
+        }
+      }
+      // record
+      std::sort(edges.begin(),edges.end(),edge_less);
+      edges.erase(std::unique(edges.begin(),edges.end(),edge_equal),edges.end());
+      pCtx->mSucCount[q]=(Idx) edges.size();
+      res.insert(res.end(),edges.begin(),edges.end());
+    }
+  }
+  // signatures of positions, local offsets
+  if(pCtx->mPhase==2) {
+    const std::vector<Idx>& states=*pCtx->pStates;
+    Idx n=(Idx) pRef->mStates.size();
+    std::vector<uint64_t>& sig=pCtx->mSigs[task];
+    sig.clear();
+    std::size_t pbeg= task*pCtx->mChunk;
+    std::size_t pend= std::min(states.size(),(task+1)*pCtx->mChunk);
+    for(std::size_t p=pbeg; p<pend; ++p) {
+      pRef->mSigBegin[p]=(Idx) sig.size();
+      if(states[p]<n) pRef->Signature(states[p],sig);
+      pRef->mSigEnd[p]=(Idx) sig.size();
+      pRef->mSigHash[p]=sig_hash(sig.data()+pRef->mSigBegin[p],sig.data()+pRef->mSigEnd[p]);
+    }
+  }
+  // sort range of positions
+  if(pCtx->mPhase==3) {
+    std::vector<Idx>& order=*pCtx->pOrder;
+    std::sort(order.begin()+pCtx->mRanges[task].first,order.begin()+pCtx->mRanges[task].second,*pCtx->pSigOrder);
+  }
+}
+
+// saturate
+void SignatureRefinement::Saturate(const EventSet& rSilent, int mode, bool selfloops) {
+  FD_DF("SignatureRefinement::Saturate(): mode " << mode);
+  Idx n=(Idx) mStates.size();
+  // silent events by internal index
+  std::vector<bool> silent(mEvents.size(),false);
+  std::vector<Idx> silentevs;
+  for(Idx e=1; e<mEvents.size(); ++e) {
+    if(!rSilent.Exists(mEvents[e])) continue;
+    silent[e]=true;
+    silentevs.push_back(e);
+  }
+  if(silentevs.empty()) return;
+  // closures per chunk of states
+  Idx threads=sr_threads(mThreads,n);
+  sr_context ctx;
+  ctx.pRef=this;
+  ctx.mPhase=1;
+  ctx.mChunk=FAUDES_PARTITION_CHUNK;
+  ctx.pSilent=&silent;
+  ctx.pSilentEvs=&silentevs;
+  ctx.mMode=mode;
+  ctx.mSelfloops=selfloops;
+  ctx.mScratch.resize(threads);
+  std::size_t tasks=(n+ctx.mChunk-1)/ctx.mChunk;
+  ctx.mSuc.resize(tasks);
+  ctx.mSucCount.resize(n);
+  RunTasks(threads,tasks,&SignatureRefinement::Task,&ctx);
+  LoopCallback();
+  // concatenate
+  std::vector<Idx> sucbegin(n+1);
+  std::vector<Edge> suc;
+  std::size_t size=0;
+  for(std::size_t t=0; t<tasks; ++t) size+=ctx.mSuc[t].size();
+  suc.reserve(size);
+  for(std::size_t t=0; t<tasks; ++t) {
+    suc.insert(suc.end(),ctx.mSuc[t].begin(),ctx.mSuc[t].end());
+    std::vector<Edge>().swap(ctx.mSuc[t]);
+  }
+  sucbegin[0]=0;
+  for(Idx q=0; q<n; ++q) sucbegin[q+1]=sucbegin[q]+ctx.mSucCount[q];
+  mSucBegin.swap(sucbegin);
+  mSuc.swap(suc);
+  CompilePredecessors();
+  FD_DF("SignatureRefinement::Saturate(): transitions #" << mSuc.size());
+}
+
+// refine by state set
+void SignatureRefinement::PrePartition(const StateSet& rStates) {
+  StateSet::Iterator sit=rStates.Begin();
+  StateSet::Iterator sit_end=rStates.End();
+  for(;sit!=sit_end;++sit) {
+    Idx q=StateIndex(*sit);
+    if(q>=mStates.size()) continue;
+    mBlocks.Mark(q);
+  }
+  mBlocks.Split();
+}
+
+// refine by family of state sets
+void SignatureRefinement::PrePartition(const std::vector<StateSet>& rPrePartition) {
+  if(rPrePartition.empty()) return;
+  Idx n=(Idx) mStates.size();
+  // figure set per state
+  std::vector<Idx> cls(n,0);
+  for(std::size_t k=0; k<rPrePartition.size(); ++k) {
+    StateSet::Iterator sit=rPrePartition[k].Begin();
+    StateSet::Iterator sit_end=rPrePartition[k].End();
+    for(;sit!=sit_end;++sit) {
+      Idx q=StateIndex(*sit);
+      if(q>=n) continue;
+      if(cls[q]==0) cls[q]=k+1;
+    }
+  }
+  for(Idx q=0; q<n; ++q)
+    if(cls[q]==0)
+      throw Exception("SignatureRefinement::PrePartition",
+        "invalid prepartition: state " + ToStringInteger(mStates[q]) + " is not allocated", 100);
+  // split per set, the last set remains
+  for(std::size_t k=0; k+1<rPrePartition.size(); ++k) {
+    StateSet::Iterator sit=rPrePartition[k].Begin();
+    StateSet::Iterator sit_end=rPrePartition[k].End();
+    for(;sit!=sit_end;++sit) {
+      Idx q=StateIndex(*sit);
+      if(q>=n) continue;
+      if(cls[q]==k+1) mBlocks.Mark(q);
+    }
+    mBlocks.Split();
+  }
+}
+
+// default signature: pairs of event and class of successor
+void SignatureRefinement::Signature(Idx q, std::vector<uint64_t>& rSig) const {
+  std::size_t beg=rSig.size();
+  for(Idx i=mSucBegin[q]; i<mSucBegin[q+1]; ++i)
+    rSig.push_back( (((uint64_t) mSuc[i].Ev) << 32) | mBlocks.S[mSuc[i].X] );
+  std::sort(rSig.begin()+beg,rSig.end());
+  rSig.erase(std::unique(rSig.begin()+beg,rSig.end()),rSig.end());
+}
+
+// fixpoint iteration
+void SignatureRefinement::Refine(void) {
+  FD_DF("SignatureRefinement::Refine(): states #" << mStates.size() << " transitions #" << mSuc.size());
+  Idx n=(Idx) mStates.size();
+  // all states are affected initially
+  mAffected.resize(n);
+  for(Idx q=0; q<n; ++q) mAffected[q]=q;
+  mAffectedFlags.assign(n,true);
+  // buffers
+  std::vector<Idx> blocks;      // affected blocks
+  std::vector<Idx> bbegin;      // per affected block: first position
+  std::vector<Idx> states;      // per position: state
+  std::vector<Idx> order;       // positions, sorted per block
+  std::vector<Idx> moved;
+  std::vector<sr_merge> merges; // chunks to merge after sorting
+  SigOrder sorder(mSigBuffer,mSigBegin,mSigEnd,mSigHash);
+  sr_context ctx;
+  ctx.pRef=this;
+  ctx.mChunk=FAUDES_PARTITION_CHUNK;
+  ctx.pStates=&states;
+  ctx.pOrder=&order;
+  ctx.pSigOrder=&sorder;
+  while(!mAffected.empty()) {
+    FD_WPC(mBlocks.z,n,"SignatureRefinement: classes/affected: " << mBlocks.z << "/" << mAffected.size());
+    FD_DF("SignatureRefinement::Refine(): classes #" << mBlocks.z << " affected #" << mAffected.size());
+    Idx threads=sr_threads(mThreads,mAffected.size());
+    // group affected states by class: marking moves them to the front of their class
+    for(std::size_t k=0; k<mAffected.size(); ++k) {
+      mBlocks.Mark(mAffected[k]);
+      mAffectedFlags[mAffected[k]]=false;
+    }
+    blocks.clear();
+    bbegin.clear();
+    states.clear();
+    for(std::size_t k=0; k<mBlocks.pW->size(); ++k) {
+      Idx b=(*mBlocks.pW)[k];
+      if(mBlocks.Size(b)==1) continue;
+      blocks.push_back(b);
+      bbegin.push_back((Idx) states.size());
+      Idx m=mBlocks.MarkedSize(b);
+      // representative of unaffected states goes first
+      if(m<mBlocks.Size(b)) states.push_back(mBlocks.E[mBlocks.F[b]+m]);
+      else states.push_back(n);
+      states.insert(states.end(),mBlocks.E.begin()+mBlocks.F[b],mBlocks.E.begin()+mBlocks.F[b]+m);
+    }
+    bbegin.push_back((Idx) states.size());
+    mBlocks.Unmark();
+    mAffected.clear();
+    // compute signatures, data-parallel per chunk of positions
+    mSigBegin.resize(states.size());
+    mSigEnd.resize(states.size());
+    mSigHash.resize(states.size());
+    std::size_t tasks=(states.size()+ctx.mChunk-1)/ctx.mChunk;
+    ctx.mPhase=2;
+    if(ctx.mSigs.size()<tasks) ctx.mSigs.resize(tasks);
+    RunTasks(threads,tasks,&SignatureRefinement::Task,&ctx);
+    // concatenate signatures
+    mSigBuffer.clear();
+    for(std::size_t t=0; t<tasks; ++t) {
+      Idx offset=(Idx) mSigBuffer.size();
+      mSigBuffer.insert(mSigBuffer.end(),ctx.mSigs[t].begin(),ctx.mSigs[t].end());
+      std::size_t pend=std::min(states.size(),(t+1)*ctx.mChunk);
+      for(std::size_t p=t*ctx.mChunk; p<pend; ++p) {
+        mSigBegin[p]+=offset;
+        mSigEnd[p]+=offset;
+      }
+    }
+    LoopCallback();
+    // sort affected states per block, data-parallel per block or chunk of large block
+    order.resize(states.size());
+    ctx.mRanges.clear();
+    merges.clear();
+    for(std::size_t k=0; k<blocks.size(); ++k) {
+      Idx pbeg=bbegin[k]+1;
+      Idx pend=bbegin[k+1];
+      for(Idx p=pbeg; p<pend; ++p) order[p]=p;
+      if(pend-pbeg<2) continue;
+      if((threads>1) && (pend-pbeg >= 2*ctx.mChunk)) {
+        Idx csize= std::max((Idx) ctx.mChunk, (Idx) ((pend-pbeg+threads-1)/threads));
+        for(Idx p=pbeg; p<pend; p+=csize) {
+          ctx.mRanges.push_back(std::pair<Idx,Idx>(p,std::min(pend,p+csize)));
+          if(p==pbeg) continue;
+          sr_merge merge;
+          merge.first=pbeg;
+          merge.middle=p;
+          merge.last=std::min(pend,p+csize);
+          merges.push_back(merge);
+        }
+        continue;
+      }
+      ctx.mRanges.push_back(std::pair<Idx,Idx>(pbeg,pend));
+    }
+    ctx.mPhase=3;
+    RunTasks(threads,ctx.mRanges.size(),&SignatureRefinement::Task,&ctx);
+    for(std::size_t k=0; k<merges.size(); ++k) 
+      std::inplace_merge(order.begin()+merges[k].first,order.begin()+merges[k].middle,order.begin()+merges[k].last,sorder);
+    // split classes
+    moved.clear();
+    for(std::size_t k=0; k<blocks.size(); ++k) {
+      Idx rep=bbegin[k];
+      bool hasrep= states[rep]<n;
+      Idx pbeg=rep+1;
+      Idx pend=bbegin[k+1];
+      // figure runs of equal signature and the run to remain
+      Idx rbeg=pend;
+      if(!hasrep) {
+        Idx max=0;
+        Idx i=pbeg;
+        while(i<pend) {
+          Idx j=i+1;
+          while(j<pend && sorder.Equal(order[i],order[j])) ++j;
+          if(j-i>max) { max=j-i; rbeg=i;}
+          i=j;
+        }
+        // all equal: no split
+        if(max==pend-pbeg) continue;
+      }
+      // split off all other runs
+      Idx i=pbeg;
+      while(i<pend) {
+        Idx j=i+1;
+        while(j<pend && sorder.Equal(order[i],order[j])) ++j;
+        bool remain=false;
+        if(hasrep) remain=sorder.Equal(order[i],rep);
+        else remain=(i==rbeg);
+        if(!remain) {
+          for(Idx l=i; l<j; ++l) mBlocks.Mark(states[order[l]]);
+          mBlocks.Split(&moved);
+        }
+        i=j;
+      }
+    }
+    // predecessors of moved states are affected
+    for(std::size_t k=0; k<moved.size(); ++k) {
+      Idx x=moved[k];
+      for(Idx i=mPreBegin[x]; i<mPreBegin[x+1]; ++i) {
+        Idx q=mPre[i];
+        if(mAffectedFlags[q]) continue;
+        mAffectedFlags[q]=true;
+        mAffected.push_back(q);
+      }
+    }
+  }
+  FD_DF("SignatureRefinement::Refine(): done: classes #" << mBlocks.z);
+}
+
+// result as map
+void SignatureRefinement::Classes(std::map<Idx,Idx>& rMap) const {
+  rMap.clear();
+  Idx n=(Idx) mStates.size();
+  std::vector<Idx> cmap(mBlocks.z,0);
+  Idx ccnt=0;
+  for(Idx q=0; q<n; ++q) {
+    Idx& c=cmap[mBlocks.S[q]];
+    if(c==0) c=++ccnt;
+    rMap.insert(rMap.end(),std::pair<Idx,Idx>(mStates[q],c));
+  }
+}
+
+// result as list of sets
+void SignatureRefinement::Classes(std::list<StateSet>& rClasses) const {
+  rClasses.clear();
+  Idx n=(Idx) mStates.size();
+  std::vector<bool> done(mBlocks.z,false);
+  std::vector<Idx> members;
+  for(Idx q=0; q<n; ++q) {
+    Idx b=mBlocks.S[q];
+    if(done[b]) continue;
+    done[b]=true;
+    if(mBlocks.Size(b)<2) continue;
+    members.assign(mBlocks.E.begin()+mBlocks.F[b],mBlocks.E.begin()+mBlocks.P[b]);
+    std::sort(members.begin(),members.end());
+    rClasses.push_back(StateSet());
+    StateSet& cls=rClasses.back();
+    for(std::size_t k=0; k<members.size(); ++k) cls.Insert(mStates[members[k]]);
+  }
+}
+
+// quotient automaton
+void SignatureRefinement::Quotient(const vGenerator& rGen, std::map<Idx,Idx>& rMap, vGenerator& rQuotient) const {
+  FD_DF("SignatureRefinement::Quotient(): " << rGen.Name());
+  Classes(rMap);
+  rQuotient.Clear();
+  Idx n=(Idx) mStates.size();
+  // states in order of classes
+  std::vector<Idx> cmap(mBlocks.z,0);
+  std::vector<Idx> members;
+  for(Idx q=0; q<n; ++q) {
+    Idx b=mBlocks.S[q];
+    if(cmap[b]!=0) continue;
+    Idx newstate=rQuotient.InsState();
+    cmap[b]=newstate;
+    members.assign(mBlocks.E.begin()+mBlocks.F[b],mBlocks.E.begin()+mBlocks.P[b]);
+    std::sort(members.begin(),members.end());
+    std::ostringstream ostr;
+    for(std::size_t k=0; k<members.size(); ++k) {
+      Idx st=mStates[members[k]];
+      if(rQuotient.StateNamesEnabled()) {
+        if(rGen.StateName(st)!="") ostr << rGen.StateName(st) << ",";
+        else ostr << st << ",";
+      }
+      if(rGen.ExistsInitState(st)) rQuotient.SetInitState(newstate);
+      if(rGen.ExistsMarkedState(st)) rQuotient.SetMarkedState(newstate);
+    }
+    if(rQuotient.StateNamesEnabled()) {
+      std::string statename = ostr.str();
+      if(statename.length()>=1) statename.erase(statename.length()-1);
+      statename = "{" + statename + "}";
+      rQuotient.StateName(newstate, statename);
+    }
+  }
+  // transitions
+  TransSet::Iterator tit = rGen.TransRelBegin();
+  TransSet::Iterator tit_end = rGen.TransRelEnd();
+  for(; tit != tit_end; ++tit) {
+    rQuotient.InsEvent(tit->Ev);
+    rQuotient.SetTransition(cmap[mBlocks.S[StateIndex(tit->X1)]], tit->Ev, cmap[mBlocks.S[StateIndex(tit->X2)]]);
+  }
+}
+
+} // namespace faudes
@@ -0,0 +1,397 @@
+/** @file cfl_partition.h Partition refinement kernel */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#ifndef FAUDES_PARTITION_H
+#define FAUDES_PARTITION_H
+
+#include "cfl_definitions.h"
+#include "cfl_generator.h"
+#include "cfl_compiledgen.h"
+
+#include <vector>
+#include <list>
+#include <map>
+#include <stdint.h>
+
+namespace faudes {
+
+/**
+ * Refinable partition.
+ *
+ * Partition of the elements 0 ... n-1 as proposed by A. Valmari and P. Lehtinen,
+ * "Efficient minimization of DFAs with partial transition functions", 2008.
+ * Elements are stored in one array such that each set occupies a consecutive segment.
+ * Marking an element swaps it to the front of its segment and counts the marked
+ * elements per set. Splitting then separates the marked from the unmarked part in time
+ * proportional to the smaller part, which becomes a new set.
+ *
+ * The marker counts and the list of sets with marked elements may be shared among
+ * several partitions, provided that at most one partition has marked elements at any
+ * time; see Init(). All members are public and meant to be accessed by algorithms directly.
+ *
+ * @ingroup GeneratorClasses
+ */
+class FAUDES_API RefinablePartition {
+public:
+  /** Number of sets */
+  Idx z;
+  /** Elements ordered by set */
+  std::vector<Idx> E;
+  /** Location of element in E */
+  std::vector<Idx> L;
+  /** Set of element */
+  std::vector<Idx> S;
+  /** First location of set in E */
+  std::vector<Idx> F;
+  /** Past-the-end location of set in E */
+  std::vector<Idx> P;
+  /** Marked elements per set (shared) */
+  std::vector<Idx>* pM;
+  /** Sets with marked elements (shared) */
+  std::vector<Idx>* pW;
+
+  /** Construct empty partition with own marker buffers */
+  RefinablePartition(void) : z(0), pM(&mM), pW(&mW) {};
+
+  /** Copy constructor, own marker buffers remain own buffers */
+  RefinablePartition(const RefinablePartition& rOther) :
+    z(rOther.z), E(rOther.E), L(rOther.L), S(rOther.S), F(rOther.F), P(rOther.P),
+    pM(rOther.pM), pW(rOther.pW), mM(rOther.mM), mW(rOther.mW)
+  {
+    if(rOther.pM==&rOther.mM) pM=&mM;
+    if(rOther.pW==&rOther.mW) pW=&mW;
+  };
+
+  /** Assignment operator, own marker buffers remain own buffers */
+  RefinablePartition& operator=(const RefinablePartition& rOther) {
+    if(this==&rOther) return *this;
+    z=rOther.z; E=rOther.E; L=rOther.L; S=rOther.S; F=rOther.F; P=rOther.P;
+    mM=rOther.mM; mW=rOther.mW;
+    pM= (rOther.pM==&rOther.mM ? &mM : rOther.pM);
+    pW= (rOther.pW==&rOther.mW ? &mW : rOther.pW);
+    return *this;
+  };
+
+  /** Initialize with all n elements in one set, using own marker buffers */
+  void Init(Idx n) {
+    mM.assign(n+1,0); mW.clear();
+    Init(n,mM,mW);
+  }
+
+  /** Initialize with all n elements in one set, using shared marker buffers of size n+1 */
+  void Init(Idx n, std::vector<Idx>& rM, std::vector<Idx>& rW) {
+    pM=&rM;
+    pW=&rW;
+    z= (n>0 ? 1 : 0);
+    E.resize(n); L.resize(n); S.assign(n,0);
+    F.resize(n+1); P.resize(n+1);
+    for(Idx i=0; i<n; ++i) E[i]=L[i]=i;
+    F[0]=0;
+    P[0]=n;
+  }
+
+  /** Number of elements in set s */
+  Idx Size(Idx s) const { return P[s]-F[s]; };
+
+  /** Mark element e */
+  void Mark(Idx e) { Mark(e,*pW); };
+
+  /** Mark element e, record its set in rW when it is the first marked element (threads may mark concurrently in disjoint sets); marking a marked element has no effect */
+  void Mark(Idx e, std::vector<Idx>& rW) {
+    std::vector<Idx>& M=*pM;
+    Idx s=S[e];
+    Idx i=L[e];
+    Idx j=F[s]+M[s];
+    if(i < j) return;
+    E[i]=E[j]; L[E[i]]=i;
+    E[j]=e; L[e]=j;
+    if(M[s]++==0) rW.push_back(s);
+  }
+
+  /** Test whether element e is marked */
+  bool Marked(Idx e) const { return L[e] < F[S[e]]+(*pM)[S[e]]; };
+
+  /** Number of marked elements in set s; marked elements are located at F[s] onwards */
+  Idx MarkedSize(Idx s) const { return (*pM)[s]; };
+
+  /** Unmark all elements without splitting */
+  void Unmark(void) {
+    std::vector<Idx>& W=*pW;
+    for(std::size_t i=0; i<W.size(); ++i) (*pM)[W[i]]=0;
+    W.clear();
+  }
+
+  /**
+   * Split all sets with marked elements, the smaller part becomes a new set
+   *
+   * @param pMoved
+   *   If not NULL, elements that are assigned to a new set are appended
+   */
+  void Split(std::vector<Idx>* pMoved=0) {
+    std::vector<Idx>& M=*pM;
+    std::vector<Idx>& W=*pW;
+    while(!W.empty()) {
+      Idx s=W.back();
+      W.pop_back();
+      Idx j=F[s]+M[s];
+      // all elements marked: no split
+      if(j==P[s]) { M[s]=0; continue; }
+      // have the smaller part as new set z
+      if(M[s] <= P[s]-j) {
+        F[z]=F[s]; P[z]=F[s]=j;
+      } else {
+        P[z]=P[s]; F[z]=P[s]=j;
+      }
+      for(Idx i=F[z]; i<P[z]; ++i) S[E[i]]=z;
+      if(pMoved) pMoved->insert(pMoved->end(),E.begin()+F[z],E.begin()+P[z]);
+      M[s]=M[z]=0;
+      ++z;
+    }
+  }
+
+private:
+  /** Own marker buffers */
+  std::vector<Idx> mM;
+  std::vector<Idx> mW;
+};
+
+
+/**
+ * Partition refinement by signatures.
+ *
+ * This class computes the coarsest partition of the state set of a generator that refines
+ * a given initial partition such that equivalent states have the same signature. The
+ * signature of a state is derived from the classes of its successors. With the default
+ * signature, i.e., the set of pairs of event and successor class, the result is the
+ * coarsest bisimulation. Other equivalences are obtained by either a saturated transition
+ * relation (delayed or weak bisimulation, see Saturate()) or by overriding Signature() in
+ * a derived class.
+ *
+ * The implementation uses a RefinablePartition for the current classes and tracks
+ * which states may have changed their signature, i.e., signatures are only re-evaluated
+ * for predecessors of states that have been moved to a new class. Since the larger part
+ * of a split class keeps its index, each state is moved at most log(n) times. States
+ * are re-indexed to consecutive integers 0 ... n-1 in the order of their original indices,
+ * and the transition relation is stored in compressed-sparse-row format.
+ *
+ * Typical use:
+ * @code
+ * SignatureRefinement ref;
+ * ref.Compile(gen);              // transition structure
+ * ref.Saturate(silent,2);        // optional: observation equivalence
+ * ref.PrePartition(gen.MarkedStates()); // optional: initial partition
+ * ref.Refine();                  // run fixpoint iteration
+ * ref.Classes(eqclasses);        // retrieve non-trivial classes
+ * @endcode
+ *
+ * @ingroup GeneratorClasses
+ */
+class FAUDES_API SignatureRefinement {
+
+public:
+
+  /** Edge record, see also CompiledGenerator::Edge */
+  typedef CompiledGenerator::Edge Edge;
+
+  /** Construct empty */
+  SignatureRefinement(void);
+
+  /** Destruct */
+  virtual ~SignatureRefinement(void);
+
+  /**
+   * Set up from generator.
+   *
+   * Records all states and transitions of the specified generator and initialises
+   * the partition to consist of one class.
+   *
+   * @param rGen
+   *   Generator to operate on
+   */
+  void Compile(const vGenerator& rGen);
+
+  /**
+   * Saturate transition relation w.r.t. silent events.
+   *
+   * With mode 1, a transition x -e-> y is inserted whenever there is a path x -s e-> y
+   * where s is a (possibly empty) sequence of silent events (delayed bisimulation).
+   * With mode 2, we insert x -e-> y whenever there is a path x -s e t-> y where s
+   * and t are sequences of silent events (weak bisimulation or observation equivalence).
+   * This complies with ExtendTransRel(Generator&, const EventSet&, const Idx&).
+   *
+   * @param rSilent
+   *   Silent events
+   * @param mode
+   *   1 for delayed, 2 for weak bisimulation
+   * @param selfloops
+   *   Install a selfloop in every state for every silent event
+   */
+  void Saturate(const EventSet& rSilent, int mode, bool selfloops=true);
+
+  /**
+   * Refine current partition by a state set.
+   * Any class that contains states within as well as outside the specified set is split.
+   *
+   * @param rStates
+   *   States to separate, original indices
+   */
+  void PrePartition(const StateSet& rStates);
+
+  /**
+   * Refine current partition by a family of state sets.
+   * Each state must be contained in one set.
+   *
+   * @param rPrePartition
+   *   Vector of state sets, original indices
+   *
+   * @exception Exception
+   *   Invalid prepartition (id 100)
+   */
+  void PrePartition(const std::vector<StateSet>& rPrePartition);
+
+  /** Run partition refinement until all classes are stable */
+  void Refine(void);
+
+  /**
+   * Set number of worker threads.
+   *
+   * When libFAUDES is configured with the option core_threads, Saturate() and Refine()
+   * operate data-parallel across states, provided that sufficiently many states are
+   * involved. Signatures are computed concurrently and classes are split by sorting
+   * signatures w.r.t. their hash value. The result does not depend on the number of threads.
+   * Workers are organised by RunTasks(), i.e., they operate in the context of the caller
+   * and exceptions, e.g. on cancellation, are passed on to the caller.
+   * The default is taken from the current Context when the refinement is constructed, see
+   * Context::Threads(). Thus, the thread count of ComputeBisimulation(), ComputeBisimulationCTA(),
+   * ComputeWeakBisimulationCTA() and ComputeDelayedBisimulationCTA() is set by the context.
+   *
+   * @param n
+   *   Number of threads; 0 for the number of available processors,
+   *   1 for sequential operation
+   */
+  void Threads(Idx n) { mThreads=n; };
+
+  /** Get number of worker threads, see Threads(Idx) */
+  Idx Threads(void) const { return mThreads; };
+
+  /** Number of states */
+  Idx Size(void) const { return (Idx) mStates.size(); };
+
+  /** Number of classes */
+  Idx ClassCount(void) const { return mBlocks.z; };
+
+  /**
+   * Retrieve result as a map from original state index to class index.
+   * Classes are numbered consecutively starting with 1, in the order of their least state.
+   *
+   * @param rMap
+   *   Result map
+   */
+  void Classes(std::map<Idx,Idx>& rMap) const;
+
+  /**
+   * Retrieve result as a list of non-trivial classes, ordered by least state.
+   *
+   * @param rClasses
+   *   Result list, singleton classes are not reported
+   */
+  void Classes(std::list<StateSet>& rClasses) const;
+
+  /**
+   * Construct quotient automaton. States correspond to classes and are numbered
+   * as with Classes(std::map<Idx,Idx>&); transitions, initial and marked states are
+   * mapped from the original generator. State names list the original states.
+   *
+   * @param rGen
+   *   Original generator, i.e., the argument of Compile()
+   * @param rMap
+   *   Result map from original states to classes
+   * @param rQuotient
+   *   Result quotient automaton
+   */
+  void Quotient(const vGenerator& rGen, std::map<Idx,Idx>& rMap, vGenerator& rQuotient) const;
+
+protected:
+
+  /**
+   * Compute the signature of a state w.r.t. the current partition.
+   * The default implementation reports the sorted set of pairs of event and class of successor
+   * state, encoded as (ev<<32 | class). Derived classes may implement other equivalences;
+   * the signature must not depend on anything but the classes of successor states w.r.t.
+   * the recorded transition relation. The function may be called concurrently from
+   * several threads and must not modify any data.
+   *
+   * @param q
+   *   State (internal index)
+   * @param rSig
+   *   Result signature (appended)
+   */
+  virtual void Signature(Idx q, std::vector<uint64_t>& rSig) const;
+
+  /** Recompute predecessor lists after modification of the successor relation */
+  void CompilePredecessors(void);
+
+  /** Original state index by internal index */
+  std::vector<Idx> mStates;
+
+  /** Original event index by internal index [starting with 1] */
+  std::vector<Idx> mEvents;
+
+  /** Successor relation in CSR format, sorted by event and successor */
+  std::vector<Idx> mSucBegin;
+  std::vector<Edge> mSuc;
+
+  /** Predecessors in CSR format (events neglected, no duplicates) */
+  std::vector<Idx> mPreBegin;
+  std::vector<Idx> mPre;
+
+  /** Current partition */
+  RefinablePartition mBlocks;
+
+  /** Internal index of original state (binary search) */
+  Idx StateIndex(Idx x) const;
+
+  /** Refinement: states that may have changed their signature */
+  std::vector<Idx> mAffected;
+  std::vector<bool> mAffectedFlags;
+
+  /** Refinement: signatures of current round */
+  std::vector<uint64_t> mSigBuffer;
+  std::vector<Idx> mSigBegin;
+  std::vector<Idx> mSigEnd;
+  std::vector<uint64_t> mSigHash;
+
+  /** Number of worker threads */
+  Idx mThreads;
+
+private:
+
+  /** Worker task for data-parallel phases (thread function) */
+  static void Task(void* pContext, std::size_t worker, std::size_t task);
+
+};
+
+
+
+} // namespace faudes
+
+#endif
@@ -405,7 +405,11 @@ void faudes_thread_exit(void* res) {
   pthread_exit(res);
 }
 int faudes_thread_join(faudes_thread_t thr, void **res) {
-  return pthread_join(thr, res) == 0 ? FAUDES_THREAD_ERROR : FAUDES_THREAD_SUCCESS;
+  return pthread_join(thr, res) == 0 ? FAUDES_THREAD_SUCCESS : FAUDES_THREAD_ERROR;
+}
+int faudes_thread_concurrency(void) {
+  long n=sysconf(_SC_NPROCESSORS_ONLN);
+  return n>0 ? (int) n : 1;
 }
 #endif
 #endif // POSIX threads
@@ -503,6 +507,13 @@ int faudes_thread_join(faudes_thread_t thr, void **res) {
   return FAUDES_THREAD_SUCCESS;
 }
 
+// Number of processors available
+int faudes_thread_concurrency(void) {
+  SYSTEM_INFO sysinfo;
+  GetSystemInfo(&sysinfo);
+  return sysinfo.dwNumberOfProcessors>0 ? (int) sysinfo.dwNumberOfProcessors : 1;
+}
+
 #endif
 #endif // Windows threads
 
@@ -567,7 +578,7 @@ int faudes_cond_signal(faudes_cond_t *cond){
   return pthread_cond_signal(cond) == 0 ? FAUDES_THREAD_SUCCESS : FAUDES_THREAD_ERROR;
 }
 int faudes_cond_broadcast(faudes_cond_t *cond) {
-  return pthread_cond_signal(cond) == 0 ? FAUDES_THREAD_SUCCESS : FAUDES_THREAD_ERROR;
+  return pthread_cond_broadcast(cond) == 0 ? FAUDES_THREAD_SUCCESS : FAUDES_THREAD_ERROR;
 }
 int faudes_cond_wait(faudes_cond_t *cond, faudes_mutex_t *mtx) {
   return pthread_cond_wait(cond, mtx) == 0 ? FAUDES_THREAD_SUCCESS : FAUDES_THREAD_ERROR;
@@ -330,6 +330,7 @@ extern FAUDES_API int faudes_thread_detach(faudes_thread_t thr);
 extern FAUDES_API int faudes_thread_equal(faudes_thread_t thr0, faudes_thread_t thr1);
 extern FAUDES_API void faudes_thread_exit(void* res);
 extern int faudes_thread_join(faudes_thread_t thr, void **res);
+extern FAUDES_API int faudes_thread_concurrency(void);
 
 // Mutex data type (use plain POSIX mutex)
 #ifdef FAUDES_POSIX
@@ -55,6 +55,9 @@ void ProjectNonDet_opitz(Generator& rGen, const EventSet& rProjectAlphabet) {
   TransSet::Iterator tit_end;
 
   // ALGORITHM:
+
+  rGen.TransRel().Detach();
+
   // initialize algorithm by pushing init states on todo stack
   for (lit = rGen.InitStatesBegin(); lit != rGen.InitStatesEnd(); ++lit) {
     FD_DF("ProjectNonDet: todo add: " << rGen.SStr(*lit));
@@ -141,6 +144,8 @@ void ProjectNonDet_ref(Generator& rGen, const EventSet& rProjectAlphabet) {
 
   // ALGORITHM:
 
+  rGen.TransRel().Detach();
+
   // initialize todo stack by adding init states to todo 
   for(sit=rGen.InitStatesBegin(); sit!=rGen.InitStatesEnd(); ++sit) {
     todod.push(*sit);
@@ -148,11 +153,13 @@ void ProjectNonDet_ref(Generator& rGen, const EventSet& rProjectAlphabet) {
   }
     
   // process main todo stack
+  Idx lcnt=0;
   while(!todod.empty()) {
 
     // loop callback
     FD_WPC(doned.Size() - todod.size(), rGen.Size(), "ProjectNonDet() [STD]: done/size: " 
 	   <<  doned.Size() - todod.size() << " / " << rGen.Size());
+    FD_LOOP(lcnt,0);
 
     // get top of the stack
     currentstate = todod.top();
@@ -432,6 +439,7 @@ struct TGraph<Idx,Idx> : std::map< Idx , TNode< Idx , Idx > >{
   }
   // conversion from generator interface (destructive)
   void Import(vGenerator& rGen) {
+    rGen.TransRel().Detach();
     TransSet::Iterator tit = rGen.TransRelBegin();
     TransSet::Iterator tit_end = rGen.TransRelEnd();  
     for(; tit != tit_end; rGen.ClrTransition(tit++)) {
@@ -515,11 +523,13 @@ void ProjectNonDet_graph(Generator& rGen, const EventSet& rProjectAlphabet) {
   }
     
   // process main todo stack
+  Idx lcnt=0;
   while(!todod.empty()) {
 
     // loop callback
     FD_WPC(doned.Size() - todod.size(),trg.size(), "ProjectNonDet() [G1]: done/size: " 
 	   <<  doned.Size() - todod.size() << "/" << trg.size());
+    FD_LOOP(lcnt,0);
 
     // get top of the stack
     currentstate = todod.top();
@@ -613,6 +623,8 @@ void ProjectNonDet_simple(Generator& rGen, const EventSet& rProjectAlphabet) {
 
   // ALGORITHM:
 
+  rGen.TransRel().Detach();
+
   // initialize todo stack by adding init states to todo 
   for(sit=rGen.InitStatesBegin(); sit!=rGen.InitStatesEnd(); ++sit) {
     todod.push(*sit);
@@ -620,11 +632,13 @@ void ProjectNonDet_simple(Generator& rGen, const EventSet& rProjectAlphabet) {
   }
     
   // process main todo stack
+  Idx lcnt=0;
   while(!todod.empty()) {
 
     // loop callback
     FD_WPC(doned.Size(),rGen.Size(), "ProjectNonDet() [SIMPL]: current/size: " 
       <<  doned.Size() << " / " << rGen.Size());
+    FD_LOOP(lcnt,0);
 
     // get top of the stack
     currentstate = todod.top();
@@ -695,6 +709,8 @@ void ProjectNonDet_barthel(Generator& rGen, const EventSet& rProjectAlphabet) {
 
   // ALGORITHM:
 
+  rGen.TransRel().Detach();
+
   // set all locally reachable states to init states
   // tmoor 201403: is this needed to prevent the initial state to disappear?
   reachext.Clear();
@@ -818,6 +834,7 @@ void ProjectNonDet_fbr(Generator& rGen, const EventSet& rProjectAlphabet) {
   std::string name=CollapsString("ProjectNonDet(" + rGen.Name() + ")");
 
   // removing silent selfloops (to avoid trivial sccs and special cases in their treatment)
+  rGen.TransRel().Detach();
   FD_WPD(0,1, "ProjectNonDet() [FB-REACH]: remove silent selfloops");
   tit=rGen.TransRelBegin(); 
   tit_end=rGen.TransRelEnd(); 
@@ -1073,6 +1090,7 @@ void ProjectNonDet_scc(Generator& rGen, const EventSet& rProjectAlphabet) {
   std::string name=CollapsString("ProjectNonDet(" + rGen.Name() + ")");
 
   // removing silent selfloops (to avoid trivial sccs and special cases in their treatment)
+  rGen.TransRel().Detach();
   FD_WPD(0,1, "ProjectNonDet() [SCC]: remove silent selfloops");
   tit=rGen.TransRelBegin(); 
   tit_end=rGen.TransRelEnd(); 
@@ -1475,6 +1493,21 @@ void Project(const Generator& rGen, const EventSet& rProjectAlphabet,
 }
 
 
+// ProjectClosure(rGen, rProjectAlphabet, rResGen&)
+void ProjectClosure(const Generator& rGen, const EventSet& rProjectAlphabet, Generator& rResGen) {
+  FD_DF("ProjectClosure(...): #" << rGen.TransRelSize());
+  // hide all events not to project on
+  EventSet hidden = rGen.Alphabet() - rProjectAlphabet;
+  SubsetConstruction subcon;
+  subcon.Hide(hidden);
+  // run closure based subset construction 
+  subcon.Compute(rGen, rResGen);
+  // set name
+  rResGen.Name("Project("+CollapsString(rGen.Name()+")")); 
+  FD_DF("ProjectClosure(...): done #" << rResGen.TransRelSize() << " power states #" << subcon.Size());
+}
+
+
 // InvProject(rGen&, rProjectAlphabet)
 void InvProject(Generator& rGen, const EventSet& rProjectAlphabet) {
   // test if the alphabet of the generator is included in the given alphabet
@@ -112,6 +112,29 @@ extern FAUDES_API void ProjectNonDetScc(Generator& rGen, const EventSet& rProjec
  */
 extern FAUDES_API void Project(const Generator& rGen, const EventSet& rProjectAlphabet, Generator& rResGen);
 
+/**
+ * Deterministic projection by on-the-fly closure.
+ *
+ * Computes a deterministic realisation of the projected languages, however,
+ * without first constructing the non-deterministic projection. Instead, the subset
+ * construction is run on the argument with all events outside the projection
+ * alphabet hidden, i.e., each power state is closed w.r.t. hidden transitions when
+ * discovered; see also SubsetConstruction. This is the preferred variant for large
+ * generators with many hidden transitions, since it only stores the power states
+ * that are actually reached. The result is language equivalent to Project(), but
+ * state indices differ and no state minimisation is applied.
+ *
+ * @param rGen
+ *   Reference to generator
+ * @param rProjectAlphabet
+ *   Projection alphabet
+ * @param rResGen
+ *   Reference to resulting deterministic generator
+ *
+ * @ingroup GeneratorFunctions
+ */
+extern FAUDES_API void ProjectClosure(const Generator& rGen, const EventSet& rProjectAlphabet, Generator& rResGen);
+
 /**
  * Deterministic projection. 
  *
@@ -33,6 +33,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
   
 #include "cfl_regular.h"
 #include "cfl_determin.h"
+#include "cfl_compiledgen.h"
 
 
 /* turn on debugging for this file */
@@ -216,10 +217,14 @@ void LanguageIntersection(const GeneratorVector& rGenVec, Generator& rResGen)
     return;
   }
 
-  // run product on others
-  LanguageIntersection(rGenVec.At(0),rGenVec.At(1),rResGen);
-  for(GeneratorVector::Position i=2; i<rGenVec.Size(); i++) 
-    LanguageIntersection(rGenVec.At(i),rResGen,rResGen);
+  // record names
+  std::string name=rGenVec.At(0).Name();
+  for(GeneratorVector::Position i=1; i<rGenVec.Size(); i++) 
+    name+=","+rGenVec.At(i).Name();
+
+  // the n-ary product implements the language intersection
+  Product(rGenVec,rResGen);
+  rResGen.Name(CollapsString("Intersection("+name+")"));
 }
 
 
@@ -1017,15 +1022,143 @@ bool IsNonblocking(const Generator& rGen) {
 
 // IsNonblocking 
 bool IsNonblocking(const Generator& rGen1, const Generator& rGen2) {
-  
-  // build composition
-  Generator parallel;
-  parallel.StateNamesEnabled(false);
-  Parallel(rGen1,rGen2,parallel);
+  FD_DF("IsNonblocking(" << rGen1.Name() << "," << rGen2.Name() << ")");
+
+  // compile arguments
+  CompiledGenerator gen1(rGen1,false);
+  CompiledGenerator gen2(rGen2,false);
+  // shared events: map rGen1 to rGen2 events, 0 if not shared
+  std::vector<Idx> ev1to2(gen1.AlphabetSize()+1,0);
+  for(Idx e1=1; e1<=gen1.AlphabetSize(); ++e1)
+    ev1to2[e1]=gen2.EventIndex(gen1.Event(e1));
+  std::vector<bool> shared2(gen2.AlphabetSize()+1,false);
+  for(Idx e2=1; e2<=gen2.AlphabetSize(); ++e2)
+    shared2[e2]= gen1.EventIndex(gen2.Event(e2))!=0;
+
+  // composition states, indexed in order of discovery
+  CompositionHashMap cmap;
+  cmap.Reserve(gen1.Size(),gen2.Size());
+  // compact edge store: successors per composition state
+  std::vector<Idx> succ;
+  std::vector<Idx> sbegin(1,0);
+  std::vector<Idx> send(1,0);
+  // marked composition states
+  std::vector<Idx> marked;
+  // todo stack
+  std::stack<Idx> todo;
+
+  // all combinations of initial states
+  const std::vector<Idx>& init1=gen1.InitStates();
+  const std::vector<Idx>& init2=gen2.InitStates();
+  for(std::size_t i1=0; i1<init1.size(); ++i1) {
+    for(std::size_t i2=0; i2<init2.size(); ++i2) {
+      Idx x12=cmap.Size()+1;
+      cmap.Insert(init1[i1],init2[i2],x12);
+      todo.push(x12);
+    }
+  }
+
+  // forward search, record successors
+  CompiledGenerator::Iterator eit1, eit1_end, eit2, eit2_end;
+  Idx lcnt=0;
+  while(!todo.empty()) {
+    FD_WPC(cmap.Size()-todo.size(),cmap.Size(),"IsNonblocking(): forward search"); 
+    FD_LOOP(lcnt,cmap.Size());
+    Idx x12=todo.top();
+    todo.pop();
+    Idx x1=cmap.Entries()[x12-1].X1;
+    Idx x2=cmap.Entries()[x12-1].X2;
+    if(sbegin.size()<=x12) {
+      sbegin.resize(cmap.Size()+1,0);
+      send.resize(cmap.Size()+1,0);
+    }
+    sbegin[x12]= (Idx) succ.size();
+    // successors by rGen1 transitions, incl. shared events
+    eit1=gen1.SuccBegin(x1);
+    eit1_end=gen1.SuccEnd(x1);
+    for(;eit1!=eit1_end;++eit1) {
+      Idx e2=ev1to2[eit1->Ev];
+      if(e2==0) {
+        succ.push_back(eit1->X);
+        succ.push_back(x2);
+        continue;
+      }
+      eit2=gen2.SuccBegin(x2,e2);
+      eit2_end=gen2.SuccEnd(x2,e2);
+      for(;eit2!=eit2_end;++eit2) {
+        succ.push_back(eit1->X);
+        succ.push_back(eit2->X);
+      }
+    }
+    // successors by rGen2 transitions, excl. shared events
+    eit2=gen2.SuccBegin(x2);
+    eit2_end=gen2.SuccEnd(x2);
+    for(;eit2!=eit2_end;++eit2) {
+      if(shared2[eit2->Ev]) continue;
+      succ.push_back(x1);
+      succ.push_back(eit2->X);
+    }
+    // translate pairs to composition states
+    Idx pos=sbegin[x12];
+    for(Idx i=sbegin[x12]; i<succ.size(); i+=2) {
+      Idx y12=cmap.Find(succ[i],succ[i+1]);
+      if(y12==0) {
+        y12=cmap.Size()+1;
+        cmap.Insert(succ[i],succ[i+1],y12);
+        todo.push(y12);
+      }
+      succ[pos++]=y12;
+    }
+    succ.resize(pos);
+    send[x12]=pos;
+    // record marking
+    bool mark= gen1.MarkedState(x1) && gen2.MarkedState(x2);
+    if(mark) marked.push_back(x12);
+    // early exit: deadlock
+    if((!mark) && (sbegin[x12]==send[x12])) {
+      FD_DF("IsNonblocking(): deadlock at (" << gen1.State(x1) << "|" << gen2.State(x2) << ")");
+      return false;
+    }
+  }
 
-  // test (parallel returns an accessible generator).
-  return parallel.States() <= parallel.CoaccessibleSet();
+  // backward search from marked states on reverse edges
+  Idx n=cmap.Size();
+  FD_DF("IsNonblocking(): backward search on #" << n << " states");
+  sbegin.resize(n+1,0);
+  send.resize(n+1,0);
+  std::vector<Idx> pbegin(n+2,0);
+  for(Idx x12=1; x12<=n; ++x12)
+    for(Idx i=sbegin[x12]; i<send[x12]; ++i) 
+      pbegin[succ[i]+1]++;
+  for(Idx x12=1; x12<=n+1; ++x12) pbegin[x12]+=pbegin[x12-1];
+  std::vector<Idx> pred(succ.size());
+  std::vector<Idx> ppos(pbegin.begin(),pbegin.end());
+  for(Idx x12=1; x12<=n; ++x12)
+    for(Idx i=sbegin[x12]; i<send[x12]; ++i) 
+      pred[ppos[succ[i]]++]=x12;
+  std::vector<bool> coacc(n+1,false);
+  Idx count=0;
+  std::vector<Idx> stack;
+  for(std::size_t i=0; i<marked.size(); ++i) {
+    coacc[marked[i]]=true;
+    stack.push_back(marked[i]);
+    ++count;
+  }
+  while(!stack.empty()) {
+    FD_LOOP(lcnt,cmap.Size());
+    Idx x12=stack.back();
+    stack.pop_back();
+    for(Idx i=pbegin[x12]; i<pbegin[x12+1]; ++i) {
+      Idx y12=pred[i];
+      if(coacc[y12]) continue;
+      coacc[y12]=true;
+      stack.push_back(y12);
+      ++count;
+    }
+  }
 
+  // test: all accessible states are coaccessible
+  return count==n;
 }
 
 
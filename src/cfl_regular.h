@@ -189,8 +189,8 @@ extern FAUDES_API void LanguageIntersection(const Generator& rGen1, const Genera
  * See also LanguageUnion(const Generator&, const Generator&, Generator&);
  * This version takes a vector of generators as argument to perform
  * the intersection for multiple languages. The implementation
- * calls the std intersection multiple times, future implementations may
- * do better.
+ * uses the n-ary product, see Product(const GeneratorVector&, Generator&),
+ * i.e., no intermediate results are computed.
  *
  * @param rGenVec
  *   Vector of input generators
@@ -873,10 +873,13 @@ extern FAUDES_API bool IsNonblocking(const Generator& rGen);
  * Two languages L1 and L2 are nonblocking, if
  * closure(L1 || L2) == closure(L1) || closure(L2).
  *
- * This function performs the parallel composition of the two
- * specified generators and tests it for nonblockingness. Provided
+ * This function tests the parallel composition of the two
+ * specified generators for nonblockingness. Provided
  * that both generators are trim, this is equivalent to the
- * respective marked languages being nonblocking.
+ * respective marked languages being nonblocking. The implementation
+ * explores the composition on-the-fly, i.e., without setting up
+ * the composed generator, and returns early when a reachable deadlock
+ * is encountered.
  *
  * The specified generators must be trim.
  *
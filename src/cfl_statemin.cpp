@@ -24,6 +24,11 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
 #include "cfl_statemin.h"
 #include "cfl_exception.h"
 #include "cfl_project.h"
+#include "cfl_compiledgen.h"
+#include "cfl_partition.h"
+#include "cfl_platform.h"
+#include "cfl_context.h"
+#include "cfl_tasks.h"
 
 #include <stack>
 
@@ -37,37 +42,105 @@ Part 1: Stages of Hopcroft algorithm wrapped in a class
 - invoke Partition() to construct quotient automaton
 
 [Code revision 201508, tmoor]
+[Code revision 2026: refinable partitions after Valmari/Lehtinen, see cfl_partition.h]
 *********************************************************
 */
 
+/*
+Multi-threaded marking: the elements to mark are binned by the owner of
+their set (set index modulo number of threads) and one task per owner, see
+RunTasks(), then marks the elements of the sets it owns. Since the sets occupy disjoint
+segments, no locking is required. The order of marking within each set does
+not depend on scheduling, and neither do the resulting blocks.
+*/
+
+#ifdef FAUDES_THREADS
+
+// min number of elements to mark to go multi-threaded
+#define FAUDES_STATEMIN_MTMIN 50000
+
+// shared data, one task per owner
+typedef struct {
+  RefinablePartition* pPart;                     // partition to mark in
+  const std::vector<Idx>* pMarks;                // elements to mark
+  std::vector< std::vector<Idx> > mBins;         // bins by task and owner
+  Idx mThreads;                                  // number of tasks
+  int mPhase;                                    // 1: binning, 2: marking
+  std::vector< std::vector<Idx> > mTouched;      // per task: sets with marked elements
+} hcmt_context;
+
+// task function
+static void hcmt_task(void* pData, std::size_t worker, std::size_t task) {
+  (void) worker;
+  hcmt_context* pCtx=(hcmt_context*) pData;
+  Idx T=pCtx->mThreads;
+  Idx w=(Idx) task;
+  std::vector< std::vector<Idx> >& bins=pCtx->mBins;
+  // phase 1: bin my slice of elements by owner
+  if(pCtx->mPhase==1) {
+    const std::vector<Idx>& marks=*pCtx->pMarks;
+    const std::vector<Idx>& S=pCtx->pPart->S;
+    std::size_t beg= (marks.size()*w)/T;
+    std::size_t end= (marks.size()*(w+1))/T;
+    for(std::size_t i=beg; i<end; ++i) 
+      bins[w*T+S[marks[i]]%T].push_back(marks[i]);
+  }
+  // phase 2: mark elements in the sets I own
+  if(pCtx->mPhase==2) {
+    for(Idx v=0; v<T; ++v) {
+      std::vector<Idx>& bin=bins[v*T+w];
+      for(std::size_t i=0; i<bin.size(); ++i) 
+        pCtx->pPart->Mark(bin[i],pCtx->mTouched[w]);
+      bin.clear();
+    }
+  }
+}
+
+// mark all specified elements
+static void hcmt_mark(RefinablePartition& rPart, const std::vector<Idx>& rMarks, Idx threads) {
+  hcmt_context ctx;
+  ctx.pPart=&rPart;
+  ctx.pMarks=&rMarks;
+  ctx.mBins.resize(threads*threads);
+  ctx.mThreads=threads;
+  ctx.mTouched.resize(threads);
+  ctx.mPhase=1;
+  RunTasks(threads,threads,&hcmt_task,&ctx);
+  ctx.mPhase=2;
+  RunTasks(threads,threads,&hcmt_task,&ctx);
+  // record sets with marked elements in task order
+  for(Idx w=0; w<threads; ++w) 
+    rPart.pW->insert(rPart.pW->end(),ctx.mTouched[w].begin(),ctx.mTouched[w].end());
+}
+
+#endif
+
+
+/**
+ * Hopcroft algorithm on refinable partitions of states and transitions.
+ *
+ * States are partitioned into blocks, transitions are partitioned into cords, i.e., 
+ * sets of transitions with the same event whose target states lie in the same block. 
+ * Each new cord is used to split blocks by the source states of its transitions 
+ * and each new block is used to split cords by the target states of its incoming 
+ * transitions. With the smaller part becoming the new set, the overall effort is 
+ * O(m log n) for m transitions and n states, even for partial transition functions.
+ */
 class Hopcroft {
 
 public:
 
   /**
-   * Internal representation of reverse transition relation with consecutive indexed states and events.
-   * Technically, re-indexing is equivalent to "pointers on original indicees" and
-   * buffers log-n searches for transitions
+   * Internal representation of the transition relation with consecutive indexed 
+   * states 0 ... n-1 (accessible states only) and transitions 0 ... m-1.
    */
-  struct State {
-    Idx idx;      // original state idx
-    std::vector< std::vector<Idx> > pre; // predecessors by event
-  };
-  std::vector<State> states;        // vector of all states [starting with 1 -- use min-index for debugging]
-  std::vector<Idx> events;          // vector of all events [starting with 1]
-
-  /**
-   * plain stl set debugging output
-   */
-  std::string setstr(const std::set<Idx>& sset) {
-     std::set<Idx>::const_iterator ssit;
-     std::stringstream str;
-     str << "{";
-     for(ssit = sset.begin(); ssit != sset.end(); ++ssit) 
-       str << " " << *ssit;
-     str << " }";
-     return str.str();
-  }
+  std::vector<Idx> idx;             // original state index by internal state 
+  std::vector<Idx> tail;            // source state by transition
+  std::vector<Idx> head;            // target state by transition
+  std::vector<Idx> label;           // event by transition (compiled index)
+  std::vector<bool> marked;         // marked flag by internal state 
+  std::vector<bool> init;           // initial flag by internal state 
+  std::vector<Idx> events;          // original event index by compiled index [starting with 1]
 
   /**
    * plain stl vec debugging output
@@ -83,7 +156,7 @@ public:
   }
   
   /**
-   * Hopcroft algorithm data structure: vector of blocks
+   * Result: vector of blocks, each a sorted vector of internal states
    * [revision 201508 tmoor: use plain stl vectors and maintain sorting manually]
    */
   std::vector< std::vector<Idx> > blocks;
@@ -109,33 +182,43 @@ public:
     //keep ref
     gen=&rGen;
 
+    // compile forward relation (consecutive states and events)
+    CompiledGenerator cgen(rGen,false);
+    std::vector<bool> acc;
+    cgen.Accessible(acc);
+    events.resize(cgen.AlphabetSize()+1);
+    for(Idx e=1; e<events.size(); ++e)
+      events[e]=cgen.Event(e);
     // convert accessible part to internal data structure
-    StateSet acc = gen->AccessibleSet();
-    std::map<Idx,Idx> smap; // original->internal
-    std::map<Idx,Idx> emap; // original->internal
-    Idx max=0;
-    events.resize(gen->Alphabet().Size()+1);
-    EventSet::Iterator eit=gen->AlphabetBegin();
-    for(; eit != gen->AlphabetEnd(); ++eit) {
-      emap[*eit]=++max;
-      events[max]=*eit;
-    }
-    max=0;
-    states.resize(acc.Size()+1);
-    StateSet::Iterator sit=acc.Begin();
-    for(; sit != acc.End(); ++sit) {
-      smap[*sit]=++max;
-      states[max].idx=*sit;
-      states[max].pre.resize(events.size());
+    std::vector<Idx> smap(cgen.Size()+1,0); // compiled->internal
+    Idx n=0;
+    for(Idx q=1; q<=cgen.Size(); ++q)
+      if(acc[q]) smap[q]=n++;
+    idx.resize(n);
+    marked.resize(n);
+    init.resize(n);
+    for(Idx q=1; q<=cgen.Size(); ++q) {
+      if(!acc[q]) continue;
+      idx[smap[q]]=cgen.State(q);
+      marked[smap[q]]=cgen.MarkedState(q);
+      init[smap[q]]=cgen.InitState(q);
     }
-    TransSet::Iterator tit=gen->TransRelBegin();
-    for(; tit != gen->TransRelEnd(); ++tit) {
-      if(!acc.Exists(tit->X1)) continue;
-      if(!acc.Exists(tit->X2)) continue;
-      states[smap[tit->X2]].pre[emap[tit->Ev]].push_back(smap[tit->X1]);
+    // all transitions of accessible states are accessible
+    tail.reserve(cgen.TransRelSize());
+    head.reserve(cgen.TransRelSize());
+    label.reserve(cgen.TransRelSize());
+    for(Idx q=1; q<=cgen.Size(); ++q) {
+      if(!acc[q]) continue;
+      CompiledGenerator::Iterator eit=cgen.SuccBegin(q);
+      CompiledGenerator::Iterator eit_end=cgen.SuccEnd(q);
+      for(; eit != eit_end; ++eit) {
+        tail.push_back(smap[q]);
+        head.push_back(smap[eit->X]);
+        label.push_back(eit->Ev);
+      }
     }
 
-    FD_DF("Hopcroft::Initialize(): states #" << states.size()-1);
+    FD_DF("Hopcroft::Initialize(): states #" << idx.size() << " transitions #" << tail.size());
 
     //FAUDES_TIMER_LAP("reindexing: done");
 
@@ -155,112 +238,143 @@ public:
    */
   void Minimize(void) {
 
+    Idx n=(Idx) idx.size();
+    Idx m=(Idx) tail.size();
+
     // no accessible states: return no blocks 
-    if(states.size()-1 == 0) {
+    if(n == 0) {
       FD_DF("Hopcroft::Minimize(): generator size 0");
       return;
     }
  
     // one accessible state: return that one block
-    if(states.size()-1 == 1) {
+    if(n == 1) {
       FD_DF("Hopcroft::Minimize(): generator size 1");
-      std::vector<Idx>  b;
-      b.push_back(1);
-      blocks.push_back(b);
+      blocks.push_back(std::vector<Idx>(1,1));
       return;
     }
 
-    // loop variables
-    std::stack<Idx> active; // active blocks
-    std::vector<Idx>::iterator ssit;
-    std::vector<Idx>::iterator ssit_end;
-    std::vector<Idx> dp;
-    std::vector<Idx> dpp;
-    std::vector<Idx> c;
-      
-    // set up blocks B[0] and B[1] as Xm and X-Xm, resp.
-    // [revision tmoor 200909: prevent empty blocks]
-    std::vector<Idx> bm;
-    std::vector<Idx> bnm;
-    for(Idx q=1; q<states.size();++q) {
-      if(gen->ExistsMarkedState(states[q].idx)) bm.push_back(q);
-      else bnm.push_back(q);
+    // shared marker counts and touched sets
+    std::vector<Idx> M(std::max(n,m)+1,0);
+    std::vector<Idx> W;
+
+    // set up blocks as Xm and X-Xm
+    RefinablePartition B;
+    B.Init(n,M,W);
+    for(Idx q=0; q<n; ++q)
+      if(marked[q]) B.Mark(q);
+    B.Split();
+    FD_DF("Hopcroft::Minimize(): initial partition #" << B.z);
+
+    // set up cords by event (counting sort)
+    RefinablePartition C;
+    C.Init(m,M,W);
+    if(m>0) {
+      std::vector<Idx> cnt(events.size()+1,0);
+      for(Idx t=0; t<m; ++t) ++cnt[label[t]+1];
+      for(Idx e=1; e<cnt.size(); ++e) cnt[e]+=cnt[e-1];
+      C.z=0;
+      for(Idx e=1; e<events.size(); ++e) {
+        if(cnt[e]==cnt[e+1]) continue;
+        C.F[C.z]=cnt[e];
+        C.P[C.z]=cnt[e+1];
+        ++C.z;
+      }
+      // place transitions; the set index is derived from the event segment
+      std::vector<Idx> pos(cnt);
+      std::vector<Idx> cord(events.size(),0);
+      Idx c=0;
+      for(Idx e=1; e<events.size(); ++e) 
+        if(cnt[e]!=cnt[e+1]) cord[e]=c++;
+      for(Idx t=0; t<m; ++t) {
+        Idx i=pos[label[t]]++;
+        C.E[i]=t;
+        C.L[t]=i;
+        C.S[t]=cord[label[t]];
+      }
     }
-    if(bm.size()>0) {
-      blocks.push_back(std::vector<Idx>());
-      blocks.back().swap(bm);
-      active.push(blocks.size()-1);
-      FD_DF("Hopcroft::Minimize(): initial partition not-marked  #" << blocks.back().size());
+
+    // incoming transitions by target state (counting sort)
+    std::vector<Idx> inbeg(n+1,0);
+    std::vector<Idx> in(m);
+    for(Idx t=0; t<m; ++t) ++inbeg[head[t]+1];
+    for(Idx q=1; q<=n; ++q) inbeg[q]+=inbeg[q-1];
+    {
+      std::vector<Idx> pos(inbeg.begin(),inbeg.end()-1);
+      for(Idx t=0; t<m; ++t) in[pos[head[t]]++]=t;
     }
-    if(bnm.size()>0) {
-      blocks.push_back(std::vector<Idx>());
-      blocks.back().swap(bnm);
-      active.push(blocks.size()-1);
-      FD_DF("Hopcroft::Minimize(): initial partition not-marked  #" << blocks.back().size());
+
+    // figure number of threads for marking large splitters
+    Idx threads=1;
+#ifdef FAUDES_THREADS
+    threads=TaskThreads(Context::Current()->Threads(),64);
+    if(m < FAUDES_STATEMIN_MTMIN) threads=1;
+    std::vector<Idx> marks;
+#endif
+    FD_DF("Hopcroft::Minimize(): threads #" << threads);
+
+    // Hopcroft iteration: all cords are splitters initially; all blocks but the first 
+    // are splitters, since the cords initially represent the entire state set
+    Idx b=1;
+    Idx c=0;
+    Idx lcnt=0;
+    while(c < C.z) {
+      FD_WPC(c, C.z, "StateMin: cords/blocks:   " << C.z << " / " << B.z);
+      // split blocks by source states of cord c
+#ifdef FAUDES_THREADS
+      if((threads>1) && (C.Size(c) >= FAUDES_STATEMIN_MTMIN)) {
+        marks.clear();
+        for(Idx i=C.F[c]; i<C.P[c]; ++i) 
+          marks.push_back(tail[C.E[i]]);
+        hcmt_mark(B,marks,threads);
+        FD_LOOP(lcnt,0);
+      } else
+#endif
+      for(Idx i=C.F[c]; i<C.P[c]; ++i) {
+        B.Mark(tail[C.E[i]]);
+        FD_LOOP(lcnt,0);
+      }
+      B.Split(); 
+      ++c;
+      // split cords by all new blocks
+      for(; b < B.z; ++b) {
+#ifdef FAUDES_THREADS
+        if((threads>1) && (B.Size(b) >= FAUDES_STATEMIN_MTMIN/16)) {
+          marks.clear();
+          for(Idx i=B.F[b]; i<B.P[b]; ++i) {
+  	    Idx q=B.E[i];
+            marks.insert(marks.end(),in.begin()+inbeg[q],in.begin()+inbeg[q+1]);
+          }
+          if(marks.size() >= FAUDES_STATEMIN_MTMIN) {
+            hcmt_mark(C,marks,threads);
+          } else {
+            for(std::size_t i=0; i<marks.size(); ++i) C.Mark(marks[i]);
+          }
+          FD_LOOP(lcnt,0);
+          C.Split(); 
+          continue;
+        }
+#endif
+        for(Idx i=B.F[b]; i<B.P[b]; ++i) {
+	  Idx q=B.E[i];
+          for(Idx j=inbeg[q]; j<inbeg[q+1]; ++j) 
+            C.Mark(in[j]);
+          FD_LOOP(lcnt,0);
+	}
+        C.Split(); 
+      }
     }
+    FD_DF("Hopcroft::Minimize(): blocks #" << B.z);
 
-    // while there is an active block B[i]
-    while(!active.empty()) {
-      FD_WPC(blocks.size()-active.size(), blocks.size(), "StateMin: blocks/active:   " << blocks.size() << " / " << active.size());
-      FD_DF("Hopcroft::Minimize(): active blocks #" << active.size());
+    // report blocks with 1-based sorted states, ordered by smallest member
+    std::vector<Idx> bmap(B.z,0);
+    Idx bcnt=0;
+    for(Idx q=0; q<n; ++q) 
+      if(bmap[B.S[q]]==0) bmap[B.S[q]]=++bcnt;
+    blocks.resize(bcnt);
+    for(Idx q=0; q<n; ++q) 
+      blocks[bmap[B.S[q]]-1].push_back(q+1);
 
-      // pick an arbitrary active block B[i]  (need a copy for splitting B[i] by itself)
-      std::vector<Idx> b_current(blocks.at(active.top()));
-      FD_DF("StateMin: getting active block B[" << active.top() << "] = { #" << b_current.size() << "}");
-      active.pop();
- 
-      // compute C = f^-1(B[i])  per event with B[i] as b_current
-      Idx ev=1;
-      for(; ev!= events.size(); ++ev){
-        // iteration over states in current block
-        c.clear();
-        ssit = b_current.begin();
-        ssit_end = b_current.end();
-        for(; ssit != ssit_end; ++ssit) {
-  	  // find predecessor states by current ev + x2
-	  std::vector<Idx>& preevx2=states[*ssit].pre[ev];
-	  std::vector<Idx>::iterator rit = preevx2.begin();
-	  std::vector<Idx>::iterator rit_end = preevx2.end();
-	  for (; rit != rit_end; ++rit) c.push_back(*rit);
-        }
-	std::sort(c.begin(),c.end());
-        // if no predecessor states where found current block wont split anyway
-        if(c.empty()) continue;
-        // search for block to be split 
-        FD_DF("StateMin: computed predecessor states C = {#" << c.size() << "} for event " << gen->EventName(events[ev]));
-        // foreach block D 
-        for(Idx j=0; j < blocks.size(); ++j) {
-          // d_current <- B[j]
-          const std::vector<Idx>& d_current = blocks[j];
-          // singletons wont split anyway
-          if(d_current.size()==1) continue;
-	  FD_DF("StateMin: examining block D=B[" << j << "] = {#" << d_current.size() << "}");
-	  // compute D' = D intersection C
-          dp.clear();
-          std::set_intersection(d_current.begin(), d_current.end(), c.begin(), c.end(),       
-	     std::inserter(dp, dp.begin()));
-	  // check whether D splits by B
-	  if(dp.empty() || (dp.size()==d_current.size())) continue; 
-	  FD_DF("StateMin: -> split:");  
-    	  // compute split block D'' = D - D'
-      	  dpp.clear();
-          std::set_difference(d_current.begin(), d_current.end(), dp.begin(), dp.end(), 
-	     std::inserter(dpp,dpp.begin()));
-          // make D'' the smaller part
-	  if(dp.size() < dpp.size()) dp.swap(dpp); 
-     	  // record split blocks D' and D'' (invalidates references)
-          // [performance: using swap (constant) as opposed to assignment (linear) did not make a difference]
-	  blocks[j].swap(dp);
-          blocks.push_back(std::vector<Idx>());
-          blocks.back().swap(dpp);
-	  FD_DF("StateMin: new block D' as B[" << j << "] = " << vecstr(dp));
-	  FD_DF("StateMin: new block D'' as B[" << blocks.size()-1 << "] = " << vecstr(dpp));
-  	  // if D was active then mark both D', D'' active, else mark smaller part D'' as active
-          // [... and both cases effectively amount to mark D'' active]
-	  active.push((Idx)blocks.size()- 1);
-	} // foreach block D
-      } // foreach event
-    } // while active blocks exist
     //FAUDES_TIMER_LAP("minimzing: done");
 
    };
@@ -286,7 +400,7 @@ public:
     bool stateNames= pResGen->StateNamesEnabled() && gen->StateNamesEnabled();
 
     // build minimized generator
-    std::map<Idx,Idx> minstatemap; // original states index -> new state index
+    std::vector<Idx> minstatemap(idx.size(),0); // internal state -> new state index
     // loop over all blocks B
     for(Idx i = 0; i < blocks.size(); ++i) {
       // create state in new generator for every block
@@ -297,20 +411,20 @@ public:
       std::vector<Idx>::iterator ssit = blocks[i].begin();
       std::vector<Idx>::iterator ssit_end = blocks[i].end();
       for(; ssit != ssit_end; ++ssit) {
-        Idx orgstate = states[*ssit].idx;
+        Idx orgstate = idx[*ssit-1];
         // set minstatemap entry for every state in gen
-        minstatemap[orgstate] = newstate;
+        minstatemap[*ssit-1] = newstate;
         if(stateNames) {
   	  if (gen->StateName(orgstate) == "") ostr << ToStringInteger(orgstate) << ",";
 	  else ostr << gen->StateName(orgstate) << ",";
         }
         // set istates
-        if(gen->ExistsInitState(orgstate)) {
+        if(init[*ssit-1]) {
 	  pResGen->SetInitState(newstate);
 	  FD_DF("StateMin: -> initial state");
         }
         // set mstates
-        if(gen->ExistsMarkedState(orgstate)) {
+        if(marked[*ssit-1]) {
 	  pResGen->SetMarkedState(newstate);
 	  FD_DF("StateMmin: -> marked state");
         }
@@ -323,14 +437,8 @@ public:
       }
     }
     // create transition relation
-    TransSet::Iterator tit = gen->TransRelBegin();
-    for(; tit != gen->TransRelEnd(); ++tit) {
-      std::map<Idx,Idx>::iterator xit1=minstatemap.find(tit->X1);
-      std::map<Idx,Idx>::iterator xit2=minstatemap.find(tit->X2);
-      if(xit1==minstatemap.end()) continue;
-      if(xit2==minstatemap.end()) continue;
-      pResGen->SetTransition(xit1->second, tit->Ev, xit2->second);
-    }
+    for(Idx t=0; t<tail.size(); ++t) 
+      pResGen->SetTransition(minstatemap[tail[t]], events[label[t]], minstatemap[head[t]]);
     
     // resolve buffered result
     if(pResGen != &rResGen) {
@@ -361,7 +469,7 @@ public:
       std::vector<Idx>::iterator ssit_end = blocks[i].end();
       block.Clear();
       for(; ssit != ssit_end; ++ssit) {
-        Idx orgstate = states[*ssit].idx;
+        Idx orgstate = idx[*ssit-1];
         block.Insert(orgstate);
       }
       rSubsets.push_back(block);
@@ -35,8 +35,13 @@ namespace faudes {
  * State set minimization.
  * Constructs a generator with minimal stateset while preserving the generated und marked languages.
  * This function implements the (n*log n) set partitioning algorithm by
- * John E. Hopcroft.  The algorithm expects an accessible input generator. To have a const
- * interface, the argument is copied. See also StateMin(Generator&,Generator&).
+ * John E. Hopcroft, using the refinable partitions proposed by A. Valmari and P. Lehtinen
+ * for partial transition functions, i.e., the effort is O(m log n) for m transitions.
+ * States of the result are numbered in the order of the least original state they 
+ * represent. Non-accessible states are ignored. See also StateMin(Generator&,Generator&).
+ * When libFAUDES is configured with the option core_threads, the states and transitions
+ * affected by large splitters are marked concurrently by the number of threads specified by 
+ * the current Context, see Context::Threads(); the result does not depend on the number of threads.
  *
  * @param rGen
  *   Generator
@@ -22,10 +22,484 @@
 
 
 #include "cfl_symboltable.h"
+#include "cfl_context.h"
+#include "cfl_platform.h"
 #include <iostream>
+#include <atomic>
+#include <vector>
+#include <cstring>
 
 namespace faudes {
 
+
+/*
+*********************************************************
+Symboltable representation
+*********************************************************
+
+Symbolic names are interned as records in a pool of memory blocks, where the
+block size grows with the number of records. The records are referred to by an 
+open addressing hash table for the index lookup and by a segmented array for the 
+name lookup, where segment k holds 64*2^k entries. A segment is only allocated when 
+its size does not exceed twice the number of entries; sparse indices are kept in an 
+ordered map until their segment is allocated. Records are never moved; deleted 
+records are marked by index 0, and their slots in the hash table become tombstones.
+
+By default, the hash table consists of one shard and the records of deleted
+entries are kept on a free list for re-use. Symboltables configured for concurrent
+access, i.e., the global event symboltable, split the hash table into 
+FAUDES_SYMTAB_SHARDS shards to reduce contention of concurrent insertion.
+
+Concurrency: readers load slots with acquire semantics and never lock, except
+for the ordered map. Writers lock the shard of the hash table that corresponds
+to the symbolic name. When a shard grows, the hash table is rebuilt and published 
+by a single pointer; for concurrent tables, the previous hash table and all deleted 
+records are retired, but kept until the symboltable is cleared, since concurrent 
+readers may still refer to them. Indices are claimed by a compare-and-swap on the 
+respective slot of the segmented array; the ordered map and the allocation of 
+segments are guarded by one extra lock.
+
+*/
+
+// number of shards for concurrent tables (power of two, at most 256)
+#define FAUDES_SYMTAB_SHARDS 16
+// number of segments of the dense array
+#define FAUDES_SYMTAB_SEGMENTS 20
+// size of first segment
+#define FAUDES_SYMTAB_SEGBASE 64
+// size of pool blocks, first and max
+#define FAUDES_SYMTAB_BLOCK0 256
+#define FAUDES_SYMTAB_BLOCK 16384
+
+// elementary mutex (no-op without thread support)
+class SymMutex {
+public:
+#ifdef FAUDES_THREADS
+  SymMutex(void) { faudes_mutex_init(&mMutex); };
+  ~SymMutex(void) { faudes_mutex_destroy(&mMutex); };
+  void Lock(void) { faudes_mutex_lock(&mMutex); };
+  void Unlock(void) { faudes_mutex_unlock(&mMutex); };
+private:
+  faudes_mutex_t mMutex;
+#else
+  void Lock(void) {};
+  void Unlock(void) {};
+#endif
+};
+
+// scoped lock
+class SymLock {
+public:
+  SymLock(SymMutex& rMutex) : mrMutex(rMutex) { mrMutex.Lock(); };
+  ~SymLock(void) { mrMutex.Unlock(); };
+private:
+  SymMutex& mrMutex;
+};
+
+// interned symbol: index (0 for deleted), hash and null terminated name
+struct SymRec {
+  std::atomic<Idx> mIndex;
+  uint64_t mHash;
+  std::size_t mLen;
+  char mName[1];
+};
+
+// tombstone for deleted records in the hash table
+static char gSymTombstone;
+#define FAUDES_SYMTAB_TOMB (reinterpret_cast<SymRec*>(&gSymTombstone))
+
+// open addressing hash table
+struct SymHash {
+  std::size_t mMask;
+  std::atomic<SymRec*>* mSlots;
+};
+
+// shard of the hash table incl. pool
+struct SymShard {
+  SymMutex mMutex;
+  std::atomic<SymHash*> mHash;
+  std::size_t mUsed;
+  std::size_t mLive;
+  std::vector<SymHash*> mRetired;
+  std::vector<char*> mBlocks;
+  char* mPos;
+  std::size_t mAvail;
+  std::size_t mBlockSize;
+  std::map<std::size_t, std::vector<SymRec*> > mFree;
+};
+
+// slot of the dense array
+typedef std::atomic<SymRec*> SymSlot;
+
+// representation
+class SymbolTableRep {
+public:
+  SymbolTableRep(bool concurrent);
+  ~SymbolTableRep(void);
+  // configuration
+  bool mConcurrent;
+  // hash table shards
+  std::size_t mShardMask;
+  SymShard* mShards;
+  // dense array
+  std::atomic<SymSlot*> mSegments[FAUDES_SYMTAB_SEGMENTS];
+  // ordered map for sparse indices
+  std::map<Idx,SymRec*> mOverflow;
+  std::atomic<std::size_t> mOverflowSize;
+  SymMutex mOverflowMutex;
+  // number of entries
+  std::atomic<Idx> mSize;
+  // largest used index + 1
+  std::atomic<Idx> mNextIndex;
+  // hash function
+  static uint64_t Hash(const char* pName, std::size_t len);
+  // shard by hash
+  SymShard& Shard(uint64_t hash) { return mShards[(hash >> 56) & mShardMask]; };
+  // find record by name (no lock required)
+  SymRec* Find(const char* pName, std::size_t len, uint64_t hash) const;
+  // find record by index (no lock required)
+  SymRec* Find(Idx index);
+  // segment of index
+  static int Segment(Idx index);
+  // dense slot (0 if not allocated)
+  SymSlot* Slot(Idx index);
+  // allocate dense slot (0 for sparse indices)
+  SymSlot* Allocate(Idx index);
+  // record size
+  static std::size_t RecSize(std::size_t len);
+  // new record (shard lock required)
+  SymRec* NewRec(SymShard& rShard, const std::string& rName, uint64_t hash);
+  // dispose deleted record (shard lock required)
+  void DelRec(SymShard& rShard, SymRec* pRec);
+  // insert record to hash table (shard lock required)
+  void HashIns(SymShard& rShard, SymRec* pRec);
+  // remove record from hash table (shard lock required)
+  void HashDel(SymShard& rShard, SymRec* pRec);
+  // claim index for record
+  bool Claim(Idx index, SymRec* pRec);
+  // release index, return record 
+  SymRec* Release(Idx index);
+  // record index bound
+  void NextIndex(Idx index);
+  // all live records
+  void Records(std::vector<SymRec*>& rRecs);
+  // copy all live records from other representation
+  void Copy(SymbolTableRep& rSrc);
+};
+
+// construct
+SymbolTableRep::SymbolTableRep(bool concurrent) : 
+  mConcurrent(concurrent), mOverflowSize(0), mSize(0), mNextIndex(1) 
+{
+  mShardMask = concurrent ? FAUDES_SYMTAB_SHARDS-1 : 0;
+  mShards = new SymShard[mShardMask+1];
+  for(std::size_t s=0; s<=mShardMask; ++s) {
+    mShards[s].mHash.store(0,std::memory_order_relaxed);
+    mShards[s].mUsed=0;
+    mShards[s].mLive=0;
+    mShards[s].mPos=0;
+    mShards[s].mAvail=0;
+    mShards[s].mBlockSize=FAUDES_SYMTAB_BLOCK0;
+  }
+  for(int k=0; k<FAUDES_SYMTAB_SEGMENTS; ++k) 
+    mSegments[k].store(0,std::memory_order_relaxed);
+}
+
+// destruct
+SymbolTableRep::~SymbolTableRep(void) {
+  for(std::size_t s=0; s<=mShardMask; ++s) {
+    SymShard& shard=mShards[s];
+    SymHash* hash=shard.mHash.load(std::memory_order_relaxed);
+    if(hash) shard.mRetired.push_back(hash);
+    for(std::size_t i=0; i<shard.mRetired.size(); ++i) {
+      delete[] shard.mRetired[i]->mSlots;
+      delete shard.mRetired[i];
+    }
+    for(std::size_t i=0; i<shard.mBlocks.size(); ++i)
+      delete[] shard.mBlocks[i];
+  }
+  delete[] mShards;
+  for(int k=0; k<FAUDES_SYMTAB_SEGMENTS; ++k) 
+    delete[] mSegments[k].load(std::memory_order_relaxed);
+}
+
+// hash function (FNV-1a)
+uint64_t SymbolTableRep::Hash(const char* pName, std::size_t len) {
+  uint64_t res=14695981039346656037ULL;
+  for(std::size_t i=0; i<len; ++i) {
+    res ^= (unsigned char) pName[i];
+    res *= 1099511628211ULL;
+  }
+  return res;
+}
+
+// find by name
+SymRec* SymbolTableRep::Find(const char* pName, std::size_t len, uint64_t hash) const {
+  const SymShard& shard=mShards[(hash >> 56) & mShardMask];
+  SymHash* table=shard.mHash.load(std::memory_order_acquire);
+  if(!table) return 0;
+  std::size_t pos=hash & table->mMask;
+  while(true) {
+    SymRec* rec=table->mSlots[pos].load(std::memory_order_acquire);
+    if(!rec) return 0;
+    if(rec!=FAUDES_SYMTAB_TOMB)
+    if(rec->mHash==hash && rec->mLen==len)
+    if(std::memcmp(rec->mName,pName,len)==0) 
+    if(rec->mIndex.load(std::memory_order_acquire)!=0) 
+      return rec;
+    pos=(pos+1) & table->mMask;
+  }
+}
+
+// dense slot (0 if the segment is not allocated)
+SymSlot* SymbolTableRep::Slot(Idx index) {
+  int k=Segment(index);
+  if(k>=FAUDES_SYMTAB_SEGMENTS) return 0;
+  SymSlot* seg=mSegments[k].load(std::memory_order_acquire);
+  if(!seg) return 0;
+  return seg + (index - FAUDES_SYMTAB_SEGBASE * ((((Idx) 1) << k) -1));
+}
+
+// figure segment
+int SymbolTableRep::Segment(Idx index) {
+  Idx v= index/FAUDES_SYMTAB_SEGBASE + 1;
+  int k=0;
+  while(v>1) { v>>=1; ++k;}
+  return k;
+}
+
+// allocate segment (overflow lock required)
+SymSlot* SymbolTableRep::Allocate(Idx index) {
+  int k=Segment(index);
+  if(k>=FAUDES_SYMTAB_SEGMENTS) return 0;
+  // only allocate segments that will be reasonably populated
+  std::size_t sz= ((std::size_t) FAUDES_SYMTAB_SEGBASE) << k;
+  if(k>0 && sz > 2*((std::size_t) mSize.load(std::memory_order_relaxed)+1)) return 0;
+  // allocate and migrate entries from the ordered map
+  Idx base = FAUDES_SYMTAB_SEGBASE * ((((Idx) 1) << k) -1);
+  SymSlot* seg = new SymSlot[sz]();
+  std::map<Idx,SymRec*>::iterator rit=mOverflow.lower_bound(base);
+  std::map<Idx,SymRec*>::iterator rit_end=rit;
+  for(;rit_end!=mOverflow.end() && rit_end->first < base+sz; ++rit_end) 
+    seg[rit_end->first - base].store(rit_end->second,std::memory_order_relaxed);
+  mSegments[k].store(seg,std::memory_order_release);
+  mOverflow.erase(rit,rit_end);
+  mOverflowSize.store(mOverflow.size(),std::memory_order_release);
+  return seg + (index-base);
+}
+
+// find by index
+SymRec* SymbolTableRep::Find(Idx index) {
+  SymRec* rec=0;
+  // read the overflow size before the slot: Allocate() publishes a segment before it
+  // clears the size, so we either see the segment or a non-zero size
+  std::size_t osize=mOverflowSize.load(std::memory_order_acquire);
+  SymSlot* slot=Slot(index);
+  if(slot) {
+    rec=slot->load(std::memory_order_acquire);
+  } else if(osize>0) {
+    SymLock lock(mOverflowMutex);
+    slot=Slot(index);
+    if(slot) {
+      rec=slot->load(std::memory_order_acquire);
+    } else {
+      std::map<Idx,SymRec*>::iterator rit=mOverflow.find(index);
+      if(rit!=mOverflow.end()) rec=rit->second;
+    }
+  }
+  if(rec) 
+  if(rec->mIndex.load(std::memory_order_acquire)!=index) rec=0;
+  return rec;
+}
+
+// claim index
+bool SymbolTableRep::Claim(Idx index, SymRec* pRec) {
+  SymSlot* slot=Slot(index);
+  if(!slot) {
+    SymLock lock(mOverflowMutex);
+    slot=Slot(index);
+    if(!slot) slot=Allocate(index);
+    if(!slot) {
+      bool ok=mOverflow.insert(std::make_pair(index,pRec)).second;
+      mOverflowSize.store(mOverflow.size(),std::memory_order_release);
+      return ok;
+    }
+  }
+  SymRec* expected=0;
+  return slot->compare_exchange_strong(expected,pRec,std::memory_order_acq_rel);
+}
+
+// release index
+SymRec* SymbolTableRep::Release(Idx index) {
+  SymSlot* slot=Slot(index);
+  if(slot) return slot->exchange(0,std::memory_order_acq_rel);
+  SymLock lock(mOverflowMutex);
+  slot=Slot(index);
+  if(slot) return slot->exchange(0,std::memory_order_acq_rel);
+  std::map<Idx,SymRec*>::iterator rit=mOverflow.find(index);
+  if(rit==mOverflow.end()) return 0;
+  SymRec* rec=rit->second;
+  mOverflow.erase(rit);
+  mOverflowSize.store(mOverflow.size(),std::memory_order_release);
+  return rec;
+}
+
+// record index bound
+void SymbolTableRep::NextIndex(Idx index) {
+  Idx next=mNextIndex.load(std::memory_order_relaxed);
+  while(next<=index) 
+    if(mNextIndex.compare_exchange_weak(next,index+1)) break;
+}
+
+// record size
+std::size_t SymbolTableRep::RecSize(std::size_t len) {
+  std::size_t sz=offsetof(SymRec,mName)+len+1;
+  return (sz+7) & ~((std::size_t) 7);
+}
+
+// new record
+SymRec* SymbolTableRep::NewRec(SymShard& rShard, const std::string& rName, uint64_t hash) {
+  std::size_t len=rName.size();
+  std::size_t sz=RecSize(len);
+  // re-use deleted record of same size
+  std::map<std::size_t, std::vector<SymRec*> >::iterator fit=rShard.mFree.find(sz);
+  if(fit!=rShard.mFree.end()) {
+    SymRec* rec=fit->second.back();
+    fit->second.pop_back();
+    if(fit->second.empty()) rShard.mFree.erase(fit);
+    rec->mHash=hash;
+    rec->mLen=len;
+    std::memcpy(rec->mName,rName.data(),len);
+    rec->mName[len]=0;
+    return rec;
+  }
+  // allocate from pool
+  char* mem;
+  if(sz>FAUDES_SYMTAB_BLOCK/4) {
+    mem = new char[sz];
+    rShard.mBlocks.push_back(mem);
+  } else {
+    if(rShard.mAvail<sz) {
+      if(rShard.mBlockSize<sz) rShard.mBlockSize=FAUDES_SYMTAB_BLOCK;
+      rShard.mPos = new char[rShard.mBlockSize];
+      rShard.mAvail = rShard.mBlockSize;
+      rShard.mBlocks.push_back(rShard.mPos);
+      if(rShard.mBlockSize<FAUDES_SYMTAB_BLOCK) rShard.mBlockSize*=2;
+    }
+    mem=rShard.mPos;
+    rShard.mPos+=sz;
+    rShard.mAvail-=sz;
+  }
+  SymRec* rec= new (mem) SymRec;
+  rec->mIndex.store(0,std::memory_order_relaxed);
+  rec->mHash=hash;
+  rec->mLen=len;
+  std::memcpy(rec->mName,rName.data(),len);
+  rec->mName[len]=0;
+  return rec;
+}
+
+// dispose deleted record: keep for re-use, or retire for concurrent readers
+void SymbolTableRep::DelRec(SymShard& rShard, SymRec* pRec) {
+  if(mConcurrent) return;
+  rShard.mFree[RecSize(pRec->mLen)].push_back(pRec);
+}
+
+// insert to hash table
+void SymbolTableRep::HashIns(SymShard& rShard, SymRec* pRec) {
+  SymHash* table=rShard.mHash.load(std::memory_order_relaxed);
+  // rebuild on load factor 1/2, incl tombstones
+  if(!table || 2*(rShard.mUsed+1) > table->mMask+1) {
+    std::size_t cap=16;
+    while(cap < 4*(rShard.mLive+1)) cap*=2;
+    SymHash* ntable = new SymHash;
+    ntable->mMask=cap-1;
+    ntable->mSlots = new std::atomic<SymRec*>[cap]();
+    if(table) {
+      for(std::size_t i=0; i<=table->mMask; ++i) {
+        SymRec* rec=table->mSlots[i].load(std::memory_order_relaxed);
+        if(!rec || rec==FAUDES_SYMTAB_TOMB) continue;
+        std::size_t pos=rec->mHash & ntable->mMask;
+        while(ntable->mSlots[pos].load(std::memory_order_relaxed)) pos=(pos+1) & ntable->mMask;
+        ntable->mSlots[pos].store(rec,std::memory_order_relaxed);
+      }
+      if(mConcurrent) rShard.mRetired.push_back(table);
+      else { delete[] table->mSlots; delete table; }
+    }
+    rShard.mUsed=rShard.mLive;
+    rShard.mHash.store(ntable,std::memory_order_release);
+    table=ntable;
+  }
+  // insert
+  std::size_t pos=pRec->mHash & table->mMask;
+  while(table->mSlots[pos].load(std::memory_order_relaxed)) pos=(pos+1) & table->mMask;
+  table->mSlots[pos].store(pRec,std::memory_order_release);
+  ++rShard.mUsed;
+  ++rShard.mLive;
+}
+
+// remove from hash table
+void SymbolTableRep::HashDel(SymShard& rShard, SymRec* pRec) {
+  SymHash* table=rShard.mHash.load(std::memory_order_relaxed);
+  if(!table) return;
+  std::size_t pos=pRec->mHash & table->mMask;
+  while(true) {
+    SymRec* rec=table->mSlots[pos].load(std::memory_order_relaxed);
+    if(!rec) return;
+    if(rec==pRec) {
+      table->mSlots[pos].store(FAUDES_SYMTAB_TOMB,std::memory_order_release);
+      --rShard.mLive;
+      return;
+    }
+    pos=(pos+1) & table->mMask;
+  }
+}
+
+// live records
+void SymbolTableRep::Records(std::vector<SymRec*>& rRecs) {
+  rRecs.clear();
+  for(std::size_t s=0; s<=mShardMask; ++s) {
+    SymShard& shard=mShards[s];
+    SymLock lock(shard.mMutex);
+    SymHash* table=shard.mHash.load(std::memory_order_relaxed);
+    if(!table) continue;
+    for(std::size_t i=0; i<=table->mMask; ++i) {
+      SymRec* rec=table->mSlots[i].load(std::memory_order_acquire);
+      if(!rec || rec==FAUDES_SYMTAB_TOMB) continue;
+      if(rec->mIndex.load(std::memory_order_acquire)==0) continue;
+      rRecs.push_back(rec);
+    }
+  }
+}
+
+// copy live records
+void SymbolTableRep::Copy(SymbolTableRep& rSrc) {
+  std::vector<SymRec*> recs;
+  rSrc.Records(recs);
+  for(std::size_t i=0; i<recs.size(); ++i) {
+    Idx index=recs[i]->mIndex.load(std::memory_order_acquire);
+    SymShard& shard=Shard(recs[i]->mHash);
+    SymRec* rec=NewRec(shard,std::string(recs[i]->mName,recs[i]->mLen),recs[i]->mHash);
+    rec->mIndex.store(index,std::memory_order_relaxed);
+    Claim(index,rec);
+    HashIns(shard,rec);
+  }
+  mSize.store(recs.size());
+  mNextIndex.store(rSrc.mNextIndex.load());
+}
+
+// order records by name
+static bool SymRecLess(const SymRec* pRec1, const SymRec* pRec2) {
+  return std::strcmp(pRec1->mName,pRec2->mName)<0;
+}
+
+
+/*
+*********************************************************
+SymbolTable
+*********************************************************
+*/
+
 // faudes type std
 FAUDES_TYPE_IMPLEMENTATION(Void,SymbolTable,Type)
 
@@ -35,22 +509,30 @@ AutoRegisterType<SymbolTable> gRtiSymboltable("Symboltable");
 // constructor
 SymbolTable:: SymbolTable(void) :
   mMyName("SymbolTable"),
-  mMaxIndex(std::numeric_limits<Idx>::max()), 
-  mNextIndex(1) {
+  mpRep(new SymbolTableRep(false)),
+  mMaxIndex(std::numeric_limits<Idx>::max()) {
 }
 
 // constructor
-SymbolTable:: SymbolTable(const SymbolTable& rSrc) {
+SymbolTable:: SymbolTable(const SymbolTable& rSrc) : 
+  mpRep(new SymbolTableRep(false)) {
   DoCopy(rSrc);
 }
 
+// destructor
+SymbolTable::~SymbolTable(void) {
+  delete mpRep;
+}
+
 // asignment
 void SymbolTable::DoCopy(const SymbolTable& rSrc) {
+  if(&rSrc==this) return;
   mMyName=rSrc.mMyName;
-  mIndexMap=rSrc.mIndexMap;
-  mNameMap=rSrc.mNameMap;
+  SymbolTableRep* rep = new SymbolTableRep(mpRep->mConcurrent);
+  rep->Copy(*rSrc.mpRep);
+  delete mpRep;
+  mpRep=rep;
   mMaxIndex=rSrc.mMaxIndex;
-  mNextIndex=rSrc.mNextIndex;
 }
 
 
@@ -67,14 +549,35 @@ void SymbolTable::Name(const std::string& rName) {
 // Clear()
 void SymbolTable::Clear(void) {   
   mMaxIndex=std::numeric_limits<Idx>::max();
-  mNextIndex=1;
-  mIndexMap.clear();
-  mNameMap.clear();
+  bool concurrent=mpRep->mConcurrent;
+  delete mpRep;
+  mpRep = new SymbolTableRep(concurrent);
+}
+
+// Concurrent(flag)
+void SymbolTable::Concurrent(bool flag) {
+  if(mpRep->mConcurrent==flag) return;
+  SymbolTableRep* rep = new SymbolTableRep(flag);
+  rep->Copy(*mpRep);
+  delete mpRep;
+  mpRep=rep;
+}
+
+// Concurrent()
+bool SymbolTable::Concurrent(void) const {
+  return mpRep->mConcurrent;
+}
+
+// install in context, configure for concurrent access once (defined here, since
+// the minimal library used by the build tools does not provide symbol tables)
+void Context::EventSymbolTablep(SymbolTable* pSymTab) {
+  if(pSymTab) pSymTab->Concurrent(true);
+  pEventSymbolTable=pSymTab;
 }
 
 // Size()
 Idx SymbolTable::Size(void) const {   
-  return mIndexMap.size();
+  return mpRep->mSize.load(std::memory_order_acquire);
 }
 
 // MaxIndex()
@@ -95,7 +598,7 @@ void SymbolTable::MaxIndex(Idx index) {
 		
 // LastIndex()
 Idx SymbolTable::LastIndex(void) const {
-  return mNextIndex - 1;
+  return mpRep->mNextIndex.load(std::memory_order_acquire) - 1;
 }
 		
 // ValidSymbol(rName)
@@ -146,14 +649,18 @@ Idx SymbolTable::InsEntry(Idx index, const std::string& rName) {
     errstr << "symboltable overflow in \"" << mMyName << "\"";
     throw Exception("SymbolTable::InsEntry(index,name))", errstr.str(), 40);
   }
-  Idx nidx=Index(rName);
-  if((nidx!=0) && (nidx!=index)) {
+  uint64_t hash=SymbolTableRep::Hash(rName.data(),rName.size());
+  SymShard& shard=mpRep->Shard(hash);
+  SymLock lock(shard.mMutex);
+  SymRec* nrec=mpRep->Find(rName.data(),rName.size(),hash);
+  Idx nidx= nrec ? nrec->mIndex.load(std::memory_order_acquire) : 0;
+  if(nidx==index) return index;
+  if(nidx!=0) {
     std::stringstream errstr;
     errstr << "Name " << rName << " allready exists in \"" << mMyName << "\"";
     throw Exception("SymbolTable::InsEntry(index,name)", errstr.str(), 41);
   }
-  std::string idxname=Symbol(index);
-  if((idxname != "") && (idxname != rName)) {
+  if(mpRep->Find(index)) {
     std::stringstream errstr;
     errstr << "Index " << index << " allready exists in \"" << mMyName << "\"";
     throw Exception("SymbolTable::InsEntry(index,name)", errstr.str(), 42);
@@ -163,19 +670,54 @@ Idx SymbolTable::InsEntry(Idx index, const std::string& rName) {
     errstr << "Name " << rName << " is not a valid symbol";
     throw Exception("SymbolTable::InsEntry(index,name)", errstr.str(), 43);
   }
-
-  mIndexMap[rName] = index;
-  mNameMap[index] = rName;
-
-  if(mNextIndex<=index) mNextIndex=index+1; 
+  SymRec* rec=mpRep->NewRec(shard,rName,hash);
+  rec->mIndex.store(index,std::memory_order_relaxed);
+  if(!mpRep->Claim(index,rec)) {
+    rec->mIndex.store(0,std::memory_order_relaxed);
+    mpRep->DelRec(shard,rec);
+    std::stringstream errstr;
+    errstr << "Index " << index << " allready exists in \"" << mMyName << "\"";
+    throw Exception("SymbolTable::InsEntry(index,name)", errstr.str(), 42);
+  }
+  mpRep->HashIns(shard,rec);
+  mpRep->mSize.fetch_add(1);
+  mpRep->NextIndex(index);
   return index;
 }
 
 // InsEntry(rName)
 Idx SymbolTable::InsEntry(const std::string& rName) {
-  Idx index=Index(rName);
-  if( index != 0) return index;
-  return InsEntry(mNextIndex,rName);
+  uint64_t hash=SymbolTableRep::Hash(rName.data(),rName.size());
+  SymShard& shard=mpRep->Shard(hash);
+  SymLock lock(shard.mMutex);
+  SymRec* nrec=mpRep->Find(rName.data(),rName.size(),hash);
+  if(nrec) return nrec->mIndex.load(std::memory_order_acquire);
+  // claim next free index
+  SymRec* rec=0;
+  Idx index=mpRep->mNextIndex.load(std::memory_order_acquire);
+  while(true) {
+    if( ! (index <= mMaxIndex)) {
+      if(rec) { rec->mIndex.store(0,std::memory_order_relaxed); mpRep->DelRec(shard,rec); }
+      std::stringstream errstr;
+      errstr << "symboltable overflow in \"" << mMyName << "\"";
+      throw Exception("SymbolTable::InsEntry(index,name))", errstr.str(), 40);
+    }
+    if(!rec) {
+      if(!ValidSymbol(rName)) {
+        std::stringstream errstr;
+        errstr << "Name " << rName << " is not a valid symbol";
+        throw Exception("SymbolTable::InsEntry(index,name)", errstr.str(), 43);
+      }
+      rec=mpRep->NewRec(shard,rName,hash);
+    }
+    if(!mpRep->mNextIndex.compare_exchange_weak(index,index+1)) continue;
+    rec->mIndex.store(index,std::memory_order_relaxed);
+    if(mpRep->Claim(index,rec)) break;
+    index=mpRep->mNextIndex.load(std::memory_order_acquire);
+  }
+  mpRep->HashIns(shard,rec);
+  mpRep->mSize.fetch_add(1);
+  return index;
 }
 
 
@@ -185,23 +727,40 @@ void SymbolTable::SetEntry(Idx index, const std::string& rName) {
     ClrEntry(index);
     return;
   }
-  Idx nidx=Index(rName);
-  if((nidx!=0) && (nidx!=index)) {
-    std::stringstream errstr;
-    errstr << "Name " << rName << " allready exists in \"" << mMyName << "\"";
-    throw Exception("SymbolTable::SetEntry(index,name)", errstr.str(), 41);
+  SymRec* orec=0;
+  {
+    uint64_t hash=SymbolTableRep::Hash(rName.data(),rName.size());
+    SymShard& shard=mpRep->Shard(hash);
+    SymLock lock(shard.mMutex);
+    SymRec* nrec=mpRep->Find(rName.data(),rName.size(),hash);
+    Idx nidx= nrec ? nrec->mIndex.load(std::memory_order_acquire) : 0;
+    if(nidx==index) return;
+    if(nidx!=0) {
+      std::stringstream errstr;
+      errstr << "Name " << rName << " allready exists in \"" << mMyName << "\"";
+      throw Exception("SymbolTable::SetEntry(index,name)", errstr.str(), 41);
+    }
+    if(!ValidSymbol(rName)) {
+      std::stringstream errstr;
+      errstr << "Name " << rName << " is not a valid symbol";
+      throw Exception("SymbolTable::SetEntry(index,name)", errstr.str(), 43);
+    }
+    // replace old entry
+    SymRec* rec=mpRep->NewRec(shard,rName,hash);
+    rec->mIndex.store(index,std::memory_order_relaxed);
+    orec=mpRep->Release(index);
+    if(orec) orec->mIndex.store(0,std::memory_order_release);
+    mpRep->Claim(index,rec);
+    mpRep->HashIns(shard,rec);
+    if(!orec) mpRep->mSize.fetch_add(1);
   }
-  if(!ValidSymbol(rName)) {
-    std::stringstream errstr;
-    errstr << "Name " << rName << " is not a valid symbol";
-    throw Exception("SymbolTable::SetEntry(index,name)", errstr.str(), 43);
+  // remove old entry from hash table
+  if(orec) {
+    SymShard& shard=mpRep->Shard(orec->mHash);
+    SymLock lock(shard.mMutex);
+    mpRep->HashDel(shard,orec);
+    mpRep->DelRec(shard,orec);
   }
-  // remove old entry from reverse map
-  std::map<Idx,std::string>::iterator nit = mNameMap.find(index);
-  if(nit != mNameMap.end()) mIndexMap.erase(nit->second);
-  // insert new name/index to maps
-  mIndexMap[rName] = index;
-  mNameMap[index] = rName;
 }
 
 // SetDefaultSymbol(index)
@@ -215,18 +774,20 @@ void SymbolTable::SetDefaultSymbol(Idx index) {
 
 // ClrEntry(index)
 void SymbolTable::ClrEntry(Idx index) {
-  std::map<Idx,std::string>::iterator it = mNameMap.find(index);
-  if (it == mNameMap.end()) return;
-  mIndexMap.erase(it->second);
-  mNameMap.erase(it);
+  SymRec* rec=mpRep->Release(index);
+  if(!rec) return;
+  rec->mIndex.store(0,std::memory_order_release);
+  SymShard& shard=mpRep->Shard(rec->mHash);
+  SymLock lock(shard.mMutex);
+  mpRep->HashDel(shard,rec);
+  mpRep->DelRec(shard,rec);
+  mpRep->mSize.fetch_sub(1);
 }
 
 // ClrEntry(rName)
 void SymbolTable::ClrEntry(const std::string& rName) {
-  std::map<std::string,Idx>::iterator it = mIndexMap.find(rName);
-  if (it == mIndexMap.end()) return;
-  mNameMap.erase(it->second);
-  mIndexMap.erase(it);
+  Idx index=Index(rName);
+  if(index!=0) ClrEntry(index);
 }
 
 // RestrictDomain(set)
@@ -234,54 +795,57 @@ void SymbolTable::RestrictDomain(const IndexSet& rDomain) {
   // trivial cases
   if(rDomain.Empty()) { Clear(); return;}
   if(Size()==0) return;
-  // lazy loop (todo: sorted iterate)
-  std::map<Idx,std::string>::iterator it, oit;
-  it = mNameMap.begin();
-  while(it!=mNameMap.end()) {
-    oit=it;
-    it++;
-    if(!rDomain.Exists(oit->first)) mNameMap.erase(oit);
+  // loop all entries
+  std::vector<SymRec*> recs;
+  mpRep->Records(recs);
+  for(std::size_t i=0; i<recs.size(); ++i) {
+    Idx index=recs[i]->mIndex.load(std::memory_order_acquire);
+    if(!rDomain.Exists(index)) ClrEntry(index);
   }
 }
 
 // Index(rName)
 Idx SymbolTable::Index(const std::string& rName) const {
-  std::map<std::string,Idx>::const_iterator it = mIndexMap.find(rName);
-  if (it == mIndexMap.end()) 
-    return 0;
-  else 
-    return it->second;
+  uint64_t hash=SymbolTableRep::Hash(rName.data(),rName.size());
+  SymRec* rec=mpRep->Find(rName.data(),rName.size(),hash);
+  if(!rec) return 0;
+  return rec->mIndex.load(std::memory_order_acquire);
 }
 
 // Symbol(index)
 std::string SymbolTable::Symbol(Idx index) const {
-  std::map<Idx,std::string>::const_iterator it = mNameMap.find(index);
-  if (it == mNameMap.end()) 
-    return "";
-  else 
-    return it->second;
+  SymRec* rec=mpRep->Find(index);
+  if(!rec) return "";
+  return std::string(rec->mName,rec->mLen);
 }
 
 
 
 // Exists(index)
 bool SymbolTable::Exists(Idx index) const {
-  std::map<Idx,std::string>::const_iterator it = mNameMap.find(index);
-  return (it != mNameMap.end());
+  return mpRep->Find(index)!=0;
 }
 
 // Exists(rName)
 bool SymbolTable::Exists(const std::string& rName) const {
-  std::map<std::string,Idx>::const_iterator it = mIndexMap.find(rName);
-  return ( it != mIndexMap.end());
+  return Index(rName)!=0;
 }
 
 
+// global event symboltable, configured for concurrent access
+static SymbolTable* symtab_global(void) {
+  static SymbolTable fls;
+  fls.Concurrent(true);
+  return &fls;
+}
+
 // GlobalEventSymbolTablep 
 // (initialize on first use pattern)
 SymbolTable* SymbolTable::GlobalEventSymbolTablep(void) {
-  static SymbolTable fls;
-  return &fls; 
+  SymbolTable* cls=Context::Current()->EventSymbolTablep();
+  if(cls) return cls;
+  static SymbolTable* fls = symtab_global();
+  return fls; 
 }
 
 
@@ -299,11 +863,13 @@ void SymbolTable::DoWrite(TokenWriter& rTw, const std::string& rLabel, const Typ
   int ocol= rTw.Columns();
   rTw.Columns(2);
 
-  // iterate over indices
-  std::map< std::string, Idx >::const_iterator sit = mIndexMap.begin();
-  for(; sit != mIndexMap.end();++sit) {
-    rTw.WriteInteger(sit->second);
-    rTw.WriteString(sit->first);
+  // iterate over symbols, sorted by name
+  std::vector<SymRec*> recs;
+  mpRep->Records(recs);
+  std::sort(recs.begin(),recs.end(),SymRecLess);
+  for(std::size_t i=0; i<recs.size(); ++i) {
+    rTw.WriteInteger(recs[i]->mIndex.load(std::memory_order_acquire));
+    rTw.WriteString(std::string(recs[i]->mName,recs[i]->mLen));
   }
   
   // restore columns
@@ -43,6 +43,7 @@ namespace faudes {
 
 // forward
 class IndexSet;
+class SymbolTableRep;
 
 /**  
  * A SymbolTable associates sybolic names with indices. 
@@ -56,7 +57,22 @@ class IndexSet;
  * Generators refer to a global symboltable for event names and hold a local 
  * symboltable for state names.
  *
- *
+ * Technically, symbolic names are interned in a pool of memory blocks and 
+ * referred to from a hash table for the index lookup and from a dense segmented 
+ * array for the symbolic name lookup; both lookups are O(1) on average. 
+ * Indices beyond the range of the dense array, i.e., larger than approx. 2^26, 
+ * fall back to an ordered map. 
+ * By default, a symboltable must be operated by one thread at a time and the records
+ * of deleted entries are re-used. A symboltable configured by Concurrent() supports 
+ * concurrent access when compiled with the FAUDES_THREADS option: lookups by Index(), 
+ * Symbol() and Exists() do not lock and may be issued concurrently to InsEntry(), 
+ * SetEntry() and ClrEntry(); the hash table is split in shards with one lock each 
+ * to reduce contention of concurrent insertion, and deleted records are retained until
+ * the table is cleared. The global event symboltable is configured for concurrent 
+ * access, i.e., multiple threads may refer to it, e.g., when running independent 
+ * syntheses; the same applies to the event symboltable installed in a Context, which is shared
+ * by the workers of RunTasks(). Clear(), 
+ * RestrictDomain(), assignment and token io must not be used concurrently.
  */
 class FAUDES_API SymbolTable : public Type {
 public:
@@ -72,6 +88,9 @@ public:
   /** Copy constructor */
   SymbolTable(const SymbolTable& rSrc);
 
+  /** Destructor */
+  virtual ~SymbolTable(void);
+
   /** Return name of SymbolTable */
   const std::string& Name(void) const;
 		
@@ -84,6 +103,22 @@ public:
   /** Clear all entries */
   void Clear(void);
 
+  /** 
+   * Configure for concurrent access.
+   *
+   * A concurrent symboltable splits its hash table in shards with one lock each and
+   * retains deleted records for concurrent readers; see class documentation. 
+   * Entries are retained. This function must not be invoked while other threads 
+   * refer to the symboltable.
+   *
+   * @param flag
+   *   True to configure for concurrent access
+   */
+  void Concurrent(bool flag);
+
+  /** Test whether the symboltable is configured for concurrent access */
+  bool Concurrent(void) const;
+
 
   /** Get maximum index which this SymbolTable accepts */
   Idx MaxIndex(void) const;
@@ -251,7 +286,9 @@ public:
 
   /**
    * Get Static Symboltable ref
-   * (initialize on first use pattern)
+   * (initialize on first use pattern).
+   * If the current Context of the calling thread specifies an event
+   * symbol table, that table is returned instead.
    */
   static SymbolTable* GlobalEventSymbolTablep(void);
 
@@ -271,17 +308,11 @@ public:
   /** Name of the SymbolTable */
   std::string mMyName;
 		
-  /** Index lookup map */
-  std::map<std::string,Idx> mIndexMap;
-		
-  /** Name lookup map */
-  std::map<Idx,std::string> mNameMap;
+  /** Hash table, dense array and string pool (see cfl_symboltable.cpp) */
+  SymbolTableRep* mpRep;
 
   /** Upper limit (incl) */
   Idx mMaxIndex;
-		
-  /** Largest used index + 1 */
-  Idx mNextIndex;
 
 };
 
@@ -0,0 +1,160 @@
+/** @file cfl_tasks.cpp Run independent tasks on worker threads */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#include "cfl_tasks.h"
+#include "cfl_platform.h"
+#include "cfl_context.h"
+#include "cfl_allocator.h"
+#include "cfl_symboltable.h"
+
+#include <atomic>
+#include <exception>
+#include <vector>
+
+namespace faudes {
+
+// set for the workers of a multi-threaded run
+static thread_local bool gTaskWorker=false;
+
+// test for worker
+bool TaskWorker(void) {
+  return gTaskWorker;
+}
+
+// figure number of threads
+Idx TaskThreads(Idx threads, std::size_t count) {
+#ifdef FAUDES_THREADS
+  if(gTaskWorker) return 1;
+  if(threads==0) threads=faudes_thread_concurrency();
+  if(threads>64) threads=64;
+  if(threads>count) threads=(Idx) count;
+  if(threads<1) threads=1;
+  return threads;
+#else
+  (void) threads;
+  (void) count;
+  return 1;
+#endif
+}
+
+#ifdef FAUDES_THREADS
+
+// data shared by the workers of one run
+typedef struct {
+  TaskFnct pFnct;
+  void* pData;
+  std::size_t mCount;
+  std::atomic<std::size_t> mNext;
+  std::atomic<bool> mFailed;
+  std::vector<std::exception_ptr> mErrors;
+  Context* pCaller;
+} task_run;
+
+// worker record
+typedef struct {
+  task_run* pRun;
+  std::size_t mWorker;
+  faudes_thread_t mThread;
+} task_worker;
+
+// worker function: fetch tasks until done or failed
+static void* task_worker_fnct(void* arg) {
+  task_worker* pWorker=(task_worker*) arg;
+  task_run* pRun=pWorker->pRun;
+  // operate on the context of the caller, allocate from the global heap, do not spawn threads
+  ContextScope cscope(pRun->pCaller);
+  MemoryPoolScope mscope(NULL);
+  bool worker=gTaskWorker;
+  gTaskWorker=true;
+  while(!pRun->mFailed) {
+    std::size_t task= pRun->mNext++;
+    if(task>=pRun->mCount) break;
+    try {
+      pRun->pFnct(pRun->pData,pWorker->mWorker,task);
+    } catch(...) {
+      pRun->mErrors[task]=std::current_exception();
+      pRun->mFailed=true;
+    }
+  }
+  gTaskWorker=worker;
+  return 0;
+}
+
+#endif
+
+// run tasks
+void RunTasks(Idx threads, std::size_t count, TaskFnct fnct, void* pData) {
+#ifdef FAUDES_THREADS
+  if(threads>count) threads=(Idx) count;
+  if((threads>1) && !gTaskWorker) {
+    FD_DF("RunTasks(): #" << count << " tasks with #" << threads << " workers");
+    task_run run;
+    run.pFnct=fnct;
+    run.pData=pData;
+    run.mCount=count;
+    run.mNext=0;
+    run.mFailed=false;
+    run.mErrors.resize(count);
+    run.pCaller=Context::Current();
+    std::vector<task_worker> workers(threads);
+    for(Idx w=0; w<threads; ++w) {
+      workers[w].pRun=&run;
+      workers[w].mWorker=w;
+    }
+    // this thread is worker 0 and fallback
+    Idx started=1;
+    for(; started<threads; ++started)
+      if(faudes_thread_create(&workers[started].mThread,task_worker_fnct,&workers[started]) != FAUDES_THREAD_SUCCESS)
+        break;
+    task_worker_fnct(&workers[0]);
+    for(Idx w=1; w<started; ++w)
+      faudes_thread_join(workers[w].mThread,0);
+    // pass on first exception in task order
+    for(std::size_t task=0; task<count; ++task)
+      if(run.mErrors[task]) std::rethrow_exception(run.mErrors[task]);
+    return;
+  }
+#else
+  (void) threads;
+#endif
+  for(std::size_t task=0; task<count; ++task) fnct(pData,0,task);
+}
+
+// copy generator with own storage
+void TaskCopy(const vGenerator& rSrc, vGenerator& rDst) {
+  MemoryPoolScope scope(NULL);
+  rDst.Copy(rSrc);
+  rDst.Alphabet().Detach();
+  rDst.States().Detach();
+  rDst.InitStates().Detach();
+  rDst.MarkedStates().Detach();
+  rDst.TransRel().Detach();
+}
+
+// copy alphabet with own storage
+void TaskCopy(const EventSet& rSrc, EventSet& rDst) {
+  MemoryPoolScope scope(NULL);
+  rDst.Copy(rSrc);
+  rDst.Detach();
+}
+
+} // namespace faudes
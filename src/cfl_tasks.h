@@ -0,0 +1,126 @@
+/** @file cfl_tasks.h Run independent tasks on worker threads */
+
+/* FAU Discrete Event Systems Library (libfaudes)
+
+   Copyright (C) 2026  agent
+   Exclusive copyright is granted to Klaus Schmidt
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with this library; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
+
+
+#ifndef FAUDES_TASKS_H
+#define FAUDES_TASKS_H
+
+#include "cfl_definitions.h"
+#include "cfl_generator.h"
+
+#include <cstddef>
+
+namespace faudes {
+
+/**
+ * Task function.
+ *
+ * @param pData
+ *   Data shared by all tasks
+ * @param worker
+ *   Index of the worker that runs the task, 0 ... threads-1, e.g. to address scratch memory
+ * @param task
+ *   Index of the task, 0 ... count-1
+ */
+typedef void (*TaskFnct)(void* pData, std::size_t worker, std::size_t task);
+
+/**
+ * Figure number of worker threads.
+ *
+ * Resolves the thread count setting of an algorithm, i.e., 0 is mapped to the number of
+ * available processors and the result is bounded by 64 and by the number of tasks.
+ * When called from within a task, or when libFAUDES is configured without
+ * the option core_threads, the result is 1. Thus, algorithms that
+ * are invoked by a task operate sequentially and do not spawn further threads.
+ *
+ * @param threads
+ *   Thread count setting (0 for number of processors)
+ * @param count
+ *   Number of tasks
+ * @return
+ *   Number of workers to use, at least 1
+ */
+extern FAUDES_API Idx TaskThreads(Idx threads, std::size_t count);
+
+/**
+ * Run independent tasks.
+ *
+ * Runs the tasks 0 ... count-1 by the specified number of workers, see TaskThreads(). The
+ * calling thread acts as worker 0 and takes over the tasks of any worker thread that cannot
+ * be started. Workers operate in the current Context of the caller, allocate from the
+ * global heap (i.e., any MemoryPoolScope of the caller is suspended) and TaskThreads()
+ * evaluates to 1 for them. Workers share the event symbol table of the caller's Context,
+ * which has been configured for concurrent access when installed. Tasks must not share non-const data unless they synchronise
+ * access themselves; in particular, generators and sets passed to a task should be
+ * prepared by TaskCopy().
+ *
+ * If a task throws an exception, no further tasks are started and, when all workers have
+ * completed, the exception of the first failed task in task order is passed on to the
+ * caller. This is the exception a sequential run would have thrown. With one worker,
+ * the tasks are run sequentially within the calling thread.
+ *
+ * @param threads
+ *   Number of workers
+ * @param count
+ *   Number of tasks
+ * @param fnct
+ *   Task function
+ * @param pData
+ *   Data passed on to the task function
+ */
+extern FAUDES_API void RunTasks(Idx threads, std::size_t count, TaskFnct fnct, void* pData);
+
+/**
+ * Test whether the calling thread is a worker of RunTasks().
+ *
+ * @return
+ *   True for workers of a run with more than one worker
+ */
+extern FAUDES_API bool TaskWorker(void);
+
+/**
+ * Copy a generator for use by a task.
+ *
+ * Since the deferred copy mechanism of TBaseSet is not thread-safe, data passed on to a task
+ * must not share storage with other sets. This function assigns the source to the destination,
+ * enforces own storage for all sets of the destination and allocates from the global heap.
+ *
+ * @param rSrc
+ *   Source
+ * @param rDst
+ *   Destination, with own storage
+ */
+extern FAUDES_API void TaskCopy(const vGenerator& rSrc, vGenerator& rDst);
+
+/**
+ * Copy an alphabet for use by a task. See TaskCopy(const vGenerator&, vGenerator&).
+ *
+ * @param rSrc
+ *   Source
+ * @param rDst
+ *   Destination, with own storage
+ */
+extern FAUDES_API void TaskCopy(const EventSet& rSrc, EventSet& rDst);
+
+
+} // namespace faudes
+
+#endif
@@ -630,6 +630,9 @@ public:
 
 private:
 
+  /** TokenReader fast path hands over non-plain tokens */
+  friend class TokenReader;
+
   /** Token type */
   int mType; 
 		
@@ -28,6 +28,9 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
 
 namespace faudes {
 
+// block size for file input (bytes)
+#define FAUDES_TOKENREADER_BUFSIZE (1<<20)
+
 // TokenReader(mode,instring)
 TokenReader::TokenReader(Mode mode, const std::string& rInString)
   : mMode(mode), mpStream(NULL), mFileName("") 
@@ -44,6 +47,8 @@ TokenReader::TokenReader(Mode mode, const std::string& rInString)
     // set up mFStream
     FD_DV("TokenReader::Tokenreader(File, \"" << rInString <<"\")");
     mFStream.exceptions(std::ios::badbit|std::ios::failbit);
+    mFileBuffer.resize(FAUDES_TOKENREADER_BUFSIZE);
+    mFStream.rdbuf()->pubsetbuf(&mFileBuffer[0],mFileBuffer.size());
     try{
       mFStream.open(rInString.c_str(), std::ios::in | std::ios::binary); 
     } 
@@ -71,6 +76,8 @@ TokenReader::TokenReader(const std::string& rFilename)
   // set up mFStream
   FD_DV("TokenReader::Tokenreader(File, \"" << rFilename <<"\")");
   mFStream.exceptions(std::ios::badbit|std::ios::failbit);
+  mFileBuffer.resize(FAUDES_TOKENREADER_BUFSIZE);
+  mFStream.rdbuf()->pubsetbuf(&mFileBuffer[0],mFileBuffer.size());
   try{
     mFStream.open(rFilename.c_str(), std::ios::in | std::ios::binary); 
   } 
@@ -459,6 +466,120 @@ bool TokenReader::Eos(const std::string& rLabel) {
 }
   
 
+// PlainSpace(): skip white space and faudes comments on stream buffer level
+int TokenReader::PlainSpace(void) {
+  std::streambuf* sb=mpStream->rdbuf();
+  int c;
+  while(true) {
+    c=sb->sgetc();
+    if(c==EOF) return c;
+    // count lines
+    if(c=='\n') {
+      ++mLineCount;
+      sb->sbumpc();
+      continue;
+    }
+    // swallow controls and space
+    if(iscntrl(c) || isspace(c)) {
+      sb->sbumpc();
+      continue;
+    }
+    // regard this non-white
+    if(c!='%' || !mFaudesComments) break;
+    // swallow comment incl. terminating new line
+    while(true) {
+      c=sb->sbumpc();
+      if(c==EOF) return c;
+      if(c=='\n') { ++mLineCount; break;}
+      if(c=='\r') break;
+    }
+  }
+  return c;
+}
+
+// ReadPlain(index,name)
+bool TokenReader::ReadPlain(Idx& rIndex, std::string& rName) {
+  // case a: token in peek buffer
+  if(!mPeekToken.IsNone()) {
+    Token::TokenType ttype=mPeekToken.Type();
+    if(ttype==Token::Integer) {
+      if(mPeekToken.IntegerValue()<=0) return false;
+      if(mPeekToken.IntegerValue()>(Int) FAUDES_IDX_MAX) return false;
+      rIndex=(Idx) mPeekToken.IntegerValue();
+      rName.clear();
+    } else if(ttype==Token::String) {
+      rIndex=0;
+      rName=mPeekToken.StringValue();
+    } else {
+      return false;
+    }
+    Token token;
+    Get(token);
+    return true;
+  }
+  // case b: scan stream buffer
+  int c=PlainSpace();
+  if(c==EOF) return false;
+  // not plain: quoted strings, options, binary, markup and comments
+  if(c=='"' || c=='\'' || c=='+' || c=='=' || c=='<' || c=='>' || c=='%' || c=='&') 
+    return false;
+  // read space separated string
+  std::streambuf* sb=mpStream->rdbuf();
+  bool digits=true;
+  uint64_t value=0;
+  rName.clear();
+  while(true) {
+    c=sb->sgetc();
+    if(c==EOF) break;
+    if(c=='<' || c=='>') break;
+    if(isblank(c) || iscntrl(c)) break;
+    sb->sbumpc();
+    // resolve entity reference
+    if(c=='&') {
+      digits=false;
+      std::string entref="&";
+      while(true) {
+        c=sb->sgetc();
+        if(c==EOF || c=='<' || c=='>' || isspace(c) || iscntrl(c)) break;
+        sb->sbumpc();
+        entref.append(1,(char) c);
+        if(c==';') break;
+      }
+      if(entref=="&amp;") rName.append(1,'&'); 
+      else if(entref=="&quot;") rName.append(1,'"'); 
+      else if(entref=="&apos;") rName.append(1,'\''); 
+      else if(entref=="&lt;") rName.append(1,'<');
+      else if(entref=="&gt;") rName.append(1,'>');
+      else rName.append(entref);
+      continue;
+    }
+    rName.append(1,(char) c);
+    // track decimal value
+    if(digits) {
+      if(c<'0' || c>'9') digits=false;
+      else if(value<=FAUDES_IDX_MAX) value=10*value+(c-'0');
+    }
+  }
+  // plain integer
+  if(digits && value>0 && value<=FAUDES_IDX_MAX) {
+    rIndex=(Idx) value;
+    rName.clear();
+    return true;
+  }
+  // number or special value: pass on to peek buffer
+  c=rName[0];
+  if(digits || c=='-' || c=='.' || isdigit(c) || 
+     rName=="inf" || rName=="true" || rName=="True" || rName=="false" || rName=="False") 
+  {
+    mPeekToken.SetString(rName);
+    mPeekToken.InterpretNumber();
+    return false;
+  }
+  // plain name
+  rIndex=0;
+  return true;
+}
+
 // ReadInteger()
 long int TokenReader::ReadInteger(void) {
   Token token;			
@@ -404,6 +404,29 @@ enum Mode {File, Stdin, String, Stream};
    void ReadBinary(std::string& rData);
 
 
+  /**
+   * Read plain token (fast path)
+   *
+   * Reads the next token provided that it is a plain token, i.e., either a positive
+   * decimal integer or a symbolic name that is not quoted and that cannot be
+   * interpreted as a number. In contrast to Get(), plain tokens are scanned directly
+   * from the stream buffer, without constructing a Token object. 
+   *
+   * This method is meant for the bulk input of large containers, e.g., the transition
+   * relation of a generator; see vGenerator::ReadTransRel(). If the next token is
+   * not plain, nothing is read (except for leading white space), and the caller is meant
+   * to fall back to Get() or Peek().
+   *
+   * @param rIndex
+   *   Value of integer token, or 0 for a name
+   * @param rName
+   *   Name, or empty string for an integer token
+   * @return
+   *   True, if a plain token was read
+   *
+   */
+  bool ReadPlain(Idx& rIndex, std::string& rName);
+
   /**
    * Read plain text
    *		  
@@ -535,6 +558,9 @@ enum Mode {File, Stdin, String, Stream};
   /** istream object pointer */
   std::istream* mpStream;
 
+  /** Block buffer for file input (declared before the stream, which must be destructed first) */
+  std::vector<char> mFileBuffer;
+
   /** actual stream object, file input  */
   std::ifstream mFStream;
 
@@ -544,6 +570,9 @@ enum Mode {File, Stdin, String, Stream};
   /** Filename */
   std::string mFileName;
 
+  /** Skip white space and comments on stream buffer level (fast path) */
+  int PlainSpace(void);
+
   /** Line counter */
   int mLineCount;
 
@@ -23,6 +23,9 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
 
 #include "cfl_tokenwriter.h"
 
+// block buffer for file output
+#define FAUDES_TOKENWRITER_BUFSIZE (1<<20)
+
 namespace faudes {
 
 // TokenWriter(rFilename, openmode)
@@ -30,6 +33,8 @@ TokenWriter::TokenWriter(const std::string& rFilename, std::ios::openmode openmo
   : mMode(File), pSStream(0), mHasOutBuffer(false), mFileName(rFilename), mColumns(80/FD_NAMELEN), mColCount(0) {
   // set up mFStream
   mFStream.exceptions(std::ios::badbit|std::ios::failbit);
+  mFileBuffer.resize(FAUDES_TOKENWRITER_BUFSIZE);
+  mFStream.rdbuf()->pubsetbuf(&mFileBuffer[0],mFileBuffer.size());
   try{
     mFStream.open(rFilename.c_str(), openmode); 
   }
@@ -48,6 +53,8 @@ TokenWriter::TokenWriter(const std::string& rFilename, const std::string& ftype)
   : mMode(XmlFile), pSStream(0), mHasOutBuffer(false), mFileName(rFilename), mColumns(80/FD_NAMELEN), mColCount(0) {
   // set up mFStream
   mFStream.exceptions(std::ios::badbit|std::ios::failbit);
+  mFileBuffer.resize(FAUDES_TOKENWRITER_BUFSIZE);
+  mFStream.rdbuf()->pubsetbuf(&mFileBuffer[0],mFileBuffer.size());
   try{
     mFStream.open(rFilename.c_str(), std::ios::out|std::ios::trunc); 
     mFStream << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\" standalone=\"no\"?>" << std::endl;
@@ -186,7 +193,7 @@ void TokenWriter::Columns(int columns) {
 void TokenWriter::Endl(void) {
   DoFlush(1);
   try{
-    if(mEndl) *mpStream << std::endl;
+    if(mEndl) *mpStream << '\n';
     else *mpStream << " ";
   }
   catch (std::ios::failure&) {
@@ -211,7 +218,7 @@ void TokenWriter::DoFlush(bool clf) {
     for(size_t i=0; i< mOutBuffer.mPreceedingSpace.size(); ++i) {
       char c= mOutBuffer.mPreceedingSpace.at(i);
       if(c=='\n') {
-        if(mEndl) *mpStream << std::endl;
+        if(mEndl) *mpStream << '\n';
         else *mpStream << " ";
         mColCount=0; ;
         continue;
@@ -227,7 +234,7 @@ void TokenWriter::DoFlush(bool clf) {
     if(clf) {
       if(mOutBuffer.IsBegin() || mOutBuffer.IsEnd()) 
  	if(mColCount==1)
-          if(mEndl) { *mpStream << std::endl; mColCount=0;}
+          if(mEndl) { *mpStream << '\n'; mColCount=0;}
       mOutBuffer.SetNone();
     }
   }
@@ -404,9 +411,58 @@ void TokenWriter::WriteCharacterData(const std::string& rCharacterData) {
 
 // WriteInteger(index)
 void TokenWriter::WriteInteger(Idx index) {
-  Token token;
-  token.SetInteger(index);
-  Write(token);
+  // format as Token::Write(), i.e., expand to FD_NAMELEN plus one space
+  char buf[32+FD_NAMELEN];
+  char* end=buf+32;
+  char* pos=end;
+  do { *(--pos)= '0' + (index % 10); index/=10; } while(index>0);
+  while(end-pos < FD_NAMELEN) *(end++)=' ';
+  *(end++)=' ';
+  DoWriteFormatted(pos,end-pos);
+}
+
+// WriteFormatted(rData)
+void TokenWriter::WriteFormatted(const std::string& rData) {
+  DoWriteFormatted(rData.data(),rData.size());
+}
+
+// Format(rToken)
+std::string TokenWriter::Format(const Token& rToken) {
+  std::ostringstream ostr;
+  rToken.Write(&ostr);
+  return ostr.str();
+}
+
+// DoWriteFormatted(data): see Write(Token&) for the rules on data tokens
+void TokenWriter::DoWriteFormatted(const char* pData, std::size_t len) {
+  // flush buffer 
+  if(mHasOutBuffer) DoFlush(0);  
+  // figure preceeding space
+  char space=0;
+  bool markup = mOutBuffer.IsBegin() || mOutBuffer.IsEnd();
+  if(markup && (mColCount == 1)) space='\n';
+  else if(mColCount >= mColumns && (mColumns>0) && mEndl) space='\n';
+  else if(!markup) space=' ';
+  // do write
+  try{
+    if(space=='\n') {
+      if(mEndl) mpStream->put('\n');
+      else mpStream->put(' ');
+      mColCount=0;
+    } else if(space!=0) {
+      mpStream->put(space);
+    }
+    mpStream->write(pData,len);
+  }
+  catch (std::ios::failure&) {
+    std::stringstream errstr;
+    errstr << "Exception opening/writing file \"" << mFileName << "\"";
+    throw Exception("TokenWriter::Write(token)", errstr.str(), 2);
+  }
+  // count my columns
+  mColCount++;
+  // record a data token as recent output
+  if(markup) mOutBuffer.SetNone();
 }
 
 // WriteInteger(index)
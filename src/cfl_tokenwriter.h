@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA */
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 namespace faudes {
 
@@ -342,6 +343,32 @@ class FAUDES_API TokenWriter {
    */
   void WriteInteger(Idx index);
 
+  /**
+   * Write pre-formatted data token
+   *
+   * Bulk output of large containers may format repeated data tokens
+   * only once, e.g. the event names when writing a transition relation. 
+   * This method then emits the formatted string without setting up an
+   * intermediate Token, while spacing and column count are the same as 
+   * with Write(Token&). Formatted strings are obtained by Format(). 
+   *
+   * @param rData
+   *   Formatted data token
+   * @exception Exception
+   *   - faudes::Exception ios error wrtiting file (id 2)
+   */
+  void WriteFormatted(const std::string& rData);
+
+  /**
+   * Format data token for WriteFormatted()
+   *
+   * @param rToken
+   *   Data token, i.e., string, integer or float
+   * @return
+   *   Token as it would be written by Write(Token&)
+   */
+  static std::string Format(const Token& rToken);
+
   /**
    * Write float
    *
@@ -487,6 +514,9 @@ class FAUDES_API TokenWriter {
   /** ostream object pointer*/
   std::ostream* mpStream;
 
+  /** Block buffer for file output (declared before the stream, which must be destructed first) */
+  std::vector<char> mFileBuffer;
+
   /** Actual stream object, file output */
   std::ofstream mFStream;
 
@@ -518,6 +548,9 @@ class FAUDES_API TokenWriter {
   /** Flush internal buffer */
   void DoFlush(bool clf=1);
 
+  /** Write formatted data token, fast path  */
+  void DoWriteFormatted(const char* pData, std::size_t len);
+
 };
 
 } // namespace faudes
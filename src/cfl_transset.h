@@ -199,6 +199,66 @@ class FAUDES_API TransSort {
 };
 
 
+/**
+ * Compile-time properties of transition orders. For each kind of range, the
+ * respective flag indicates whether the order allows to access the range by
+ * a single lower_bound, e.g., ByX1Ev for all transitions with specified
+ * current state and event. TTransSet uses the flags to reject range access that
+ * does not match the sort order at compile time. The default applies to
+ * unknown orders and has all flags cleared.
+ */
+template<class Cmp>
+struct TransSortTraits {
+  static const bool ByX1=false;
+  static const bool ByX1Ev=false;
+  static const bool ByEv=false;
+  static const bool ByEvX1=false;
+  static const bool ByEvX2=false;
+  static const bool ByX2=false;
+  static const bool ByX2Ev=false;
+};
+
+/** Compile-time properties of order X1, Ev, X2 */
+template<>
+struct TransSortTraits<TransSort::X1EvX2> : public TransSortTraits<void> {
+  static const bool ByX1=true;
+  static const bool ByX1Ev=true;
+};
+
+/** Compile-time properties of order X1, X2, Ev */
+template<>
+struct TransSortTraits<TransSort::X1X2Ev> : public TransSortTraits<void> {
+  static const bool ByX1=true;
+};
+
+/** Compile-time properties of order Ev, X1, X2 */
+template<>
+struct TransSortTraits<TransSort::EvX1X2> : public TransSortTraits<void> {
+  static const bool ByEv=true;
+  static const bool ByEvX1=true;
+};
+
+/** Compile-time properties of order Ev, X2, X1 */
+template<>
+struct TransSortTraits<TransSort::EvX2X1> : public TransSortTraits<void> {
+  static const bool ByEv=true;
+  static const bool ByEvX2=true;
+};
+
+/** Compile-time properties of order X2, Ev, X1 */
+template<>
+struct TransSortTraits<TransSort::X2EvX1> : public TransSortTraits<void> {
+  static const bool ByX2=true;
+  static const bool ByX2Ev=true;
+};
+
+/** Compile-time properties of order X2, X1, Ev */
+template<>
+struct TransSortTraits<TransSort::X2X1Ev> : public TransSortTraits<void> {
+  static const bool ByX2=true;
+};
+
+
 
 /** 
  * Set of Transitions.
@@ -227,6 +287,10 @@ class FAUDES_API TransSort {
  *   
  * \endcode
  *
+ * Range access by Begin(x1), BeginByX2(x2) etc. is resolved at compile time: 
+ * each accessor amounts to a single lower_bound on the STL set, and accessors
+ * that do not match the sort order fail to compile (see TransSortTraits).
+ *
  * Note: it is the context of a Generator that
  * actually allows to interpret a TTransSet as a set of transitions as opposed to
  * a set of triples of indices. In particular, file IO of transitions is provided
@@ -361,8 +425,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    *
    * @param x1
    *   State index
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   void EraseByX1(Idx x1);
 
@@ -373,8 +435,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    *   State index
    * @param ev
    *   Event index
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   void EraseByX1Ev(Idx x1, Idx ev);
 
@@ -566,8 +626,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - Sorting mismatch (id 68)
    */
   Iterator Begin(Idx x1) const;
 
@@ -580,8 +638,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - Sorting mismatch (id 68)
    */
   Iterator End(Idx x1) const;
 
@@ -596,8 +652,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator 
    *
-   * @exception Exception
-   *   - Sorting mismatch (id 68)
    */
   Iterator Begin(Idx x1, Idx ev) const;
 
@@ -612,8 +666,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator End(Idx x1, Idx ev) const;
 
@@ -627,8 +679,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator BeginByEv(Idx ev) const;
 
@@ -642,8 +692,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator EndByEv(Idx ev) const;
 
@@ -659,8 +707,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator BeginByEvX1(Idx ev, Idx x1) const;
 
@@ -676,8 +722,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator EndByEvX1(Idx ev, Idx x1) const;
 
@@ -693,8 +737,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator BeginByEvX2(Idx ev, Idx x2) const;
 
@@ -710,8 +752,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator EndByEvX2(Idx ev, Idx x2) const;
 
@@ -725,8 +765,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator BeginByX2(Idx x2) const;
 
@@ -740,8 +778,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator EndByX2(Idx x2) const;
 
@@ -757,8 +793,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator BeginByX2Ev(Idx x2, Idx ev) const;
 
@@ -774,8 +808,6 @@ FAUDES_TYPE_DECLARATION(TransSet,TTransSet,(TBaseSet<Transition,Cmp>))
    * @return
    *   TTransSet<Cmp>::Iterator
    *
-   * @exception Exception
-   *   - sorting mismatch (id 68)
    */
   Iterator EndByX2Ev(Idx x2, Idx ev) const;
 
@@ -1417,154 +1449,105 @@ TEMP typename THIS::Iterator THIS::End(void) const {
 }
 
 
-// Convenience macro for order typecheck
-#define SORT_EXCEPTION  { std::stringstream errstr; \
-  errstr << "Transition set order mismatch " << std::endl; \
-  throw Exception("TransSet::Iterator()", errstr.str(), 68); }
+// Convenience macro for order typecheck (resolved at compile time)
+#define SORT_ASSERT(range) \
+  static_assert(TransSortTraits<Cmp>::range, "transition set order mismatch: no range access " #range)
 
 
 // iterator Begin(x1) const
 TEMP typename THIS::Iterator THIS::Begin(Idx x1) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    if(typeid(Cmp)!=typeid(TransSort::X1X2Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1);
   Transition tlx(x1,0,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator End(x1) const
 TEMP typename THIS::Iterator THIS::End(Idx x1) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    if(typeid(Cmp)!=typeid(TransSort::X1X2Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1);
   Transition tlx(x1+1,0,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator Begin(x1,ev) const
 TEMP typename THIS::Iterator THIS::Begin(Idx x1, Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1Ev);
   Transition tlx(x1,ev,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator End(x1,ev) const
 TEMP typename THIS::Iterator THIS::End(Idx x1, Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1Ev);
   Transition tlx(x1,ev+1, 0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator BeginByEv(ev) const
 TEMP typename THIS::Iterator THIS::BeginByEv(Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::EvX1X2)) 
-    if(typeid(Cmp)!=typeid(TransSort::EvX2X1)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByEv);
   Transition tlx(0,ev,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator EndByEv(ev) const
 TEMP typename THIS::Iterator THIS::EndByEv(Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::EvX1X2)) 
-    if(typeid(Cmp)!=typeid(TransSort::EvX2X1)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByEv);
   Transition tlx(0,ev+1,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator BeginByEvX1(ev,x1) const
 TEMP typename THIS::Iterator THIS::BeginByEvX1(Idx ev, Idx x1) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::EvX1X2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByEvX1);
   Transition tlx(x1,ev,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator EndByEvX1(ev,x1) const
 TEMP typename THIS::Iterator THIS::EndByEvX1(Idx ev, Idx x1) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::EvX1X2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByEvX1);
   Transition tlx(x1+1,ev,0);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator BeginByEvX2(ev,x2) const
 TEMP typename THIS::Iterator THIS::BeginByEvX2(Idx ev, Idx x2) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::EvX2X1)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByEvX2);
   Transition tlx(0,ev,x2);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator EndByEvX2(ev,x2) const
 TEMP typename THIS::Iterator THIS::EndByEvX2(Idx ev, Idx x2) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::EvX2X1)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByEvX2);
   Transition tlx(0,ev,x2+1);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator BeginByX2(x2) const
 TEMP typename THIS::Iterator THIS::BeginByX2(Idx x2) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-    if(typeid(Cmp)!=typeid(TransSort::X2X1Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2);
   Transition tlx(0,0,x2);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator EndByX2(x2) const
 TEMP typename THIS::Iterator THIS::EndByX2(Idx x2) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-    if(typeid(Cmp)!=typeid(TransSort::X2X1Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2);
   Transition tlx(0,0,x2+1);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator BeginByX2Ev(x2,ev) const
 TEMP typename THIS::Iterator THIS::BeginByX2Ev(Idx x2, Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2Ev);
   Transition tlx(0,ev,x2);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
 
 // iterator EndByX2Ev(x2,ev) const
 TEMP typename THIS::Iterator THIS::EndByX2Ev(Idx x2, Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2Ev);
   Transition tlx(0,ev+1,x2);
   return THIS::ThisIterator(BASE::pSet->lower_bound(tlx));
 }
@@ -1706,11 +1689,7 @@ TEMP typename THIS::Iterator THIS::Erase(const Iterator& it) {
 // EraseByX1(x)
 TEMP void THIS::EraseByX1(Idx x1) {
   FD_DC("TTransSet(" << this << ")::EraseByX1(" << x1 << ")");
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    if(typeid(Cmp)!=typeid(TransSort::X1X2Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1);
   this->Detach();
   typename BASE::iterator lower, upper, it;
   Transition tl(x1,0,0);
@@ -1726,10 +1705,7 @@ TEMP void THIS::EraseByX1(Idx x1) {
 // EraseByX1Ev(x,e)
 TEMP void THIS::EraseByX1Ev(Idx x1, Idx ev) {
   FD_DC("TTransSet(" << this << ")::EraseByX1Ev(" << x1 << "," << ev << ")");
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1Ev);
   this->Detach();
   typename BASE::iterator lower, upper, it;
   Transition tl(x1,ev,0);
@@ -1875,34 +1851,19 @@ TEMP bool THIS::ExistsByX1OrX2(Idx x) const {
 // ExistsByX1Ev(x,e)
 TEMP bool THIS::ExistsByX1Ev(Idx x1, Idx ev) const {
   FD_DC("TTransSet(" << this << ")::ExistsByX1Ev(" << x1 << "," << ev << ")");
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    SORT_EXCEPTION;
-#endif
-  this->Detach();
-  typename BASE::iterator lower, upper, it;
-  Transition tl(x1,ev,0);
-  Transition tu(x1,ev+1,0);
-  lower = BASE::pSet->lower_bound(tl);
-  upper = BASE::pSet->upper_bound(tu);
-  return lower != upper;
+  SORT_ASSERT(ByX1Ev);
+  typename BASE::const_iterator lower=BASE::pSet->lower_bound(Transition(x1,ev,0));
+  if(lower==BASE::pSet->end()) return false;
+  return (lower->X1==x1) && (lower->Ev==ev);
 }
 
 // ExistsByX1(x)
 TEMP bool THIS::ExistsByX1(Idx x1) const {
   FD_DC("TTransSet(" << this << ")::ExistsByX1(" << x1  << ")");
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-  if(typeid(Cmp)!=typeid(TransSort::X1X2Ev)) 
-    SORT_EXCEPTION;
-#endif
-  this->Detach();
-  typename BASE::iterator lower, upper, it;
-  Transition tl(x1,0,0);
-  Transition tu(x1+1,0,0);
-  lower = BASE::pSet->lower_bound(tl);
-  upper = BASE::pSet->upper_bound(tu);
-  return lower != upper;
+  SORT_ASSERT(ByX1);
+  typename BASE::const_iterator lower=BASE::pSet->lower_bound(Transition(x1,0,0));
+  if(lower==BASE::pSet->end()) return false;
+  return lower->X1==x1;
 }
 
 
@@ -1929,11 +1890,7 @@ TEMP StateSet THIS::States(void) const {
 
 // SuccessorStates(x1)
 TEMP StateSet THIS::SuccessorStates(Idx x1) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    if(typeid(Cmp)!=typeid(TransSort::X1X2Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1);
   StateSet states;
   Iterator it = Begin(x1);
   Iterator it_end = End(x1);
@@ -1946,11 +1903,7 @@ TEMP StateSet THIS::SuccessorStates(Idx x1) const {
 
 // SuccessorStates(x1set)
 TEMP StateSet THIS::SuccessorStates(const StateSet&  rX1Set) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    if(typeid(Cmp)!=typeid(TransSort::X1X2Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1);
   StateSet states;
   StateSet::Iterator sit= rX1Set.Begin();
   StateSet::Iterator sit_end= rX1Set.End();
@@ -1967,10 +1920,7 @@ TEMP StateSet THIS::SuccessorStates(const StateSet&  rX1Set) const {
 
 // SuccessorStates(x1, ev)
 TEMP StateSet THIS::SuccessorStates(Idx x1, Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1Ev);
   StateSet states;
   Iterator it = Begin(x1, ev);
   Iterator it_end = End(x1, ev);
@@ -1983,10 +1933,7 @@ TEMP StateSet THIS::SuccessorStates(Idx x1, Idx ev) const {
 
 // SuccessorStates(x1set, evset)
 TEMP StateSet THIS::SuccessorStates(const StateSet&  rX1Set, const EventSet& rEvSet) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X1EvX2)) 
-    SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX1Ev);
   StateSet states;
   if(rEvSet.Empty()) return states;
   StateSet::Iterator sit= rX1Set.Begin();
@@ -2018,11 +1965,7 @@ TEMP StateSet THIS::SuccessorStates(const StateSet&  rX1Set, const EventSet& rEv
 
 // PredecessorStates(x2)
 TEMP StateSet THIS::PredecessorStates(Idx x2) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-    if(typeid(Cmp)!=typeid(TransSort::X2X1Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2);
   StateSet states;
   Iterator it = BeginByX2(x2);
   Iterator it_end = EndByX2(x2);
@@ -2036,11 +1979,7 @@ TEMP StateSet THIS::PredecessorStates(Idx x2) const {
 
 // PredecessorStates(x2set)
 TEMP StateSet THIS::PredecessorStates(const StateSet&  rX2Set) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-    if(typeid(Cmp)!=typeid(TransSort::X2X1Ev)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2);
   StateSet states;
   StateSet::Iterator sit= rX2Set.Begin();
   StateSet::Iterator sit_end= rX2Set.End();
@@ -2057,10 +1996,7 @@ TEMP StateSet THIS::PredecessorStates(const StateSet&  rX2Set) const {
 
 // PredecessorStates(x2, ev)
 TEMP StateSet THIS::PredecessorStates(Idx x2, Idx ev) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2Ev);
   StateSet states;
   Iterator it = BeginByX2Ev(x2, ev);
   Iterator it_end = EndByX2Ev(x2, ev);
@@ -2073,10 +2009,7 @@ TEMP StateSet THIS::PredecessorStates(Idx x2, Idx ev) const {
 
 // PredecessorStates(x2set, evset)
 TEMP StateSet THIS::PredecessorStates(const StateSet&  rX2Set, const EventSet& rEvSet) const {
-#ifdef FAUDES_CHECKED
-  if(typeid(Cmp)!=typeid(TransSort::X2EvX1)) 
-      SORT_EXCEPTION;
-#endif
+  SORT_ASSERT(ByX2Ev);
   StateSet states;
   if(rEvSet.Empty()) return states;
   StateSet::Iterator sit= rX2Set.Begin();
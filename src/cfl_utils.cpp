@@ -24,6 +24,7 @@
 
 
 #include "cfl_utils.h"
+#include "cfl_context.h"
 
 
 // Debug includes
@@ -458,6 +459,8 @@ ConsoleOut::~ConsoleOut(void) {
   if(this==smpInstance) smpInstance=NULL;
 }
 ConsoleOut* ConsoleOut::G(void) {
+  ConsoleOut* cout=Context::Current()->Console();
+  if(cout) return cout;
   if(!smpInstance) smpInstance= new ConsoleOut();
   return smpInstance->pInstance;
 }
@@ -528,14 +531,35 @@ ObjectCount::ObjectCount(void) {
 void  ObjectCount::Init(void) {
  if(!msDone) ObjectCount();
 }
+#ifdef FAUDES_THREADS
+// counts are shared among all threads/contexts
+static faudes_mutex_t* objcount_mutex(void) {
+  static faudes_mutex_t mtx;
+  static int init=faudes_mutex_init(&mtx);
+  (void) init;
+  return &mtx;
+}
+#endif
 void  ObjectCount::Inc(const std::string& rTypeName) {
+#ifdef FAUDES_THREADS
+  faudes_mutex_lock(objcount_mutex());
+#endif
   if(!msDone) ObjectCount();
   long int cnt = ((*mspCount)[rTypeName]+=1);
   if((*mspMax)[rTypeName]<cnt) (*mspMax)[rTypeName]=cnt;
+#ifdef FAUDES_THREADS
+  faudes_mutex_unlock(objcount_mutex());
+#endif
 }
 void  ObjectCount::Dec(const std::string& rTypeName) {
+#ifdef FAUDES_THREADS
+  faudes_mutex_lock(objcount_mutex());
+#endif
   if(!msDone) ObjectCount();
   (*mspCount)[rTypeName]-=1;
+#ifdef FAUDES_THREADS
+  faudes_mutex_unlock(objcount_mutex());
+#endif
 }
 
 
@@ -617,6 +641,8 @@ void TestProtocol(const std::string& rMessage, const Type& rData, bool full) {
   gTestProtocolTw->WriteComment("");
   gTestProtocolTw->WriteComment("");
   *gTestProtocolTw << "\n";
+  // the protocol is not closed on exit, so we flush per record
+  gTestProtocolTw->Streamp()->flush();
 }
 void TestProtocol(const std::string& rMessage, bool data) {
   Boolean fbool(data);
@@ -706,9 +732,26 @@ void LoopCallback( bool pBreak(void)) {
 // note: this function is meant to be "quiet" during normal
 // operation in order not to mess up console logging
 void LoopCallback(void){
-  if(!gBreakFnct) return;
-  if(! (*gBreakFnct)() ) return;
-  throw Exception("LoopCallback", "break on application request", 110);
+  Context* ctx=Context::Current();
+  bool (*brk)(void)=ctx->BreakFnct();
+  if(!brk) brk=gBreakFnct;
+  if(brk) if((*brk)())
+    throw Exception("LoopCallback", "break on application request", 110);
+  if(ctx->Cancelled())
+    throw Exception("LoopCallback", "cancelled on application request", 110);
+  if(ctx->DeadlineExceeded())
+    throw Exception("LoopCallback", "deadline exceeded", 111);
+}
+
+// do loop callback incl state count
+void LoopCheck(Idx cntstates){
+  LoopCallback();
+  Idx limit=Context::Current()->StateLimit();
+  if((limit>0) && (cntstates>limit)) {
+    std::stringstream errstr;
+    errstr << "state limit exceeded (#" << cntstates << " > #" << limit << ")";
+    throw Exception("LoopCheck", errstr.str(), 112);
+  }
 }
 
 } // namespace faudes
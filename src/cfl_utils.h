@@ -340,6 +340,10 @@ extern FAUDES_API std::set< std::string > ReadDirectory(const std::string& rDire
  * The main motivation of the entire construct is to support gui applications that may
  * grab all console output by 1) deriving a specialised class from ConsoleOut and 2) 
  * redirection by ConsoleOut::G()->Redirect(derived_class_instance).
+ *
+ * When the current Context of the calling thread specifies a console, ConsoleOut::G()
+ * refers to that console instead; this is meant for applications that run multiple
+ * computations concurrently and need to separate the respective output.
  */
 class FAUDES_API ConsoleOut {
 public:
@@ -523,6 +527,8 @@ extern FAUDES_API bool TestProtocol(void);
  * are meant to use this interface to terminate an algorithm on user
  * request. libFAUDES algorithms are meant to throw an execption when
  * the callback function returns true. See also void LoopCallback(void).
+ * The callback function set by this function applies to all threads; a
+ * Context may specify an individual callback that takes precedence.
  *
  * @param pBreakFnct
  *
@@ -532,14 +538,34 @@ extern FAUDES_API  void LoopCallback(bool (*pBreakFnct)(void));
  /** Algorithm loop callback
   *
   * Calls the loop callback function and throws an exception if it
-  * returns true. 
+  * returns true. Likewise, an exception is thrown if the current Context
+  * has been cancelled or if its deadline has passed.
   *
   * @exception
   *   Break on appliation request (id 110)
+  *   Deadline exceeded (id 111)
   *
   */
 extern FAUDES_API void LoopCallback(void);
 
+ /** Algorithm loop callback incl. state count
+  *
+  * Calls LoopCallback() and, in addition, tests the number of states 
+  * of the intermediate result against the state limit of the current
+  * Context. Algorithms are meant to invoke this function via the macro
+  * FD_LOOP(), which amortises the overhead over multiple iterations.
+  *
+  * @param cntstates
+  *   Number of states of the intermediate result
+  *
+  * @exception
+  *   Break on appliation request (id 110)
+  *   Deadline exceeded (id 111)
+  *   State limit exceeded (id 112)
+  *
+  */
+extern FAUDES_API void LoopCheck(Idx cntstates);
+
 
 
 } // namespace faudes
@@ -26,10 +26,12 @@
 #include "cfl_definitions.h"
 
 #include "cfl_platform.h"
+#include "cfl_context.h"
 #include "cfl_utils.h"
 #include "cfl_exception.h"
 #include "cfl_registry.h"
 #include "cfl_attributes.h"
+#include "cfl_allocator.h"
 #include "cfl_baseset.h"
 #include "cfl_basevector.h"
 #include "cfl_elementary.h"
@@ -39,12 +41,16 @@
 #include "cfl_transset.h"
 #include "cfl_generator.h"
 #include "cfl_agenerator.h"
+#include "cfl_compiledgen.h"
+#include "cfl_tasks.h"
+#include "cfl_genbinary.h"
 #include "cfl_graphfncts.h"
 #include "cfl_parallel.h"
 #include "cfl_project.h"
 #include "cfl_determin.h"
 #include "cfl_regular.h"
 #include "cfl_statemin.h"
+#include "cfl_partition.h"
 #include "cfl_conflequiv.h"
 #include "cfl_bisimulation.h"
 #include "cfl_bisimcta.h"
@@ -0,0 +1,144 @@
+/** gen2bin.cpp  Utility to convert generators to/from the binary file format.
+
+This utility converts a generator from the std faudes token format (or XML)
+to the binary file format, see BinaryGenerator, and vice versa. The direction
+is sensed from the input file. Binary files are meant for fast loading of large
+generators, while the token format remains the preferred format for human
+editable files.
+
+Copyright (C) 2026  agent
+
+*/
+
+#include "corefaudes.h"
+
+using namespace faudes;
+
+
+// print usage info and exit
+void usage_exit(const std::string& message="") {
+  if(message!="") {
+    std::cout << "gen2bin: " << message << std::endl;
+    std::cout << "" << std::endl;
+    exit(-1);
+  }
+  std::cout << "gen2bin: version" << VersionString()  << std::endl;
+  std::cout << "" << std::endl;
+  std::cout << "usage: gen2bin [-t <ftype>] [-x] [-v] [-o <outfile>] <infile>" << std::endl;
+  std::cout << "where " << std::endl;
+  std::cout << "  <infile>: generator file to convert, either token format or binary" << std::endl;
+  std::cout << "" << std::endl;
+  std::cout << "  -t <ftype>:  faudes type of the generator (defaults to Generator)" << std::endl;
+  std::cout << "  -x:  write XML format when converting from binary" << std::endl;
+  std::cout << "  -v:  verify by reading back the output file and comparing with the input" << std::endl;
+  std::cout << "  -o <outfile>:  file to write (defaults to infile with .bgen or .gen suffix)" << std::endl;
+  std::cout << "" << std::endl;
+  exit(-1);
+}
+
+
+// process file
+int main(int argc, char *argv[]) {
+
+  // parameters
+  std::string mInFile;
+  std::string mOutFile;
+  std::string mType="Generator";
+  bool mXml=false;
+  int mVerify = 0;
+
+  // primitive commad line parsing
+  for(int i=1; i<argc; i++) {
+    std::string option(argv[i]);
+    // option: -t
+    if((option=="-t") || (option=="--ftype")) {
+      i++; if(i>=argc) usage_exit();
+      mType=argv[i];
+      continue;
+    }
+    // option: -o
+    if((option=="-o") || (option=="--outfile")) {
+      i++; if(i>=argc) usage_exit();
+      mOutFile=argv[i];
+      continue;
+    }
+    // option: -x
+    if((option=="-x") || (option=="--xml")) {
+      mXml=true;
+      continue;
+    }
+    // option: -v
+    if((option=="-v") || (option=="--verify")) {
+      mVerify++;
+      continue;
+    }
+    // option: help
+    if((option=="-?") || (option=="--help")) {
+      usage_exit();
+      continue;
+    }
+    // option: unknown
+    if(option.c_str()[0]=='-') {
+      usage_exit("unknown option "+ option);
+      continue;
+    }
+    // input
+    if(mInFile!="")
+      usage_exit("more than one filname specified");
+    mInFile=option;
+  }
+  if(mInFile=="") usage_exit();
+
+  // sense direction
+  bool tobin= !BinaryGenerator::Sense(mInFile);
+
+  // fix output file name
+  std::string basename = ExtractFilename(mInFile);
+  if(basename.find_last_of(".") !=std::string::npos) {
+    basename.resize(basename.find_last_of("."));
+  }
+  if(mOutFile=="") {
+    mOutFile= basename + (tobin ? ".bgen" : ".gen");
+  }
+  if(tobin && mOutFile=="-")
+    usage_exit("binary output requires a file");
+
+  // generator of specified type
+  Type* fobject=faudes::NewObject(mType);
+  vGenerator* gen=dynamic_cast<vGenerator*>(fobject);
+  if(!gen) usage_exit("faudes type " + mType + " is not a generator");
+
+  // convert to binary
+  if(tobin) {
+    gen->Read(mInFile);
+    WriteGeneratorBinary(*gen,mOutFile);
+  }
+
+  // convert from binary
+  if(!tobin) {
+    ReadGeneratorBinary(*gen,mInFile);
+    if(mOutFile=="-") {
+      if(mXml) gen->XWrite();
+      else gen->Write();
+    } else {
+      if(mXml) gen->XWrite(mOutFile);
+      else gen->Write(mOutFile);
+    }
+  }
+
+  // verify: read back
+  if(mOutFile!="-")
+  if(mVerify>0) {
+    std::cout << "gen2bin: reading back output" << std::endl;
+    vGenerator* readback = gen->New();
+    if(tobin) ReadGeneratorBinary(*readback,mOutFile);
+    else readback->Read(mOutFile);
+    if(!(*gen==*readback))
+      std::cout << "gen2bin: warning: generators dont match (!)" << std::endl;
+    delete readback;
+  }
+
+  // done
+  delete fobject;
+  return 0;
+}
@@ -701,16 +701,12 @@ public:
   bool Insert(Idx x1, Idx ev, Idx x2);
   bool Erase(Idx x1, Idx ev, Idx x2);
   TransSet ## ORDER ## Iterator Find(Idx x1, Idx ev, Idx x2) const;
-  void EraseByX1(Idx x1);
-  void EraseByX1Ev(Idx x1, Idx ev);
   void EraseByX2(Idx x2);
   void EraseByEv(Idx ev);
   void EraseByX1OrX2(Idx x);
   void RestrictStates(const StateSet& states);
   bool Exists(Idx x1, Idx ev, Idx x2) const;
   bool ExistsByX1OrX2(Idx x) const;
-  bool ExistsByX1Ev(Idx x1, Idx ev) const;
-  bool ExistsByX1(Idx x1) const;
   // convenience extension: event by name
   %extend {
     bool Insert(Idx x1, const std::string& rEvent, Idx x2) {
@@ -729,21 +725,6 @@ public:
       static EventSet defeset;
       return $self->Find(x1,defeset.SymbolTablep()->Index(rEvent),x2); };
   };
-  // more iterators (depend on sorting!)
-  TransSet ## ORDER ## Iterator Begin(Idx x1) const;
-  TransSet ## ORDER ## Iterator End(Idx x1) const;
-  TransSet ## ORDER ## Iterator Begin(Idx x1, Idx ev) const;
-  TransSet ## ORDER ## Iterator End(Idx x1, Idx ev) const;
-  TransSet ## ORDER ## Iterator BeginByEv(Idx ev) const;
-  TransSet ## ORDER ## Iterator EndByEv(Idx ev) const;
-  TransSet ## ORDER ## Iterator BeginByEvX1(Idx ev, Idx x1) const;
-  TransSet ## ORDER ## Iterator EndByEvX1(Idx ev, Idx x1) const;
-  TransSet ## ORDER ## Iterator BeginByEvX2(Idx ev, Idx x2) const;
-  TransSet ## ORDER ## Iterator EndByEvX2(Idx ev, Idx x2) const;
-  TransSet ## ORDER ## Iterator BeginByX2(Idx x2) const;
-  TransSet ## ORDER ## Iterator EndByX2(Idx x2) const;
-  TransSet ## ORDER ## Iterator BeginByX2Ev(Idx x2, Idx ev) const;
-  TransSet ## ORDER ## Iterator EndByX2Ev(Idx x2, Idx ev) const;
   // resort
   void ReSort(TransSetX1EvX2& res) const;
   void ReSort(TransSetX1X2Ev& res) const;
@@ -753,16 +734,6 @@ public:
   void ReSort(TransSetEvX2X1& res) const;
   // misc
   StateSet States(void) const;
-  EventSet ActiveEvents(Idx x1, SymbolTable* pSymTab=NULL) const;
-  StateSet SuccessorStates(Idx x1) const;
-  StateSet SuccessorStates(const StateSet&  x1set) const;
-  StateSet SuccessorStates(Idx x1, Idx ev) const;
-  StateSet SuccessorStates(const StateSet&  x1set, const EventSet& evset) const;
-  EventSet IncommingEvents(Idx x2, SymbolTable* pSymTab=NULL) const;
-  StateSet PredecessorStates(Idx x2) const;
-  StateSet PredecessorStates(const StateSet&  x2set) const;
-  StateSet PredecessorStates(Idx x1, Idx ev) const;
-  StateSet PredecessorStates(const StateSet&  x1set, const EventSet& evset) const;
   // convenience string conversion
   std::string Str(const Transition& rTrans) const;
   // convenience string conversion via iterator
@@ -781,6 +752,92 @@ SwigTransSet(X2X1Ev);
 SwigTransSet(EvX1X2);
 SwigTransSet(EvX2X1);
 
+
+// Transition set: range access depends on the sort order and is 
+// resolved at compile time; thus, we only wrap what matches the order 
+
+// range access by X1
+%define SwigTransSetByX1(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator Begin(Idx x1) const { return $self->Begin(x1); };
+  TransSet ## ORDER ## Iterator End(Idx x1) const { return $self->End(x1); };
+  void EraseByX1(Idx x1) { $self->EraseByX1(x1); };
+  bool ExistsByX1(Idx x1) const { return $self->ExistsByX1(x1); };
+  EventSet ActiveEvents(Idx x1, SymbolTable* pSymTab=NULL) const { return $self->ActiveEvents(x1,pSymTab); };
+  StateSet SuccessorStates(Idx x1) const { return $self->SuccessorStates(x1); };
+  StateSet SuccessorStates(const StateSet& x1set) const { return $self->SuccessorStates(x1set); };
+};
+%enddef
+
+// range access by X1 and Ev
+%define SwigTransSetByX1Ev(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator Begin(Idx x1, Idx ev) const { return $self->Begin(x1,ev); };
+  TransSet ## ORDER ## Iterator End(Idx x1, Idx ev) const { return $self->End(x1,ev); };
+  void EraseByX1Ev(Idx x1, Idx ev) { $self->EraseByX1Ev(x1,ev); };
+  bool ExistsByX1Ev(Idx x1, Idx ev) const { return $self->ExistsByX1Ev(x1,ev); };
+  StateSet SuccessorStates(Idx x1, Idx ev) const { return $self->SuccessorStates(x1,ev); };
+  StateSet SuccessorStates(const StateSet& x1set, const EventSet& evset) const { return $self->SuccessorStates(x1set,evset); };
+};
+%enddef
+
+// range access by Ev
+%define SwigTransSetByEv(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator BeginByEv(Idx ev) const { return $self->BeginByEv(ev); };
+  TransSet ## ORDER ## Iterator EndByEv(Idx ev) const { return $self->EndByEv(ev); };
+};
+%enddef
+
+// range access by Ev and X1
+%define SwigTransSetByEvX1(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator BeginByEvX1(Idx ev, Idx x1) const { return $self->BeginByEvX1(ev,x1); };
+  TransSet ## ORDER ## Iterator EndByEvX1(Idx ev, Idx x1) const { return $self->EndByEvX1(ev,x1); };
+};
+%enddef
+
+// range access by Ev and X2
+%define SwigTransSetByEvX2(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator BeginByEvX2(Idx ev, Idx x2) const { return $self->BeginByEvX2(ev,x2); };
+  TransSet ## ORDER ## Iterator EndByEvX2(Idx ev, Idx x2) const { return $self->EndByEvX2(ev,x2); };
+};
+%enddef
+
+// range access by X2
+%define SwigTransSetByX2(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator BeginByX2(Idx x2) const { return $self->BeginByX2(x2); };
+  TransSet ## ORDER ## Iterator EndByX2(Idx x2) const { return $self->EndByX2(x2); };
+  EventSet IncommingEvents(Idx x2, SymbolTable* pSymTab=NULL) const { return $self->IncommingEvents(x2,pSymTab); };
+  StateSet PredecessorStates(Idx x2) const { return $self->PredecessorStates(x2); };
+  StateSet PredecessorStates(const StateSet& x2set) const { return $self->PredecessorStates(x2set); };
+};
+%enddef
+
+// range access by X2 and Ev
+%define SwigTransSetByX2Ev(ORDER)
+%extend TransSet ## ORDER {
+  TransSet ## ORDER ## Iterator BeginByX2Ev(Idx x2, Idx ev) const { return $self->BeginByX2Ev(x2,ev); };
+  TransSet ## ORDER ## Iterator EndByX2Ev(Idx x2, Idx ev) const { return $self->EndByX2Ev(x2,ev); };
+  StateSet PredecessorStates(Idx x2, Idx ev) const { return $self->PredecessorStates(x2,ev); };
+  StateSet PredecessorStates(const StateSet& x2set, const EventSet& evset) const { return $self->PredecessorStates(x2set,evset); };
+};
+%enddef
+
+// Run macros to have range access as supported by TransSortTraits
+SwigTransSetByX1(X1EvX2);
+SwigTransSetByX1Ev(X1EvX2);
+SwigTransSetByX1(X1X2Ev);
+SwigTransSetByX2(X2EvX1);
+SwigTransSetByX2Ev(X2EvX1);
+SwigTransSetByX2(X2X1Ev);
+SwigTransSetByEv(EvX1X2);
+SwigTransSetByEvX1(EvX1X2);
+SwigTransSetByEv(EvX2X1);
+SwigTransSetByEvX2(EvX2X1);
+
 // Run macro to apply Python iterator fix
 SwigPyIteratorFix(TransSet)
 SwigPyIteratorFix(TransSetX1X2Ev)
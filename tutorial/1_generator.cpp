@@ -24,6 +24,24 @@ It also demonstrates file IO.
 using namespace faudes;
 
 
+// helper: test whether the range holds exactly those transitions of rAll 
+// that match the specified components (0 for any)
+template<class Iterator>
+bool TransRangeOk(Iterator begin, Iterator end, const TransSet& rAll, Idx x1, Idx ev, Idx x2) {
+  Idx cnt=0;
+  for(;begin!=end;++begin) {
+    if(x1!=0 && begin->X1!=x1) return false; 
+    if(ev!=0 && begin->Ev!=ev) return false; 
+    if(x2!=0 && begin->X2!=x2) return false; 
+    if(!rAll.Exists(*begin)) return false; 
+    ++cnt;
+  }
+  TransSet::Iterator tit=rAll.Begin();
+  for(;tit!=rAll.End();++tit) 
+    if((x1==0 || tit->X1==x1) && (ev==0 || tit->Ev==ev) && (x2==0 || tit->X2==x2)) --cnt;
+  return cnt==0;
+}
+
 
 /////////////////
 // main program
@@ -160,6 +178,130 @@ int main() {
   g4.Read("tmp_simplemachine.gen");
   g4.Read("tmp_simplemachine_ridx.gen");
 
+  // write to and read back from a file in compact binary format (see BinaryGenerator)
+  WriteGeneratorBinary(g4,"tmp_simplemachine.bgen");
+  Generator g4bin;
+  ReadGeneratorBinary(g4bin,"tmp_simplemachine.bgen");
+
+  // record test case
+  FAUDES_TEST_DUMP("binary io", g4bin); 
+  FAUDES_TEST_DUMP("binary io, equal", g4bin==g4); 
+
+  // binary files are validated when opened, i.e., a truncated file is rejected 
+  {
+    std::ifstream bsrc("tmp_simplemachine.bgen", std::ios::binary);
+    std::string bdata((std::istreambuf_iterator<char>(bsrc)), std::istreambuf_iterator<char>());
+    std::ofstream bdst("tmp_truncated.bgen", std::ios::binary);
+    bdst.write(bdata.data(), bdata.size()/2);
+  }
+  long int binary_errid=0;
+  try {
+    ReadGeneratorBinary(g4bin,"tmp_truncated.bgen");
+  } catch(faudes::Exception& exception) {
+    binary_errid=exception.Id();
+  } 
+
+  // record test case
+  FAUDES_TEST_DUMP("binary io, truncated", binary_errid); 
+
+  // a forged transition count that wraps when scaled to bytes is rejected, too
+  {
+    std::ifstream bsrc("tmp_simplemachine.bgen", std::ios::binary);
+    std::string bdata((std::istreambuf_iterator<char>(bsrc)), std::istreambuf_iterator<char>());
+    uint64_t forged=0x5555555555555556ULL; // transition count at header offset 40
+    bdata.replace(40, sizeof(forged), reinterpret_cast<const char*>(&forged), sizeof(forged));
+    std::ofstream bdst("tmp_forged.bgen", std::ios::binary);
+    bdst.write(bdata.data(), bdata.size());
+  }
+  binary_errid=0;
+  try {
+    ReadGeneratorBinary(g4bin,"tmp_forged.bgen");
+  } catch(faudes::Exception& exception) {
+    binary_errid=exception.Id();
+  }
+
+  // record test case
+  FAUDES_TEST_DUMP("binary io, forged", binary_errid);
+
+  // plain indices and names are scanned by a fast path of the token reader, anything
+  // else is passed on to the ordinary tokenizer: test a file that mixes both
+  Generator g4mix("data/tokenmix.gen");
+  TaGenerator<AttributeVoid,AttributeFlags,AttributeVoid,AttributeFlags> g4flags("data/tokenmix_flags.gen");
+
+  // record test case
+  FAUDES_TEST_DUMP("token io, mixed", g4mix.ToText());
+  FAUDES_TEST_DUMP("token io, attributes", g4flags.ToText());
+
+  // syntax errors are reported with the line number, also after fast path tokens
+  std::string mix_errmsg;
+  try {
+    Generator g4err("data/tokenmix_error.gen");
+  } catch(faudes::Exception& exception) {
+    mix_errmsg=exception.What();
+  }
+
+  // record test case
+  FAUDES_TEST_DUMP("token io, error", mix_errmsg);
+
+  // re-indexing on write maps named initial states to the lowest indices, followed by
+  // other named states and anonymous states; set up a generator with index gaps, anonymous
+  // initial states, long names and transition attributes to exercise the formatter
+  TaGenerator<AttributeVoid,AttributeVoid,AttributeVoid,AttributeFlags> g4ridx;
+  g4ridx.InsEvent("a");
+  g4ridx.InsEvent("an_event_with_a_long_name");
+  Idx ridx_s1=g4ridx.InsInitState();
+  Idx ridx_s2=g4ridx.InsState("a_state_with_a_long_name");
+  Idx ridx_s3=g4ridx.InsInitState("start");
+  Idx ridx_s4=g4ridx.InsState();
+  Idx ridx_s5=g4ridx.InsMarkedState("done");
+  Idx ridx_s6=g4ridx.InsState("yet_another_long_state_name");
+  for(int i=0; i<8; ++i) g4ridx.InsState("s"+ToStringInteger(i));
+  g4ridx.DelState(ridx_s4);
+  AttributeFlags ridx_flags;
+  ridx_flags.Set(0x0f);
+  g4ridx.SetTransition(Transition(ridx_s1,g4ridx.EventIndex("a"),ridx_s2),ridx_flags);
+  g4ridx.SetTransition(ridx_s3,g4ridx.EventIndex("an_event_with_a_long_name"),ridx_s6);
+  g4ridx.SetTransition(ridx_s6,g4ridx.EventIndex("a"),ridx_s5);
+  ridx_flags.Set(0xf0);
+  g4ridx.SetTransition(Transition(ridx_s2,g4ridx.EventIndex("an_event_with_a_long_name"),ridx_s5),ridx_flags);
+  g4ridx.SetTransition(ridx_s5,g4ridx.EventIndex("a"),ridx_s1);
+  g4ridx.ReindexOnWrite(true);
+  std::string ridx_text=g4ridx.ToText();
+
+  // reading back the re-indexed output gives consecutive indices in the above order, i.e.,
+  // now re-indexing amounts to the identity and must not affect the output
+  TaGenerator<AttributeVoid,AttributeVoid,AttributeVoid,AttributeFlags> g4ridxrd;
+  g4ridxrd.FromString(ridx_text);
+  g4ridxrd.ReindexOnWrite(true);
+  std::string ridx_textrd=g4ridxrd.ToText();
+  g4ridxrd.ReindexOnWrite(false);
+  bool ridx_same=(g4ridxrd.ToText()==ridx_textrd);
+
+  // record test case
+  FAUDES_TEST_DUMP("token io, reindex", ridx_text);
+  FAUDES_TEST_DUMP("token io, reindex read back", ridx_textrd);
+  FAUDES_TEST_DUMP("token io, reindex identity", ridx_same);
+
+  // with anonymous states, re-indexing maps initial states to the lowest indices, followed
+  // by all other states in their original order; set up a generator with index gaps
+  Generator g4anon;
+  g4anon.StateNamesEnabled(false);
+  g4anon.InsEvent("a");
+  for(int i=0; i<30; ++i) g4anon.InsState();
+  g4anon.DelState(3);
+  g4anon.DelState(17);
+  g4anon.SetInitState(20);
+  g4anon.SetInitState(25);
+  g4anon.SetMarkedState(30);
+  g4anon.SetTransition(20,g4anon.EventIndex("a"),1);
+  g4anon.SetTransition(1,g4anon.EventIndex("a"),25);
+  g4anon.SetTransition(25,g4anon.EventIndex("a"),30);
+  g4anon.SetTransition(30,g4anon.EventIndex("a"),20);
+  g4anon.ReindexOnWrite(true);
+
+  // record test case
+  FAUDES_TEST_DUMP("token io, reindex anonymous", g4anon.ToText());
+
   // debug output of Generator to console 
 
   std::cout << "################################\n";
@@ -739,6 +881,87 @@ int main() {
   gsigcomplC.Write("tmp_gsigcomplc.gen");
 
 
+  ///////////////////////////////////
+  // Range access per sort order
+  ///////////////////////////////////
+
+  // the range accessors available depend on the sort order, e.g., BeginByX2() requires 
+  // X2->Ev->X1 or X2->X1->Ev sorting; mismatching access is rejected at compile time
+  TransSet trel;
+  EventSet range_events;
+  Idx ev_a=range_events.Insert("a");
+  Idx ev_b=range_events.Insert("b");
+  trel.Insert(1,ev_a,2);
+  trel.Insert(1,ev_b,3);
+  trel.Insert(2,ev_a,2);
+  trel.Insert(2,ev_b,1);
+  trel.Insert(3,ev_a,1);
+  trel.Insert(3,ev_a,4);
+  trel.Insert(4,ev_b,4);
+  trel.Insert(4,ev_a,2);
+  TransSetX1X2Ev trel_x1x2ev;
+  TransSetX2EvX1 trel_x2evx1;
+  TransSetX2X1Ev trel_x2x1ev;
+  TransSetEvX1X2 trel_evx1x2;
+  TransSetEvX2X1 trel_evx2x1;
+  trel.ReSort(trel_x1x2ev);
+  trel.ReSort(trel_x2evx1);
+  trel.ReSort(trel_x2x1ev);
+  trel.ReSort(trel_evx1x2);
+  trel.ReSort(trel_evx2x1);
+
+  // compare all ranges with the respective filter on the full relation, incl. a state without transitions
+  bool range_ok=true;
+  for(Idx x=1; x<=5; ++x) {
+    range_ok = range_ok && TransRangeOk(trel.Begin(x),trel.End(x),trel,x,0,0);
+    range_ok = range_ok && TransRangeOk(trel_x1x2ev.Begin(x),trel_x1x2ev.End(x),trel,x,0,0);
+    range_ok = range_ok && TransRangeOk(trel_x2evx1.BeginByX2(x),trel_x2evx1.EndByX2(x),trel,0,0,x);
+    range_ok = range_ok && TransRangeOk(trel_x2x1ev.BeginByX2(x),trel_x2x1ev.EndByX2(x),trel,0,0,x);
+    range_ok = range_ok && (trel.ExistsByX1(x) == (trel.Begin(x)!=trel.End(x)));
+    EventSet::Iterator rit=range_events.Begin();
+    for(;rit!=range_events.End();++rit) {
+      range_ok = range_ok && TransRangeOk(trel.Begin(x,*rit),trel.End(x,*rit),trel,x,*rit,0);
+      range_ok = range_ok && TransRangeOk(trel_x2evx1.BeginByX2Ev(x,*rit),trel_x2evx1.EndByX2Ev(x,*rit),trel,0,*rit,x);
+      range_ok = range_ok && TransRangeOk(trel_evx1x2.BeginByEvX1(*rit,x),trel_evx1x2.EndByEvX1(*rit,x),trel,x,*rit,0);
+      range_ok = range_ok && TransRangeOk(trel_evx2x1.BeginByEvX2(*rit,x),trel_evx2x1.EndByEvX2(*rit,x),trel,0,*rit,x);
+      range_ok = range_ok && (trel.ExistsByX1Ev(x,*rit) == (trel.Begin(x,*rit)!=trel.End(x,*rit)));
+    }
+  }
+  EventSet::Iterator rit=range_events.Begin();
+  for(;rit!=range_events.End();++rit) {
+    range_ok = range_ok && TransRangeOk(trel_evx1x2.BeginByEv(*rit),trel_evx1x2.EndByEv(*rit),trel,0,*rit,0);
+    range_ok = range_ok && TransRangeOk(trel_evx2x1.BeginByEv(*rit),trel_evx2x1.EndByEv(*rit),trel,0,*rit,0);
+  }
+
+  // derived queries 
+  std::string range_succ = trel.SuccessorStates(3).ToString();
+  std::string range_succ_a = trel.SuccessorStates(3,ev_a).ToString();
+  std::string range_active = trel.ActiveEvents(4).ToString();
+  std::string range_pred = trel_x2evx1.PredecessorStates(2).ToString();
+  std::string range_pred_b = trel_x2evx1.PredecessorStates(1,ev_b).ToString();
+  std::string range_incomming = trel_x2evx1.IncommingEvents(1).ToString();
+
+  // erase by range 
+  trel.EraseByX1Ev(3,ev_a);
+  trel.EraseByX1(4);
+  std::string range_erase = trel.ToString();
+
+  std::cout << "################################\n";
+  std::cout << "# tutorial, range access: " << (range_ok ? "ok" : "failed") << "\n";
+  std::cout << "# successors of 3: " << range_succ << ", predecessors of 2: " << range_pred << "\n";
+  std::cout << "################################\n";
+
+  // record test case
+  FAUDES_TEST_DUMP("range ok",range_ok);
+  FAUDES_TEST_DUMP("range successors",range_succ);
+  FAUDES_TEST_DUMP("range successors a",range_succ_a);
+  FAUDES_TEST_DUMP("range active",range_active);
+  FAUDES_TEST_DUMP("range predecessors",range_pred);
+  FAUDES_TEST_DUMP("range predecessors b",range_pred_b);
+  FAUDES_TEST_DUMP("range incomming",range_incomming);
+  FAUDES_TEST_DUMP("range erase",range_erase);
+
+
   ///////////////////////////////////
   // Test case evaluation
   ///////////////////////////////////
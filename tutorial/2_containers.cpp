@@ -394,6 +394,12 @@ int main() {
 
   // Trigger detach and lock set B
   setB.Lock();
+#ifdef FAUDES_ITERATOR_EPOCH
+  // Epoch based iterators dont survive the detach: collect again
+  edIts.clear();
+  for(cit=setB.Begin();cit!=setB.End(); cit++) 
+    if(*cit % 5 ==0) edIts.push_back(cit);
+#endif
 
   // Further investigate true copy of setB
   cit=setB.Begin(); 
@@ -430,6 +436,352 @@ int main() {
   FAUDES_TEST_DUMP("deferred copy B - 3",setB);
   FAUDES_TEST_DUMP("deferred copy C - 3",setC);
 
+  ////////////////////////////////////////////////////
+  // Developper internal: iterators on deferred copies
+  ////////////////////////////////////////////////////
+
+  std::cout << "################################\n";
+  std::cout << "# tutorial, iterators on deferred copies \n";
+
+  // Two sets sharing their data
+  StateSet setD;
+  for(Idx state=1; state<11; state++) setD.Insert(state);
+  StateSet setE=setD;
+
+  // Iterators on both sets, pointing to state 5
+  StateSet::Iterator itD=setD.Find(5);
+  StateSet::Iterator itE=setE.Find(5);
+
+  // Write access to setE triggers the actual copy (setE gets the copy) 
+  setE.Insert(11);
+
+  // Iterators on setD remain valid; tracked iterators on setE get relinked,
+  // epoch based iterators on setE become invalid and must not be used 
+  bool ditok = itD.Valid() && *itD==5;
+  bool eitok = true;
+#ifndef FAUDES_ITERATOR_EPOCH
+  eitok = itE.Valid() && *itE==5;
+#endif
+
+  // Erase(pos) returns a valid iterator also when the set gets detached
+  StateSet setF=setD;
+  StateSet::Iterator itF=setF.Begin();
+  while(itF!=setF.End()) {
+    if(*itF % 2 == 0) itF=setF.Erase(itF);
+    else ++itF;
+  }
+  
+  // Test protocol
+  FAUDES_TEST_DUMP("iterator relink/stale D",ditok);
+  FAUDES_TEST_DUMP("iterator relink/stale E",eitok);
+  FAUDES_TEST_DUMP("iterator erase D",setD.ToString());
+  FAUDES_TEST_DUMP("iterator erase F",setF.ToString());
+  std::cout << "################################\n";
+
+  ////////////////////////////////////////////////////
+  // Developper internal: memory pools
+  ////////////////////////////////////////////////////
+
+  std::cout << "################################\n";
+  std::cout << "# tutorial, memory pools \n";
+
+  // Containers that outlive the scope
+  StateSet poolSurvivor;
+  Generator poolGen;
+  std::size_t poolCap1=0, poolCap2=0;
+  {
+    MemoryPoolScope scope;
+    // Build and destroy a generator within the scope
+    {
+      Generator gtmp;
+      Idx ev=gtmp.InsEvent("a");
+      for(Idx q=1; q<=1000; ++q) gtmp.InsState(q);
+      for(Idx q=1; q<1000; ++q) gtmp.SetTransition(q,ev,q+1);
+      poolCap1=scope.Pool()->Capacity();
+    }
+    // Nodes of the destroyed generator are re-used for the next one
+    Idx ev=poolGen.InsEvent("a");
+    for(Idx q=1; q<=1000; ++q) poolGen.InsState(q);
+    for(Idx q=1; q<1000; ++q) poolGen.SetTransition(q,ev,q+1);
+    poolGen.SetInitState(1);
+    poolGen.SetMarkedState(1000);
+    poolCap2=scope.Pool()->Capacity();
+    // A set allocated in the pool, shared with an outer set
+    StateSet stmp;
+    stmp.Insert(1);
+    stmp.Insert(2);
+    poolSurvivor=stmp;
+  }
+  bool poolReuse = (poolCap1>0) && (poolCap2==poolCap1);
+  std::cout << "# pool capacity " << poolCap1 << " / " << poolCap2 << "\n";
+
+  // Operate on the containers after the scope has been closed
+  poolSurvivor.Insert(3);
+  poolGen.DelState(500);
+  poolGen.Accessible();
+  std::string poolSurvivorStr = poolSurvivor.ToString();
+  long int poolGenSize = poolGen.Size();
+  std::cout << "# pool survivor " << poolSurvivorStr << "\n";
+
+  // Assignment across pools
+  StateSet poolSetA, poolSetB;
+  MemoryPoolScope* scopeA = new MemoryPoolScope();
+  for(Idx q=1; q<=10; ++q) poolSetA.Insert(q);
+  {
+    MemoryPoolScope scopeB;
+    for(Idx q=11; q<=20; ++q) poolSetB.Insert(q);
+    poolSetB=poolSetA;
+    poolSetB.Insert(21);
+  }
+  delete scopeA;
+  poolSetA.Erase(1);
+  poolSetB.Erase(2);
+  StateSet poolSetC;
+  poolSetC.Insert(22);
+  poolSetC.InsertSet(poolSetB);
+  std::string poolStrA = poolSetA.ToString();
+  std::string poolStrB = poolSetB.ToString();
+  std::string poolStrC = poolSetC.ToString();
+  std::cout << "# pool A " << poolStrA << "\n";
+  std::cout << "# pool B " << poolStrB << "\n";
+  std::cout << "# pool C " << poolStrC << "\n";
+  std::cout << "################################\n";
+
+  // Test protocol
+  FAUDES_TEST_DUMP("pool reuse",poolReuse);
+  FAUDES_TEST_DUMP("pool survivor",poolSurvivorStr);
+  FAUDES_TEST_DUMP("pool generator",poolGenSize);
+  FAUDES_TEST_DUMP("pool assign A",poolStrA);
+  FAUDES_TEST_DUMP("pool assign B",poolStrB);
+  FAUDES_TEST_DUMP("pool assign C",poolStrC);
+
+  ////////////////////////////////////////////////////
+  // Developper internal: symbol tables
+  ////////////////////////////////////////////////////
+
+  std::cout << "################################\n";
+  std::cout << "# tutorial, symbol tables \n";
+
+  // Have a symboltable with some entries, incl. an index beyond the dense array
+  SymbolTable symtab;
+  for(Idx k=1; k<=100; ++k) symtab.InsEntry("ev_" + ToStringInteger(k));
+  symtab.InsEntry(1000000000,"ev_far");
+  bool symLookup=true;
+  for(Idx k=1; k<=100; ++k) {
+    std::string name = "ev_" + ToStringInteger(k);
+    symLookup = symLookup && (symtab.Symbol(symtab.Index(name))==name);
+  }
+  symLookup = symLookup && (symtab.Index("ev_far")==1000000000) && (symtab.Symbol(1000000000)=="ev_far");
+  symLookup = symLookup && (symtab.LastIndex()==1000000000);
+
+  // Delete entries and insert names of the same length, i.e., deleted records are re-used
+  for(Idx k=10; k<=99; ++k) symtab.ClrEntry("ev_" + ToStringInteger(k));
+  for(Idx k=10; k<=99; ++k) symtab.InsEntry("xy_" + ToStringInteger(k));
+  symtab.SetEntry(1,"ev_one");
+  bool symReuse = (symtab.Size()==101);
+  for(Idx k=10; k<=99; ++k) {
+    std::string oname = "ev_" + ToStringInteger(k);
+    std::string nname = "xy_" + ToStringInteger(k);
+    symReuse = symReuse && (!symtab.Exists(oname)) && (!symtab.Exists(k));
+    symReuse = symReuse && (symtab.Symbol(symtab.Index(nname))==nname);
+  }
+  symReuse = symReuse && (!symtab.Exists("ev_1")) && (symtab.Symbol(1)=="ev_one");
+
+  // Restrict to some indices, the other names can be inserted again
+  IndexSet symdom;
+  symdom.Insert(1);
+  symdom.Insert(2);
+  symdom.Insert(1000000000);
+  symdom.Insert(symtab.Index("xy_10"));
+  symtab.RestrictDomain(symdom);
+  bool symRestrict = (symtab.Size()==4) && symtab.Exists("ev_one") && symtab.Exists("ev_2");
+  symRestrict = symRestrict && symtab.Exists("ev_far") && symtab.Exists("xy_10");
+  symRestrict = symRestrict && (!symtab.Exists("ev_3")) && (!symtab.Exists("xy_11"));
+  symtab.InsEntry(3,"ev_3");
+  symRestrict = symRestrict && (symtab.Index("ev_3")==3) && (symtab.Size()==5);
+  symtab.RestrictDomain(IndexSet());
+  symRestrict = symRestrict && (symtab.Size()==0) && (!symtab.Exists("ev_one"));
+
+  // Concurrent insertion, lookup and deletion by the workers of RunTasks: every task inserts 
+  // the same shared names and its own names, and deletes every other own name
+  struct SymTask {
+    SymbolTable* mpSymTab;
+    std::vector< std::vector<Idx> > mShared;
+    std::vector<bool> mOk;
+    static void Run(void* pData, std::size_t worker, std::size_t task) {
+      (void) worker;
+      SymTask* data = static_cast<SymTask*>(pData);
+      SymbolTable* symtab = data->mpSymTab;
+      std::string own = "own_" + ToStringInteger(task) + "_";
+      bool ok=true;
+      for(Idx k=0; k<1000; ++k) {
+        data->mShared[task].push_back(symtab->InsEntry("shared_" + ToStringInteger(k)));
+        Idx idx = symtab->InsEntry(own + ToStringInteger(k));
+        ok = ok && (symtab->Symbol(idx)==own + ToStringInteger(k));
+        if(k%2==1) symtab->ClrEntry(idx);
+      }
+      data->mOk[task]=ok;
+    }
+  };
+  SymbolTable csymtab;
+  csymtab.Concurrent(true);
+  SymTask symtask;
+  symtask.mpSymTab = &csymtab;
+  symtask.mShared.resize(8);
+  symtask.mOk.resize(8,false);
+  RunTasks(TaskThreads(4,8),8,&SymTask::Run,&symtask);
+  bool symConcurrent = csymtab.Concurrent() && (csymtab.Size()==1000+8*500);
+  for(std::size_t t=0; t<8; ++t) {
+    symConcurrent = symConcurrent && symtask.mOk[t] && (symtask.mShared[t]==symtask.mShared[0]);
+    for(Idx k=0; k<1000; ++k) {
+      std::string name = "own_" + ToStringInteger(t) + "_" + ToStringInteger(k);
+      symConcurrent = symConcurrent && (csymtab.Exists(name) == (k%2==0));
+    }
+  }
+  for(Idx k=0; k<1000; ++k) 
+    symConcurrent = symConcurrent && (csymtab.Symbol(symtask.mShared[0][k])=="shared_" + ToStringInteger(k));
+
+  // Concurrent lookup of sparse indices: the table is set up with a few entries far beyond
+  // its size, which are kept in the ordered map; task 0 inserts names until the dense array
+  // covers those indices and the entries migrate, while the other tasks look them up
+  struct SymSparseTask {
+    SymbolTable* mpSymTab;
+    std::atomic<bool> mDone;
+    std::vector<bool> mOk;
+    static void Run(void* pData, std::size_t worker, std::size_t task) {
+      (void) worker;
+      SymSparseTask* data = static_cast<SymSparseTask*>(pData);
+      SymbolTable* symtab = data->mpSymTab;
+      bool ok=true;
+      if(task==0) {
+        for(Idx k=0; k<2000; ++k) symtab->InsEntry("dense_" + ToStringInteger(k));
+        data->mDone=true;
+      } else {
+        for(Idx r=0; (r<100) || !data->mDone; ++r) {
+          for(Idx k=0; k<16; ++k) {
+            ok = ok && symtab->Exists(1000+k);
+            ok = ok && (symtab->Symbol(1000+k)=="sparse_" + ToStringInteger(k));
+          }
+        }
+      }
+      data->mOk[task]=ok;
+    }
+  };
+  bool symSparse = true;
+  for(int r=0; r<20; ++r) {
+    SymbolTable ssymtab;
+    ssymtab.Concurrent(true);
+    for(Idx k=0; k<16; ++k) ssymtab.InsEntry(1000+k,"sparse_" + ToStringInteger(k));
+    SymSparseTask ssymtask;
+    ssymtask.mpSymTab = &ssymtab;
+    ssymtask.mDone = false;
+    ssymtask.mOk.resize(4,false);
+    RunTasks(TaskThreads(4,4),4,&SymSparseTask::Run,&ssymtask);
+    symSparse = symSparse && (ssymtab.Size()==16+2000);
+    for(std::size_t t=0; t<4; ++t) symSparse = symSparse && ssymtask.mOk[t];
+  }
+
+  std::cout << "# symbol tables: lookup " << symLookup << ", re-use " << symReuse 
+            << ", restrict " << symRestrict << ", concurrent " << symConcurrent 
+            << ", sparse " << symSparse << "\n"; 
+  std::cout << "################################\n";
+
+  // Test protocol
+  FAUDES_TEST_DUMP("symbol table lookup",symLookup);
+  FAUDES_TEST_DUMP("symbol table re-use",symReuse);
+  FAUDES_TEST_DUMP("symbol table restrict",symRestrict);
+  FAUDES_TEST_DUMP("symbol table concurrent",symConcurrent);
+  FAUDES_TEST_DUMP("symbol table sparse",symSparse);
+
+  ////////////////////////////////////////////////////
+  // Developper internal: composition maps
+  ////////////////////////////////////////////////////
+
+  std::cout << "################################\n";
+  std::cout << "# tutorial, composition maps \n";
+
+  // few pairs within small ranges: the lookup starts with a hash table
+  CompositionHashMap cmap;
+  cmap.Reserve(50,50);
+  Idx cmapX12=0;
+  for(Idx x1=1; x1<=2; ++x1) 
+    for(Idx x2=1; x2<=50; ++x2) cmap.Insert(x1,x2,++cmapX12);
+  bool cmapHash = !cmap.Dense();
+  // more pairs: switch to the dense table
+  for(Idx x1=3; x1<=50; ++x1) 
+    for(Idx x2=1; x2<=50; ++x2) cmap.Insert(x1,x2,++cmapX12);
+  bool cmapDense = cmap.Dense();
+  // lookups 
+  bool cmapFind = (cmap.Size()==2500) && (cmap.Find(1,51)==0) && (cmap.Find(0,1)==0);
+  for(Idx x1=1; x1<=50; ++x1) 
+    for(Idx x2=1; x2<=50; ++x2) cmapFind = cmapFind && (cmap.Find(x1,x2)==(x1-1)*50+x2);
+  // a pair out of range: back to the hash table
+  cmap.Insert(1000,1,2501);
+  bool cmapOut = !cmap.Dense();
+  cmapFind = cmapFind && (cmap.Find(1000,1)==2501) && (cmap.Find(50,50)==2500);
+  // large ranges: never dense
+  CompositionHashMap cmapL;
+  cmapL.Reserve(100000,100000);
+  for(Idx x=1; x<=10000; ++x) cmapL.Insert(x,x,x);
+  bool cmapLarge = !cmapL.Dense();
+  for(Idx x=1; x<=10000; ++x) cmapFind = cmapFind && (cmapL.Find(x,x)==x) && (cmapL.Find(x,x+1)==0);
+  // std::map representation
+  std::map< std::pair<Idx,Idx>, Idx> cmapStl;
+  cmap.StlMap(cmapStl);
+  CompositionHashMap cmapCpy;
+  cmapCpy.FromStlMap(cmapStl);
+  bool cmapConvert = (cmapStl.size()==2501) && (cmapStl.rbegin()->second==2501) && (cmapCpy.Find(2,3)==53);
+
+  std::cout << "# composition map: hash " << cmapHash << ", dense " << cmapDense << ", out of range " << cmapOut 
+	    << ", large " << cmapLarge << ", find " << cmapFind << ", convert " << cmapConvert << "\n";
+  std::cout << "################################\n";
+
+  // Test protocol
+  FAUDES_TEST_DUMP("composition map hash",cmapHash);
+  FAUDES_TEST_DUMP("composition map dense",cmapDense);
+  FAUDES_TEST_DUMP("composition map out of range",cmapOut);
+  FAUDES_TEST_DUMP("composition map large",cmapLarge);
+  FAUDES_TEST_DUMP("composition map find",cmapFind);
+  FAUDES_TEST_DUMP("composition map convert",cmapConvert);
+
+  ////////////////////////////////////////////////////
+  // Developper internal: refinable partitions
+  ////////////////////////////////////////////////////
+
+  std::cout << "################################\n";
+  std::cout << "# tutorial, refinable partitions \n";
+
+  // elements 0 ... 7 in one set
+  RefinablePartition rpart;
+  rpart.Init(8);
+
+  // mark elements 2 and 5, element 2 repeatedly (second mark has no effect)
+  rpart.Mark(2);
+  rpart.Mark(2);
+  rpart.Mark(5);
+  rpart.Mark(2);
+  bool rpartMarked = rpart.Marked(2) && rpart.Marked(5) && !rpart.Marked(3) && (rpart.MarkedSize(0)==2);
+
+  // split: the marked elements become the new set 1
+  rpart.Split();
+
+  // have each set as string, elements in ascending order
+  std::string rpartSets;
+  for(Idx s=0; s<rpart.z; ++s) {
+    std::set<Idx> elements(rpart.E.begin()+rpart.F[s],rpart.E.begin()+rpart.P[s]);
+    rpartSets+= "{";
+    for(std::set<Idx>::iterator eit=elements.begin(); eit!=elements.end(); ++eit) 
+      rpartSets+= " " + ToStringInteger(*eit);
+    rpartSets+= " } ";
+  }
+
+  std::cout << "# refinable partition: marked " << rpartMarked << ", sets " << rpartSets << "\n";
+  std::cout << "################################\n";
+
+  // Test protocol
+  FAUDES_TEST_DUMP("refinable partition marked",rpartMarked);
+  FAUDES_TEST_DUMP("refinable partition sets",rpartSets);
+
   ////////////////////////////////////////////////////
   // Developper internal: test for memory leaks
   ////////////////////////////////////////////////////
@@ -75,6 +75,21 @@ int main() {
   // Test protocol
   FAUDES_TEST_DUMP("minimal",minimal_min);
 
+  // StateMin() expects a deterministic generator; this is only tested with FAUDES_CHECKED, 
+  // otherwise nondeterministic input shall still give a well-formed result
+  bool minimal_nondet=false;
+  try {
+    Generator minimal_nondet_res;
+    StateMin(deter_nondet,minimal_nondet_res);
+    minimal_nondet = minimal_nondet_res.Valid() && (minimal_nondet_res.Size() <= deter_nondet.Size());
+  } catch(Exception& exception) {
+    minimal_nondet = (exception.Id()==101);
+  }
+  std::cout << "# minimal generator from nondeterministic input: ok " << minimal_nondet << "\n";
+
+  // Test protocol
+  FAUDES_TEST_DUMP("minimal nondet",minimal_nondet);
+
   ////////////////////////////
   // project
   ////////////////////////////
@@ -106,6 +121,39 @@ int main() {
   // Test protocol
   FAUDES_TEST_DUMP("project",project_prog_min);
 
+  // projection by on-the-fly closure, generator with cycles of hidden events h and k
+  Generator closure_g;
+  closure_g.FromString("<Generator> \"closure\" <Alphabet> a b h k </Alphabet> <States> 1 2 3 4 5 </States> "
+    "<TransRel> 1 h 2 2 k 1 2 a 3 3 h 4 4 h 3 3 a 1 4 b 5 5 k 1 5 h 5 </TransRel> "
+    "<InitStates> 1 </InitStates> <MarkedStates> 4 5 </MarkedStates> </Generator>");
+  EventSet closure_alph;
+  closure_alph.Insert("a");
+  closure_alph.Insert("b");
+  Generator closure_prog, closure_ref;
+  closure_prog.StateNamesEnabled(false);
+  ProjectClosure(closure_g, closure_alph, closure_prog);
+  Project(closure_g, closure_alph, closure_ref);
+
+  // compare with Project(): marked and generated language
+  Generator closure_progc=closure_prog, closure_refc=closure_ref;
+  PrefixClosure(closure_progc);
+  PrefixClosure(closure_refc);
+  bool closure_ok = LanguageEquality(closure_prog,closure_ref) && LanguageEquality(closure_progc,closure_refc) 
+    && IsDeterministic(closure_prog);
+  Generator project_clos;
+  ProjectClosure(project_g, alph_proj, project_clos);
+  closure_ok = closure_ok && LanguageEquality(project_clos,project_prog) && IsDeterministic(project_clos);
+
+  // report result to console
+  std::cout << "################################\n";
+  std::cout << "# projection by closure: " << (closure_ok ? "matches" : "does not match") << " projection\n";
+  closure_prog.DWrite();
+  std::cout << "################################\n";
+
+  // Test protocol
+  FAUDES_TEST_DUMP("project closure",closure_ok);
+  FAUDES_TEST_DUMP("project closure result",closure_prog.ToString());
+
 
   ////////////////////////////
   // synchronous composition
@@ -145,6 +193,92 @@ int main() {
   // Test protocol
   FAUDES_TEST_DUMP("parallel",parallel_g1g2);
 
+  // compose more than two generators at once
+  GeneratorVector parallel_vec;
+  parallel_vec.Append(parallel_g1);
+  parallel_vec.Append(parallel_g2);
+  parallel_vec.Append(wparallel_g1);
+  Generator parallel_nary, parallel_pairwise;
+  Parallel(parallel_vec, parallel_nary);
+  Parallel(parallel_g1g2, wparallel_g1, parallel_pairwise);
+
+  // Test protocol
+  FAUDES_TEST_DUMP("parallel nary",parallel_nary);
+  FAUDES_TEST_DUMP("parallel nary vs pairwise",LanguageEquality(parallel_nary,parallel_pairwise));
+
+  // the live variant does not explore beyond states that cannot reach a marked state in
+  // some component; here, the first two components block after event c
+  Generator live_a, live_b, live_c;
+  live_a.FromString("<Generator> \"a\" <Alphabet> a b c </Alphabet> <States> 1 2 3 </States> "
+    "<TransRel> 1 a 2 2 b 1 2 c 3 </TransRel> <InitStates> 1 </InitStates> <MarkedStates> 1 </MarkedStates> </Generator>");
+  live_b.FromString("<Generator> \"b\" <Alphabet> a b c d </Alphabet> <States> 1 2 3 </States> "
+    "<TransRel> 1 a 2 2 b 1 2 c 3 3 d 1 </TransRel> <InitStates> 1 </InitStates> <MarkedStates> 1 </MarkedStates> </Generator>");
+  live_c.FromString("<Generator> \"c\" <Alphabet> a b d </Alphabet> <States> 1 2 </States> "
+    "<TransRel> 1 a 1 1 b 1 1 d 2 2 a 2 </TransRel> <InitStates> 1 </InitStates> <MarkedStates> 1 2 </MarkedStates> </Generator>");
+  GeneratorVector live_vec;
+  live_vec.Append(live_a);
+  live_vec.Append(live_b);
+  live_vec.Append(live_c);
+  Generator live_abc, product_abc, inter_abc;
+  live_abc.StateNamesEnabled(false);
+  product_abc.StateNamesEnabled(false);
+  ParallelLive(live_vec, live_abc);
+  Product(live_vec, product_abc);
+  LanguageIntersection(live_vec, inter_abc);
+
+  // pairwise reference for the live variant: trim the blocking states in between
+  Generator live_ref=live_a;
+  RemoveNonCoaccessibleOut(live_ref);
+  ParallelLive(live_ref, live_b, live_ref);
+  RemoveNonCoaccessibleOut(live_ref);
+  ParallelLive(live_ref, live_c, live_ref);
+  Generator inter_ref;
+  LanguageIntersection(live_a, live_b, inter_ref);
+  LanguageIntersection(inter_ref, live_c, inter_ref);
+
+  // Test protocol
+  FAUDES_TEST_DUMP("parallel live",live_abc);
+  FAUDES_TEST_DUMP("parallel live vs pairwise",LanguageEquality(live_abc,live_ref));
+  FAUDES_TEST_DUMP("product nary",product_abc);
+  FAUDES_TEST_DUMP("intersection nary",LanguageEquality(inter_abc,inter_ref));
+  FAUDES_TEST_DUMP("intersection nary name",inter_abc.Name());
+
+  // large compositions are explored by multiple threads when the current context
+  // asks for them; here, two chains that share every other event
+  Generator chain_g1, chain_g2;
+  chain_g1.InsEvent("a");
+  chain_g1.InsEvent("u");
+  chain_g2.InsEvent("a");
+  chain_g2.InsEvent("v");
+  for(Idx i=1; i<=1001; ++i) {
+    chain_g1.InsState(i);
+    chain_g2.InsState(i);
+  }
+  for(Idx i=1; i<1001; ++i) {
+    chain_g1.SetTransition(i, chain_g1.EventIndex(i%2==1 ? "u" : "a"), i+1);
+    chain_g2.SetTransition(i, chain_g2.EventIndex(i%2==1 ? "v" : "a"), i+1);
+  }
+  chain_g1.SetInitState(1);
+  chain_g2.SetInitState(1);
+  chain_g1.SetMarkedState(1001);
+  chain_g2.SetMarkedState(1001);
+  std::map< std::pair<Idx,Idx>, Idx> chain_map1, chain_map4, chain_pmap1, chain_pmap4;
+  Generator chain_par1, chain_par4, chain_prod1, chain_prod4;
+  Parallel(chain_g1, chain_g2, chain_map1, chain_par1);
+  Product(chain_g1, chain_g1, chain_pmap1, chain_prod1);
+  Context chain_ctx;
+  chain_ctx.Threads(4);
+  {
+    ContextScope chain_scope(&chain_ctx);
+    Parallel(chain_g1, chain_g2, chain_map4, chain_par4);
+    Product(chain_g1, chain_g1, chain_pmap4, chain_prod4);
+  }
+
+  // Test protocol (same state numbering with and without threads)
+  FAUDES_TEST_DUMP("parallel threads",chain_par4);
+  FAUDES_TEST_DUMP("parallel threads vs single",(chain_par4==chain_par1) && (chain_map4==chain_map1));
+  FAUDES_TEST_DUMP("product threads vs single",(chain_prod4==chain_prod1) && (chain_pmap4==chain_pmap1));
+
 
   ////////////////////////////
   // boolean language operations
@@ -680,6 +814,359 @@ int main() {
 
   FAUDES_TEST_DUMP("nonblocking 9b", nonblocking_ok9);
 
+  // test for conflicts C, pairwise on the fly, i.e., without the composition
+  std::cout << "# non-blocking exec test 9c\n";
+  nonblocking_ok9=IsNonblocking(nonblocking_gv.At(0),nonblocking_gv.At(1));
+  if(nonblocking_ok9) 
+     std::cout << "# non-blocking test: passed (test case error!)\n";
+  else
+     std::cout << "# non-blocking test: failed (expected)\n";
+
+  FAUDES_TEST_DUMP("nonblocking 9c", nonblocking_ok9);
+
+  // test for conflicts D, the trimmed composition does not conflict with a component
+  std::cout << "# non-blocking exec test 9d\n";
+  Trim(parallel12);
+  nonblocking_ok9=IsNonblocking(parallel12,nonblocking_gv.At(0));
+  if(nonblocking_ok9) 
+     std::cout << "# non-blocking test: passed (expected)\n";
+  else
+     std::cout << "# non-blocking test: failed (test case error!)\n";
+
+  FAUDES_TEST_DUMP("nonblocking 9d", nonblocking_ok9);
+
+
+  ////////////////////////////
+  // budgets and cancellation
+  ////////////////////////////
+
+  // a composition with 4096 states: two times three cycles with private events
+  Generator budget_g1, budget_g2;
+  for(int i=0; i<6; ++i) {
+    Generator cycle;
+    for(int j=0; j<4; ++j) cycle.InsState(j+1);
+    cycle.SetInitState(1);
+    cycle.SetMarkedState(1);
+    for(int j=0; j<4; ++j) {
+      Idx ev=cycle.InsEvent("c"+ToStringInteger(i)+"_"+ToStringInteger(j));
+      cycle.SetTransition(j+1,ev,(j+1)%4+1);
+    }
+    Generator& comp = (i<3 ? budget_g1 : budget_g2);
+    if(i%3==0) comp=cycle;
+    else Parallel(comp,cycle,comp);
+  }
+
+  // limit the number of states of intermediate results (exception id 112)
+  long int budget_states=0;
+  try {
+    BudgetScope budget(0,100);
+    Generator budget_res;
+    Parallel(budget_g1, budget_g2, budget_res);
+  } catch(faudes::Exception& exception) {
+    budget_states=exception.Id();
+  } 
+  std::cout << "# budget test: state limit exception id " << budget_states << " (expect 112)\n";
+
+  // limit the time (exception id 111)
+  long int budget_time=0;
+  try {
+    BudgetScope budget(1);
+    faudes_usleep(10000);
+    Generator budget_res;
+    Parallel(budget_g1, budget_g2, budget_res);
+  } catch(faudes::Exception& exception) {
+    budget_time=exception.Id();
+  } 
+  std::cout << "# budget test: deadline exception id " << budget_time << " (expect 111)\n";
+
+  // cancel the computations within a context, e.g. from a supervising thread (exception id 110)
+  long int budget_cancel=0;
+  Context budget_context;
+  try {
+    ContextScope scope(&budget_context);
+    budget_context.Cancel();
+    Generator budget_res;
+    Parallel(budget_g1, budget_g2, budget_res);
+  } catch(faudes::Exception& exception) {
+    budget_cancel=exception.Id();
+  } 
+  std::cout << "# budget test: cancel exception id " << budget_cancel << " (expect 110)\n";
+
+  // the enclosing context is not affected
+  Generator budget_res;
+  Parallel(budget_g1, budget_g2, budget_res);
+  bool budget_ok = (budget_res.Size()==4096);
+
+  // Record test case
+  FAUDES_TEST_DUMP("budget states", budget_states);
+  FAUDES_TEST_DUMP("budget time", budget_time);
+  FAUDES_TEST_DUMP("budget cancel", budget_cancel);
+  FAUDES_TEST_DUMP("budget ok", budget_ok);
+
+
+  ////////////////////////////
+  // strongly connected components
+  ////////////////////////////
+
+  // a chain of 10^6 states with events "a" and a back edge "b" from the last to the first state
+  Generator scc_chain;
+  Idx scc_n = 1000000;
+  Idx scc_a = scc_chain.InsEvent("a");
+  Idx scc_b = scc_chain.InsEvent("b");
+  for(Idx i=1; i<=scc_n; ++i) scc_chain.InsState(i);
+  for(Idx i=1; i<scc_n; ++i) scc_chain.SetTransition(i,scc_a,i+1);
+  scc_chain.SetTransition(scc_n,scc_b,1);
+  scc_chain.SetInitState(1);
+
+  // the entire chain is one SCC (search depth 10^6, no recursion involved)
+  std::list<StateSet> scc_list;
+  StateSet scc_roots;
+  SccFilter scc_fnontriv(SccFilter::FmIgnoreTrivial,scc_chain);
+  ComputeScc(scc_chain,scc_fnontriv,scc_list,scc_roots);
+  long int scc_count = scc_list.size();
+  long int scc_size = scc_list.empty() ? 0 : scc_list.front().Size();
+  std::cout << "# scc chain: #" << scc_count << " components, largest #" << scc_size << "\n";
+
+  // without the back edge there are only trivial components
+  EventSet scc_avoid;
+  scc_avoid.Insert(scc_b);
+  SccFilter scc_favoid(SccFilter::FmIgnoreTrivial | SccFilter::FmEventsAvoid,scc_avoid);
+  bool scc_has = HasScc(scc_chain,scc_favoid);
+  std::cout << "# scc chain: non-trivial SCC without back edge " << scc_has << " (expect 0)\n";
+
+  // use the iterative search directly: callbacks count components and skip one event
+  struct SccCount {
+    Idx mSkip, mCount, mFirst, mLargest;
+    static bool Record(void* pData, Idx root, const std::vector<Idx>& rScc) {
+      SccCount* pcnt = (SccCount*) pData;
+      if(pcnt->mCount==0) pcnt->mFirst=root;
+      ++pcnt->mCount;
+      if(rScc.size()>pcnt->mLargest) pcnt->mLargest=rScc.size();
+      return true;
+    }
+    static bool Skip(void* pData, Idx q, const CompiledGenerator::Edge& rEdge) {
+      return rEdge.Ev != ((SccCount*) pData)->mSkip;
+    }
+  };
+  CompiledGenerator scc_cgen(scc_chain);
+  std::vector<bool> scc_todo(scc_cgen.Size()+1,true);
+  SccCount scc_cnt = {scc_cgen.EventIndex(scc_b),0,0,0};
+  IterativeScc(scc_cgen,scc_todo,&SccCount::Skip,&SccCount::Record,&scc_cnt,false);
+  long int scc_ncount = scc_cnt.mCount;
+  // ... successors are reported first: the end of the chain completes first
+  bool scc_order = (scc_cgen.State(scc_cnt.mFirst)==scc_n);
+  // ... all edges, backward search
+  scc_todo.assign(scc_cgen.Size()+1,true);
+  scc_cnt.mCount=0;
+  scc_cnt.mLargest=0;
+  IterativeScc(scc_cgen,scc_todo,NULL,&SccCount::Record,&scc_cnt,true);
+  long int scc_bcount = scc_cnt.mCount;
+  long int scc_bsize = scc_cnt.mLargest;
+
+  // Record test case
+  FAUDES_TEST_DUMP("scc chain count", scc_count);
+  FAUDES_TEST_DUMP("scc chain size", scc_size);
+  FAUDES_TEST_DUMP("scc chain avoid", scc_has);
+  FAUDES_TEST_DUMP("scc iterative count", scc_ncount);
+  FAUDES_TEST_DUMP("scc iterative order", scc_order);
+  FAUDES_TEST_DUMP("scc backward count", scc_bcount);
+  FAUDES_TEST_DUMP("scc backward size", scc_bsize);
+
+
+  ////////////////////////////
+  // state minimization, multiple threads
+  ////////////////////////////
+
+  // cycle of 60000 states, events "a" (step 1) and "b" (step 2), every 6th state marked;
+  // the minimal realisation has 6 states, with the large splitters marked concurrently
+  Generator smt_cycle;
+  Idx smt_n = 60000;
+  Idx smt_a = smt_cycle.InsEvent("a");
+  Idx smt_b = smt_cycle.InsEvent("b");
+  for(Idx i=1; i<=smt_n; ++i) smt_cycle.InsState(i);
+  for(Idx i=1; i<=smt_n; ++i) {
+    smt_cycle.SetTransition(i,smt_a,i % smt_n + 1);
+    smt_cycle.SetTransition(i,smt_b,(i+1) % smt_n + 1);
+    if(i % 6 == 0) smt_cycle.SetMarkedState(i);
+  }
+  smt_cycle.SetInitState(1);
+
+  // minimize sequentially and with 4 threads
+  Generator smt_min1, smt_min4;
+  StateMin(smt_cycle, smt_min1);
+  Context smt_ctx;
+  smt_ctx.Threads(4);
+  {
+    ContextScope smt_scope(&smt_ctx);
+    StateMin(smt_cycle, smt_min4);
+  }
+
+  // results must match including the state numbering, i.e., the order of the least original state
+  bool smt_equal = 
+    (smt_min1.States()==smt_min4.States()) && (smt_min1.TransRel()==smt_min4.TransRel()) &&
+    (smt_min1.InitStates()==smt_min4.InitStates()) && (smt_min1.MarkedStates()==smt_min4.MarkedStates());
+  smt_min4.ClearStateNames();
+  std::string smt_trans = smt_min4.TransRelToString();
+  std::string smt_marked = smt_min4.MarkedStatesToString();
+  std::cout << "# state minimization: #" << smt_min4.Size() << " states, threads agree " << smt_equal << "\n";
+
+  // Record test case
+  FAUDES_TEST_DUMP("statemin threads",smt_min4);
+  FAUDES_TEST_DUMP("statemin equal",smt_equal);
+  FAUDES_TEST_DUMP("statemin trans",smt_trans);
+  FAUDES_TEST_DUMP("statemin marked",smt_marked);
+
+
+  ////////////////////////////
+  // compositional conflict verification: threads and candidate heuristics
+  ////////////////////////////
+
+  // heuristic that validates the event index before passing on to 'minS'
+  struct CfeCheck {
+    static Idx& Calls(void) { static Idx calls=0; return calls; }
+    static bool& Ok(void) { static bool ok=true; return ok; }
+    static void Fnct(const GeneratorVector& rGenVec, const std::map<Idx,Idx>& rEventCount, Idx& rI, Idx& rJ) {
+      ++Calls();
+      std::map<Idx,Idx> count;
+      for(Idx i=0; i<rGenVec.Size(); ++i) {
+        EventSet::Iterator eit=rGenVec.At(i).AlphabetBegin();
+        for(;eit!=rGenVec.At(i).AlphabetEnd();++eit) ++count[*eit];
+      }
+      std::map<Idx,Idx>::const_iterator cit=rEventCount.begin();
+      for(;cit!=rEventCount.end();++cit) {
+        Idx n = count.count(cit->first) ? count[cit->first] : 0;
+        if(n!=cit->second) Ok()=false;
+        count.erase(cit->first);
+      }
+      if(!count.empty()) Ok()=false;
+      ConflictCandidateMinS(rGenVec,rEventCount,rI,rJ);
+    }
+  };
+
+  // families and expected results from the above test cases
+  std::vector<std::string> cfe_families = {"2345", "56789", "34567", "1357", "2468"};
+  std::string cfe_expected = "11001";
+  // runs: default heuristic sequential, then all heuristics with 4 threads
+  ConflictCandidateFnct cfe_heuristics[] = 
+    {&ConflictCandidateMinTMaxC, &ConflictCandidateMinTMaxC, &ConflictCandidateMinTMaxL, 
+     &ConflictCandidateMinS, &CfeCheck::Fnct};
+  Idx cfe_threads[] = {1,4,4,4,4};
+  bool cfe_agree = true;
+  Context cfe_ctx;
+  for(std::size_t f=0; f<cfe_families.size(); ++f) {
+    GeneratorVector cfe_gv;
+    for(std::size_t k=0; k<cfe_families[f].size(); ++k) 
+      cfe_gv.PushBack("data/noblo_g" + cfe_families[f].substr(k,1) + ".gen");
+    bool expected = (cfe_expected[f]=='1');
+    for(int r=0; r<5; ++r) {
+      cfe_ctx.ConflictCandidate(cfe_heuristics[r]);
+      cfe_ctx.Threads(cfe_threads[r]);
+      ContextScope cfe_scope(&cfe_ctx);
+      if(IsNonblocking(cfe_gv)!=expected) {
+        std::cout << "# conflict equivalence: family " << cfe_families[f] << " run " << r << " [fail]\n";
+        cfe_agree=false;
+      }
+    }
+  }
+  bool cfe_index = CfeCheck::Ok() && (CfeCheck::Calls()>0);
+  std::cout << "# conflict equivalence: agree " << cfe_agree << ", event index " << cfe_index << "\n";
+
+  // Record test case
+  FAUDES_TEST_DUMP("conflequiv agree", cfe_agree);
+  FAUDES_TEST_DUMP("conflequiv event index", cfe_index);
+
+
+  ////////////////////////////
+  // library contexts: isolation of concurrent computations
+  ////////////////////////////
+
+  // every task installs its own context with a copy of the event symbol table and 
+  // its own console; task 1 also has a break function that requests a break 
+  struct CtxConsole : public ConsoleOut {
+    std::string mText;
+    virtual void DoWrite(const std::string& message,long int cntnow=0, long int cntdone=0, int verb=1) {
+      (void) cntnow; (void) cntdone; (void) verb;
+      mText += message;
+    }
+  };
+  struct CtxTask {
+    std::vector<bool> mTable;
+    std::vector<std::string> mConsole;
+    std::vector<long int> mBreak;
+    static bool Break(void) { return true; }
+    static void Run(void* pData, std::size_t worker, std::size_t task) {
+      (void) worker;
+      CtxTask* data = static_cast<CtxTask*>(pData);
+      std::string tname = ToStringInteger(task);
+      SymbolTable events(*SymbolTable::GlobalEventSymbolTablep());
+      CtxConsole console;
+      Context ctx;
+      ctx.EventSymbolTablep(&events);
+      ctx.Console(&console);
+      if(task==1) ctx.BreakFnct(&Break);
+      ContextScope scope(&ctx);
+      Generator gen;
+      gen.InsEvent("ctx_ev_" + tname);
+      data->mTable[task] = (gen.EventSymbolTablep()==&events) && events.Concurrent() && events.Exists("ctx_ev_" + tname);
+      for(Idx k=0; k<1000; ++k) ObjectCount::Inc("ContextTest");
+      for(Idx k=0; k<500; ++k) ObjectCount::Dec("ContextTest");
+      try {
+        Print(1,"task " + tname);
+        Print(1,"done " + tname);
+      } catch(faudes::Exception& exception) {
+        data->mBreak[task]=exception.Id();
+      }
+      data->mConsole[task]=console.mText;
+    }
+  };
+
+  // run 4 tasks on 4 threads
+  CtxTask ctx_task;
+  ctx_task.mTable.resize(4,false);
+  ctx_task.mConsole.resize(4);
+  ctx_task.mBreak.resize(4,0);
+  ObjectCount::Init();
+  long int ctx_cnt0 = (*ObjectCount::mspCount)["ContextTest"];
+  RunTasks(TaskThreads(4,4),4,&CtxTask::Run,&ctx_task);
+  long int ctx_cnt1 = (*ObjectCount::mspCount)["ContextTest"];
+
+  // symbol tables: events of the tasks must not show in the global table
+  bool ctx_table = true;
+  for(std::size_t t=0; t<4; ++t) {
+    ctx_table = ctx_table && ctx_task.mTable[t];
+    ctx_table = ctx_table && !SymbolTable::GlobalEventSymbolTablep()->Exists("ctx_ev_" + ToStringInteger(t));
+  }
+
+  // consoles: each task only sees its own output; task 1 breaks after the first message
+  std::string ctx_console;
+  for(std::size_t t=0; t<4; ++t) ctx_console += ctx_task.mConsole[t];
+  std::string ctx_break;
+  for(std::size_t t=0; t<4; ++t) {
+    if(t>0) ctx_break += " ";
+    ctx_break += ToStringInteger(ctx_task.mBreak[t]);
+  }
+
+  // the global context is not affected by the break function of task 1 
+  bool ctx_global = true;
+  try {
+    Print(2,"context test: global console");
+  } catch(faudes::Exception& exception) {
+    ctx_global = false;
+  }
+
+  // object counts are shared by all threads
+  long int ctx_count = ctx_cnt1 - ctx_cnt0;
+  std::cout << "# context test: tables " << ctx_table << ", breaks " << ctx_break 
+	    << ", global " << ctx_global << ", object count " << ctx_count << " (expect 2000)\n";
+  std::cout << ctx_console;
+
+  // Record test case
+  FAUDES_TEST_DUMP("context tables", ctx_table);
+  FAUDES_TEST_DUMP("context consoles", ctx_console);
+  FAUDES_TEST_DUMP("context breaks", ctx_break);
+  FAUDES_TEST_DUMP("context global", ctx_global);
+  FAUDES_TEST_DUMP("context object count", ctx_count);
+
 
   FAUDES_TEST_DIFF()
 